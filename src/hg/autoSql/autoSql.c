@@ -25,6 +25,7 @@ boolean addBin = FALSE;
 boolean makeJson = FALSE;
 boolean makeDjango = FALSE;
 boolean defaultZeros = FALSE;
+boolean makeLm = FALSE;
 
 void usage()
 /* Explain usage and exit. */
@@ -33,7 +34,7 @@ errAbort("autoSql - create SQL and C code for permanently storing\n"
          "a structure in database and loading it back into memory\n"
 	 "based on a specification file\n"
 	 "usage:\n"
-	 "    autoSql specFile outRoot {optional: -dbLink -withNull -json} \n"
+	 "    autoSql specFile outRoot {optional: -dbLink -withNull -json -lm} \n"
 	 "This will create outRoot.sql outRoot.c and outRoot.h based\n"
 	 "on the contents of specFile. \n"
          "\n"
@@ -47,7 +48,10 @@ errAbort("autoSql - create SQL and C code for permanently storing\n"
          "              situations.\n"
 	 "  -defaultZeros - will put zero and or empty string as default value\n"
          "  -django - generate method to output object as django model Python code\n"
-	 "  -json - generate method to output the object in JSON (JavaScript) format.\n");
+	 "  -json - generate method to output the object in JSON (JavaScript) format.\n"
+	 "  -lm - also generate routines that load objects into local memory without\n"
+	 "        copying strings, and that pack objects into a compact binary form\n"
+	 "        and unpack them again.\n");
 }
 
 static struct optionSpec optionSpecs[] = {
@@ -57,6 +61,7 @@ static struct optionSpec optionSpecs[] = {
     {"defaultZeros", OPTION_BOOLEAN},
     {"json", OPTION_BOOLEAN},
     {"django", OPTION_BOOLEAN},
+    {"lm", OPTION_BOOLEAN},
     {NULL, 0}
 };
 
@@ -740,6 +745,18 @@ for (col = table->columnList; col != NULL; col = col->next)
 return FALSE;
 }
 
+boolean objectHasLists(struct asObject *table)
+/* Returns TRUE if object has any list or array members. */
+{
+struct asColumn *col;
+for (col = table->columnList; col != NULL; col = col->next)
+    {
+    if (col->isList || col->isArray)
+	return TRUE;
+    }
+return FALSE;
+}
+
 boolean objectHasSubObjects(struct asObject *table)
 /* Returns TRUE if object has any object members. */
 {
@@ -1747,6 +1764,302 @@ for (col = obj->columnList; col != NULL; col = col->next)
     }
 }
 
+boolean lmSupported(struct asObject *table)
+/* Returns TRUE if local memory loaders and binary packing can be made for
+ * object, which is so unless it contains other objects. */
+{
+struct asColumn *col;
+for (col = table->columnList; col != NULL; col = col->next)
+    {
+    if (col->obType != NULL)
+	return FALSE;
+    }
+return TRUE;
+}
+
+void lmLoadColumn(struct asColumn *col, int colIx, boolean isSizeLink, FILE *f)
+/* Print statement to load column into local memory.  Strings are
+ * left in row rather than copied. */
+{
+if (col->isSizeLink != isSizeLink)
+    return;
+struct asTypeInfo *lt = col->lowType;
+if (col->isList || col->isArray)
+    {
+    char *lName;
+    if ((lName = lt->listyName) == NULL)
+	errAbort("Sorry, lists of %s not implemented.", lt->name);
+    if (col->fixedSize)
+	fprintf(f, "sql%sArray(row[%d], ret->%s, %d);\n",
+		   lName, colIx, col->name, col->fixedSize);
+    else
+	{
+	fprintf(f, "lmAllocArray(lm, ret->%s, ret->%s);\n", col->name, col->linkedSizeName);
+	fprintf(f, "sql%sArray(row[%d], ret->%s, ret->%s);\n",
+		   lName, colIx, col->name, col->linkedSizeName);
+	}
+    }
+else
+    {
+    switch (lt->type)
+	{
+	case t_string:
+	case t_lstring:
+	    fprintf(f, "ret->%s = row[%d];\n", col->name, colIx);
+	    break;
+	case t_char:
+	    if (col->fixedSize > 0)
+		fprintf(f, "safecpy(ret->%s, sizeof(ret->%s), row[%d]);\n", col->name, col->name, colIx);
+	    else
+		fprintf(f, "ret->%s = row[%d][0];\n", col->name, colIx);
+	    break;
+	case t_enum:
+	case t_set:
+	    fprintf(f, "ret->%s = sql%sParse(row[%d], values_%s, &valhash_%s);\n", col->name,
+		    lt->nummyName, colIx, col->name, col->name);
+	    break;
+	default:
+	    fprintf(f, "ret->%s = sql%s(row[%d]);\n", col->name, lt->nummyName, colIx);
+	    break;
+	}
+    }
+}
+
+void makeLoadLm(struct asObject *table, FILE *f, FILE *hFile)
+/* Create C code to load an instance from a row into local memory. */
+{
+int i;
+char *tableName = table->name;
+struct asColumn *col;
+int tfIx;
+
+fprintf(hFile, "struct %s *%sLoadLm(char **row, struct lm *lm);\n", tableName, tableName);
+fprintf(hFile, "/* Load a %s from row into local memory lm.  Strings point into row\n", tableName);
+fprintf(hFile, " * rather than being copied, so row must last as long as the %s.\n", tableName);
+fprintf(hFile, " * Dispose of this with lmCleanup(), not %sFree(). */\n\n", tableName);
+
+fprintf(f, "struct %s *%sLoadLm(char **row, struct lm *lm)\n", tableName, tableName);
+fprintf(f, "/* Load a %s from row into local memory lm.  Strings point into row\n", tableName);
+fprintf(f, " * rather than being copied, so row must last as long as the %s.\n", tableName);
+fprintf(f, " * Dispose of this with lmCleanup(), not %sFree(). */\n", tableName);
+fprintf(f, "{\n");
+fprintf(f, "struct %s *ret;\n", tableName);
+fprintf(f, "\n");
+fprintf(f, "lmAllocVar(lm, ret);\n");
+for (tfIx = 0; tfIx < 2; ++tfIx)
+    {
+    for (i=0,col = table->columnList; col != NULL; col = col->next, ++i)
+	lmLoadColumn(col, i, trueFalse[tfIx], f);
+    }
+fprintf(f, "return ret;\n");
+fprintf(f, "}\n\n");
+}
+
+void makeLoadAllLm(struct asObject *table, FILE *f, FILE *hFile)
+/* Create C code to load all objects from a tab separated file into local memory. */
+{
+char *tableName = table->name;
+int colCount = slCount(table->columnList);
+
+fprintf(hFile, "struct %s *%sLoadAllLm(char *fileName, struct lm *lm);\n", tableName, tableName);
+fprintf(hFile, "/* Load all %s from tab-separated file into local memory lm.\n", tableName);
+fprintf(hFile, " * Each line is copied to lm once and its fields used in place.\n");
+fprintf(hFile, " * Dispose of this with lmCleanup(). */\n\n");
+
+fprintf(f, "struct %s *%sLoadAllLm(char *fileName, struct lm *lm)\n", tableName, tableName);
+fprintf(f, "/* Load all %s from tab-separated file into local memory lm.\n", tableName);
+fprintf(f, " * Each line is copied to lm once and its fields used in place.\n");
+fprintf(f, " * Dispose of this with lmCleanup(). */\n");
+fprintf(f, "{\n");
+fprintf(f, "struct %s *list = NULL, *el;\n", tableName);
+fprintf(f, "struct lineFile *lf = lineFileOpen(fileName, TRUE);\n");
+fprintf(f, "char *line, *row[%d];\n", colCount + 1);
+fprintf(f, "\n");
+fprintf(f, "while (lineFileNextReal(lf, &line))\n");
+fprintf(f, "    {\n");
+fprintf(f, "    int wordCount = chopTabs(lmCloneString(lm, line), row);\n");
+fprintf(f, "    lineFileExpectWords(lf, %d, wordCount);\n", colCount);
+fprintf(f, "    el = %sLoadLm(row, lm);\n", tableName);
+fprintf(f, "    slAddHead(&list, el);\n");
+fprintf(f, "    }\n");
+fprintf(f, "lineFileClose(&lf);\n");
+fprintf(f, "slReverse(&list);\n");
+fprintf(f, "return list;\n");
+fprintf(f, "}\n\n");
+}
+
+void packValue(struct asColumn *col, char *indent, char *val, FILE *f)
+/* Print statement to append binary form of a single value of column's
+ * type to dy. */
+{
+switch (col->lowType->type)
+    {
+    case t_double:
+    case t_float:
+	fprintf(f, "%sbinPackOne(dy, %s);\n", indent, val);
+	break;
+    case t_char:
+	fprintf(f, "%sdyStringAppendC(dy, %s);\n", indent, val);
+	break;
+    case t_int:
+    case t_short:
+    case t_byte:
+    case t_off:
+	fprintf(f, "%sbinPackSigned(dy, %s);\n", indent, val);
+	break;
+    case t_uint:
+    case t_ushort:
+    case t_ubyte:
+    case t_enum:
+    case t_set:
+	fprintf(f, "%sbinPackUnsigned(dy, %s);\n", indent, val);
+	break;
+    case t_string:
+    case t_lstring:
+	fprintf(f, "%sbinPackString(dy, %s);\n", indent, val);
+	break;
+    default:
+	errAbort("Sorry, can't pack %s.", col->lowType->name);
+	break;
+    }
+}
+
+void unpackValue(struct asColumn *col, char *indent, char *val, FILE *f)
+/* Print statement to read binary form of a single value of column's
+ * type from s. */
+{
+switch (col->lowType->type)
+    {
+    case t_double:
+    case t_float:
+	fprintf(f, "%sbinUnpackOne(&s, %s);\n", indent, val);
+	break;
+    case t_char:
+	fprintf(f, "%s%s = *s++;\n", indent, val);
+	break;
+    case t_int:
+    case t_short:
+    case t_byte:
+    case t_off:
+	fprintf(f, "%s%s = binUnpackSigned(&s);\n", indent, val);
+	break;
+    case t_uint:
+    case t_ushort:
+    case t_ubyte:
+    case t_enum:
+    case t_set:
+	fprintf(f, "%s%s = binUnpackUnsigned(&s);\n", indent, val);
+	break;
+    case t_string:
+    case t_lstring:
+	fprintf(f, "%s%s = binUnpackString(&s);\n", indent, val);
+	break;
+    default:
+	errAbort("Sorry, can't unpack %s.", col->lowType->name);
+	break;
+    }
+}
+
+void packColumn(struct asColumn *col, boolean isSizeLink, boolean isUnpack, FILE *f)
+/* Print statements to pack or unpack column. */
+{
+char *el = (isUnpack ? "ret" : "el");
+char val[256];
+if (col->isSizeLink != isSizeLink)
+    return;
+if (col->isList || col->isArray)
+    {
+    if (col->fixedSize)
+	fprintf(f, "for (i=0; i<%d; ++i)\n", col->fixedSize);
+    else
+	{
+	if (isUnpack)
+	    fprintf(f, "lmAllocArray(lm, ret->%s, ret->%s);\n", col->name, col->linkedSizeName);
+	fprintf(f, "for (i=0; i<%s->%s; ++i)\n", el, col->linkedSizeName);
+	}
+    safef(val, sizeof(val), "%s->%s[i]", el, col->name);
+    if (isUnpack)
+	unpackValue(col, "    ", val, f);
+    else
+	packValue(col, "    ", val, f);
+    }
+else if (col->lowType->type == t_char && col->fixedSize > 0)
+    {
+    if (isUnpack)
+	fprintf(f, "memRead(&s, ret->%s, %d);\n", col->name, col->fixedSize);
+    else
+	fprintf(f, "dyStringAppendN(dy, el->%s, %d);\n", col->name, col->fixedSize);
+    }
+else
+    {
+    safef(val, sizeof(val), "%s->%s", el, col->name);
+    if (isUnpack)
+	unpackValue(col, "", val, f);
+    else
+	packValue(col, "", val, f);
+    }
+}
+
+void makePack(struct asObject *table, FILE *f, FILE *hFile)
+/* Make function that appends binary form of object to a dyString. */
+{
+char *tableName = table->name;
+struct asColumn *col;
+int tfIx;
+
+fprintf(hFile, "void %sPack(struct %s *el, struct dyString *dy);\n", tableName, tableName);
+fprintf(hFile, "/* Append compact binary form of %s to dy.  Read it back with %sUnpack(). */\n\n",
+	tableName, tableName);
+
+fprintf(f, "void %sPack(struct %s *el, struct dyString *dy)\n", tableName, tableName);
+fprintf(f, "/* Append compact binary form of %s to dy.  Read it back with %sUnpack(). */\n",
+	tableName, tableName);
+fprintf(f, "{\n");
+if (objectHasLists(table))
+    fprintf(f, "int i;\n");
+for (tfIx = 0; tfIx < 2; ++tfIx)
+    {
+    for (col = table->columnList; col != NULL; col = col->next)
+	packColumn(col, trueFalse[tfIx], FALSE, f);
+    }
+fprintf(f, "}\n\n");
+}
+
+void makeUnpack(struct asObject *table, FILE *f, FILE *hFile)
+/* Make function that reads object from binary form into local memory. */
+{
+char *tableName = table->name;
+struct asColumn *col;
+int tfIx;
+
+fprintf(hFile, "struct %s *%sUnpack(char **pS, struct lm *lm);\n", tableName, tableName);
+fprintf(hFile, "/* Read a %s written by %sPack() from *pS into local memory lm, and\n",
+	tableName, tableName);
+fprintf(hFile, " * advance *pS past it.  Strings point into the *pS buffer rather than being\n");
+fprintf(hFile, " * copied.  Dispose of this with lmCleanup(), not %sFree(). */\n\n", tableName);
+
+fprintf(f, "struct %s *%sUnpack(char **pS, struct lm *lm)\n", tableName, tableName);
+fprintf(f, "/* Read a %s written by %sPack() from *pS into local memory lm, and\n",
+	tableName, tableName);
+fprintf(f, " * advance *pS past it.  Strings point into the *pS buffer rather than being\n");
+fprintf(f, " * copied.  Dispose of this with lmCleanup(), not %sFree(). */\n", tableName);
+fprintf(f, "{\n");
+fprintf(f, "char *s = *pS;\n");
+fprintf(f, "struct %s *ret;\n", tableName);
+if (objectHasLists(table))
+    fprintf(f, "int i;\n");
+fprintf(f, "\n");
+fprintf(f, "lmAllocVar(lm, ret);\n");
+for (tfIx = 0; tfIx < 2; ++tfIx)
+    {
+    for (col = table->columnList; col != NULL; col = col->next)
+	packColumn(col, trueFalse[tfIx], TRUE, f);
+    }
+fprintf(f, "*pS = s;\n");
+fprintf(f, "return ret;\n");
+fprintf(f, "}\n\n");
+}
+
 void genObjectCode(struct asObject *obj, boolean doDbLoadAndSave,
                    FILE *cFile, FILE *hFile, FILE *sqlFile, FILE *djangoFile)
 /* output code for one object */
@@ -1787,6 +2100,19 @@ else
 makeOutput(obj, cFile, hFile);
 if (makeJson)
     makeJsonOutput(obj, cFile, hFile);
+if (makeLm)
+    {
+    if (lmSupported(obj))
+	{
+	makeLoadLm(obj, cFile, hFile);
+	makeLoadAllLm(obj, cFile, hFile);
+	makePack(obj, cFile, hFile);
+	makeUnpack(obj, cFile, hFile);
+	}
+    else
+	verbose(1, "No local memory or Pack/Unpack routines for %s, which contains objects\n",
+		obj->name);
+    }
 verbose(2, "Made %s object\n", obj->name);
 }
 
@@ -1834,9 +2160,12 @@ withNull = optionExists("withNull");
 defaultZeros = optionExists("defaultZeros");
 makeJson = optionExists("json");
 makeDjango = optionExists("django");
+makeLm = optionExists("lm");
 
 if (argc != 3)
     usage();
+if (makeLm && withNull)
+    errAbort("-lm and -withNull can't be used together");
 
 objList = asParseFile(argv[1]);
 if (addBin)
@@ -1893,6 +2222,11 @@ if(doDbLoadAndSave)
     {
     fprintf(hFile, "#include \"jksql.h\"\n");
     }
+if (makeLm)
+    {
+    fprintf(hFile, "#include \"localmem.h\"\n");
+    fprintf(hFile, "#include \"dystring.h\"\n");
+    }
 
 /* Put the usual includes in .c file, and also include .h file we are
  * generating. */
@@ -1900,6 +2234,11 @@ fprintf(cFile, "#include \"common.h\"\n");
 fprintf(cFile, "#include \"linefile.h\"\n");
 fprintf(cFile, "#include \"dystring.h\"\n");
 fprintf(cFile, "#include \"jksql.h\"\n");
+if (makeLm)
+    {
+    fprintf(cFile, "#include \"localmem.h\"\n");
+    fprintf(cFile, "#include \"binPack.h\"\n");
+    }
 fprintf(cFile, "#include \"%s\"\n", dotH);
 fprintf(cFile, "\n");
 fprintf(cFile, "\n");
@@ -0,0 +1,379 @@
+/* lmTest.c was originally generated by the autoSql program, which also 
+ * generated lmTest.h and lmTest.sql.  This module links the database and
+ * the RAM representation of objects. */
+
+#include "common.h"
+#include "linefile.h"
+#include "dystring.h"
+#include "jksql.h"
+#include "localmem.h"
+#include "binPack.h"
+#include "output/lmTest.h"
+
+
+
+char *lmTestCommaSepFieldNames = "chrom,chromStart,score,strand,frame,shortVal,flags,bigVal,ratio,value,kind,colors,fixedInts,blockCount,blockSizes,blockNames,description";
+
+/* definitions for kind column */
+static char *values_kind[] = {"coding", "noncoding", "pseudo", NULL};
+static struct hash *valhash_kind = NULL;
+
+/* definitions for colors column */
+static char *values_colors[] = {"red", "green", "blue", NULL};
+static struct hash *valhash_colors = NULL;
+
+struct lmTest *lmTestLoad(char **row)
+/* Load a lmTest from row fetched with select * from lmTest
+ * from database.  Dispose of this with lmTestFree(). */
+{
+struct lmTest *ret;
+
+AllocVar(ret);
+ret->blockCount = sqlSigned(row[13]);
+ret->chrom = cloneString(row[0]);
+ret->chromStart = sqlUnsigned(row[1]);
+ret->score = sqlSigned(row[2]);
+safecpy(ret->strand, sizeof(ret->strand), row[3]);
+ret->frame = row[4][0];
+ret->shortVal = sqlSigned(row[5]);
+ret->flags = sqlUnsigned(row[6]);
+ret->bigVal = sqlLongLong(row[7]);
+ret->ratio = sqlFloat(row[8]);
+ret->value = sqlDouble(row[9]);
+ret->kind = sqlEnumParse(row[10], values_kind, &valhash_kind);
+ret->colors = sqlSetParse(row[11], values_colors, &valhash_colors);
+sqlSignedArray(row[12], ret->fixedInts, 3);
+{
+int sizeOne;
+sqlSignedDynamicArray(row[14], &ret->blockSizes, &sizeOne);
+assert(sizeOne == ret->blockCount);
+}
+{
+int sizeOne;
+sqlStringDynamicArray(row[15], &ret->blockNames, &sizeOne);
+assert(sizeOne == ret->blockCount);
+}
+ret->description = cloneString(row[16]);
+return ret;
+}
+
+struct lmTest *lmTestLoadAll(char *fileName) 
+/* Load all lmTest from a whitespace-separated file.
+ * Dispose of this with lmTestFreeList(). */
+{
+struct lmTest *list = NULL, *el;
+struct lineFile *lf = lineFileOpen(fileName, TRUE);
+char *row[17];
+
+while (lineFileRow(lf, row))
+    {
+    el = lmTestLoad(row);
+    slAddHead(&list, el);
+    }
+lineFileClose(&lf);
+slReverse(&list);
+return list;
+}
+
+struct lmTest *lmTestLoadAllByChar(char *fileName, char chopper) 
+/* Load all lmTest from a chopper separated file.
+ * Dispose of this with lmTestFreeList(). */
+{
+struct lmTest *list = NULL, *el;
+struct lineFile *lf = lineFileOpen(fileName, TRUE);
+char *row[17];
+
+while (lineFileNextCharRow(lf, chopper, row, ArraySize(row)))
+    {
+    el = lmTestLoad(row);
+    slAddHead(&list, el);
+    }
+lineFileClose(&lf);
+slReverse(&list);
+return list;
+}
+
+struct lmTest *lmTestCommaIn(char **pS, struct lmTest *ret)
+/* Create a lmTest out of a comma separated string. 
+ * This will fill in ret if non-null, otherwise will
+ * return a new lmTest */
+{
+char *s = *pS;
+
+if (ret == NULL)
+    AllocVar(ret);
+ret->chrom = sqlStringComma(&s);
+ret->chromStart = sqlUnsignedComma(&s);
+ret->score = sqlSignedComma(&s);
+sqlFixedStringComma(&s, ret->strand, sizeof(ret->strand));
+sqlFixedStringComma(&s, &(ret->frame), sizeof(ret->frame));
+ret->shortVal = sqlSignedComma(&s);
+ret->flags = sqlUnsignedComma(&s);
+ret->bigVal = sqlLongLongComma(&s);
+ret->ratio = sqlFloatComma(&s);
+ret->value = sqlDoubleComma(&s);
+ret->kind = sqlEnumComma(&s, values_kind, &valhash_kind);
+ret->colors = sqlSetComma(&s, values_colors, &valhash_colors);
+{
+int i;
+s = sqlEatChar(s, '{');
+for (i=0; i<3; ++i)
+    {
+    ret->fixedInts[i] = sqlSignedComma(&s);
+    }
+s = sqlEatChar(s, '}');
+s = sqlEatChar(s, ',');
+}
+ret->blockCount = sqlSignedComma(&s);
+{
+int i;
+s = sqlEatChar(s, '{');
+AllocArray(ret->blockSizes, ret->blockCount);
+for (i=0; i<ret->blockCount; ++i)
+    {
+    ret->blockSizes[i] = sqlSignedComma(&s);
+    }
+s = sqlEatChar(s, '}');
+s = sqlEatChar(s, ',');
+}
+{
+int i;
+s = sqlEatChar(s, '{');
+AllocArray(ret->blockNames, ret->blockCount);
+for (i=0; i<ret->blockCount; ++i)
+    {
+    ret->blockNames[i] = sqlStringComma(&s);
+    }
+s = sqlEatChar(s, '}');
+s = sqlEatChar(s, ',');
+}
+ret->description = sqlStringComma(&s);
+*pS = s;
+return ret;
+}
+
+void lmTestFree(struct lmTest **pEl)
+/* Free a single dynamically allocated lmTest such as created
+ * with lmTestLoad(). */
+{
+struct lmTest *el;
+
+if ((el = *pEl) == NULL) return;
+freeMem(el->chrom);
+freeMem(el->blockSizes);
+/* All strings in blockNames are allocated at once, so only need to free first. */
+if (el->blockNames != NULL)
+    freeMem(el->blockNames[0]);
+freeMem(el->blockNames);
+freeMem(el->description);
+freez(pEl);
+}
+
+void lmTestFreeList(struct lmTest **pList)
+/* Free a list of dynamically allocated lmTest's */
+{
+struct lmTest *el, *next;
+
+for (el = *pList; el != NULL; el = next)
+    {
+    next = el->next;
+    lmTestFree(&el);
+    }
+*pList = NULL;
+}
+
+void lmTestOutput(struct lmTest *el, FILE *f, char sep, char lastSep) 
+/* Print out lmTest.  Separate fields with sep. Follow last field with lastSep. */
+{
+if (sep == ',') fputc('"',f);
+fprintf(f, "%s", el->chrom);
+if (sep == ',') fputc('"',f);
+fputc(sep,f);
+fprintf(f, "%u", el->chromStart);
+fputc(sep,f);
+fprintf(f, "%d", el->score);
+fputc(sep,f);
+if (sep == ',') fputc('"',f);
+fprintf(f, "%s", el->strand);
+if (sep == ',') fputc('"',f);
+fputc(sep,f);
+if (sep == ',') fputc('"',f);
+fprintf(f, "%c", el->frame);
+if (sep == ',') fputc('"',f);
+fputc(sep,f);
+fprintf(f, "%d", el->shortVal);
+fputc(sep,f);
+fprintf(f, "%u", el->flags);
+fputc(sep,f);
+fprintf(f, "%lld", el->bigVal);
+fputc(sep,f);
+fprintf(f, "%g", el->ratio);
+fputc(sep,f);
+fprintf(f, "%g", el->value);
+fputc(sep,f);
+if (sep == ',') fputc('"',f);
+sqlEnumPrint(f, el->kind, values_kind);
+if (sep == ',') fputc('"',f);
+fputc(sep,f);
+if (sep == ',') fputc('"',f);
+sqlSetPrint(f, el->colors, values_colors);
+if (sep == ',') fputc('"',f);
+fputc(sep,f);
+{
+int i;
+if (sep == ',') fputc('{',f);
+for (i=0; i<3; ++i)
+    {
+    fprintf(f, "%d", el->fixedInts[i]);
+    fputc(',', f);
+    }
+if (sep == ',') fputc('}',f);
+}
+fputc(sep,f);
+fprintf(f, "%d", el->blockCount);
+fputc(sep,f);
+{
+int i;
+if (sep == ',') fputc('{',f);
+for (i=0; i<el->blockCount; ++i)
+    {
+    fprintf(f, "%d", el->blockSizes[i]);
+    fputc(',', f);
+    }
+if (sep == ',') fputc('}',f);
+}
+fputc(sep,f);
+{
+int i;
+if (sep == ',') fputc('{',f);
+for (i=0; i<el->blockCount; ++i)
+    {
+    if (sep == ',') fputc('"',f);
+    fprintf(f, "%s", el->blockNames[i]);
+    if (sep == ',') fputc('"',f);
+    fputc(',', f);
+    }
+if (sep == ',') fputc('}',f);
+}
+fputc(sep,f);
+if (sep == ',') fputc('"',f);
+fprintf(f, "%s", el->description);
+if (sep == ',') fputc('"',f);
+fputc(lastSep,f);
+}
+
+struct lmTest *lmTestLoadLm(char **row, struct lm *lm)
+/* Load a lmTest from row into local memory lm.  Strings point into row
+ * rather than being copied, so row must last as long as the lmTest.
+ * Dispose of this with lmCleanup(), not lmTestFree(). */
+{
+struct lmTest *ret;
+
+lmAllocVar(lm, ret);
+ret->blockCount = sqlSigned(row[13]);
+ret->chrom = row[0];
+ret->chromStart = sqlUnsigned(row[1]);
+ret->score = sqlSigned(row[2]);
+safecpy(ret->strand, sizeof(ret->strand), row[3]);
+ret->frame = row[4][0];
+ret->shortVal = sqlSigned(row[5]);
+ret->flags = sqlUnsigned(row[6]);
+ret->bigVal = sqlLongLong(row[7]);
+ret->ratio = sqlFloat(row[8]);
+ret->value = sqlDouble(row[9]);
+ret->kind = sqlEnumParse(row[10], values_kind, &valhash_kind);
+ret->colors = sqlSetParse(row[11], values_colors, &valhash_colors);
+sqlSignedArray(row[12], ret->fixedInts, 3);
+lmAllocArray(lm, ret->blockSizes, ret->blockCount);
+sqlSignedArray(row[14], ret->blockSizes, ret->blockCount);
+lmAllocArray(lm, ret->blockNames, ret->blockCount);
+sqlStringArray(row[15], ret->blockNames, ret->blockCount);
+ret->description = row[16];
+return ret;
+}
+
+struct lmTest *lmTestLoadAllLm(char *fileName, struct lm *lm)
+/* Load all lmTest from tab-separated file into local memory lm.
+ * Each line is copied to lm once and its fields used in place.
+ * Dispose of this with lmCleanup(). */
+{
+struct lmTest *list = NULL, *el;
+struct lineFile *lf = lineFileOpen(fileName, TRUE);
+char *line, *row[18];
+
+while (lineFileNextReal(lf, &line))
+    {
+    int wordCount = chopTabs(lmCloneString(lm, line), row);
+    lineFileExpectWords(lf, 17, wordCount);
+    el = lmTestLoadLm(row, lm);
+    slAddHead(&list, el);
+    }
+lineFileClose(&lf);
+slReverse(&list);
+return list;
+}
+
+void lmTestPack(struct lmTest *el, struct dyString *dy)
+/* Append compact binary form of lmTest to dy.  Read it back with lmTestUnpack(). */
+{
+int i;
+binPackSigned(dy, el->blockCount);
+binPackString(dy, el->chrom);
+binPackUnsigned(dy, el->chromStart);
+binPackSigned(dy, el->score);
+dyStringAppendN(dy, el->strand, 1);
+dyStringAppendC(dy, el->frame);
+binPackSigned(dy, el->shortVal);
+binPackUnsigned(dy, el->flags);
+binPackSigned(dy, el->bigVal);
+binPackOne(dy, el->ratio);
+binPackOne(dy, el->value);
+binPackUnsigned(dy, el->kind);
+binPackUnsigned(dy, el->colors);
+for (i=0; i<3; ++i)
+    binPackSigned(dy, el->fixedInts[i]);
+for (i=0; i<el->blockCount; ++i)
+    binPackSigned(dy, el->blockSizes[i]);
+for (i=0; i<el->blockCount; ++i)
+    binPackString(dy, el->blockNames[i]);
+binPackString(dy, el->description);
+}
+
+struct lmTest *lmTestUnpack(char **pS, struct lm *lm)
+/* Read a lmTest written by lmTestPack() from *pS into local memory lm, and
+ * advance *pS past it.  Strings point into the *pS buffer rather than being
+ * copied.  Dispose of this with lmCleanup(), not lmTestFree(). */
+{
+char *s = *pS;
+struct lmTest *ret;
+int i;
+
+lmAllocVar(lm, ret);
+ret->blockCount = binUnpackSigned(&s);
+ret->chrom = binUnpackString(&s);
+ret->chromStart = binUnpackUnsigned(&s);
+ret->score = binUnpackSigned(&s);
+memRead(&s, ret->strand, 1);
+ret->frame = *s++;
+ret->shortVal = binUnpackSigned(&s);
+ret->flags = binUnpackUnsigned(&s);
+ret->bigVal = binUnpackSigned(&s);
+binUnpackOne(&s, ret->ratio);
+binUnpackOne(&s, ret->value);
+ret->kind = binUnpackUnsigned(&s);
+ret->colors = binUnpackUnsigned(&s);
+for (i=0; i<3; ++i)
+    ret->fixedInts[i] = binUnpackSigned(&s);
+lmAllocArray(lm, ret->blockSizes, ret->blockCount);
+for (i=0; i<ret->blockCount; ++i)
+    ret->blockSizes[i] = binUnpackSigned(&s);
+lmAllocArray(lm, ret->blockNames, ret->blockCount);
+for (i=0; i<ret->blockCount; ++i)
+    ret->blockNames[i] = binUnpackString(&s);
+ret->description = binUnpackString(&s);
+*pS = s;
+return ret;
+}
+
+/* -------------------------------- End autoSql Generated Code -------------------------------- */
+
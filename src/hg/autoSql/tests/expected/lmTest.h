@@ -0,0 +1,107 @@
+/* lmTest.h was originally generated by the autoSql program, which also 
+ * generated lmTest.c and lmTest.sql.  This header links the database and
+ * the RAM representation of objects. */
+
+#ifndef LMTEST_H
+#define LMTEST_H
+
+#include "localmem.h"
+#include "dystring.h"
+#define LMTEST_NUM_COLS 17
+
+extern char *lmTestCommaSepFieldNames;
+
+enum lmTestKind
+    {
+    lmTestCoding = 0,
+    lmTestNoncoding = 1,
+    lmTestPseudo = 2,
+    };
+enum lmTestColors
+    {
+    lmTestRed = 0x0001,
+    lmTestGreen = 0x0002,
+    lmTestBlue = 0x0004,
+    };
+struct lmTest
+/* test of local memory loading and binary packing */
+    {
+    struct lmTest *next;  /* Next in singly linked list. */
+    char *chrom;	/* Reference sequence chromosome or scaffold */
+    unsigned chromStart;	/* Start position in chromosome */
+    int score;	/* Score, may be negative */
+    char strand[2];	/* + or - for strand */
+    char frame;	/* Single character */
+    short shortVal;	/* A short */
+    unsigned char flags;	/* A small unsigned number */
+    long long bigVal;	/* A big number */
+    float ratio;	/* Single precision number */
+    double value;	/* Double precision number */
+    enum lmTestKind kind;	/* Enumerated column */
+    unsigned colors;	/* Set column */
+    int fixedInts[3];	/* Fixed size array */
+    int blockCount;	/* Number of blocks */
+    int *blockSizes;	/* Variable size array */
+    char **blockNames;	/* Variable size string array */
+    char *description;	/* Long description */
+    };
+
+struct lmTest *lmTestLoad(char **row);
+/* Load a lmTest from row fetched with select * from lmTest
+ * from database.  Dispose of this with lmTestFree(). */
+
+struct lmTest *lmTestLoadAll(char *fileName);
+/* Load all lmTest from whitespace-separated file.
+ * Dispose of this with lmTestFreeList(). */
+
+struct lmTest *lmTestLoadAllByChar(char *fileName, char chopper);
+/* Load all lmTest from chopper separated file.
+ * Dispose of this with lmTestFreeList(). */
+
+#define lmTestLoadAllByTab(a) lmTestLoadAllByChar(a, '\t');
+/* Load all lmTest from tab separated file.
+ * Dispose of this with lmTestFreeList(). */
+
+struct lmTest *lmTestCommaIn(char **pS, struct lmTest *ret);
+/* Create a lmTest out of a comma separated string. 
+ * This will fill in ret if non-null, otherwise will
+ * return a new lmTest */
+
+void lmTestFree(struct lmTest **pEl);
+/* Free a single dynamically allocated lmTest such as created
+ * with lmTestLoad(). */
+
+void lmTestFreeList(struct lmTest **pList);
+/* Free a list of dynamically allocated lmTest's */
+
+void lmTestOutput(struct lmTest *el, FILE *f, char sep, char lastSep);
+/* Print out lmTest.  Separate fields with sep. Follow last field with lastSep. */
+
+#define lmTestTabOut(el,f) lmTestOutput(el,f,'\t','\n');
+/* Print out lmTest as a line in a tab-separated file. */
+
+#define lmTestCommaOut(el,f) lmTestOutput(el,f,',',',');
+/* Print out lmTest as a comma separated list including final comma. */
+
+struct lmTest *lmTestLoadLm(char **row, struct lm *lm);
+/* Load a lmTest from row into local memory lm.  Strings point into row
+ * rather than being copied, so row must last as long as the lmTest.
+ * Dispose of this with lmCleanup(), not lmTestFree(). */
+
+struct lmTest *lmTestLoadAllLm(char *fileName, struct lm *lm);
+/* Load all lmTest from tab-separated file into local memory lm.
+ * Each line is copied to lm once and its fields used in place.
+ * Dispose of this with lmCleanup(). */
+
+void lmTestPack(struct lmTest *el, struct dyString *dy);
+/* Append compact binary form of lmTest to dy.  Read it back with lmTestUnpack(). */
+
+struct lmTest *lmTestUnpack(char **pS, struct lm *lm);
+/* Read a lmTest written by lmTestPack() from *pS into local memory lm, and
+ * advance *pS past it.  Strings point into the *pS buffer rather than being
+ * copied.  Dispose of this with lmCleanup(), not lmTestFree(). */
+
+/* -------------------------------- End autoSql Generated Code -------------------------------- */
+
+#endif /* LMTEST_H */
+
@@ -0,0 +1,27 @@
+# lmTest.sql was originally generated by the autoSql program, which also 
+# generated lmTest.c and lmTest.h.  This creates the database representation of
+# an object which can be loaded and saved from RAM in a fairly 
+# automatic way.
+
+#test of local memory loading and binary packing
+CREATE TABLE lmTest (
+    chrom varchar(255) not null,	# Reference sequence chromosome or scaffold
+    chromStart int unsigned not null,	# Start position in chromosome
+    score int not null,	# Score, may be negative
+    strand char(1) not null,	# + or - for strand
+    frame char(1) not null,	# Single character
+    shortVal smallint not null,	# A short
+    flags tinyint unsigned not null,	# A small unsigned number
+    bigVal bigint not null,	# A big number
+    ratio float not null,	# Single precision number
+    value double not null,	# Double precision number
+    kind enum("coding", "noncoding", "pseudo") not null,	# Enumerated column
+    colors set("red", "green", "blue") not null,	# Set column
+    fixedInts longblob not null,	# Fixed size array
+    blockCount int not null,	# Number of blocks
+    blockSizes longblob not null,	# Variable size array
+    blockNames longblob not null,	# Variable size string array
+    description longblob not null,	# Long description
+              #Indices
+    PRIMARY KEY(chrom)
+);
@@ -0,0 +1,21 @@
+table lmTest
+"test of local memory loading and binary packing"
+    (
+    string chrom;                        "Reference sequence chromosome or scaffold"
+    uint chromStart;                     "Start position in chromosome"
+    int score;                           "Score, may be negative"
+    char[1] strand;                      "+ or - for strand"
+    char frame;                          "Single character"
+    short shortVal;                      "A short"
+    ubyte flags;                         "A small unsigned number"
+    bigint bigVal;                       "A big number"
+    float ratio;                         "Single precision number"
+    double value;                        "Double precision number"
+    enum(coding, noncoding, pseudo) kind;   "Enumerated column"
+    set(red, green, blue) colors;        "Set column"
+    int[3] fixedInts;                    "Fixed size array"
+    int blockCount;                      "Number of blocks"
+    int[blockCount] blockSizes;          "Variable size array"
+    string[blockCount] blockNames;       "Variable size string array"
+    lstring description;                 "Long description"
+    )
@@ -0,0 +1,63 @@
+/* Program to test local memory loading and binary packing in autoSql. */
+#include "common.h"
+#include "linefile.h"
+#include "dystring.h"
+#include "localmem.h"
+#include "output/lmTest.h"
+
+
+void usage()
+{
+errAbort("lmTest - test local memory loading and binary packing in autoSql\n"
+         "usage:\n"
+         "   lmTest in.tab out.tab outPacked.tab\n");
+}
+
+void writeTabFile(struct lmTest *list, char *outFile)
+/* Write out list to tab file. */
+{
+struct lmTest *el;
+FILE *f = mustOpen(outFile, "w");
+for (el = list; el != NULL; el = el->next)
+    lmTestTabOut(el, f);
+carefulClose(&f);
+}
+
+void lmTestTest(char *inFile, char *outFile, char *outPackedFile)
+/* Load inFile into local memory and write it back out, then pack it, unpack
+ * it into separate local memory and write that out too. */
+{
+struct lm *lm = lmInit(0);
+struct lmTest *list = lmTestLoadAllLm(inFile, lm), *el;
+writeTabFile(list, outFile);
+
+struct dyString *dy = dyStringNew(0);
+int count = 0;
+for (el = list; el != NULL; el = el->next)
+    {
+    lmTestPack(el, dy);
+    ++count;
+    }
+lmCleanup(&lm);
+
+struct lm *unpackLm = lmInit(0);
+struct lmTest *unpacked = NULL;
+char *s = dy->string;
+int i;
+for (i=0; i<count; ++i)
+    slAddHead(&unpacked, lmTestUnpack(&s, unpackLm));
+slReverse(&unpacked);
+if (s != dy->string + dy->stringSize)
+    errAbort("Unpacked %d bytes, but packed %ld", (int)(s - dy->string), dy->stringSize);
+writeTabFile(unpacked, outPackedFile);
+lmCleanup(&unpackLm);
+dyStringFree(&dy);
+}
+
+int main(int argc, char *argv[])
+{
+if (argc != 4)
+    usage();
+lmTestTest(argv[1], argv[2], argv[3]);
+return 0;
+}
@@ -14,6 +14,12 @@
 #include "chromInfo.h"
 #include "wiggle.h"
 #include "hdb.h"
+#include "localmem.h"
+#include "portable.h"
+#include "pipeline.h"
+#include "pthreadDoList.h"
+#include "bigWig.h"
+#include "bwgInternal.h"
 
 
 /* define unitSize to be a larger storage class if your counts
@@ -34,6 +40,12 @@ boolean doMax;   /* if overlap count will overflow, just keep max */
 boolean doZero;  /* add blocks with 0 counts */
 boolean doBed12;  /* expect bed12 and process block by block */
 boolean doOutBounds;  /* output min/max to stderr */
+boolean doUnsorted;  /* sort input by chrom first */
+char *tmpDir = NULL;  /* where to sort input */
+char *bigWigOut = NULL;  /* write bigWig here instead of bedGraph to stdout */
+int threads = 1;  /* number of chromosomes to count at once */
+static int blockSize = 256;  /* bigWig index block size */
+static int itemsPerSlot = 1024;  /* bigWig items per section */
 unitSize overMin = ~1;
 unitSize overMax = 0;
 
@@ -47,6 +59,10 @@ static struct optionSpec optionSpecs[] = {
     {"zero", OPTION_BOOLEAN},
     {"bed12", OPTION_BOOLEAN},
     {"outBounds", OPTION_BOOLEAN},
+    {"unsorted", OPTION_BOOLEAN},
+    {"tmpDir", OPTION_STRING},
+    {"bigWig", OPTION_STRING},
+    {"threads", OPTION_INT},
     {NULL, 0}
 };
 
@@ -62,6 +78,8 @@ errAbort(
   " sort -k1,1 bedFile.bed | bedItemOverlapCount [options] <database> stdin \\\n"
   "         > bedFile.bedGraph\n"
   " bedGraphToBigWig bedFile.bedGraph chrom.sizes bedFile.bw\n"
+  "   or directly:\n"
+  " bedItemOverlapCount -chromSize=chrom.sizes -bigWig=bedFile.bw none bedFile.bed\n"
   "   where the chrom.sizes is obtained with the script: fetchChromSizes\n"
   "   See also:\n"
   " http://genome-test.gi.ucsc.edu/~kent/src/unzipped/utils/userApps/fetchChromSizes\n"
@@ -71,6 +89,10 @@ errAbort(
   "              Without this option, only the first three fields are used.\n"
   "   -max       if counts per base overflows set to max (%lu) instead of exiting\n"
   "   -outBounds output min/max to stderr\n"
+  "   -unsorted  input need not be sorted by chrom, it is sorted first\n"
+  "   -tmpDir=dir\tdirectory for sorting with -unsorted, default %s\n"
+  "   -bigWig=out.bw\twrite bigWig to out.bw instead of bedGraph to stdout\n"
+  "   -threads=N\tcount N chromosomes at once, default 1\n"
   "   -chromSize=sizefile\tRead chrom sizes from file instead of database\n"
   "             sizefile contains two white space separated fields per line:\n"
   "		chrom name and size\n"
@@ -83,21 +105,21 @@ errAbort(
   "   the chrom, start and end columns of the bed file.\n"
   " * Program requires a <database> connection to lookup chrom sizes for a sanity\n"
   "   check of the incoming data.  Even when the -chromSize argument is used\n"
-  "   the <database> must be present, but it will not be used.\n\n"
-  " * The bed file *must* be sorted by chrom\n"
-  " * Maximum count per base is %lu. Recompile with new unitSize to increase this",(unsigned long)MAXCOUNT, (unsigned long)MAXCOUNT
+  "   the <database> must be present, but it will not be used.  Use 'none' for\n"
+  "   <database> to skip the check, which -zero, -outBounds and -bigWig need.\n\n"
+  " * The bed file *must* be sorted by chrom unless -unsorted is used\n"
+  " * Maximum count per base is %lu. Recompile with new unitSize to increase this",(unsigned long)MAXCOUNT, getTempDir(), (unsigned long)MAXCOUNT
   );
 }
 
-static struct hash *loadAllChromInfo(char *database, unsigned *largest)
-/* Load up all chromosome infos, return largest one if asked to do so. */
+static struct hash *loadAllChromInfo(char *database)
+/* Load up all chromosome sizes into a hash with int values. */
 {
 struct chromInfo *el;
 struct sqlConnection *conn = NULL;
 struct sqlResult *sr = NULL;
 struct hash *ret;
 char **row;
-unsigned max = 0;
 
 if(host)
     {
@@ -116,69 +138,323 @@ sr = sqlGetResult(conn, query);
 while ((row = sqlNextRow(sr)) != NULL)
     {
     el = chromInfoLoad(row);
-    if (el->size > max) max = el->size;
-    verbose(4, "Add hash %s value %u (%#lx)\n", el->chrom, el->size, (unsigned long)&el->size);
-    hashAdd(ret, el->chrom, (void *)(& el->size));
+    verbose(4, "Add hash %s value %u\n", el->chrom, el->size);
+    hashAddInt(ret, el->chrom, el->size);
+    chromInfoFree(&el);
     }
 sqlFreeResult(&sr);
 sqlDisconnect(&conn);
-if (largest) *largest = max;
 return ret;
 }
 
 static unsigned chromosomeSize(char *chromosome)
-/* Return full extents of chromosome.  Warn and fill in if none. */
+/* Return full extents of chromosome, or 0 if chromosome sizes were not loaded. */
 {
+if (chromHash == NULL)
+    return 0;
 struct hashEl *el = hashLookup(chromHash,chromosome);
 
 if (el == NULL)
     errAbort("Couldn't find size of chromosome %s", chromosome);
-return *(unsigned *)el->val;
+return ptToInt(el->val);
 }
 
-static void outputCounts(unitSize *counts, char *chrom, unsigned size)
+struct chromCounts
+/* Items on one chromosome, and the runs of counts they sweep out to. */
+    {
+    struct chromCounts *next;
+    char *chrom;		/* Chromosome name. */
+    unsigned size;		/* Chromosome size, 0 if not known. */
+    bits32 *starts, *ends;	/* Starts and ends of ranges covered by items. */
+    size_t rangeCount;		/* Number of starts and ends. */
+    size_t rangeAlloc;		/* Allocated size of starts and ends. */
+    boolean haveRun;		/* TRUE if there is a run not yet output. */
+    unsigned runStart, runEnd;	/* Run of bases with same count not yet output. */
+    unitSize runCount;		/* Count in run. */
+    unitSize min, max;		/* Smallest and biggest counts in chromosome. */
+    struct dyString *text;	/* bedGraph output. */
+    struct lm *lm;		/* Memory for bigWig output. */
+    struct bwgBedGraphItem *itemList;	/* bigWig output, in reverse order. */
+    };
+
+static struct chromCounts *chromCountsNew(char *chrom)
+/* Return new, empty, counts for chrom. */
 {
-if (size == 0)
-    errAbort("got 0 for size of chrom %s\n", chrom);
+struct chromCounts *cc;
+AllocVar(cc);
+cc->chrom = cloneString(chrom);
+cc->size = chromosomeSize(chrom);
+cc->min = MAXCOUNT;
+if (bigWigOut != NULL)
+    cc->lm = lmInit(0);
+else
+    cc->text = dyStringNew(0);
+return cc;
+}
 
-if (doOutBounds)
+static void chromCountsFree(struct chromCounts **pCc)
+/* Free up counts, but not the memory bigWig output is in. */
+{
+struct chromCounts *cc = *pCc;
+if (cc != NULL)
     {
-    if (counts[0] < overMin)
-	overMin = counts[0];
-    if (counts[0] > overMax)
-	overMax = counts[0];
+    freeMem(cc->chrom);
+    freeMem(cc->starts);
+    freeMem(cc->ends);
+    dyStringFree(&cc->text);
+    freez(pCc);
     }
+}
 
-int ii;
-int prevValue = counts[0];
-int startPoint = 0;
-for(ii=1; ii < size; ii++)
+static void addRange(struct chromCounts *cc, unsigned start, unsigned end)
+/* Add a range whose bases are each counted once. */
+{
+if (start >= end)
+    return;
+if (cc->rangeCount >= cc->rangeAlloc)
     {
-    if (doOutBounds)
+    size_t newAlloc = (cc->rangeAlloc == 0 ? 1024 : 2 * cc->rangeAlloc);
+    cc->starts = needHugeMemResize(cc->starts, newAlloc * sizeof(cc->starts[0]));
+    cc->ends = needHugeMemResize(cc->ends, newAlloc * sizeof(cc->ends[0]));
+    cc->rangeAlloc = newAlloc;
+    }
+cc->starts[cc->rangeCount] = start;
+cc->ends[cc->rangeCount] = end;
+++cc->rangeCount;
+}
+
+static void addBed(struct chromCounts *cc, struct bed *bed)
+/* Add ranges covered by bed, checking that it is on the chromosome. */
+{
+unsigned chromSize = cc->size;
+if (chromSize != 0 && bed->chromEnd > chromSize)
+    {
+    // check for circular chrM
+    if (doBed12 || bed->chromStart>=chromSize
+	|| !isMito(bed->chrom))
 	{
-	if (counts[ii] < overMin)
-	    overMin = counts[ii];
-	if (counts[ii] > overMax)
-	    overMax = counts[ii];
+	warn("ERROR: %s\t%d\t%d", bed->chrom, bed->chromStart,
+	bed->chromEnd);
+	errAbort("chromEnd > chromSize ?  %d > %d",
+	    bed->chromEnd,chromSize);
 	}
-    if (counts[ii] != prevValue)
+    addRange(cc, bed->chromStart, chromSize);
+    addRange(cc, 0, bed->chromEnd - chromSize);
+    }
+else if (doBed12)
+    {
+    int i;
+    for (i = 0; i < bed->blockCount; ++i)
 	{
-	if (doZero || (prevValue != 0))
-	    printf("%s\t%u\t%u\t%u\n", chrom, startPoint, ii, prevValue);
-	startPoint = ii;
-	prevValue = counts[ii];
+	unsigned start = bed->chromStart + bed->chromStarts[i];
+	addRange(cc, start, start + bed->blockSizes[i]);
 	}
     }
+else
+    addRange(cc, bed->chromStart, bed->chromEnd);
+}
+
+static int bits32Cmp(const void *va, const void *vb)
+/* Compare two bits32s. */
+{
+bits32 a = *((bits32 *)va), b = *((bits32 *)vb);
+if (a < b)
+    return -1;
+return (a > b);
+}
 
-if (doZero || (prevValue != 0))
-    printf("%s\t%u\t%u\t%u\n", chrom, startPoint, ii, prevValue);
+static void sortPositions(bits32 *pos, size_t count)
+/* Sort positions, which are often in order already. */
+{
+size_t i;
+for (i = 1; i < count; ++i)
+    if (pos[i] < pos[i-1])
+	{
+	qsort(pos, count, sizeof(pos[0]), bits32Cmp);
+	break;
+	}
+}
+
+static void outputRun(struct chromCounts *cc)
+/* Output run of bases with the same count, unless it is zero and zeros aren't wanted. */
+{
+unitSize count = cc->runCount;
+if (count < cc->min)
+    cc->min = count;
+if (count > cc->max)
+    cc->max = count;
+if (count == 0 && !doZero)
+    return;
+if (bigWigOut != NULL)
+    {
+    struct bwgBedGraphItem *item;
+    lmAllocVar(cc->lm, item);
+    item->start = cc->runStart;
+    item->end = cc->runEnd;
+    item->val = count;
+    slAddHead(&cc->itemList, item);
+    }
+else
+    dyStringPrintf(cc->text, "%s\t%u\t%u\t%u\n", cc->chrom, cc->runStart, cc->runEnd, count);
+}
+
+static void addRun(struct chromCounts *cc, unsigned start, unsigned end, long long count)
+/* Add bases from start to end, all with the same count.  Runs are merged with the one before
+ * if they have the same count, which they can after clipping to MAXCOUNT. */
+{
+if (count > MAXCOUNT)
+    {
+    if (!doMax)
+	errAbort(MAXMESSAGE,(unsigned long)MAXCOUNT);
+    count = MAXCOUNT;
+    }
+if (cc->haveRun && cc->runCount == count)
+    cc->runEnd = end;
+else
+    {
+    if (cc->haveRun)
+	outputRun(cc);
+    cc->haveRun = TRUE;
+    cc->runStart = start;
+    cc->runEnd = end;
+    cc->runCount = count;
+    }
+}
+
+static void sweepChrom(void *item, void *context)
+/* Sort starts and ends of ranges on chromosome and sweep through them, so that the
+ * work is proportional to the number of items rather than of bases.  Called by
+ * pthreadDoList. */
+{
+struct chromCounts *cc = item;
+size_t count = cc->rangeCount;
+bits32 *starts = cc->starts, *ends = cc->ends;
+sortPositions(starts, count);
+sortPositions(ends, count);
+long long depth = 0;
+unsigned runStart = 0;
+size_t s = 0, e = 0;
+while (e < count)
+    {
+    unsigned pos = ends[e];
+    if (s < count && starts[s] < pos)
+	pos = starts[s];
+    long long change = 0;
+    for (; s < count && starts[s] == pos; ++s)
+	++change;
+    for (; e < count && ends[e] == pos; ++e)
+	--change;
+    if (change != 0)
+	{
+	if (pos > runStart)
+	    addRun(cc, runStart, pos, depth);
+	depth += change;
+	runStart = pos;
+	}
+    }
+if (cc->size > runStart)
+    addRun(cc, runStart, cc->size, 0);
+if (cc->haveRun)
+    outputRun(cc);
+freez(&cc->starts);
+freez(&cc->ends);
+cc->rangeCount = cc->rangeAlloc = 0;
+}
+
+static struct bwgSection *chromSections(struct chromCounts *cc)
+/* Return list of bigWig sections for chromosome. */
+{
+struct bwgSection *sectionList = NULL;
+struct bwgBedGraphItem *item, *nextItem;
+slReverse(&cc->itemList);
+for (nextItem = cc->itemList; (item = nextItem) != NULL; )
+    {
+    struct bwgSection *section;
+    lmAllocVar(cc->lm, section);
+    section->chrom = lmCloneString(cc->lm, cc->chrom);
+    section->start = item->start;
+    section->type = bwgTypeBedGraph;
+    section->items.bedGraphList = item;
+    int sectionSize = 1;
+    while (sectionSize < itemsPerSlot && item->next != NULL)
+	{
+	item = item->next;
+	++sectionSize;
+	}
+    nextItem = item->next;
+    item->next = NULL;
+    section->end = item->end;
+    section->itemCount = sectionSize;
+    slAddHead(&sectionList, section);
+    }
+slReverse(&sectionList);
+cc->itemList = NULL;
+return sectionList;
+}
+
+static void countBatch(struct chromCounts **pBatch, struct bwgSection **pSectionList,
+	struct slRef **pLmList)
+/* Sweep chromosomes in batch in parallel, then output them in order and free batch. */
+{
+struct chromCounts *cc, *batch = *pBatch;
+slReverse(&batch);
+pthreadDoList(threads, batch, sweepChrom, NULL);
+for (cc = batch; cc != NULL; cc = cc->next)
+    {
+    verbose(2,"#\tchrom %s done, size %d\n", cc->chrom, cc->size);
+    if (cc->min < overMin)
+	overMin = cc->min;
+    if (cc->max > overMax)
+	overMax = cc->max;
+    if (bigWigOut != NULL)
+	{
+	*pSectionList = slCat(chromSections(cc), *pSectionList);
+	refAdd(pLmList, cc->lm);
+	}
+    else
+	fputs(cc->text->string, stdout);
+    }
+while ((cc = batch) != NULL)
+    {
+    batch = cc->next;
+    chromCountsFree(&cc);
+    }
+*pBatch = NULL;
+}
+
+static char *sortInput(int fileCount, char *fileList[], int numFields)
+/* Sort the fields we use from all input files by chromosome into a temporary file,
+ * and return its name. */
+{
+char *sortedName = cloneString(rTempName(tmpDir, "bedItemOverlapCount", ".bed"));
+char *cmd[] = {"env", "LC_ALL=C", "sort", "-k1,1", "-S", "1G", "-T", tmpDir, NULL};
+struct pipeline *pl = pipelineOpen1(cmd, pipelineWrite, sortedName, NULL, 0);
+FILE *f = pipelineFile(pl);
+int i;
+for (i=0; i<fileCount; ++i)
+    {
+    struct lineFile *lf = lineFileOpen(fileList[i], TRUE);
+    char *row[12];
+    while (lineFileNextRow(lf, row, numFields))
+	{
+	int j;
+	for (j = 0; j < numFields; ++j)
+	    {
+	    if (j > 0)
+		fputc('\t', f);
+	    fputs(row[j], f);
+	    }
+	fputc('\n', f);
+	}
+    lineFileClose(&lf);
+    }
+pipelineClose(&pl);
+return sortedName;
 }
 
 static void bedItemOverlapCount(char *database, int fileCount, char *fileList[])
 {
-unsigned maxChromSize = 0;
 int i;
-unitSize *counts = (unitSize *)NULL;
 
 if (chromSizes != NULL)
     {
@@ -186,33 +462,29 @@ if (chromSizes != NULL)
     struct lineFile *lf = lineFileOpen(chromSizes, TRUE);
     char *row[2];
     while (lineFileRow(lf, row))
-        {
-        unsigned *ptr;
-        AllocVar(ptr);
-        *ptr = sqlUnsigned(row[1]);
-        maxChromSize = max(*ptr, maxChromSize);
-        hashAdd(chromHash, row[0], ptr);
-        }
+        hashAddInt(chromHash, row[0], sqlUnsigned(row[1]));
     lineFileClose(&lf);
     }
-else
+else if (differentString(database, "none"))
     {
-    chromHash = loadAllChromInfo(database, &maxChromSize);
+    chromHash = loadAllChromInfo(database);
     }
+if (chromHash == NULL && (doZero || doOutBounds || bigWigOut != NULL))
+    errAbort("-zero, -outBounds and -bigWig need chromosome sizes from a database or -chromSize");
 
-verbose(2,"#\tmaxChromSize: %u\n", maxChromSize);
-if (maxChromSize < 1)
-    errAbort("maxChromSize is zero ?");
-
-/*	Allocate just once for the largest chrom and reuse this array */
-counts = needHugeMem(sizeof(unitSize) * maxChromSize);
-
-/*	Reset the array to be zero to be reused */
-memset((void *)counts, 0, sizeof(unitSize)*(size_t)maxChromSize);
+int numFields = doBed12 ? 12 : 3;
+char *sortedName = NULL;
+if (doUnsorted)
+    {
+    sortedName = sortInput(fileCount, fileList, numFields);
+    fileCount = 1;
+    fileList = &sortedName;
+    }
 
-unsigned chromSize = 0;
-char *prevChrom = (char *)NULL;
-boolean outputToDo = FALSE;
+struct chromCounts *cc = NULL, *batch = NULL;
+int doneCount = 0;
+struct bwgSection *sectionList = NULL;
+struct slRef *lmList = NULL;	/* Memory that bigWig sections are in. */
 struct hash *seenHash = newHash(5);
 
 for (i=0; i<fileCount; ++i)
@@ -220,90 +492,62 @@ for (i=0; i<fileCount; ++i)
     struct lineFile *bf = lineFileOpen(fileList[i] , TRUE);
     struct bed *bed = (struct bed *)NULL;
     char *row[12];
-    int numFields = doBed12 ? 12 : 3;
 
     while (lineFileNextRow(bf,row, numFields))
 	{
-	int i;
 	bed = bedLoadN(row, numFields);
 
 	verbose(3,"#\t%s\t%d\t%d\n",bed->chrom,bed->chromStart, bed->chromEnd);
 
-	if (prevChrom && differentWord(bed->chrom,prevChrom)) // End a chr
-	    {
-	    verbose(2,"#\tchrom %s done, size %d\n", prevChrom, chromSize);
-	    if (outputToDo)
-		outputCounts(counts, prevChrom, chromSize);
-	    outputToDo = FALSE;
-	    memset((void *)counts, 0,
-		sizeof(unitSize)*(size_t)maxChromSize); /* zero counts */
-	    freez(&prevChrom); 
-	    // prevChrom is now NULL so it will be caught by next if!
-	    }
-	if ((char *)NULL == prevChrom)  // begin a chr
+	if (cc == NULL || differentWord(bed->chrom, cc->chrom))  // begin a chr
 	    {
 	    if (hashLookup(seenHash, bed->chrom))
-		errAbort("ERROR:input file not sorted. %s seen before on line %d\n",
+		errAbort("ERROR:input file not sorted. %s seen before on line %d\n"
+		    "Use -unsorted to sort it.",
 		    bed->chrom, bf->lineIx);
-
 	    hashAdd(seenHash, bed->chrom, NULL);
-	    prevChrom = cloneString(bed->chrom);
-	    chromSize = chromosomeSize(prevChrom);
-	    verbose(2,"#\tchrom %s starting, size %d\n", prevChrom,chromSize);
-	    }
-	if (bed->chromEnd > chromSize)
-	    {
-	    // check for circular chrM
-	    if (doBed12 || bed->chromStart>=chromSize 
-		|| !isMito(bed->chrom))
-		{
-		warn("ERROR: %s\t%d\t%d", bed->chrom, bed->chromStart,
-		bed->chromEnd);
-		errAbort("chromEnd > chromSize ?  %d > %d", 
-		    bed->chromEnd,chromSize);
-		}
-
-	    for (i = bed->chromStart; i < chromSize; ++i)
-		INCWOVERFLOW(counts,i);
-	    for (i = 0; i < (bed->chromEnd - chromSize); ++i)
-		INCWOVERFLOW(counts,i);
-	    }
-	else if (doBed12)
-	    {
-	    int *starts = bed->chromStarts;
-	    int *sizes = bed->blockSizes;
-	    int *endStarts = &bed->chromStarts[bed->blockCount];
-
-	    for(; starts < endStarts; starts++, sizes++)
+	    // Sweep chromosomes a batch at a time, once the last one is complete.
+	    if (cc != NULL && ++doneCount >= threads)
 		{
-		unsigned int end = *starts + *sizes + bed->chromStart;
-		for (i = *starts + bed->chromStart; i < end; ++i)
-		    INCWOVERFLOW(counts,i);
+		countBatch(&batch, &sectionList, &lmList);
+		doneCount = 0;
 		}
+	    cc = chromCountsNew(bed->chrom);
+	    slAddHead(&batch, cc);
+	    verbose(2,"#\tchrom %s starting, size %d\n", cc->chrom, cc->size);
 	    }
-	else
-	    {
-	    for (i = bed->chromStart; i < bed->chromEnd; ++i)
-		INCWOVERFLOW(counts, i);
-	    }
-	outputToDo = TRUE;
+	addBed(cc, bed);
 	bedFree(&bed); // plug the memory leak
 	}
 
     lineFileClose(&bf);
     // Note, next file could be on same chr!
     }
-
-if (outputToDo)
-    outputCounts(counts, prevChrom, chromSize);
+countBatch(&batch, &sectionList, &lmList);
 
 if (doOutBounds)
     fprintf(stderr, "min %lu max %lu\n", (unsigned long)overMin, (unsigned long)overMax);
 
-verbose(2,"#\tchrom %s done, size %d\n", prevChrom, chromSize);
-freeMem(counts);
-freez(&prevChrom);
-// hashFreeWithVals(&chromHash, freez);
+if (bigWigOut != NULL)
+    {
+    if (sectionList == NULL)
+	errAbort("No items in input, can't make %s", bigWigOut);
+    slSort(&sectionList, bwgSectionCmp);
+    bwgCreate(sectionList, chromHash, blockSize, itemsPerSlot, TRUE, FALSE, FALSE, FALSE,
+	bigWigOut);
+    }
+struct slRef *ref;
+for (ref = lmList; ref != NULL; ref = ref->next)
+    {
+    struct lm *lm = ref->val;
+    lmCleanup(&lm);
+    }
+slFreeList(&lmList);
+if (sortedName != NULL)
+    {
+    remove(sortedName);
+    freez(&sortedName);
+    }
 freeHash(&seenHash);
 }
 
@@ -322,6 +566,12 @@ doMax = optionExists("max");
 doBed12 = optionExists("bed12");
 doZero = optionExists("zero");
 doOutBounds = optionExists("outBounds");
+doUnsorted = optionExists("unsorted");
+tmpDir = optionVal("tmpDir", getTempDir());
+bigWigOut = optionVal("bigWig", NULL);
+threads = optionInt("threads", threads);
+if (threads < 1)
+    errAbort("-threads must be at least 1");
 verbose(2, "#\tworking on database: %s\n", argv[1]);
 bedItemOverlapCount(argv[1], argc-2, argv+2);
 optionFree();
@@ -71,6 +71,8 @@ fi
 #  TEST 1
 oneTest "$TESTPROG hg16 plusStrand.bed.gz" "08998   212"
 oneTest "$TESTPROG hg16 minusStrand.bed.gz" "62695   231"
+oneTest "$TESTPROG -unsorted hg16 plusStrand.bed.gz" "08998   212"
+oneTest "$TESTPROG -threads=2 hg16 minusStrand.bed.gz" "62695   231"
 
 if [ -n "${verbose}" ]; then
     C=`echo $tests | awk '{printf "%4d", $1}'`
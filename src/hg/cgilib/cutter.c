@@ -12,6 +12,9 @@
 #include "dnaseq.h"
 #include "dnautil.h"
 #include "bed.h"
+#include "iupac.h"
+#include "localmem.h"
+#include "oligoScan.h"
 #include "cutter.h"
 
 
@@ -534,242 +537,57 @@ lineFileClose(&lf);
 return enzList;
 }
 
-boolean matchingBase(char enzBase, char seqBase)
-/* An enzyme matching */
-{
-switch (seqBase)
-    {
-    /* Ignore hard-masked and gaps for now. */
-    case 'A': 
-	{
-	switch (enzBase)
-	    {
-	    case 'A': 
-	    case 'R':
-	    case 'M':
-	    case 'W':
-	    case 'H':
-	    case 'V':
-	    case 'D': 
-	    case 'N': return TRUE;
-	    default: return FALSE;
-	    }
-	}
-    case 'C': 
-	{
-	switch (enzBase)
-	    {
-	    case 'C': 
-	    case 'Y':
-	    case 'M':
-	    case 'S':
-	    case 'H':
-	    case 'B':
-	    case 'V': 
-	    case 'N': return TRUE;
-	    default: return FALSE;
-	    }
-	}
-    case 'G':
-	{
-	switch (enzBase)
-	    {
-	    case 'G': 
-	    case 'R':
-	    case 'K':
-	    case 'S':
-	    case 'B':
-	    case 'V':
-	    case 'D': 
-	    case 'N': return TRUE;
-	    default: return FALSE;
-	    }
-	}
-    case 'T':
-	{
-	switch (enzBase)
-	    {
-	    case 'T': 
-	    case 'Y':
-	    case 'K':
-	    case 'W':
-	    case 'H':
-	    case 'B':
-	    case 'D': 
-	    case 'N': return TRUE;
-	    default: return FALSE;
-	    }
-	}
-    }
-return FALSE;
-}
-
-struct bed *allocBedEnz(struct cutter *enz, char *seqName, int seqPos, char strand)
+static struct bed *allocBedEnz(struct cutter *enz, char *seqName, int chromStart, char strand)
+/* Return a bed for a match of enz at chromStart. */
 {
 struct bed *newbed = NULL;
 AllocVar(newbed);
 newbed->chrom = cloneString(seqName);
-newbed->chromStart = (strand == '-') ? seqPos - enz->size : seqPos;
-newbed->chromEnd = (strand == '-') ? seqPos : seqPos + enz->size;
+newbed->chromStart = chromStart;
+newbed->chromEnd = chromStart + enz->size;
 newbed->name = cloneString(enz->name);
 newbed->score = 1000;
 newbed->strand[0] = strand;
 return newbed;
 }
 
-struct bed *searchStrand(struct hash *sixers, struct cutter *ACGTo[], struct dnaSeq *seq, int startOffset, char strand)
-/* Cheesey function that checks a strand for the enzymes after they're put in the hash/array structures.  
-   This used to be a part of the matchEnzymes function but I do it twice now. */
+static boolean allIupac(char *seq)
+/* Return TRUE if seq is non-empty and consists only of IUPAC codes. */
 {
-struct cutter *enz;
-struct bed *bedList = NULL;
-int seqPos;
-
-if (ACGTo[0] || ACGTo[1] || ACGTo[2] || ACGTo[3] || (sixers->elCount > 0)) 
-    {
-    for (seqPos = 0; seqPos < seq->size; seqPos++)
-	{
-	struct cutter *enzList = NULL;
-	char sixer[7];
-	int bedPos = (strand == '-') ? (seq->size - seqPos) : seqPos;
-	if (seq->size - seqPos >= 6)
-	    {
-	    struct hashEl *el = NULL;
-	    sixer[6] = '\0';
-	    memcpy(sixer, seq->dna+seqPos, 6);
-	    el = hashLookup(sixers, sixer);
-	    if (el)
-		{	    
-		struct bed *add;
-		enz = el->val;
-		add = allocBedEnz(enz, seq->name, bedPos + startOffset, strand);
-		slAddHead(&bedList, add);
-		/* Just in case there's another one with the same sequence. */
-		while ((el = hashLookupNext(el)))
-		    {
-		    enz = el->val;
-		    add = allocBedEnz(enz, seq->name, bedPos + startOffset, strand);
-		    slAddHead(&bedList, add);
-		    }
-		}
-	    }
-	/* Use a certain list depending on which letter we're on in the sequence. */
-	if (seq->dna[seqPos] == 'A')
-	    enzList = ACGTo[0];
-	else if (seq->dna[seqPos] == 'C')
-	    enzList = ACGTo[1];
-	else if (seq->dna[seqPos] == 'G')
-	    enzList = ACGTo[2];
-	else if (seq->dna[seqPos] == 'T')
-	    enzList = ACGTo[3];
-	for (enz = enzList; enz != NULL; enz = enz->next)
-	    {
-	    int enzPos = 0;
-	    int seqCurPos = seqPos;	
-	    while (enzPos < enz->size && seqCurPos < seq->size && matchingBase(enz->seq[enzPos],seq->dna[seqCurPos]))
-		{
-		enzPos++; 
-		seqCurPos++;
-		}
-	    if (enzPos == enz->size)
-		{
-		struct bed *add = allocBedEnz(enz, seq->name, bedPos + startOffset, strand);
-		slAddHead(&bedList, add);
-		}
-	    }
-	}
-    }
-return bedList;
+if (isEmpty(seq))
+    return FALSE;
+char c;
+while ((c = *seq++) != 0)
+    if (!isIupac(c))
+        return FALSE;
+return TRUE;
 }
 
 struct bed *matchEnzymes(struct cutter *cutters, struct dnaSeq *seq, int startOffset)
-/* Match the enzymes to sequence and return a bed list in all cases. */
+/* Match the enzymes to sequence and return a bed list in all cases.  All enzymes are
+ * searched for in a single pass over the sequence; non-palindromic ones on both
+ * strands.  Only upper case A, C, G and T in seq can match.  The list is sorted by
+ * position, then strand, then order of enzymes in cutters. */
 {
-struct hash *sixers = newHash(8), *palinSixers = newHash(8);
+struct oligoScanner *scanner;
 struct cutter *enz;
-struct cutter *ACGTo[5], *palinACGTo[5];
-struct bed *bedList = NULL, *tmp;
-int i;
+struct bed *bedList = NULL;
 if (!cutters)
     return NULL;
-for (i = 0; i < 5; i++)
-    ACGTo[i] = palinACGTo[i] = NULL;
-/* Put each of the enzymes in either a hash table of six-cutters or */
-enz = cutters;
-while (enz != NULL)
-    {
-    int acgtCount = 0;
-    struct cutter *next = enz->next;
-    acgtCount = countChars(enz->seq,'A') + countChars(enz->seq,'C') + 
-                countChars(enz->seq,'G') + countChars(enz->seq,'T');
-    /* Super dumb coding here but it's quick. */
-     if (enz->palindromic)
-	{
-	if (enz->size==6 && acgtCount==6)
-	    hashAdd(palinSixers, enz->seq, enz);
-	else
-	    {
-	    if (enz->seq[0] == 'A')
-		slAddHead(&palinACGTo[0], enz);
-	    else if (enz->seq[0] == 'C')
-		slAddHead(&palinACGTo[1], enz);
-	    else if (enz->seq[0] == 'G')
-		slAddHead(&palinACGTo[2], enz);
-	    else if (enz->seq[0] == 'T')
-		slAddHead(&palinACGTo[3], enz);
-	    else 
-		{
-		slAddHead(&palinACGTo[4], enz);
-		}
-	    }
-	}
-    else
-	{
-	if (enz->size==6 && acgtCount==6)
-	    hashAdd(sixers, enz->seq, enz);
-	else
-	    {
-	    if (enz->seq[0] == 'A')
-		slAddHead(&ACGTo[0], enz);
-	    else if (enz->seq[0] == 'C')
-		slAddHead(&ACGTo[1], enz);
-	    else if (enz->seq[0] == 'G')
-		slAddHead(&ACGTo[2], enz);
-	    else if (enz->seq[0] == 'T')
-		slAddHead(&ACGTo[3], enz);
-	    else 
-		slAddHead(&ACGTo[4], enz);
-	    }	
-	}
-    enz = next;
-    }
-/* At this point we got a hash for the palindromes and non-palindromic six-cutters, 
-   plus an array for each too.  The array is set up so the enzymes starting with 'A' go into [0], 'C'
-   into [1], 'G' into [2], 'T' into [3], and other bases into [4].  */
-if (ACGTo[4])
-    {
-    ACGTo[0] = slCat(ACGTo[0], ACGTo[4]);
-    ACGTo[1] = slCat(ACGTo[1], ACGTo[4]);
-    ACGTo[2] = slCat(ACGTo[2], ACGTo[4]);
-    ACGTo[3] = slCat(ACGTo[3], ACGTo[4]);
-    }
-if (palinACGTo[4])
+scanner = oligoScannerNew(FALSE, TRUE);
+for (enz = cutters; enz != NULL; enz = enz->next)
+    if (allIupac(enz->seq))
+        oligoScannerAdd(scanner, enz->seq, !enz->palindromic, enz);
+struct lm *lm = lmInit(0);
+struct oligoHit *hit, *hitList = oligoScanHits(scanner, seq->dna, seq->size, lm);
+for (hit = hitList; hit != NULL; hit = hit->next)
     {
-    palinACGTo[0] = slCat(palinACGTo[0], palinACGTo[4]);
-    palinACGTo[1] = slCat(palinACGTo[1], palinACGTo[4]);
-    palinACGTo[2] = slCat(palinACGTo[2], palinACGTo[4]);
-    palinACGTo[3] = slCat(palinACGTo[3], palinACGTo[4]);
+    struct bed *bed = allocBedEnz(hit->patVal, seq->name, hit->start + startOffset, hit->strand);
+    slAddHead(&bedList, bed);
     }
-/* Search the DNA in three ways: on the plus strand for both palindromes and nonpalindromes, and then
-   just nonpalindromes on the minus strand. */
-bedList = searchStrand(palinSixers, palinACGTo, seq, startOffset, '+');
-tmp = searchStrand(sixers, ACGTo, seq, startOffset, '+');
-bedList = slCat(bedList, tmp);
-reverseComplement(seq->dna, seq->size);
-tmp = searchStrand(sixers, ACGTo, seq, startOffset, '-');
-bedList = slCat(bedList, tmp);
-if (bedList)
-    slReverse(&bedList);
+slReverse(&bedList);
+lmCleanup(&lm);
+oligoScannerFree(&scanner);
 return bedList;
 }
 
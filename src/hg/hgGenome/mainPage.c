@@ -128,12 +128,15 @@ if (gg != NULL)
 	    }
 	}
 
-    /* Draw graphs on each chromosome */
-    chromGraphBinRewind(cgb);
-    while (chromGraphBinNextChrom(cgb))
+    /* Draw graphs on each chromosome, from the zoom level that matches the
+     * resolution for bitmaps. */
+    int zoomLevel = (hvg->pixelBased ?
+	chromGraphBinZoomLevel(cgb, gl->basesPerPixel, maxGapToFill) : -1);
+    struct cgbChrom *cgbChrom;
+    for (cgbChrom = cgb->chromList; cgbChrom != NULL; cgbChrom = cgbChrom->next)
 	{
-	struct genoLayChrom *chrom = hashFindVal(gl->chromHash, cgb->chrom);
-	if (chrom)
+	struct genoLayChrom *chrom = hashFindVal(gl->chromHash, cgbChrom->name);
+	if (chrom && chromGraphBinSeekToChromZoom(cgb, cgbChrom->name, zoomLevel))
 	    {
 	    int chromX = chrom->x, chromY = chrom->y;
 	    int minY = chromY + yOff;
@@ -224,12 +227,6 @@ if (gg != NULL)
 		hvGfxUnclip(hvg);
 		}
 	    }
-	else
-	    {
-	    /* Just read and discard data. */
-	    while (chromGraphBinNextVal(cgb))
-	        ;
-	    }
 	}
 
 
@@ -87,10 +87,10 @@ else if (tg->isBigBed)
     struct lm *lm = lmInit(0);
     struct bbiFile *bbi = fetchBbiForTrack(tg);
     char *quickLiftFile = cloneString(trackDbSetting(tg->tdb, "quickLiftUrl"));
-    struct hash *chainHash = NULL;
+    struct quickLiftChainSet *chainSet = NULL;
     struct bigBedInterval *bb, *bbList = NULL;
     if (quickLiftFile)
-        bbList = quickLiftIntervals(quickLiftFile, bbi, chromName, winStart, winEnd, &chainHash);
+        bbList = quickLiftIntervals(quickLiftFile, bbi, chromName, winStart, winEnd, &chainSet);
     else
         bbList = bigBedSelectRange(tg, chromName, winStart, winEnd, lm);
 
@@ -116,7 +116,7 @@ else if (tg->isBigBed)
             }
         if (quickLiftFile)
             {
-            if ((bed = quickLiftBed(bbi, chainHash, bb)) == NULL)
+            if ((bed = quickLiftBed(bbi, chainSet, bb)) == NULL)
                 continue;
             }
         else
@@ -626,9 +626,9 @@ errCatchFree(&errCatch);
 
 struct bigBedInterval *bb, *bbList; 
 char *quickLiftFile = cloneString(trackDbSetting(track->tdb, "quickLiftUrl"));
-struct hash *chainHash = NULL;
+struct quickLiftChainSet *chainSet = NULL;
 if (quickLiftFile)
-    bbList = quickLiftIntervals(quickLiftFile, bbi, chromName, winStart, winEnd, &chainHash);
+    bbList = quickLiftIntervals(quickLiftFile, bbi, chromName, winStart, winEnd, &chainSet);
 else
     bbList = bigBedSelectRangeExt(track, chrom, start, end, lm, maxItems);
 
@@ -712,7 +712,7 @@ for (bb = bbList; bb != NULL; bb = bb->next)
             {
             if (quickLiftFile)
                 {
-                if ((bed = quickLiftBed(bbi, chainHash, bb)) != NULL)
+                if ((bed = quickLiftBed(bbi, chainSet, bb)) != NULL)
                     {
                     bedCopy = cloneBed(bed);
                     lf = bedMungToLinkedFeatures(&bed, tdb, fieldCount,
@@ -1053,20 +1053,25 @@ return seq;
 }
 #endif /* GBROWSE */
 
+static void parseExtFileSource(char *seqSource, struct dyString *buf, char *words[3])
+/* Split seqSource, which is: extFile seqTbl extFileTbl, into words using buf for storage. */
+{
+dyStringClear(buf);
+dyStringAppend(buf, seqSource);
+int nwords = chopByWhite(buf->string, words, 3);
+if ((nwords != 3) || !sameString(words[0], "extFile"))
+    errAbort("invalid %s track setting: %s", BASE_COLOR_USE_SEQUENCE,
+             seqSource);
+}
+
 static struct dnaSeq *maybeGetExtFileSeq(char *seqSource, char *name)
 /* look up sequence name in seq and extFile tables specified in seqSource */
 {
-/* seqSource is: extFile seqTbl extFileTbl */
 static struct dyString *buf = NULL;
 if (buf == NULL)
     buf = dyStringNew(0);
-dyStringClear(buf);
-dyStringAppend(buf, seqSource);
 char *words[3];
-int nwords = chopByWhite(buf->string, words, ArraySize(words));
-if ((nwords != ArraySize(words)) || !sameString(words[0], "extFile"))
-    errAbort("invalid %s track setting: %s", BASE_COLOR_USE_SEQUENCE,
-             seqSource);
+parseExtFileSource(seqSource, buf, words);
 return hDnaSeqGet(database, name, words[1], words[2]);
 }
 
@@ -1084,6 +1089,184 @@ if (cdsQueryCache == NULL)
 return cacheTwoBitRangesMayFetch(cdsQueryCache, url, seqName, seqStart, seqEnd, doRc, retSeqOffset);
 }
 
+/* Query sequences that come from genbank or seq and extFile tables, keyed by where they
+ * come from and name.  Names that weren't found are kept with NULL values so they aren't
+ * looked up again.  Sequences are only added until there are querySeqCacheMaxBases. */
+static struct hash *querySeqCache = NULL;
+static long querySeqCacheBases = 0;
+static long querySeqCacheMaxBases = 64*1024*1024;
+
+static char *batchSeqSource(struct track *tg, char *tableName)
+/* If the query sequences of tg come from genbank or seq and extFile tables, return where
+ * as a baseColorUseSequence setting such as "table refMrna", otherwise NULL. */
+{
+if (sameString(tableName,"refGene") || sameString(tableName,"refSeqAli"))
+    return "table refMrna";
+char *seqSource = trackDbSetting(tg->tdb, BASE_COLOR_USE_SEQUENCE);
+if (seqSource == NULL || sameString(seqSource, "ss")
+#ifndef GBROWSE
+    || sameString(seqSource, PCR_RESULT_TRACK_NAME)
+#endif /* GBROWSE */
+    || sameString("nameIsSequence", seqSource) || sameString("seq1Seq2", seqSource)
+    || sameString("lfExtra", seqSource) || sameString("lrg", seqSource)
+    || sameString("2bit", seqSource) || startsWithWord("db", seqSource))
+    return NULL;
+return seqSource;
+}
+
+static boolean isExtFileSource(char *seqSource)
+/* Return TRUE if seqSource names seq and extFile tables. */
+{
+return startsWith("extFile", seqSource) || endsWith("ExtFile", seqSource);
+}
+
+static char *sourceCompatTable(char *seqSource, char *buf, int bufSize)
+/* Return the table in a "table <name>" seqSource, or NULL if it isn't one.  Uses buf
+ * rather than modifying seqSource. */
+{
+if (!startsWith("table ", seqSource))
+    return NULL;
+safecpy(buf, bufSize, seqSource);
+char *table = buf;
+nextWord(&table);
+return table;
+}
+
+static struct dnaSeq *fetchQuerySeq(char *seqSource, char *name)
+/* Fetch one sequence from where batchSeqSource says it is. */
+{
+char buf[1024];
+char *table = sourceCompatTable(seqSource, buf, sizeof(buf));
+if (table != NULL)
+    return hGenBankGetMrna(database, name, table);
+else if (isExtFileSource(seqSource))
+    return maybeGetExtFileSeq(seqSource, name);
+else
+    return hGenBankGetMrna(database, name, NULL);
+}
+
+static struct hash *fetchQuerySeqBatch(char *seqSource, struct slName *nameList)
+/* Fetch all sequences in nameList from where batchSeqSource says they are, returning
+ * a hash of the ones found keyed by name. */
+{
+char buf[1024];
+char *table = sourceCompatTable(seqSource, buf, sizeof(buf));
+if (table != NULL)
+    return hGenBankGetMrnaBatch(database, nameList, table);
+else if (isExtFileSource(seqSource))
+    {
+    struct dyString *dy = dyStringNew(0);
+    char *words[3];
+    parseExtFileSource(seqSource, dy, words);
+    struct hash *seqHash = hDnaSeqGetBatch(database, nameList, words[1], words[2]);
+    dyStringFree(&dy);
+    return seqHash;
+    }
+else
+    return hGenBankGetMrnaBatch(database, nameList, NULL);
+}
+
+static boolean querySeqCacheAdd(char *key, struct dnaSeq *seq)
+/* Add seq, which is NULL if not found, to cache under key.  Returns FALSE without
+ * adding it if the cache is full. */
+{
+int size = (seq != NULL ? seq->size : 0);
+if (querySeqCacheBases + size > querySeqCacheMaxBases)
+    return FALSE;
+if (querySeqCache == NULL)
+    querySeqCache = hashNew(12);
+hashAdd(querySeqCache, key, seq);
+querySeqCacheBases += size;
+return TRUE;
+}
+
+static struct dnaSeq *cachedQuerySeq(char *seqSource, char *name)
+/* Return a copy of the sequence of name from where batchSeqSource says it is, using the
+ * cache if possible, or NULL if it isn't found. */
+{
+char key[2048];
+safef(key, sizeof(key), "%s\t%s", seqSource, name);
+struct hashEl *hel = (querySeqCache != NULL ? hashLookup(querySeqCache, key) : NULL);
+if (hel == NULL)
+    {
+    struct dnaSeq *seq = fetchQuerySeq(seqSource, name);
+    if (!querySeqCacheAdd(key, seq))
+        return seq;
+    hel = hashLookup(querySeqCache, key);
+    }
+return (hel->val != NULL ? cloneDnaSeq(hel->val) : NULL);
+}
+
+static void prefetchQuerySeqs(struct track *tg, boolean isSeries)
+/* If tg's query sequences come from genbank or seq and extFile tables, fetch the ones
+ * for all items in the window at once, so drawing items doesn't look them up one by one. */
+{
+char *seqSource = batchSeqSource(tg, tg->table);
+if (seqSource == NULL)
+    return;
+char *type = tg->tdb->type;
+boolean isPsl = (startsWith("psl", type) || sameString("bigPsl", type)
+                 || startsWithWord("bam", type));
+boolean isChain = (startsWithWord("chain", type) || startsWithWord("bigChain", type));
+struct slRef *ref, *refList = NULL;
+if (isSeries)
+    {
+    struct linkedFeaturesSeries *lfs;
+    for (lfs = tg->items;  lfs != NULL;  lfs = lfs->next)
+        {
+        struct linkedFeatures *lf;
+        for (lf = lfs->features;  lf != NULL;  lf = lf->next)
+            refAdd(&refList, lf);
+        }
+    }
+else
+    {
+    struct linkedFeatures *lf;
+    for (lf = tg->items;  lf != NULL;  lf = lf->next)
+        refAdd(&refList, lf);
+    }
+slReverse(&refList);
+
+/* Collect names like baseColorDrawSetup and maybeGetSeqUpper would make them. */
+struct hash *nameHash = hashNew(0);
+struct slName *nameList = NULL;
+for (ref = refList;  ref != NULL;  ref = ref->next)
+    {
+    struct linkedFeatures *lf = ref->val;
+    if (lf->start >= winEnd || lf->end <= winStart || (isPsl && lf->original == NULL))
+        continue;
+    char *qName = (isChain ? cloneFirstWord(lf->name) : cloneString(lf->name));
+    char *name = getItemDataName(tg, qName);
+    char key[2048];
+    safef(key, sizeof(key), "%s\t%s", seqSource, name);
+    if (hashLookup(nameHash, name) == NULL
+        && (querySeqCache == NULL || hashLookup(querySeqCache, key) == NULL))
+        {
+        hashAdd(nameHash, name, NULL);
+        slNameAddHead(&nameList, name);
+        }
+    freeMem(qName);
+    }
+slFreeList(&refList);
+
+if (nameList != NULL)
+    {
+    struct hash *seqHash = fetchQuerySeqBatch(seqSource, nameList);
+    struct slName *el;
+    for (el = nameList;  el != NULL;  el = el->next)
+        {
+        char key[2048];
+        safef(key, sizeof(key), "%s\t%s", seqSource, el->name);
+        struct dnaSeq *seq = hashFindVal(seqHash, el->name);
+        if (!querySeqCacheAdd(key, seq))
+            freeDnaSeq(&seq);
+        }
+    hashFree(&seqHash);
+    slFreeList(&nameList);
+    }
+hashFree(&nameHash);
+}
+
 static struct dnaSeq *maybeGetSeqUpper(struct linkedFeatures *lf, 
 		    char *mrnaName, int mrnaStart, int mrnaEnd,
 		    char *tableName, struct track *tg, boolean doRc, int *retMrnaOffset)
@@ -1094,8 +1277,9 @@ static struct dnaSeq *maybeGetSeqUpper(struct linkedFeatures *lf,
 boolean doUpper = TRUE;
 struct dnaSeq *mrnaSeq = NULL;
 char *name = getItemDataName(tg, mrnaName);
-if (sameString(tableName,"refGene") || sameString(tableName,"refSeqAli"))
-    mrnaSeq = hGenBankGetMrna(database, name, "refMrna");
+char *batchSource = batchSeqSource(tg, tableName);
+if (batchSource != NULL)
+    mrnaSeq = cachedQuerySeq(batchSource, name);
 else
     {
     char *seqSource = trackDbSetting(tg->tdb, BASE_COLOR_USE_SEQUENCE);
@@ -1107,10 +1291,6 @@ else
 	else if (sameString(seqSource, PCR_RESULT_TRACK_NAME))
 	    mrnaSeq = maybeGetPcrResultSeq(lf);
 #endif /* GBROWSE */
-	else if (startsWith("extFile", seqSource))
-	    mrnaSeq = maybeGetExtFileSeq(seqSource, name);
-	else if (endsWith("ExtFile", seqSource))
-	    mrnaSeq = maybeGetExtFileSeq(seqSource, name);
 	else if (sameString("nameIsSequence", seqSource))
 	    {
 	    mrnaSeq = newDnaSeq(cloneString(name), strlen(name), name);
@@ -1145,12 +1325,6 @@ else
 	    doRc = FALSE;	    // Handled it already
 	    doUpper = FALSE;    // Handled it already
 	    }
-	else if (startsWith("table ", seqSource))
-	    {
-	    char *table = seqSource;
-	    nextWord(&table);
-	    mrnaSeq = hGenBankGetMrna(database, name, table);
-	    }
 	else if (startsWithWord("db", seqSource))
 	    {
 	    char *sourceDb = seqSource;
@@ -1159,8 +1333,6 @@ else
 		sourceDb = database;
 	    mrnaSeq = hChromSeq(sourceDb, name, 0, 0);
 	    }
-	else
-	    mrnaSeq = hGenBankGetMrna(database, name, NULL);
 	}
     }
 if (mrnaSeq != NULL && doUpper)
@@ -2071,6 +2243,10 @@ if (initedTrack == NULL || differentString(tg->track, initedTrack))
 	cachedGenoDna = hDnaFromSeq(database, chromName, cachedGenoStart, cachedGenoEnd, dnaUpper);
 	}
     initedTrack = cloneString(tg->track);
+    if (drawOpt == baseColorDrawItemBases || drawOpt == baseColorDrawDiffBases ||
+	drawOpt == baseColorDrawItemCodons || drawOpt == baseColorDrawDiffCodons ||
+	indelShowPolyA)
+	prefetchQuerySeqs(tg, isSeries);
     }
 
 /* allocate colors for coding coloring */
@@ -102,7 +102,11 @@ if (vis == tvFull && cgs->linesAtCount != 0)
 if (binFileName)
     {
     struct chromGraphBin *cgb = chromGraphBinOpen(binFileName);
-    if (chromGraphBinSeekToChrom(cgb, chromName))
+    int zoomLevel = -1;
+    if (hvg->pixelBased)
+	zoomLevel = chromGraphBinZoomLevel(cgb, (double)(seqEnd - seqStart)/width,
+		cgs->maxGapToFill);
+    if (chromGraphBinSeekToChromZoom(cgb, chromName, zoomLevel))
 	{
 	int seqStartMinus = seqStart - cgs->maxGapToFill;
 	while (chromGraphBinNextVal(cgb))
@@ -133,6 +137,7 @@ if (binFileName)
 		}
 	    }
 	}
+    chromGraphBinFree(&cgb);
     }
 else
     {
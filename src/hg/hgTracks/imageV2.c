@@ -16,6 +16,7 @@
 #include "regexHelper.h"
 #include "customComposite.h"
 #include "chromAlias.h"
+#include "jsonParse.h"
 
 // Note: when right-click View image (or pdf output) then theImgBox==NULL, so it will be rendered as a single simple image
 struct imgBox   *theImgBox   = NULL; // Make this global for now to avoid huge rewrite
@@ -383,6 +384,7 @@ if (link != NULL)
         item->linkVar = cloneString(link + strlen(map->linkRoot));
     else
         item->linkVar = cloneString(link);
+    item->linkTemplate = NULL;
     }
 item->topLeftX     = topLeftX;
 item->topLeftY     = topLeftY;
@@ -418,6 +420,56 @@ slAddHead(&(map->items),item);
 return map->items;
 }
 
+struct mapItem *mapSetItemAddTemplated(struct mapSet *map,char *linkTemplate,int start,int end,
+                                       char *encodedItem,char *title,int topLeftX,int topLeftY,
+                                       int bottomRightX,int bottomRightY,char *id)
+// Add a single mapItem whose link is linkTemplate filled in with start, end and encodedItem.
+// Items sharing a template keep one copy of it, and it is sent to the browser once per map.
+{
+if (map->templates == NULL)
+    map->templates = hashNew(0);
+struct mapItem *item = mapSetItemAdd(map,NULL,title,topLeftX,topLeftY,
+                                     bottomRightX,bottomRightY,id);
+item->linkTemplate = hashStoreName(map->templates,linkTemplate);
+item->start        = start;
+item->end          = end;
+item->encodedItem  = cloneString(encodedItem);
+return item;
+}
+
+static struct mapItem *mapSetItemFindOrAddTemplated(struct mapSet *map,char *linkTemplate,
+                                    int start,int end,char *encodedItem,char *title,
+                                    int topLeftX,int topLeftY,int bottomRightX,int bottomRightY,
+                                    char *id)
+// Templated version of mapSetItemFindOrAdd
+{
+if (cfgOption("restoreMapFind"))
+    {
+    struct mapItem *item = mapSetItemFind(map,topLeftX,topLeftY,bottomRightX,bottomRightY);
+    if (item != NULL)
+        return item;
+    }
+return mapSetItemAddTemplated(map,linkTemplate,start,end,encodedItem,title,
+                              topLeftX,topLeftY,bottomRightX,bottomRightY,id);
+}
+
+char *mapItemLink(struct mapItem *item)
+// Return the link of a map item (without any map linkRoot), filling in the template if it has
+// one, or NULL if it has no link.  Free the result when done.
+{
+if (item->linkTemplate == NULL)
+    return cloneString(item->linkVar);
+char num[16];
+safef(num,sizeof(num),"%d",item->start);
+char *withStart = replaceChars(item->linkTemplate,MAP_LINK_START,num);
+safef(num,sizeof(num),"%d",item->end);
+char *withEnd = replaceChars(withStart,MAP_LINK_END,num);
+char *link = replaceChars(withEnd,MAP_LINK_ITEM,item->encodedItem);
+freeMem(withStart);
+freeMem(withEnd);
+return link;
+}
+
 struct mapItem *mapSetItemUpdateOrAdd(struct mapSet *map,char *link,char *title,
                                       int topLeftX,int topLeftY,int bottomRightX,int bottomRightY,
                                       char *id)
@@ -473,6 +525,7 @@ if (pItem != NULL && *pItem != NULL)
         freeMem(item->linkVar);
     if (item->id != NULL)
         freeMem(item->id);
+    freeMem(item->encodedItem);
     freeMem(item);
     *pItem = NULL;
     }
@@ -524,6 +577,9 @@ if (item)
     addIndent(&myDy,indent);
     dyStringPrintf(myDy,"&nbsp;&nbsp;linkVar:%s",
                    (item->linkVar ? item->linkVar : ""));
+    if (item->linkTemplate)
+        dyStringPrintf(myDy," linkTemplate:%s start:%d end:%d item:%s",
+                       item->linkTemplate,item->start,item->end,item->encodedItem);
     if (dy == NULL)
         warn("%s",dyStringCannibalize(&myDy));
     else
@@ -587,7 +643,7 @@ for (;item != NULL; item = item->next)
     {
     if (!mapItemConsistentWithImage(item,map->parentImg,verbose))
         return FALSE;
-    if (item->linkVar == NULL && map->linkRoot == NULL)
+    if (item->linkVar == NULL && item->linkTemplate == NULL && map->linkRoot == NULL)
         {
         if (verbose)
             warn("item for map(%s) has no link.",(map->name ? map->name : map->parentImg->file));
@@ -609,6 +665,7 @@ if (pMap != NULL && *pMap != NULL)
     freeMem(map->name);
     // Don't free parentImg, as it should be freed independently
     freeMem(map->linkRoot);
+    hashFree(&map->templates);
     freeMem(map);
     *pMap = NULL;
     }
@@ -1128,12 +1185,12 @@ if (slice == NULL)
 return sliceGetMap(slice,FALSE); // Map could belong to image or could be slice specific
 }
 
-int imgTrackAddMapItem(struct imgTrack *imgTrack,char *link,char *title,
-                       int topLeftX,int topLeftY,int bottomRightX,int bottomRightY, char *id)
-// Will add a map item to an imgTrack's appropriate slice's map.  Since a map item may span
-// slices, the imgTrack is in the best position to determine where to put the map item
-// returns count of map items added, which could be 0, 1 or more than one if item spans slices
-// NOTE: Precedence is given to first map item when adding items with same coordinates!
+static int imgTrackAddMapItemOrTemplate(struct imgTrack *imgTrack,char *link,
+                                        char *linkTemplate,int start,int end,char *encodedItem,
+                                        char *title,int topLeftX,int topLeftY,
+                                        int bottomRightX,int bottomRightY, char *id)
+// Adds a map item to an imgTrack's maps, with either a link or a linkTemplate that is
+// filled in from start, end and encodedItem.
 {
 if (imgTrack == NULL)
     return 0;
@@ -1177,7 +1234,14 @@ for (slice = imgTrack->slices;slice != NULL;slice=slice->next)
         struct mapSet *map = sliceGetMap(slice,FALSE);
         if (map!=NULL)
             {  // NOTE: using find or add gives precedence to first of same coordinate map items
-            mapSetItemFindOrAdd(map,link,title,max(topLeftX,slice->offsetX),
+            if (linkTemplate != NULL)
+                mapSetItemFindOrAddTemplated(map,linkTemplate,start,end,encodedItem,title,
+                                max(topLeftX,slice->offsetX),
+                                max(topLeftY,slice->offsetY),
+                                min(bottomRightX,slice->offsetX + slice->width),
+                                min(bottomRightY,slice->offsetY + slice->height), neededId);
+            else
+                mapSetItemFindOrAdd(map,link,title,max(topLeftX,slice->offsetX),
                                 max(topLeftY,slice->offsetY),
                                 min(bottomRightX,slice->offsetX + slice->width),
                                 min(bottomRightY,slice->offsetY + slice->height), neededId);
@@ -1191,7 +1255,20 @@ for (slice = imgTrack->slices;slice != NULL;slice=slice->next)
             warn("imgTrackAddMapItem(%s,%s) mapItem(lx:%d,rx:%d) is overlapping "
                  "slice:%s(lx:%d,rx:%d)",name,title,topLeftX,bottomRightX,
                  sliceTypeToString(slice->type),slice->offsetX,(slice->offsetX + slice->width - 1));
-            sliceAddLink(slice,link,title);
+            if (linkTemplate != NULL)
+                {
+                struct mapItem filled;
+                ZeroVar(&filled);
+                filled.linkTemplate = linkTemplate;
+                filled.start        = start;
+                filled.end          = end;
+                filled.encodedItem  = encodedItem;
+                char *filledLink = mapItemLink(&filled);
+                sliceAddLink(slice,filledLink,title);
+                freeMem(filledLink);
+                }
+            else
+                sliceAddLink(slice,link,title);
             count++;
             }
         }
@@ -1199,6 +1276,27 @@ for (slice = imgTrack->slices;slice != NULL;slice=slice->next)
 return count;
 }
 
+int imgTrackAddMapItem(struct imgTrack *imgTrack,char *link,char *title,
+                       int topLeftX,int topLeftY,int bottomRightX,int bottomRightY, char *id)
+// Will add a map item to an imgTrack's appropriate slice's map.  Since a map item may span
+// slices, the imgTrack is in the best position to determine where to put the map item
+// returns count of map items added, which could be 0, 1 or more than one if item spans slices
+// NOTE: Precedence is given to first map item when adding items with same coordinates!
+{
+return imgTrackAddMapItemOrTemplate(imgTrack,link,NULL,0,0,NULL,title,
+                                    topLeftX,topLeftY,bottomRightX,bottomRightY,id);
+}
+
+int imgTrackAddMapItemTemplated(struct imgTrack *imgTrack,char *linkTemplate,int start,int end,
+                                char *encodedItem,char *title,int topLeftX,int topLeftY,
+                                int bottomRightX,int bottomRightY,char *id)
+// Like imgTrackAddMapItem, but the link is linkTemplate with MAP_LINK_START, MAP_LINK_END and
+// MAP_LINK_ITEM filled in from start, end and encodedItem.
+{
+return imgTrackAddMapItemOrTemplate(imgTrack,NULL,linkTemplate,start,end,encodedItem,title,
+                                    topLeftX,topLeftY,bottomRightX,bottomRightY,id);
+}
+
 static char *centerLabelSeenToString(enum centerLabelSeen seen)
 // Translate enum slice type to string
 {
@@ -1788,6 +1886,110 @@ if (pImgBox != NULL && *pImgBox != NULL)
 
 /////////////////////// imageV2 UI API
 
+static char *mapItemHref(struct mapSet *map,struct mapItem *item)
+// Return what goes in the HREF of a map item without a link template, or NULL if it has none
+{
+char *linkVar = item->linkVar;
+if (map->linkRoot != NULL)
+    return catTwoStrings(map->linkRoot,(linkVar != NULL ? linkVar : ""));
+else if (linkVar == NULL)
+    return NULL;
+else if (startsWith("/cgi-bin/hgGene", linkVar)) // redmine #4151
+    return catTwoStrings("..",linkVar);
+else
+    return cloneString(linkVar);
+}
+
+static char *jsonScriptEscapeLm(char *string,struct lm *lm)
+// Return string escaped for a json string inside a <script> element.  Besides the usual
+// json escapes, '<', '>' and '&' become \u escapes so the string can't close the element.
+{
+char *escaped = jsonStringEscapeLm(string,lm);
+if (strpbrk(escaped,"<>&") == NULL)
+    return escaped;
+struct dyString *dy = dyStringNew(strlen(escaped) + 32);
+char *s;
+for (s = escaped;*s != '\0';s++)
+    {
+    if (*s == '<' || *s == '>' || *s == '&')
+        dyStringPrintf(dy,"\\u%04x",*s);
+    else
+        dyStringAppendC(dy,*s);
+    }
+char *result = lmCloneString(lm,dy->string);
+dyStringFree(&dy);
+return result;
+}
+
+static int mapStringIx(struct hash *stringHash,struct dyString *strings,char *string)
+// Return index of string in the json list in strings, adding it if it is new.  -1 for NULL.
+{
+if (string == NULL)
+    return -1;
+int ix = hashIntValDefault(stringHash,string,-1);
+if (ix < 0)
+    {
+    ix = stringHash->elCount;
+    hashAddInt(stringHash,string,ix);
+    if (ix > 0)
+        dyStringAppendC(strings,',');
+    dyStringPrintf(strings,"\"%s\"",jsonScriptEscapeLm(string,stringHash->lm));
+    }
+return ix;
+}
+
+static boolean imageMapDrawJson(struct mapSet *map,char *name)
+// writes an image map as a compact list of items in json that hgTracks.js turns into AREAs.
+// Strings are sent once in a list that items refer to, and templated links are sent as
+// the template and the start, end and item name to fill in.  Returns FALSE without writing
+// anything if the map has items that need to be written out as HTML.
+{
+struct mapItem *item;
+for (item = map->items;item!=NULL;item=item->next)
+    {
+    if (item->linkTemplate == NULL
+    && (item->linkVar == NULL || (map->linkRoot == NULL && skipToSpaces(item->linkVar))))
+        return FALSE;  // no link or link with extra attributes
+    }
+struct hash *stringHash = hashNew(0);
+struct dyString *strings = dyStringNew(0);
+struct dyString *items = dyStringNew(0);
+for (item = map->items;item!=NULL;item=item->next)
+    {
+    int linkIx = -1;
+    char *href = NULL;
+    if (item->linkTemplate != NULL)
+        linkIx = mapStringIx(stringHash,strings,item->linkTemplate);
+    else if (differentString(TITLE_BUT_NO_LINK,item->linkVar))
+        {
+        href = mapItemHref(map,item);
+        linkIx = mapStringIx(stringHash,strings,href);
+        }
+    int titleIx = mapStringIx(stringHash,strings,isEmpty(item->title) ? NULL : item->title);
+    int idIx = mapStringIx(stringHash,strings,item->id);
+    if (item != map->items)
+        dyStringAppendC(items,',');
+    dyStringPrintf(items,"[%d,%d,%d,%d,%d,%d,%d",
+                   item->topLeftX, item->topLeftY, item->bottomRightX, item->bottomRightY,
+                   linkIx, titleIx, idIx);
+    if (item->linkTemplate != NULL)
+        dyStringPrintf(items,",%d,%d,\"%s\"",item->start,item->end,
+                       jsonScriptEscapeLm(item->encodedItem,stringHash->lm));
+    dyStringAppendC(items,']');
+    freeMem(href);
+    }
+hPrintf("  <MAP name='map_%s'><script type='application/json' class='mapItems'>", name);
+hPrintf("{\"s\":[");
+hPuts(strings->string);
+hPrintf("],\"a\":[");
+hPuts(items->string);
+hPrintf("]}</script></MAP>\n");
+dyStringFree(&items);
+dyStringFree(&strings);
+hashFree(&stringHash);
+return TRUE;
+}
+
 static boolean imageMapDraw(struct mapSet *map,char *name)
 // writes an image map as HTML
 {
@@ -1796,6 +1998,8 @@ if (map == NULL || map->items == NULL)
 
 slReverse(&(map->items)); // These must be reversed so that they are
                           // printed in the same order as created!
+if (cfgOptionBooleanDefault("compactImageMap", TRUE) && imageMapDrawJson(map,name))
+    return TRUE;
 hPrintf("  <MAP name='map_%s'>", name); // map_ prefix is implicit
 struct mapItem *item = map->items;
 for (;item!=NULL;item=item->next)
@@ -1804,31 +2008,32 @@ for (;item!=NULL;item=item->next)
             item->topLeftX, item->topLeftY, item->bottomRightX, item->bottomRightY);
     // TODO: remove static portion of the link and handle in js
 
-    if (sameString(TITLE_BUT_NO_LINK,item->linkVar))
+    char *link = mapItemLink(item);
+    if (sameOk(TITLE_BUT_NO_LINK,link))
         { // map items could be for mouse-over titles only
         hPrintf(" class='area %s'",TITLE_BUT_NO_LINK);
         }
     else if (map->linkRoot != NULL)
         {
-        if (skipToSpaces(item->linkVar))
-            hPrintf(" HREF=%s%s",map->linkRoot,(item->linkVar != NULL ? item->linkVar : ""));
+        if (skipToSpaces(link))
+            hPrintf(" HREF=%s%s",map->linkRoot,(link != NULL ? link : ""));
         else
-            hPrintf(" HREF='%s%s'",map->linkRoot,(item->linkVar != NULL ? item->linkVar : ""));
+            hPrintf(" HREF='%s%s'",map->linkRoot,(link != NULL ? link : ""));
         hPrintf(" class='area'");
         }
-    else if (item->linkVar != NULL)
+    else if (link != NULL)
         {
-        if (skipToSpaces(item->linkVar))
-            hPrintf(" HREF=%s",item->linkVar);
-        else if (startsWith("/cgi-bin/hgGene", item->linkVar)) // redmine #4151
-            hPrintf(" HREF='..%s'",item->linkVar);             // FIXME: Chin should get rid
-        else                                                   // of this special case!
-            hPrintf(" HREF='%s'",item->linkVar);
+        if (skipToSpaces(link))
+            hPrintf(" HREF=%s",link);
+        else if (startsWith("/cgi-bin/hgGene", link)) // redmine #4151
+            hPrintf(" HREF='..%s'",link);             // FIXME: Chin should get rid
+        else                                          // of this special case!
+            hPrintf(" HREF='%s'",link);
         hPrintf(" class='area'");
         }
     else
         warn("map item has no url!");
-
+    freeMem(link);
     if (item->title != NULL && strlen(item->title) > 0)
         {
         char *encodedString = attributeEncode(item->title);
@@ -124,6 +124,11 @@ struct mapItem // IMAGEv2: single map item in an image map.
     int bottomRightY;         // in pixels relative to image
     char *id;                 // id; used by js right-click code to figure out what to do with
                               //     a map item (usually mapName)
+    char *linkTemplate;       // if not NULL, the link is this with MAP_LINK_START, MAP_LINK_END
+                              //     and MAP_LINK_ITEM filled in.  Shared, not allocated here.
+    int start;                // item start for linkTemplate
+    int end;                  // item end for linkTemplate
+    char *encodedItem;        // cgi encoded item name for linkTemplate
     };
 
 struct mapSet // IMAGEv2: full map for image OR partial map for slice
@@ -132,11 +137,17 @@ struct mapSet // IMAGEv2: full map for image OR partial map for slice
     struct image *parentImg;  // points to the image this map belongs to
     char *linkRoot;           // the common or static portion of the link for the entire image
     struct mapItem *items;    // list of items
+    struct hash *templates;   // link templates shared by items
     };
 
 // To create map items which have mouse-over titles but no link, fill link with:
 #define TITLE_BUT_NO_LINK "noLink"
 
+// Placeholders in map item link templates, filled in from each item
+#define MAP_LINK_START "{o}"
+#define MAP_LINK_END   "{t}"
+#define MAP_LINK_ITEM  "{i}"
+
 struct mapSet *mapSetStart(char *name,struct image *img,char *linkRoot);
 // Starts a map (aka mapSet) which is the seet of links and image locations used in HTML.
 // Complete a map by adding items with mapItemAdd()
@@ -157,6 +168,16 @@ struct mapItem *mapSetItemAdd(struct mapSet *map,char *link,char *title,int topL
                               int bottomRightX,int bottomRightY, char *id);
 // Add a single mapItem to a growing mapSet
 
+struct mapItem *mapSetItemAddTemplated(struct mapSet *map,char *linkTemplate,int start,int end,
+                                       char *encodedItem,char *title,int topLeftX,int topLeftY,
+                                       int bottomRightX,int bottomRightY,char *id);
+// Add a single mapItem whose link is linkTemplate filled in with start, end and encodedItem.
+// Items sharing a template keep one copy of it, and it is sent to the browser once per map.
+
+char *mapItemLink(struct mapItem *item);
+// Return the link of a map item (without any map linkRoot), filling in the template if it has
+// one, or NULL if it has no link.  Free the result when done.
+
 struct mapItem *mapSetItemUpdateOrAdd(struct mapSet *map,char *link,char *title,
                                       int topLeftX,int topLeftY,int bottomRightX,int bottomRightY,
                                       char *id);
@@ -374,6 +395,12 @@ int imgTrackAddMapItem(struct imgTrack *imgTrack,char *link,char *title,int topL
 // Returns count of map items added, which could be 0, 1 or more than one if item spans slices
 // NOTE: Precedence is given to first map item when adding items with same coordinates!
 
+int imgTrackAddMapItemTemplated(struct imgTrack *imgTrack,char *linkTemplate,int start,int end,
+                                char *encodedItem,char *title,int topLeftX,int topLeftY,
+                                int bottomRightX,int bottomRightY,char *id);
+// Like imgTrackAddMapItem, but the link is linkTemplate with MAP_LINK_START, MAP_LINK_END and
+// MAP_LINK_ITEM filled in from start, end and encodedItem.
+
 boolean imgTrackIsComplete(struct imgTrack *imgTrack,boolean verbose);
 // Tests the completeness and consistency of this imgTrack (including slices)
 
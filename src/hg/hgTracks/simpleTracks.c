@@ -1262,8 +1262,13 @@ if (x < xEnd)
             {
 	    // NOTE: chopped out winStart/winEnd
 	    // NOTE: Galt added winStart/winEnd back in for multi-region
-            safef(link,sizeof(link),"%s&db=%s&c=%s&l=%d&r=%d&o=%d&t=%d&g=%s&i=%s",
-                hgcNameAndSettings(), database, cgiEncode(chromName), winStart, winEnd, start, end, encodedTrack, encodedItem);
+            // Item coordinates and name are left as placeholders so that all items of the
+            // track share one link template.
+            char *encodedChrom = cgiEncode(chromName);
+            safef(link,sizeof(link),"%s&db=%s&c=%s&l=%d&r=%d&o=%s&t=%s&g=%s&i=%s",
+                hgcNameAndSettings(), database, encodedChrom, winStart, winEnd,
+                MAP_LINK_START, MAP_LINK_END, encodedTrack, MAP_LINK_ITEM);
+            freeMem(encodedChrom);
             }
         if (extra != NULL)
             safef(link+strlen(link),sizeof(link)-strlen(link),"&%s", extra);
@@ -1274,8 +1279,12 @@ if (x < xEnd)
         else if (revCmplDisp && x < insideWidth && xEnd > insideWidth)
             xEnd = insideWidth - 1;
         #endif//def IMAGEv2_SHORT_MAPITEMS
-        imgTrackAddMapItem(curImgTrack,link,(char *)(statusLine!=NULL?statusLine:NULL),
-                           x, y, xEnd, yEnd, track);
+        if (directUrl)
+            imgTrackAddMapItem(curImgTrack,link,(char *)(statusLine!=NULL?statusLine:NULL),
+                               x, y, xEnd, yEnd, track);
+        else
+            imgTrackAddMapItemTemplated(curImgTrack,link,start,end,encodedItem,statusLine,
+                                        x, y, xEnd, yEnd, track);
         }
     else
         {
@@ -1022,6 +1022,15 @@ boolean whiskers = (wigCart->windowingFunction == wiggleWindowingWhiskers
 
 struct wigMouseOver *mouseOverData = getMouseOverData(tg, preDraw, width, xOff, preDrawZero);
 
+/*	Dense and squish draw every pixel over the full height, so when
+ *	drawing straight to the image, runs of pixels of the same shade are
+ *	saved up as spans and drawn together after the loop.
+ */
+struct mgSpan *spans = NULL;
+int spanCount = 0;
+if ((vis == tvDense || vis == tvSquish) && vLine == vLineViaHvg)
+    AllocArray(spans, width);
+
 /*	right now this is a simple pixel by pixel loop.  Future
  *	enhancements could draw boxes where pixels
  *	are all the same height in a run.
@@ -1238,10 +1247,28 @@ for (x1 = 0; x1 < width; ++x1)
 
 	    drawColor =
 		tg->colorShades[grayInRange(grayIndex, 0, MAX_WIG_VALUE)];
-	    doLine(image, x, yOff, tg->lineHeight, drawColor);
+	    if (spans == NULL)
+		{
+		doLine(image, x, yOff, tg->lineHeight, drawColor);
+		}
+	    else if (spanCount > 0 && spans[spanCount-1].color == drawColor
+		 && spans[spanCount-1].x + spans[spanCount-1].width == x)
+		spans[spanCount-1].width += 1;
+	    else
+		{
+		struct mgSpan *span = &spans[spanCount++];
+		span->x = x;
+		span->width = 1;
+		span->color = drawColor;
+		}
             }   /*	vis == tvDense || vis == tvSquish	*/
 	}	/*	if (preDraw[].count)	*/
     }	/*	for (x1 = 0; x1 < width; ++x1)	*/
+if (spans != NULL)
+    {
+    hvGfxDrawSpans(image, yOff, tg->lineHeight, spans, spanCount);
+    freeMem(spans);
+    }
 
 return(mouseOverData);
 }	/*	graphPreDraw()	*/
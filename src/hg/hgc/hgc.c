@@ -9167,9 +9167,9 @@ struct bbiFile *bbi =  bigBedFileOpenAlias(fileName, chromAliasFindAliases);
 struct lm *lm = lmInit(0);
 char *quickLiftFile = cloneString(trackDbSetting(tdb, "quickLiftUrl"));
 struct bigBedInterval *bb, *bbList = NULL;
-struct hash *chainHash = NULL;
+struct quickLiftChainSet *chainSet = NULL;
 if (quickLiftFile)
-    bbList = quickLiftIntervals(quickLiftFile, bbi, seqName, winStart, winEnd, &chainHash);
+    bbList = quickLiftIntervals(quickLiftFile, bbi, seqName, winStart, winEnd, &chainSet);
 else
     bbList = bigBedIntervalQuery(bbi, seqName, winStart, winEnd, 0, lm);
 struct genePred *gpList = NULL;
@@ -9179,7 +9179,7 @@ for (bb = bbList; bb != NULL; bb = bb->next)
     if (quickLiftFile)
         {
         struct bed *bed;
-        if ((bed = quickLiftBed(bbi, chainHash, bb)) != NULL)
+        if ((bed = quickLiftBed(bbi, chainSet, bb)) != NULL)
             {
             struct bed *bedCopy = cloneBed(bed);
             gp =(struct genePred *) genePredFromBedBigGenePred(seqName, bedCopy, bb);
@@ -9648,10 +9648,10 @@ char *fileName = hReplaceGbdb(trackDbSetting(tdb, "bigDataUrl"));
 bbi =  bigBedFileOpenAlias(fileName, chromAliasFindAliases);
 struct lm *lm = lmInit(0);
 char *quickLiftFile = cloneString(trackDbSetting(tdb, "quickLiftUrl"));
-struct hash *chainHash = NULL;
+struct quickLiftChainSet *chainSet = NULL;
 struct bigBedInterval *bb, *bbList = NULL;
 if (quickLiftFile)
-    bbList = quickLiftIntervals(quickLiftFile, bbi, seqName, winStart, winEnd, &chainHash);
+    bbList = quickLiftIntervals(quickLiftFile, bbi, seqName, winStart, winEnd, &chainSet);
 else
     bbList = bigBedIntervalQuery(bbi, seqName, winStart, winEnd, 0, lm);
 
@@ -9664,7 +9664,7 @@ for (bb = bbList; bb != NULL; bb = bb->next)
     struct bed *bed = NULL;
     if (quickLiftFile)
         {
-        if ((bed = quickLiftBed(bbi, chainHash, bb)) == NULL)
+        if ((bed = quickLiftBed(bbi, chainSet, bb)) == NULL)
             errAbort("can't port %s",bedRow[3]);
         }
     else
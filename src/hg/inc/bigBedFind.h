@@ -11,6 +11,11 @@ boolean findBigBedPosInTdb(struct cart *cart, char *db, struct trackDb *tdb, cha
 boolean findBigBedPosInTdbList(struct cart *cart, char *db, struct trackDb *tdbList, char *term, struct hgPositions *hgp, struct hgFindSpec *hfs, boolean measureTiming);
 /* find a term in a list of tracks which may include a bigBed */ 
 
+boolean findBigBedPosInTdbListLimit(struct cart *cart, char *db, struct trackDb *tdbList, char *term, struct hgPositions *hgp, struct hgFindSpec *hfs, boolean measureTiming, int limitResults);
+/* find a term in a list of tracks which may include a bigBed, searching several tracks
+ * at once but adding results to hgp in list order.  If limitResults > 0 stop adding
+ * tracks once that many positions are found. */
+
 struct trackDb *getSearchableBigBeds(struct trackDb *tdbList);
 /* Given a list of tracks, return those that are searchable */
 
@@ -125,6 +125,16 @@ void chromGraphToBin(struct chromGraph *list, char *fileName);
 /* Create binary representation of chromGraph list, which should
  * be sorted. */
 
+/* Binary chromGraph files carry zoomed out versions of the data for drawing
+ * large regions.  Each zoom level divides chromosomes into bins of a given size,
+ * and keeps only the first, lowest, highest and last point in each bin, so that
+ * lines drawn through the points look the same when a bin is smaller than a
+ * pixel.  Levels are stored in the same format as the full resolution data,
+ * and bin sizes go up by chromGraphZoomFactor. */
+#define chromGraphZoomFirstBinSize 256
+#define chromGraphZoomFactor 4
+#define chromGraphMaxZoomLevels 10
+
 void chromGraphToBinGetMinMax(struct chromGraph *list, char *fileName,
 	double *retMin, double *retMax);
 /* Create binary representation of chromGraph list, which should
@@ -149,6 +159,7 @@ struct cgbChrom
     struct cgbChrom *next;	/* Next in list. */
     char *name;			/* Chromosome name. */
     bits64 offset;		/* Offset to start of chrom in file */
+    bits64 *zoomOffsets;	/* Offset to start of chrom in each zoom level */
     };
 
 void cgbChromFree(struct cgbChrom **pChrom);
@@ -167,6 +178,8 @@ struct chromGraphBin
     struct cgbChrom *chromList;	/* List of chromosomes/positions */
     struct hash *chromHash;	/* Hash of all chromosomes/positions */
     double minVal, maxVal;	/* Min/max values in file */
+    int zoomCount;		/* Number of zoom levels. */
+    bits32 *zoomBinSizes;	/* Bin size of each zoom level, smallest first. */
     	/* Variables used when scanning through file. */
     char chrom[256];	/* Current chromosome. */
     bits32 chromStart;	/* Current position. */
@@ -188,6 +201,18 @@ boolean chromGraphBinNextVal(struct chromGraphBin *cgb);
 boolean chromGraphBinSeekToChrom(struct chromGraphBin *cgb, char *chromName);
 /* Seek to chromosome if have data for it.  Otherwise return FALSE. */
 
+int chromGraphBinZoomLevel(struct chromGraphBin *cgb, double basesPerPixel,
+	int maxGapToFill);
+/* Return the coarsest zoom level that still looks like the full data when drawn
+ * at basesPerPixel with lines across gaps up to maxGapToFill, or -1 if the full
+ * resolution data is needed. */
+
+boolean chromGraphBinSeekToChromZoom(struct chromGraphBin *cgb, char *chromName,
+	int zoomLevel);
+/* Seek to chromosome in zoomLevel, or in full resolution data if zoomLevel is
+ * -1, if have data for it.  Otherwise return FALSE.  chromGraphBinNextVal
+ * then returns the points of that level. */
+
 void chromGraphBinRewind(struct chromGraphBin *cgb);
 /* Position file pointer back to the first chromosome */
 
@@ -0,0 +1,100 @@
+/* genePredArray - hold many genePreds compactly, a column at a time.  Rather than a
+ * separately allocated struct, name, chrom and exon arrays for each transcript, each
+ * field is one array indexed by record number, the exon lists of all records share
+ * pools, chromosome and name2 strings are stored once each, and names are packed
+ * into local memory.  This is how to hold all of GENCODE or RefSeq at once without
+ * most of the memory going to malloc overhead.
+ *
+ * The arrays have the same names as the fields in struct genePred, so
+ * gp->txStart becomes gpa->txStart[ix].  The exon lists of record ix start at
+ * gpa->exonOffset[ix] in the exonStarts, exonEnds and exonFrames pools, and the
+ * genePredArrayExonStarts etc. macros return pointers to them.  genePredArrayGet
+ * fills in a struct genePred that points into the array for code that wants one.
+ *
+ * This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+
+#ifndef GENEPREDARRAY_H
+#define GENEPREDARRAY_H
+
+#ifndef GENEPRED_H
+#include "genePred.h"
+#endif
+
+#ifndef LOCALMEM_H
+#include "localmem.h"
+#endif
+
+#ifndef HASH_H
+#include "hash.h"
+#endif
+
+struct genePredArray
+/* Many genePreds stored a field at a time. */
+    {
+    struct genePredArray *next;	/* Next in list. */
+    int count;			/* Number of records. */
+    int alloc;			/* Allocated size of per-record arrays. */
+    unsigned optFields;		/* Optional fields present in any record. */
+    char **name;		/* Name of transcript. */
+    char **chrom;		/* Chromosome, shared by all records on it. */
+    char *strand;		/* + or - */
+    unsigned *txStart;		/* Transcription start position. */
+    unsigned *txEnd;		/* Transcription end position. */
+    unsigned *cdsStart;		/* Coding region start. */
+    unsigned *cdsEnd;		/* Coding region end. */
+    unsigned *exonCount;	/* Number of exons. */
+    int *exonOffset;		/* Where record's exons start in pools. */
+    unsigned char *recordOptFields;	/* Optional fields present in each record. */
+    int *score;			/* Score, NULL if no record has one. */
+    char **name2;		/* Secondary name, shared, NULL if no record has one. */
+    unsigned char *cdsStartStat;	/* enum cdsStatus, NULL if no record has one. */
+    unsigned char *cdsEndStat;	/* enum cdsStatus, NULL if no record has one. */
+    unsigned *exonStarts;	/* Pool of exon starts for all records. */
+    unsigned *exonEnds;		/* Pool of exon ends for all records. */
+    int *exonFrames;		/* Pool of exon frames, NULL if no record has them. */
+    int exonUsed;		/* Number of entries used in exon pools. */
+    int exonAlloc;		/* Allocated size of exon pools. */
+    struct hash *stringHash;	/* Chromosome and name2 strings, each stored once. */
+    struct lm *lm;		/* Names live here. */
+    };
+
+#define genePredArrayExonStarts(gpa, ix) ((gpa)->exonStarts + (gpa)->exonOffset[ix])
+/* Return exonStarts array of record ix. */
+
+#define genePredArrayExonEnds(gpa, ix) ((gpa)->exonEnds + (gpa)->exonOffset[ix])
+/* Return exonEnds array of record ix. */
+
+#define genePredArrayExonFrames(gpa, ix) ((gpa)->exonFrames + (gpa)->exonOffset[ix])
+/* Return exonFrames array of record ix.  Only valid if exonFrames is non-NULL. */
+
+struct genePredArray *genePredArrayNew(int sizeGuess);
+/* Return a new empty genePredArray.  sizeGuess is how many records to allocate room
+ * for at first, and may be 0. */
+
+void genePredArrayFree(struct genePredArray **pGpa);
+/* Free up genePredArray and everything in it. */
+
+int genePredArrayAddRow(struct genePredArray *gpa, char **row, int numCols);
+/* Parse a genePred or genePredExt row with numCols columns into a new record and
+ * return its index.  Optional columns follow the same rules as genePredExtLoad. */
+
+int genePredArrayAdd(struct genePredArray *gpa, struct genePred *gp);
+/* Copy gp into a new record and return its index. */
+
+struct genePredArray *genePredArrayLoadFile(char *fileName);
+/* Load all genePreds or genePredExts from a tab-separated file.  Dispose of this
+ * with genePredArrayFree(). */
+
+void genePredArrayGet(struct genePredArray *gpa, int ix, struct genePred *gp);
+/* Fill in gp from record ix.  The strings and exon arrays in gp point into gpa, so gp
+ * must not be freed with genePredFree, and must not be used after more records are
+ * added to gpa. */
+
+struct genePred *genePredArrayToGenePred(struct genePredArray *gpa, int ix);
+/* Return a separately allocated copy of record ix.  Free it with genePredFree. */
+
+void genePredArraySort(struct genePredArray *gpa);
+/* Sort records by chrom, then txStart. */
+
+#endif /* GENEPREDARRAY_H */
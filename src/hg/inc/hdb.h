@@ -333,6 +333,11 @@ struct dnaSeq *hDnaSeqGet(char *db, char *acc, char *seqTbl, char *extFileTbl);
  * override what is in db (which could even be NULL). Return NULL if not
  * found. */
 
+struct hash *hDnaSeqGetBatch(char *db, struct slName *accList, char *seqTbl, char *extFileTbl);
+/* Get the sequences of all accessions in accList from the specified seq and extFile tables,
+ * the same way hDnaSeqGet gets one.  Returns a hash of dnaSeqs keyed by the accessions as
+ * given in accList that leaves out ones that aren't found. */
+
 struct dnaSeq *hDnaSeqMustGet(char *db, char *acc, char *seqTbl, char *extFileTbl);
 /* Get a cDNA or DNA sequence from the specified seq and extFile tables.  The
  * seqTbl/extFileTbl arguments may include the database, in which case they
@@ -397,6 +402,13 @@ struct dnaSeq *hGenBankGetMrna(char *db, char *acc, char *compatTable);
 struct dnaSeq *hGenBankGetMrnaC(struct sqlConnection *conn, char *acc, char *compatTable);
 /* Same as above, but can pass in connection to any db */
 
+struct hash *hGenBankGetMrnaBatch(char *db, struct slName *accList, char *compatTable);
+/* Get the GenBank or RefSeq mRNA or EST sequences of all accessions in
+ * accList, the same way hGenBankGetMrna gets one.  Returns a hash of
+ * dnaSeqs keyed by the accessions as given in accList that leaves out ones
+ * that aren't found.  The seq tables are queried a few hundred accessions
+ * at a time and the external files are read in file and offset order. */
+
 aaSeq *hGenBankGetPep(char *db, char *acc, char *compatTable);
 /* Get a RefSeq peptide sequence or NULL if it doesn't exist.  This handles
  * compatibility between pre-incremental genbank databases where refSeq
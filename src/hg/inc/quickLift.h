@@ -6,14 +6,18 @@
 #ifndef QUICKLIFT_H      
 #define QUICKLIFT_H      
 
-struct bigBedInterval *quickLiftIntervals(char *instaPortFile, struct bbiFile *bbi,   char *chrom, int start, int end, struct hash **pChainHash);
+struct quickLiftChainSet;	/* Chains for a window, private to quickLift.c. */
+
+struct bigBedInterval *quickLiftIntervals(char *instaPortFile, struct bbiFile *bbi,   char *chrom, int start, int end, struct quickLiftChainSet **pChainSet);
 /* Return intervals from "other" species that will map to the current window.
  * These intervals are NOT YET MAPPED to the current assembly.
+ * The chains are loaded once per window and shared by all tracks using quickLiftFile,
+ * so *pChainSet must not be freed.  Pass it to quickLiftBed to map the intervals.
  */
 
-struct bed *quickLiftBed(struct bbiFile *bbi, struct hash *chainHash, struct bigBedInterval *bb);
-/* Using chains stored in chainHash, port a bigBedInterval from another assembly to a bed
- * on the reference.
+struct bed *quickLiftBed(struct bbiFile *bbi, struct quickLiftChainSet *set, struct bigBedInterval *bb);
+/* Using chains in set from quickLiftIntervals, port a bigBedInterval from another assembly
+ * to a bed on the reference.
  */
 
 unsigned quickLiftGetChain(char *fromDb, char *toDb);
@@ -4206,8 +4206,50 @@ var imageV2 = {
             imageV2.markAsDirtyPage();
     },
     
+    expandMapItems: function (scope)
+    {   // hgTracks may send image maps as compact json (see imageMapDrawJson in imageV2.c).
+        // Turn them into the AREA elements that the rest of the code expects.
+        var useMouseovers = (typeof showMouseovers !== 'undefined' && showMouseovers);
+        $(scope || document).find("map > script.mapItems").each(function () {
+            var map = this.parentNode;
+            var json = JSON.parse(this.textContent);
+            var strings = json.s;
+            var fragment = document.createDocumentFragment();
+            for (var ix = 0; ix < json.a.length; ix++) {
+                var item = json.a[ix];
+                var area = document.createElement('area');
+                area.shape = 'rect';
+                area.coords = item.slice(0, 4).join(',');
+                if (item[4] < 0) {
+                    area.className = 'area noLink';
+                } else {
+                    var link = strings[item[4]];
+                    if (item.length > 7) { // templated link
+                        link = link.split('{o}').join(item[7])
+                                   .split('{t}').join(item[8])
+                                   .split('{i}').join(item[9]);
+                    }
+                    area.setAttribute('href', link);
+                    area.className = 'area';
+                }
+                if (item[5] >= 0) {
+                    var title = strings[item[5]];
+                    if (!useMouseovers)
+                        title = title.split('<br>').join('\u2028');
+                    area.title = title;
+                }
+                if (item[6] >= 0)
+                    area.id = strings[item[6]];
+                fragment.appendChild(area);
+            }
+            map.removeChild(this);
+            map.appendChild(fragment);
+        });
+    },
+
     afterReload: function (id)
     {   // Reload various UI widgets after updating imgTbl map.
+        imageV2.expandMapItems(imageV2.imgTbl);
         dragReorder.init();
         dragSelect.load(false);
         // Do NOT reload context menu (otherwise we get the "context menu sticks" problem).
@@ -4253,6 +4295,7 @@ var imageV2 = {
             var tr = $(document.getElementById("tr_" + id));
             if (tr.length > 0) {
                 $(tr).html(newTr.children());
+                imageV2.expandMapItems(tr);
 
                 // Need to update tr class list too
                 var classes = $(html).find("tr[id='tr_"+ id + "']")[0].className;
@@ -5713,6 +5756,7 @@ var downloadCurrentTrackData = {
 $(document).ready(function()
 {
     imageV2.moveTiming();
+    imageV2.expandMapItems();
 
     // hg.conf will turn this on 2020-10 - Hiram
     if (window.mouseOverEnabled) { mouseOver.addListener(); }
@@ -9,6 +9,10 @@
 #include "hdb.h"
 #include "errCatch.h"
 #include "bigBedLabel.h"
+#include "hgConfig.h"
+#include "udc.h"
+#include "pthreadWrap.h"
+#include "pthreadDoList.h"
 #include "bigBedFind.h"
 
 static struct hgPos *bigBedIntervalListToHgPositions(struct cart *cart, struct trackDb *tdb,
@@ -85,10 +89,10 @@ if (errCatch->gotError)
 return posList;
 }
 
-static struct hgPos *doTrixSearch(struct cart *cart, struct trackDb *tdb, char *trixFile,
-                        struct slName *indices, struct bbiFile *bbi, char *term, char *description,
-                        struct hgFindSpec *hfs)
-/* search a trix file in the "searchTrix" field of a bigBed trackDb */
+static struct trixSearchResult *doTrixSearch(char *trixFile, char *term, struct hgFindSpec *hfs)
+/* search a trix file in the "searchTrix" field of a bigBed trackDb, adding snippets to
+ * the results if the search spec asks for them.  The trix library has global state, so
+ * only one thread at a time may call this. */
 {
 struct trix *trix = trixOpen(trixFile);
 int trixWordCount = 0;
@@ -114,18 +118,25 @@ struct trixSearchResult *tsList = trixSearch(trix, trixWordCount, trixWords, tsm
 char *context = NULL;
 if (hfs)
     context = hgFindSpecSetting(hfs, "searchTrixContext");
-boolean doSnippets = FALSE;
 if (context && sameString(context, "on"))
     {
-    doSnippets = TRUE;
     initSnippetIndex(trix);
+    struct trixSearchResult *ts;
+    for (ts = tsList; ts != NULL; ts = ts->next)
+        addSnippetForResult(ts, trix);
     }
+return tsList;
+}
+
+static struct hgPos *trixResultsToPos(struct cart *cart, struct trackDb *tdb,
+                        struct trixSearchResult *tsList, struct slName *indices,
+                        struct bbiFile *bbi, struct hgFindSpec *hfs)
+/* Look up the items found by a trix search in the bigBed indexes. */
+{
 struct hgPos *posList = NULL;
 for ( ; tsList != NULL; tsList = tsList->next)
     {
     struct slName *oneIndex = indices;
-    if (doSnippets)
-        addSnippetForResult(tsList, trix);
     for (; oneIndex; oneIndex = oneIndex->next)
 	{
 	struct hgPos *posList2 = getPosFromBigBed(cart, tdb, bbi, oneIndex->name,
@@ -159,24 +170,40 @@ return diff;
 
 
 
-boolean findBigBedPosInTdb(struct cart *cart, char *db, struct trackDb *tdb, char *term, struct hgPositions *hgp, struct hgFindSpec *hfs, boolean measureTiming)
-/* Find a position in a single trackDb entry */
+struct bigBedSearch
+/* A bigBed track to look for a term in, and what was found there. */
+    {
+    struct bigBedSearch *next;
+    struct trackDb *tdb;	/* Track to search. */
+    char *description;		/* Description of results from search spec, may be NULL. */
+    char *indexField;		/* Comma separated list of indexes, NULL to use name index. */
+    char *fileName;		/* bigBed file or URL. */
+    struct hgPosTable *table;	/* Results, NULL if nothing found. */
+    int posCount;		/* Number of positions in table. */
+    char *trixError;		/* Message if trix search failed, reported after the fan-out. */
+    boolean done;		/* Set when search is finished or skipped. */
+    };
+
+struct bigBedSearchContext
+/* What all the searches of one term share. */
+    {
+    struct cart *cart;		/* Used for item labels. */
+    char *term;			/* What to search for. */
+    struct hgFindSpec *hfs;	/* Search spec, may be NULL. */
+    boolean measureTiming;	/* If TRUE set searchTime in results. */
+    long timeBudget;		/* Milliseconds each search gets, 0 for no limit. */
+    int limitResults;		/* Stop after this many positions, 0 or less for no limit. */
+    struct bigBedSearch *searchList;	/* All searches in the order results are merged. */
+    pthread_mutex_t mutex;	/* Protects done and posCount of searches. */
+    };
+
+static struct bigBedSearch *bigBedSearchNew(char *db, struct trackDb *tdb,
+                                            struct hgFindSpec *hfs)
+/* Return a search of tdb, or NULL if tdb can't be searched.  Anything that needs
+ * the database or modifies shared structures is done here rather than in the threads. */
 {
 if (startsWith("bigWig", tdb->type) || !startsWith("big", tdb->type))
-    return FALSE;
-long startTime = clock1000();
-boolean found = FALSE;
-char *description = NULL;
-
-if (hfs)
-    {
-    char buf[2048];
-    if (isNotEmpty(hfs->searchDescription))
-        truncatef(buf, sizeof(buf), "%s", hfs->searchDescription);
-    else
-        safef(buf, sizeof(buf), "%s", hfs->searchTable);
-    description = cloneString(buf);
-    }
+    return NULL;
 
 // Which field(s) to search?  Look for searchIndex in search spec, then in trackDb for
 // backwards compat.
@@ -186,9 +213,9 @@ if (hfs)
 if (!indexField)
     indexField = trackDbSetting(tdb, "searchIndex");
 if (!indexField && !hfs)
-    return FALSE;
+    return NULL;
 
-// If !indexField but we do have a non-NULL hfs, then open file to see if it has a name index.
+// If !indexField but we do have a non-NULL hfs, then the file is checked for a name index later.
 char *fileName = trackDbSetting(tdb, "bigDataUrl");
 if (!fileName && !trackHubDatabase(db))
     {
@@ -197,98 +224,268 @@ if (!fileName && !trackHubDatabase(db))
     hFreeConn(&conn);
     }
 if (!fileName)
-    return FALSE;
-// we fail silently if bigBed can't be opened.
-struct bbiFile *bbi = NULL;
-struct errCatch *errCatch = errCatchNew();
-if (errCatchStart(errCatch))
+    return NULL;
+
+struct bigBedSearch *search;
+AllocVar(search);
+search->tdb = tdb;
+search->indexField = indexField;
+search->fileName = fileName;
+if (hfs)
     {
-    bbi = bigBedFileOpen(fileName);
+    char buf[2048];
+    if (isNotEmpty(hfs->searchDescription))
+        truncatef(buf, sizeof(buf), "%s", hfs->searchDescription);
+    else
+        safef(buf, sizeof(buf), "%s", hfs->searchTable);
+    search->description = cloneString(buf);
     }
-errCatchEnd(errCatch);
-if (errCatch->gotError)
-    return FALSE;
 
-// Now (since hfs is non-NULL) check the file to see if it has a name index if we
-// don't already have indexField.
-if (!indexField)
+// Settings hashes are built on first use, so build them now for anything the
+// threads will look at.
+struct trackDb *parent;
+for (parent = tdb; parent != NULL; parent = parent->parent)
+    trackDbHashSettings(parent);
+return search;
+}
+
+static void bigBedSearchFree(struct bigBedSearch **pSearch)
+/* Free up a bigBedSearch, but not the results it found. */
+{
+struct bigBedSearch *search = *pSearch;
+if (search != NULL)
     {
-    struct slName *indexFields = bigBedListExtraIndexes(bbi);
-    if (slNameInList(indexFields, "name"))
-        indexField = "name";
-    slNameFreeList(&indexFields);
+    freeMem(search->description);
+    freeMem(search->trixError);
+    freez(pSearch);
     }
-if (!indexField)
-    {
-    bigBedFileClose(&bbi);
+}
+
+static boolean bigBedSearchPastLimit(struct bigBedSearchContext *bsc)
+/* Return TRUE if the searches that finished ahead of the first unfinished one
+ * already found all the results that will be used. */
+{
+if (bsc->limitResults <= 0)
     return FALSE;
+boolean pastLimit = FALSE;
+int posCount = 0;
+struct bigBedSearch *search;
+pthreadMutexLock(&bsc->mutex);
+for (search = bsc->searchList; search != NULL && search->done; search = search->next)
+    {
+    posCount += search->posCount;
+    if (posCount >= bsc->limitResults)
+        {
+        pastLimit = TRUE;
+        break;
+        }
     }
+pthreadMutexUnlock(&bsc->mutex);
+return pastLimit;
+}
+
+static boolean overBudget(long startTime, struct bigBedSearchContext *bsc)
+/* Return TRUE if a search that started at startTime has used up its time. */
+{
+return bsc->timeBudget > 0 && clock1000() - startTime > bsc->timeBudget;
+}
+
+static void bigBedSearchRun(void *item, void *context)
+/* Look for term in one bigBed.  Called by pthreadDoList, so errors are caught here
+ * and nothing shared is written outside the mutex. */
+{
+static pthread_mutex_t trixMutex = PTHREAD_MUTEX_INITIALIZER;
+struct bigBedSearch *search = item;
+struct bigBedSearchContext *bsc = context;
+struct trackDb *tdb = search->tdb;
+long startTime = clock1000();
+struct hgPos *posList = NULL;
 
-struct slName *indexList = slNameListFromString(indexField, ',');
-struct hgPos *posList1 = NULL, *posList2 = NULL;
-char *trixFile = trackDbSetting(tdb, "searchTrix");
-// if there is a trix file, use it to search for the term
-if (trixFile != NULL)
+if (!bigBedSearchPastLimit(bsc))
     {
+    // we fail silently if bigBed can't be opened.
+    struct bbiFile *bbi = NULL;
     struct errCatch *errCatch = errCatchNew();
     if (errCatchStart(errCatch))
         {
-        posList1 = doTrixSearch(cart, tdb, hReplaceGbdb(trixFile), indexList, bbi, term,
-                                NULL, hfs);
+        bbi = bigBedFileOpen(search->fileName);
         }
     errCatchEnd(errCatch);
-    if (errCatch->gotError)
-        warn("trix search failure for %s: %s", tdb->table, dyStringContents(errCatch->message));
     errCatchFree(&errCatch);
-    }
 
-// now search for the raw id's
-struct slName *oneIndex=indexList;
-for (; oneIndex; oneIndex = oneIndex->next)
-    {
-    posList2 = getPosFromBigBed(cart, tdb, bbi, oneIndex->name, term, NULL, hfs);
-    posList1 = slCat(posList1, posList2);
+    // If we don't already have indexField check the file to see if it has a name index.
+    char *indexField = search->indexField;
+    if (bbi != NULL && !indexField)
+        {
+        struct slName *indexFields = bigBedListExtraIndexes(bbi);
+        if (slNameInList(indexFields, "name"))
+            indexField = "name";
+        slNameFreeList(&indexFields);
+        }
+    if (bbi != NULL && indexField)
+        {
+        struct slName *indexList = slNameListFromString(indexField, ',');
+        char *trixFile = trackDbSetting(tdb, "searchTrix");
+        // if there is a trix file, use it to search for the term.  The trix
+        // library has global state so only one thread at a time uses it.
+        if (trixFile != NULL && !overBudget(startTime, bsc))
+            {
+            struct trixSearchResult *tsList = NULL;
+            struct errCatch *errCatch = errCatchNew();
+            pthreadMutexLock(&trixMutex);
+            if (errCatchStart(errCatch))
+                tsList = doTrixSearch(hReplaceGbdb(trixFile), bsc->term, bsc->hfs);
+            errCatchEnd(errCatch);
+            pthreadMutexUnlock(&trixMutex);
+            if (!errCatch->gotError)
+                {
+                errCatchFree(&errCatch);
+                errCatch = errCatchNew();
+                if (errCatchStart(errCatch))
+                    posList = trixResultsToPos(bsc->cart, tdb, tsList, indexList, bbi, bsc->hfs);
+                errCatchEnd(errCatch);
+                }
+            if (errCatch->gotError)
+                search->trixError = cloneString(dyStringContents(errCatch->message));
+            errCatchFree(&errCatch);
+            }
+
+        // now search for the raw id's
+        struct slName *oneIndex;
+        for (oneIndex = indexList; oneIndex; oneIndex = oneIndex->next)
+            {
+            if (overBudget(startTime, bsc))
+                break;
+            struct hgPos *posList2 = getPosFromBigBed(bsc->cart, tdb, bbi, oneIndex->name,
+                                                      bsc->term, NULL, bsc->hfs);
+            posList = slCat(posList, posList2);
+            }
+        // the trix search and the id search may have found the same item so uniqify:
+        slUniqify(&posList, posListCompare, hgPosFree);
+        slNameFreeList(&indexList);
+        }
+    bigBedFileClose(&bbi);
     }
-// the trix search and the id search may have found the same item so uniqify:
-slUniqify(&posList1, posListCompare, hgPosFree);
 
-if (posList1 != NULL)
+if (posList != NULL)
     {
     struct hgPosTable *table;
-
-    found = TRUE;
     AllocVar(table);
-    slAddHead(&hgp->tableList, table);
-    table->description = cloneString(description ? description : tdb->longLabel);
+    table->description = cloneString(search->description ? search->description : tdb->longLabel);
     table->name = cloneString(tdb->table);
     table->searchTime = -1;
-        if (measureTiming)
-            table->searchTime = clock1000() - startTime;
-
-    table->posList = posList1;
+    if (bsc->measureTiming)
+        table->searchTime = clock1000() - startTime;
+    table->posList = posList;
+    search->table = table;
     }
-bigBedFileClose(&bbi);
-freeMem(description);
-return found;
+pthreadMutexLock(&bsc->mutex);
+search->posCount = slCount(posList);
+search->done = TRUE;
+pthreadMutexUnlock(&bsc->mutex);
 }
 
-boolean findBigBedPosInTdbList(struct cart *cart, char *db, struct trackDb *tdbList, char *term, struct hgPositions *hgp, struct hgFindSpec *hfs, boolean measureTiming)
-/* Given a list of trackDb entries, check each of them for a searchIndex */
+static struct bigBedSearch *bigBedSearchList(char *db, struct trackDb *tdbList,
+                                             struct hgFindSpec *hfs)
+/* Return searches for all searchable tracks and subtracks in tdbList, last track first. */
 {
+struct bigBedSearch *searchList = NULL;
 struct trackDb *tdb;
-boolean found = FALSE;
 for (tdb = tdbList; tdb; tdb = tdb->next)
     {
     if (tdb->subtracks)
         {
-        found = findBigBedPosInTdbList(cart, db, tdb->subtracks, term, hgp, hfs, measureTiming) || found;
+        searchList = slCat(bigBedSearchList(db, tdb->subtracks, hfs), searchList);
         continue;
         }
-    found = findBigBedPosInTdb(cart, db, tdb, term, hgp, hfs, measureTiming) || found;
+    struct bigBedSearch *search = bigBedSearchNew(db, tdb, hfs);
+    if (search != NULL)
+        slAddHead(&searchList, search);
     }
+return searchList;
+}
+
+static boolean bigBedSearchDo(struct cart *cart, struct bigBedSearch *searchList, char *term,
+                              struct hgPositions *hgp, struct hgFindSpec *hfs,
+                              boolean measureTiming, int limitResults)
+/* Run all searches in searchList, several at a time, and add what they find to hgp in
+ * searchList order.  Once limitResults positions are in hgp (if limitResults > 0)
+ * the rest are not searched or are left out. Frees searchList. */
+{
+if (searchList == NULL)
+    return FALSE;
+struct bigBedSearchContext bsc;
+ZeroVar(&bsc);
+bsc.cart = cart;
+bsc.term = term;
+bsc.hfs = hfs;
+bsc.measureTiming = measureTiming;
+bsc.timeBudget = atol(cfgOptionDefault("hgFind.sourceTimeBudget", "0"));
+bsc.limitResults = limitResults;
+bsc.searchList = searchList;
+pthreadMutexInit(&bsc.mutex);
+
+// Settings and defaults that are set up on first use are set up here, before the threads.
+if (hfs)
+    hgFindSpecSetting(hfs, "padding");
+udcDefaultDir();
+
+int threadCount = atoi(cfgOptionDefault("hgFind.searchThreads", "8"));
+threadCount = max(1, min(threadCount, slCount(searchList)));
+threadCount = min(threadCount, 256);
+if (threadCount == 1)
+    {
+    struct bigBedSearch *search;
+    for (search = searchList; search != NULL; search = search->next)
+        bigBedSearchRun(search, &bsc);
+    }
+else
+    pthreadDoList(threadCount, searchList, bigBedSearchRun, &bsc);
+
+// Merge in the same order the searches used to run one after the other.
+boolean found = FALSE;
+int posCount = 0;
+struct bigBedSearch *search, *next;
+for (search = searchList; search != NULL; search = next)
+    {
+    next = search->next;
+    if (search->trixError)
+        warn("trix search failure for %s: %s", search->tdb->table, search->trixError);
+    if (search->table != NULL && (limitResults <= 0 || posCount < limitResults))
+        {
+        slAddHead(&hgp->tableList, search->table);
+        posCount += search->posCount;
+        found = TRUE;
+        }
+    bigBedSearchFree(&search);
+    }
+pthreadMutexDestroy(&bsc.mutex);
 return found;
 }
 
+boolean findBigBedPosInTdb(struct cart *cart, char *db, struct trackDb *tdb, char *term, struct hgPositions *hgp, struct hgFindSpec *hfs, boolean measureTiming)
+/* Find a position in a single trackDb entry */
+{
+return bigBedSearchDo(cart, bigBedSearchNew(db, tdb, hfs), term, hgp, hfs, measureTiming, 0);
+}
+
+boolean findBigBedPosInTdbListLimit(struct cart *cart, char *db, struct trackDb *tdbList, char *term, struct hgPositions *hgp, struct hgFindSpec *hfs, boolean measureTiming, int limitResults)
+/* Given a list of trackDb entries, check each of them for a searchIndex.  The tracks are
+ * searched several at a time, see hgFind.searchThreads and hgFind.sourceTimeBudget in
+ * hg.conf, but results are added to hgp in list order.  Tracks past the point where
+ * limitResults positions are found are skipped if limitResults > 0. */
+{
+struct bigBedSearch *searchList = bigBedSearchList(db, tdbList, hfs);
+slReverse(&searchList);
+return bigBedSearchDo(cart, searchList, term, hgp, hfs, measureTiming, limitResults);
+}
+
+boolean findBigBedPosInTdbList(struct cart *cart, char *db, struct trackDb *tdbList, char *term, struct hgPositions *hgp, struct hgFindSpec *hfs, boolean measureTiming)
+/* Given a list of trackDb entries, check each of them for a searchIndex */
+{
+return findBigBedPosInTdbListLimit(cart, db, tdbList, term, hgp, hfs, measureTiming, 0);
+}
+
 boolean isTdbSearchable(struct trackDb *tdb)
 /* Check if a single tdb is searchable */
 {
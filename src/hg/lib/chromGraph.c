@@ -322,6 +322,7 @@ struct cgbChrom *chrom = *pChrom;
 if (chrom != NULL)
     {
     freeMem(chrom->name);
+    freeMem(chrom->zoomOffsets);
     freez(pChrom);
     }
 }
@@ -384,6 +385,165 @@ slReverse(&ciList);
 return ciList;
 }
 
+struct cgPoint
+/* A position and value, used for zoom levels. */
+    {
+    bits32 pos;		/* Position in chromosome. */
+    double val;		/* Value there. */
+    };
+
+struct cgZoom
+/* A zoom level while building binary file. */
+    {
+    struct cgZoom *next;
+    bits32 binSize;		/* Size of bins. */
+    struct cgPoint **points;	/* Points for each chromosome. */
+    int *counts;		/* Number of points for each chromosome. */
+    bits64 *offsets;		/* Offset to start of each chrom in file. */
+    };
+
+static int cgZoomBin(struct cgPoint *in, int inCount, bits32 binSize, struct cgPoint *out)
+/* Put the first, lowest, highest and last points of each bin of in into out,
+ * in position order, and return how many there are. */
+{
+int outCount = 0;
+int binStart = 0;
+while (binStart < inCount)
+    {
+    bits32 bin = in[binStart].pos/binSize;
+    int binEnd, minIx = binStart, maxIx = binStart;
+    for (binEnd = binStart+1; binEnd < inCount && in[binEnd].pos/binSize == bin; ++binEnd)
+	{
+	if (in[binEnd].val < in[minIx].val)
+	    minIx = binEnd;
+	if (in[binEnd].val > in[maxIx].val)
+	    maxIx = binEnd;
+	}
+    int lastIx = binEnd-1;
+    int i;
+    for (i=binStart; i<=lastIx; ++i)
+	{
+	if (i == binStart || i == minIx || i == maxIx || i == lastIx)
+	    out[outCount++] = in[i];
+	}
+    binStart = binEnd;
+    }
+return outCount;
+}
+
+static struct cgZoom *cgZoomNew(bits32 binSize, int chromCount)
+/* Allocate zoom level with room for chromCount chromosomes. */
+{
+struct cgZoom *zoom;
+AllocVar(zoom);
+zoom->binSize = binSize;
+AllocArray(zoom->points, chromCount);
+AllocArray(zoom->counts, chromCount);
+AllocArray(zoom->offsets, chromCount);
+return zoom;
+}
+
+static void cgZoomFree(struct cgZoom **pZoom, int chromCount)
+/* Free up a zoom level. */
+{
+struct cgZoom *zoom = *pZoom;
+if (zoom != NULL)
+    {
+    int i;
+    for (i=0; i<chromCount; ++i)
+	freeMem(zoom->points[i]);
+    freeMem(zoom->points);
+    freeMem(zoom->counts);
+    freeMem(zoom->offsets);
+    freez(pZoom);
+    }
+}
+
+static void cgZoomFreeList(struct cgZoom **pList, int chromCount)
+/* Free up list of zoom levels. */
+{
+struct cgZoom *zoom, *next;
+for (zoom = *pList; zoom != NULL; zoom = next)
+    {
+    next = zoom->next;
+    cgZoomFree(&zoom, chromCount);
+    }
+*pList = NULL;
+}
+
+static struct cgZoom *cgZoomMake(struct cInfo *ciList, int chromCount)
+/* Make zoom levels for chromosomes in ciList.  Levels that are not at least
+ * twice as small as the last one kept are not worth keeping, though bigger
+ * bins after them may be. */
+{
+struct cgZoom *zoomList = NULL;
+struct cgZoom *prev = cgZoomNew(0, chromCount);
+boolean prevKept = FALSE;
+long long keptCount = 0;
+struct cInfo *ci;
+int i;
+
+/* Make full resolution points to start with. */
+for (ci = ciList, i = 0; ci != NULL; ci = ci->next, ++i)
+    {
+    struct chromGraph *el;
+    int count = 0;
+    for (el = ci->start; el != ci->end; el = el->next)
+	++count;
+    AllocArray(prev->points[i], count);
+    for (el = ci->start, count = 0; el != ci->end; el = el->next, ++count)
+	{
+	prev->points[i][count].pos = el->chromStart;
+	prev->points[i][count].val = el->val;
+	}
+    prev->counts[i] = count;
+    keptCount += count;
+    }
+
+/* Bins of each level are made of whole bins of the level before, so each level
+ * can be made from the one before even when that one is not kept. */
+bits32 binSize = chromGraphZoomFirstBinSize;
+int levelIx;
+for (levelIx = 0; levelIx < chromGraphMaxZoomLevels; ++levelIx)
+    {
+    struct cgZoom *zoom = cgZoomNew(binSize, chromCount);
+    long long totalCount = 0;
+    for (i=0; i<chromCount; ++i)
+	{
+	AllocArray(zoom->points[i], prev->counts[i]);
+	zoom->counts[i] = cgZoomBin(prev->points[i], prev->counts[i], binSize, zoom->points[i]);
+	totalCount += zoom->counts[i];
+	}
+    if (!prevKept)
+	cgZoomFree(&prev, chromCount);
+    prevKept = (totalCount*2 <= keptCount);
+    if (prevKept)
+	{
+	slAddHead(&zoomList, zoom);
+	keptCount = totalCount;
+	}
+    prev = zoom;
+    binSize *= chromGraphZoomFactor;
+    }
+if (!prevKept)
+    cgZoomFree(&prev, chromCount);
+slReverse(&zoomList);
+return zoomList;
+}
+
+static void writeZoomIndex(FILE *f, struct cgZoom *zoomList, int chromCount)
+/* Write bin size and chromosome offsets of each zoom level. */
+{
+struct cgZoom *zoom;
+for (zoom = zoomList; zoom != NULL; zoom = zoom->next)
+    {
+    int i;
+    writeOne(f, zoom->binSize);
+    for (i=0; i<chromCount; ++i)
+	msbFirstWriteBits64(f, zoom->offsets[i]);
+    }
+}
+
 void chromGraphToBinGetMinMax(struct chromGraph *list, char *fileName,
 	double *retMin, double *retMax)
 /* Create binary representation of chromGraph list, which should
@@ -403,9 +563,11 @@ bits32 sig = chromGraphSig;
 bits32 endMarker = (bits32)(-1);
 struct cInfo *ci, *ciList = cInfoMake(list, fileName);
 bits32 chromCount = slCount(ciList);
+struct cgZoom *zoom, *zoomList = cgZoomMake(ciList, chromCount);
+bits32 zoomCount = slCount(zoomList);
 fpos_t indexPos;
 double minVal, maxVal;
-bits32 reserved1=0, reserved2=0, reserved3=0, reserved4=0;
+bits32 reserved2=0, reserved3=0, reserved4=0;
 
 /* Start out with file signature and chromosome count */
 writeOne(f, sig);
@@ -416,19 +578,40 @@ chromGraphGetMinMax(list, &minVal, &maxVal);
 writeOne(f, minVal);
 writeOne(f, maxVal);
 
-/* Write out reserved (currently zero) words */
-writeOne(f, reserved1);
+/* Write zoom level count, which was a reserved zero word in older files,
+ * and remaining reserved (currently zero) words */
+writeOne(f, zoomCount);
 writeOne(f, reserved2);
 writeOne(f, reserved3);
 writeOne(f, reserved4);
 
-/* Write preliminary version of index, with offsets not filled in */
+/* Write preliminary version of index and zoom index, with offsets not filled in */
 fgetpos(f, &indexPos);
 for (ci = ciList; ci != NULL; ci = ci->next)
     {
     writeString(f, ci->name);
     msbFirstWriteBits64(f, ci->offset);
     }
+writeZoomIndex(f, zoomList, chromCount);
+
+/* Write zoom levels, in the same format as the data.  These go before the data
+ * so that reading chromosomes in order from the first one reads just the data. */
+for (zoom = zoomList; zoom != NULL; zoom = zoom->next)
+    {
+    int i;
+    for (ci = ciList, i = 0; ci != NULL; ci = ci->next, ++i)
+	{
+	int j;
+	zoom->offsets[i] = ftell(f);
+	writeString(f, ci->name);
+	for (j=0; j<zoom->counts[i]; ++j)
+	    {
+	    writeOne(f, zoom->points[i][j].pos);
+	    writeOne(f, zoom->points[i][j].val);
+	    }
+	writeOne(f, endMarker);
+	}
+    }
 
 /* Write data. */
 for (ci = ciList; ci  != NULL; ci = ci->next)
@@ -457,10 +640,12 @@ for (ci = ciList; ci != NULL; ci = ci->next)
     writeString(f, ci->name);
     msbFirstWriteBits64(f, ci->offset);
     }
+writeZoomIndex(f, zoomList, chromCount);
 carefulClose(&f);
 carefulClose(&m);
 if (cgmCount < 1)
     remove(cgmName);
+cgZoomFreeList(&zoomList, chromCount);
 slFreeList(&ciList);
 
 /* Save return variables */
@@ -486,7 +671,7 @@ bits32 sig;
 bits32 chromCount, i;
 boolean isSwapped = FALSE;
 struct cgbChrom *chrom;
-bits32 reserved1, reserved2, reserved3, reserved4;
+bits32 zoomCount, reserved2, reserved3, reserved4;
 
 /* Read in signature and use it to make sure it's the right type
  * of file, and to tell if we need to swap bytes on integers. */
@@ -515,8 +700,10 @@ if (isSwapped)
 mustReadOne(f, cgb->minVal);
 mustReadOne(f, cgb->maxVal);
 
-/* Read in reserved (currently zero) words */
-mustReadOne(f, reserved1);
+/* Read in zoom level count and reserved (currently zero) words */
+mustReadOne(f, zoomCount);
+if (isSwapped)
+    zoomCount = byteSwap32(zoomCount);
 mustReadOne(f, reserved2);
 mustReadOne(f, reserved3);
 mustReadOne(f, reserved4);
@@ -531,20 +718,72 @@ for (i=0; i<chromCount; ++i)
     hashAdd(cgb->chromHash, chrom->name, chrom);
     }
 slReverse(&cgb->chromList);
+
+/* Read zoom index. */
+cgb->zoomCount = zoomCount;
+AllocArray(cgb->zoomBinSizes, zoomCount);
+for (chrom = cgb->chromList; chrom != NULL; chrom = chrom->next)
+    AllocArray(chrom->zoomOffsets, zoomCount);
+for (i=0; i<zoomCount; ++i)
+    {
+    mustReadOne(f, cgb->zoomBinSizes[i]);
+    if (isSwapped)
+	cgb->zoomBinSizes[i] = byteSwap32(cgb->zoomBinSizes[i]);
+    for (chrom = cgb->chromList; chrom != NULL; chrom = chrom->next)
+	chrom->zoomOffsets[i] = msbFirstReadBits64(f);
+    }
+
+/* Zoom levels come before data, so position file at first chromosome's data. */
+if (cgb->chromList != NULL)
+    chromGraphBinRewind(cgb);
 return cgb;
 }
 
-boolean chromGraphBinSeekToChrom(struct chromGraphBin *cgb, char *chromName)
-/* Seek to chromosome if have data for it.  Otherwise return FALSE. */
+boolean chromGraphBinSeekToChromZoom(struct chromGraphBin *cgb, char *chromName,
+	int zoomLevel)
+/* Seek to chromosome in zoomLevel, or in full resolution data if zoomLevel is
+ * -1, if have data for it.  Otherwise return FALSE.  chromGraphBinNextVal
+ * then returns the points of that level. */
 {
 struct cgbChrom *chrom = hashFindVal(cgb->chromHash, chromName);
 if (chrom == NULL)
     return FALSE;
-fseek(cgb->f, chrom->offset, SEEK_SET);
+if (zoomLevel >= cgb->zoomCount)
+    errAbort("Zoom level %d out of range in %s, which has %d", zoomLevel,
+	cgb->fileName, cgb->zoomCount);
+fseek(cgb->f, (zoomLevel < 0 ? chrom->offset : chrom->zoomOffsets[zoomLevel]), SEEK_SET);
 chromGraphBinNextChrom(cgb);
 return TRUE;
 }
 
+boolean chromGraphBinSeekToChrom(struct chromGraphBin *cgb, char *chromName)
+/* Seek to chromosome if have data for it.  Otherwise return FALSE. */
+{
+return chromGraphBinSeekToChromZoom(cgb, chromName, -1);
+}
+
+int chromGraphBinZoomLevel(struct chromGraphBin *cgb, double basesPerPixel,
+	int maxGapToFill)
+/* Return the coarsest zoom level that still looks like the full data when drawn
+ * at basesPerPixel with lines across gaps up to maxGapToFill, or -1 if the full
+ * resolution data is needed. */
+{
+/* Bins need to be a good bit smaller than a pixel, so that the lowest and
+ * highest points in a pixel are never just in the bin next door.  They also
+ * can be no bigger than maxGapToFill.  Each bin keeps its first and last points,
+ * so gaps between bins are the same as in the full data, and gaps inside a bin
+ * are smaller than the bin, so the same points get joined by lines. */
+int level = -1;
+int i;
+for (i=0; i<cgb->zoomCount; ++i)
+    {
+    if (cgb->zoomBinSizes[i] * 2.0 <= basesPerPixel
+     && cgb->zoomBinSizes[i] <= maxGapToFill)
+	level = i;
+    }
+return level;
+}
+
 void chromGraphBinRewind(struct chromGraphBin *cgb)
 /* Position file pointer back to the first chromosome */
 {
@@ -561,6 +800,7 @@ if (cgb != NULL)
      freeMem(cgb->fileName);
      hashFree(&cgb->chromHash);
      cgbChromFreeList(&cgb->chromList);
+     freeMem(cgb->zoomBinSizes);
      freez(pCgb);
      }
 }
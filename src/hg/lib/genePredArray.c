@@ -0,0 +1,392 @@
+/* genePredArray - hold many genePreds compactly, a column at a time.
+ *
+ * This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+
+#include "common.h"
+#include "hash.h"
+#include "localmem.h"
+#include "linefile.h"
+#include "sqlNum.h"
+#include "sqlList.h"
+#include "genePred.h"
+#include "genePredArray.h"
+
+#define growArray(array, oldCount, newCount) \
+    (array = needLargeMemResize(array, (newCount)*sizeof((array)[0])))
+/* Like ExpandArray, but lets realloc move big arrays without copying, and doesn't
+ * zero the new part, so memory isn't touched until records are added. */
+
+struct genePredArray *genePredArrayNew(int sizeGuess)
+/* Return a new empty genePredArray.  sizeGuess is how many records to allocate room
+ * for at first, and may be 0. */
+{
+struct genePredArray *gpa;
+AllocVar(gpa);
+gpa->alloc = max(sizeGuess, 64);
+int n = gpa->alloc;
+AllocArray(gpa->name, n);
+AllocArray(gpa->chrom, n);
+AllocArray(gpa->strand, n);
+AllocArray(gpa->txStart, n);
+AllocArray(gpa->txEnd, n);
+AllocArray(gpa->cdsStart, n);
+AllocArray(gpa->cdsEnd, n);
+AllocArray(gpa->exonCount, n);
+AllocArray(gpa->exonOffset, n);
+AllocArray(gpa->recordOptFields, n);
+gpa->exonAlloc = 8*n;
+AllocArray(gpa->exonStarts, gpa->exonAlloc);
+AllocArray(gpa->exonEnds, gpa->exonAlloc);
+gpa->stringHash = hashNew(12);
+gpa->lm = lmInit(0);
+return gpa;
+}
+
+void genePredArrayFree(struct genePredArray **pGpa)
+/* Free up genePredArray and everything in it. */
+{
+struct genePredArray *gpa = *pGpa;
+if (gpa != NULL)
+    {
+    freeMem(gpa->name);
+    freeMem(gpa->chrom);
+    freeMem(gpa->strand);
+    freeMem(gpa->txStart);
+    freeMem(gpa->txEnd);
+    freeMem(gpa->cdsStart);
+    freeMem(gpa->cdsEnd);
+    freeMem(gpa->exonCount);
+    freeMem(gpa->exonOffset);
+    freeMem(gpa->recordOptFields);
+    freeMem(gpa->score);
+    freeMem(gpa->name2);
+    freeMem(gpa->cdsStartStat);
+    freeMem(gpa->cdsEndStat);
+    freeMem(gpa->exonStarts);
+    freeMem(gpa->exonEnds);
+    freeMem(gpa->exonFrames);
+    hashFree(&gpa->stringHash);
+    lmCleanup(&gpa->lm);
+    freez(pGpa);
+    }
+}
+
+static void expandRecords(struct genePredArray *gpa)
+/* Double the room for records. */
+{
+int oldAlloc = gpa->alloc, newAlloc = 2*oldAlloc;
+growArray(gpa->name, oldAlloc, newAlloc);
+growArray(gpa->chrom, oldAlloc, newAlloc);
+growArray(gpa->strand, oldAlloc, newAlloc);
+growArray(gpa->txStart, oldAlloc, newAlloc);
+growArray(gpa->txEnd, oldAlloc, newAlloc);
+growArray(gpa->cdsStart, oldAlloc, newAlloc);
+growArray(gpa->cdsEnd, oldAlloc, newAlloc);
+growArray(gpa->exonCount, oldAlloc, newAlloc);
+growArray(gpa->exonOffset, oldAlloc, newAlloc);
+growArray(gpa->recordOptFields, oldAlloc, newAlloc);
+if (gpa->score != NULL)
+    growArray(gpa->score, oldAlloc, newAlloc);
+if (gpa->name2 != NULL)
+    growArray(gpa->name2, oldAlloc, newAlloc);
+if (gpa->cdsStartStat != NULL)
+    {
+    growArray(gpa->cdsStartStat, oldAlloc, newAlloc);
+    growArray(gpa->cdsEndStat, oldAlloc, newAlloc);
+    }
+gpa->alloc = newAlloc;
+}
+
+static int allocExons(struct genePredArray *gpa, int exonCount)
+/* Make room for exonCount more entries in exon pools and return offset of first. */
+{
+int offset = gpa->exonUsed;
+int needed = offset + exonCount;
+if (needed > gpa->exonAlloc)
+    {
+    int newAlloc = max(2*gpa->exonAlloc, needed);
+    growArray(gpa->exonStarts, gpa->exonAlloc, newAlloc);
+    growArray(gpa->exonEnds, gpa->exonAlloc, newAlloc);
+    if (gpa->exonFrames != NULL)
+	growArray(gpa->exonFrames, gpa->exonAlloc, newAlloc);
+    gpa->exonAlloc = newAlloc;
+    }
+gpa->exonUsed = needed;
+return offset;
+}
+
+static void needOptField(struct genePredArray *gpa, unsigned field)
+/* Make sure arrays for an optional field exist.  Records added before the first
+ * that has the field get zeros. */
+{
+if (gpa->optFields & field)
+    return;
+switch (field)
+    {
+    case genePredScoreFld:
+	AllocArray(gpa->score, gpa->alloc);
+	break;
+    case genePredName2Fld:
+	AllocArray(gpa->name2, gpa->alloc);
+	break;
+    case genePredCdsStatFld:
+	AllocArray(gpa->cdsStartStat, gpa->alloc);
+	AllocArray(gpa->cdsEndStat, gpa->alloc);
+	break;
+    case genePredExonFramesFld:
+	AllocArray(gpa->exonFrames, gpa->exonAlloc);
+	break;
+    }
+gpa->optFields |= field;
+}
+
+static int newRecord(struct genePredArray *gpa)
+/* Return index of a new record, making room for it if need be. */
+{
+if (gpa->count >= gpa->alloc)
+    expandRecords(gpa);
+return gpa->count++;
+}
+
+int genePredArrayAddRow(struct genePredArray *gpa, char **row, int numCols)
+/* Parse a genePred or genePredExt row with numCols columns into a new record and
+ * return its index.  Optional columns follow the same rules as genePredExtLoad. */
+{
+int ix = newRecord(gpa);
+char *name = row[0];
+int exonCount = sqlUnsigned(row[7]);
+gpa->name[ix] = lmCloneString(gpa->lm, name);
+gpa->chrom[ix] = hashStoreName(gpa->stringHash, row[1]);
+gpa->strand[ix] = row[2][0];
+gpa->txStart[ix] = sqlUnsigned(row[3]);
+gpa->txEnd[ix] = sqlUnsigned(row[4]);
+gpa->cdsStart[ix] = sqlUnsigned(row[5]);
+gpa->cdsEnd[ix] = sqlUnsigned(row[6]);
+gpa->exonCount[ix] = exonCount;
+// Parse into one spare entry so that lists longer than exonCount are caught.
+int offset = allocExons(gpa, exonCount+1);
+gpa->exonUsed -= 1;
+gpa->exonOffset[ix] = offset;
+int sizeOne = sqlUnsignedArray(row[8], gpa->exonStarts + offset, exonCount+1);
+if (sizeOne != exonCount)
+    errAbort("genePred: %s number of exonStarts (%d) != number of exons (%d)",
+	     name, sizeOne, exonCount);
+sizeOne = sqlUnsignedArray(row[9], gpa->exonEnds + offset, exonCount+1);
+if (sizeOne != exonCount)
+    errAbort("genePred: %s number of exonEnds (%d) != number of exons (%d)",
+	     name, sizeOne, exonCount);
+
+unsigned optFields = 0;
+int iCol = GENEPRED_NUM_COLS;
+if (iCol < numCols)
+    {
+    needOptField(gpa, genePredScoreFld);
+    gpa->score[ix] = sqlSigned(row[iCol++]);
+    optFields |= genePredScoreFld;
+    }
+if (iCol < numCols)
+    {
+    needOptField(gpa, genePredName2Fld);
+    gpa->name2[ix] = hashStoreName(gpa->stringHash, row[iCol++]);
+    optFields |= genePredName2Fld;
+    }
+if (iCol < numCols && !isEmpty(row[iCol]))
+    {
+    needOptField(gpa, genePredCdsStatFld);
+    gpa->cdsStartStat[ix] = parseCdsStat(row[iCol++]);
+    optFields |= genePredCdsStatFld;
+    if (iCol < numCols)
+	gpa->cdsEndStat[ix] = parseCdsStat(row[iCol++]);
+    if (iCol < numCols)
+	{
+	needOptField(gpa, genePredExonFramesFld);
+	sizeOne = sqlSignedArray(row[iCol++], gpa->exonFrames + offset, exonCount+1);
+	if (sizeOne != exonCount)
+	    errAbort("genePred: %s number of exonFrames (%d) != number of exons (%d)",
+		     name, sizeOne, exonCount);
+	optFields |= genePredExonFramesFld;
+	}
+    }
+gpa->recordOptFields[ix] = optFields;
+return ix;
+}
+
+int genePredArrayAdd(struct genePredArray *gpa, struct genePred *gp)
+/* Copy gp into a new record and return its index. */
+{
+int ix = newRecord(gpa);
+int exonCount = gp->exonCount;
+gpa->name[ix] = lmCloneString(gpa->lm, gp->name);
+gpa->chrom[ix] = hashStoreName(gpa->stringHash, gp->chrom);
+gpa->strand[ix] = gp->strand[0];
+gpa->txStart[ix] = gp->txStart;
+gpa->txEnd[ix] = gp->txEnd;
+gpa->cdsStart[ix] = gp->cdsStart;
+gpa->cdsEnd[ix] = gp->cdsEnd;
+gpa->exonCount[ix] = exonCount;
+int offset = allocExons(gpa, exonCount);
+gpa->exonOffset[ix] = offset;
+CopyArray(gp->exonStarts, genePredArrayExonStarts(gpa, ix), exonCount);
+CopyArray(gp->exonEnds, genePredArrayExonEnds(gpa, ix), exonCount);
+unsigned optFields = gp->optFields;
+if (optFields & genePredScoreFld)
+    {
+    needOptField(gpa, genePredScoreFld);
+    gpa->score[ix] = gp->score;
+    }
+if ((optFields & genePredName2Fld) && gp->name2 != NULL)
+    {
+    needOptField(gpa, genePredName2Fld);
+    gpa->name2[ix] = hashStoreName(gpa->stringHash, gp->name2);
+    }
+else
+    optFields &= ~genePredName2Fld;
+if (optFields & genePredCdsStatFld)
+    {
+    needOptField(gpa, genePredCdsStatFld);
+    gpa->cdsStartStat[ix] = gp->cdsStartStat;
+    gpa->cdsEndStat[ix] = gp->cdsEndStat;
+    }
+if ((optFields & genePredExonFramesFld) && gp->exonFrames != NULL)
+    {
+    needOptField(gpa, genePredExonFramesFld);
+    CopyArray(gp->exonFrames, genePredArrayExonFrames(gpa, ix), exonCount);
+    }
+else
+    optFields &= ~genePredExonFramesFld;
+gpa->recordOptFields[ix] = optFields;
+return ix;
+}
+
+struct genePredArray *genePredArrayLoadFile(char *fileName)
+/* Load all genePreds or genePredExts from a tab-separated file.  Dispose of this
+ * with genePredArrayFree(). */
+{
+struct genePredArray *gpa = genePredArrayNew(0);
+struct lineFile *lf = lineFileOpen(fileName, TRUE);
+char *row[GENEPREDX_NUM_COLS];
+int numCols;
+while ((numCols = lineFileChopNextTab(lf, row, ArraySize(row))) > 0)
+    {
+    lineFileExpectAtLeast(lf, GENEPRED_NUM_COLS, numCols);
+    genePredArrayAddRow(gpa, row, numCols);
+    }
+lineFileClose(&lf);
+return gpa;
+}
+
+void genePredArrayGet(struct genePredArray *gpa, int ix, struct genePred *gp)
+/* Fill in gp from record ix.  The strings and exon arrays in gp point into gpa, so gp
+ * must not be freed with genePredFree, and must not be used after more records are
+ * added to gpa. */
+{
+ZeroVar(gp);
+gp->name = gpa->name[ix];
+gp->chrom = gpa->chrom[ix];
+gp->strand[0] = gpa->strand[ix];
+gp->txStart = gpa->txStart[ix];
+gp->txEnd = gpa->txEnd[ix];
+gp->cdsStart = gpa->cdsStart[ix];
+gp->cdsEnd = gpa->cdsEnd[ix];
+gp->exonCount = gpa->exonCount[ix];
+gp->exonStarts = genePredArrayExonStarts(gpa, ix);
+gp->exonEnds = genePredArrayExonEnds(gpa, ix);
+unsigned optFields = gpa->recordOptFields[ix];
+gp->optFields = optFields;
+if (optFields & genePredScoreFld)
+    gp->score = gpa->score[ix];
+if (optFields & genePredName2Fld)
+    gp->name2 = gpa->name2[ix];
+if (optFields & genePredCdsStatFld)
+    {
+    gp->cdsStartStat = gpa->cdsStartStat[ix];
+    gp->cdsEndStat = gpa->cdsEndStat[ix];
+    }
+if (optFields & genePredExonFramesFld)
+    gp->exonFrames = genePredArrayExonFrames(gpa, ix);
+}
+
+struct genePred *genePredArrayToGenePred(struct genePredArray *gpa, int ix)
+/* Return a separately allocated copy of record ix.  Free it with genePredFree. */
+{
+struct genePred view, *gp;
+genePredArrayGet(gpa, ix, &view);
+gp = cloneMem(&view, sizeof(view));
+gp->name = cloneString(view.name);
+gp->chrom = cloneString(view.chrom);
+gp->name2 = cloneString(view.name2);
+gp->exonStarts = gp->exonEnds = NULL;
+gp->exonFrames = NULL;
+if (view.exonCount > 0)
+    {
+    gp->exonStarts = CloneArray(view.exonStarts, view.exonCount);
+    gp->exonEnds = CloneArray(view.exonEnds, view.exonCount);
+    if (view.exonFrames != NULL)
+	gp->exonFrames = CloneArray(view.exonFrames, view.exonCount);
+    }
+return gp;
+}
+
+static struct genePredArray *sortGpa;	/* Array being sorted, for sortIxCmp. */
+
+static int sortIxCmp(const void *va, const void *vb)
+/* Compare record indexes to sort by chrom, txStart, then original order. */
+{
+int a = *((const int *)va), b = *((const int *)vb);
+int dif = strcmp(sortGpa->chrom[a], sortGpa->chrom[b]);
+if (dif == 0)
+    {
+    if (sortGpa->txStart[a] != sortGpa->txStart[b])
+	dif = (sortGpa->txStart[a] < sortGpa->txStart[b] ? -1 : 1);
+    else
+	dif = a - b;
+    }
+return dif;
+}
+
+static void *permuted(void *column, int elSize, int *order, int count, int alloc)
+/* Return a copy of column where element i is old element order[i], and free the old
+ * column.  Returns NULL if column is NULL. */
+{
+if (column == NULL)
+    return NULL;
+char *old = column, *new = needLargeZeroedMem((size_t)elSize * alloc);
+int i;
+for (i = 0; i < count; ++i)
+    memcpy(new + (size_t)i*elSize, old + (size_t)order[i]*elSize, elSize);
+freeMem(old);
+return new;
+}
+
+#define permuteColumn(column, order, gpa) \
+    (column = permuted(column, sizeof((column)[0]), order, (gpa)->count, (gpa)->alloc))
+/* Reorder a per-record array of gpa by order. */
+
+void genePredArraySort(struct genePredArray *gpa)
+/* Sort records by chrom, then txStart. */
+{
+int count = gpa->count;
+int *order, i;
+AllocArray(order, count);
+for (i = 0; i < count; ++i)
+    order[i] = i;
+sortGpa = gpa;
+qsort(order, count, sizeof(order[0]), sortIxCmp);
+sortGpa = NULL;
+permuteColumn(gpa->name, order, gpa);
+permuteColumn(gpa->chrom, order, gpa);
+permuteColumn(gpa->strand, order, gpa);
+permuteColumn(gpa->txStart, order, gpa);
+permuteColumn(gpa->txEnd, order, gpa);
+permuteColumn(gpa->cdsStart, order, gpa);
+permuteColumn(gpa->cdsEnd, order, gpa);
+permuteColumn(gpa->exonCount, order, gpa);
+permuteColumn(gpa->exonOffset, order, gpa);
+permuteColumn(gpa->recordOptFields, order, gpa);
+permuteColumn(gpa->score, order, gpa);
+permuteColumn(gpa->name2, order, gpa);
+permuteColumn(gpa->cdsStartStat, order, gpa);
+permuteColumn(gpa->cdsEndStat, order, gpa);
+freeMem(order);
+}
@@ -2064,6 +2064,237 @@ return seq;
 
 
 
+struct seqFileLoc
+/* Where a sequence is in an external file, for batched reads. */
+    {
+    struct seqFileLoc *next;
+    char *acc;			/* Accession.  Not allocated here. */
+    char *extTable;		/* extFile or gbExtFile.  Not allocated here. */
+    HGID extId;			/* Id of file in extTable. */
+    off_t offset;		/* Start of fasta record in file. */
+    size_t size;		/* Size of fasta record. */
+    };
+
+static int seqFileLocCmp(const void *va, const void *vb)
+/* Compare to sort based on file and then offset. */
+{
+const struct seqFileLoc *a = *((struct seqFileLoc **)va);
+const struct seqFileLoc *b = *((struct seqFileLoc **)vb);
+int diff = strcmp(a->extTable, b->extTable);
+if (diff == 0)
+    {
+    if (a->extId != b->extId)
+        diff = (a->extId < b->extId ? -1 : 1);
+    else if (a->offset != b->offset)
+        diff = (a->offset < b->offset ? -1 : 1);
+    }
+return diff;
+}
+
+#define SEQ_BATCH_QUERY_SIZE 500	/* Accessions per query when fetching a batch. */
+#define SEQ_BATCH_MAX_GAP (64*1024)	/* Records this close together are read together. */
+
+static struct slName *nextAccChunk(struct slName **pAcc, struct hash *doneHash)
+/* Return a list of up to SEQ_BATCH_QUERY_SIZE accessions starting at *pAcc that are not
+ * in doneHash, and advance *pAcc past them.  Free result with slFreeList. */
+{
+struct slName *chunk = NULL, *acc;
+int chunkSize = 0;
+for (acc = *pAcc; acc != NULL && chunkSize < SEQ_BATCH_QUERY_SIZE; acc = acc->next)
+    {
+    if (hashLookup(doneHash, acc->name) == NULL)
+        {
+        slNameAddHead(&chunk, acc->name);
+        chunkSize++;
+        }
+    }
+*pAcc = acc;
+return chunk;
+}
+
+static struct hash *chunkNameHash(struct slName *chunk)
+/* Return a hash of the accessions in chunk keyed by lower case accession.  An "in (...)"
+ * query matches names without regard to case, so rows it returns are matched back to
+ * the accessions asked for this way. */
+{
+struct hash *nameHash = hashNew(10);
+struct slName *acc;
+for (acc = chunk; acc != NULL; acc = acc->next)
+    {
+    char *key = cloneString(acc->name);
+    tolowers(key);
+    hashAdd(nameHash, key, acc->name);
+    freeMem(key);
+    }
+return nameHash;
+}
+
+static struct hashEl *lookupChunkName(struct hash *nameHash, char *name)
+/* Return the first hashEl in nameHash for the accessions asked for that match name.
+ * Use hashLookupNext to get the others. */
+{
+char *key = cloneString(name);
+tolowers(key);
+struct hashEl *hel = hashLookup(nameHash, key);
+freeMem(key);
+return hel;
+}
+
+static void querySeqInfoBatch(struct sqlConnection *conn, struct slName *accList,
+                              char *seqTbl, char *extFileFld, char *extTable,
+                              struct hash *locHash, struct seqFileLoc **pLocList)
+/* Look up the file locations in seqTbl of accessions in accList that aren't already
+ * in locHash, and add them to locHash and pLocList. */
+{
+if (!sqlTableExists(conn, seqTbl))
+    return;
+struct slName *acc = accList, *chunk;
+while ((chunk = nextAccChunk(&acc, locHash)) != NULL)
+    {
+    struct dyString *query = sqlDyStringCreate(
+        "select acc, %s, file_offset, file_size from %s where acc in (", extFileFld, seqTbl);
+    sqlDyStringPrintValuesList(query, chunk);
+    sqlDyStringPrintf(query, ")");
+    struct hash *nameHash = chunkNameHash(chunk);
+    struct sqlResult *sr = sqlGetResult(conn, dyStringContents(query));
+    char **row;
+    while ((row = sqlNextRow(sr)) != NULL)
+        {
+        /* Key by the accession asked for, which may differ in case from row[0]. */
+        struct hashEl *hel;
+        for (hel = lookupChunkName(nameHash, row[0]); hel != NULL; hel = hashLookupNext(hel))
+            {
+            if (hashLookup(locHash, hel->val) != NULL)
+                continue;
+            struct seqFileLoc *loc;
+            AllocVar(loc);
+            loc->acc = hashAdd(locHash, hel->val, loc)->name;
+            loc->extTable = extTable;
+            loc->extId = sqlUnsigned(row[1]);
+            loc->offset = sqlLongLong(row[2]);
+            loc->size = sqlUnsigned(row[3]);
+            slAddHead(pLocList, loc);
+            }
+        }
+    sqlFreeResult(&sr);
+    hashFree(&nameHash);
+    dyStringFree(&query);
+    slFreeList(&chunk);
+    }
+}
+
+static void readSeqFileLocs(struct sqlConnection *extFileConn, struct seqFileLoc *locList,
+                            struct hash *seqHash)
+/* Read the sequences at locList, which is sorted by file and offset, into seqHash.
+ * Records that are close together in a file are read with one seek and read. */
+{
+struct seqFileLoc *start, *end, *loc;
+for (start = locList; start != NULL; start = end)
+    {
+    off_t spanEnd = start->offset + start->size;
+    for (end = start->next; end != NULL; end = end->next)
+        {
+        if (end->extId != start->extId || differentString(end->extTable, start->extTable)
+            || end->offset > spanEnd + SEQ_BATCH_MAX_GAP)
+            break;
+        spanEnd = max(spanEnd, end->offset + (off_t)end->size);
+        }
+    struct largeSeqFile *lsf = largeFileHandle(extFileConn, start->extId, start->extTable);
+    if (lsf == NULL)
+        continue;
+    char *span = readOpenFileSection(lsf->fd, start->offset, spanEnd - start->offset,
+                                     lsf->path, start->acc);
+    for (loc = start; loc != end; loc = loc->next)
+        {
+        char *buf = needMem(loc->size+1);
+        memcpy(buf, span + (loc->offset - start->offset), loc->size);
+        hashAdd(seqHash, loc->acc, faFromMemText(buf));
+        }
+    freeMem(span);
+    }
+}
+
+static void readSeqsFromTableBatch(struct sqlConnection *conn, struct slName *accList,
+                                   char *table, struct hash *seqHash)
+/* Load sequences of accList from a table with name and seq columns into seqHash. */
+{
+struct slName *acc = accList, *chunk;
+while ((chunk = nextAccChunk(&acc, seqHash)) != NULL)
+    {
+    struct dyString *query = sqlDyStringCreate("select name,seq from %s where name in (", table);
+    sqlDyStringPrintValuesList(query, chunk);
+    sqlDyStringPrintf(query, ")");
+    struct hash *nameHash = chunkNameHash(chunk);
+    struct sqlResult *sr = sqlGetResult(conn, dyStringContents(query));
+    char **row;
+    while ((row = sqlNextRow(sr)) != NULL)
+        {
+        struct hashEl *hel;
+        for (hel = lookupChunkName(nameHash, row[0]); hel != NULL; hel = hashLookupNext(hel))
+            {
+            if (hashLookup(seqHash, hel->val) == NULL)
+                hashAdd(seqHash, hel->val,
+                        newDnaSeq(cloneString(row[1]), strlen(row[1]), row[0]));
+            }
+        }
+    sqlFreeResult(&sr);
+    hashFree(&nameHash);
+    dyStringFree(&query);
+    slFreeList(&chunk);
+    }
+}
+
+struct hash *hGenBankGetMrnaBatch(char *db, struct slName *accList, char *compatTable)
+/* Get the GenBank or RefSeq mRNA or EST sequences of all accessions in
+ * accList, the same way hGenBankGetMrna gets one.  Returns a hash of
+ * dnaSeqs keyed by the accessions as given in accList that leaves out ones
+ * that aren't found.  The seq tables are queried a few hundred accessions
+ * at a time and the external files are read in file and offset order. */
+{
+struct hash *seqHash = hashNew(0);
+struct sqlConnection *conn = hAllocConn(db);
+if ((compatTable != NULL) && hTableExists(sqlGetDatabase(conn), compatTable))
+    readSeqsFromTableBatch(conn, accList, compatTable, seqHash);
+else
+    {
+    /* gbSeq takes precedence over seq, as in getSeqAndId */
+    struct hash *locHash = hashNew(0);
+    struct seqFileLoc *locList = NULL;
+    querySeqInfoBatch(conn, accList, gbSeqTable, "gbExtFile", gbExtFileTable, locHash, &locList);
+    querySeqInfoBatch(conn, accList, "seq", "extFile", "extFile", locHash, &locList);
+    slSort(&locList, seqFileLocCmp);
+    readSeqFileLocs(conn, locList, seqHash);
+    slFreeList(&locList);
+    hashFree(&locHash);
+    }
+hFreeConn(&conn);
+return seqHash;
+}
+
+struct hash *hDnaSeqGetBatch(char *db, struct slName *accList, char *seqTbl, char *extFileTbl)
+/* Get the sequences of all accessions in accList from the specified seq and extFile tables,
+ * the same way hDnaSeqGet gets one.  Returns a hash of dnaSeqs keyed by the accessions as
+ * given in accList that leaves out ones that aren't found. */
+{
+char seqDbBuf[64], extFileDbBuf[64];
+char *seqDb = dbTblParse(db, seqTbl, &seqTbl, seqDbBuf, sizeof(seqDbBuf));
+char *extFileDb = dbTblParse(db, extFileTbl, &extFileTbl, extFileDbBuf, sizeof(extFileDbBuf));
+struct sqlConnection *seqConn = hAllocConn(seqDb);
+struct sqlConnection *extFileConn = hAllocConn(extFileDb);
+struct hash *seqHash = hashNew(0);
+struct hash *locHash = hashNew(0);
+struct seqFileLoc *locList = NULL;
+querySeqInfoBatch(seqConn, accList, seqTbl, "extFile", extFileTbl, locHash, &locList);
+slSort(&locList, seqFileLocCmp);
+readSeqFileLocs(extFileConn, locList, seqHash);
+slFreeList(&locList);
+hashFree(&locHash);
+hFreeConn(&seqConn);
+hFreeConn(&extFileConn);
+return seqHash;
+}
+
+
 aaSeq *hGenBankGetPepC(struct sqlConnection *conn, char *acc, char *compatTable)
 /* Get a RefSeq peptide sequence or NULL if it doesn't exist.  This handles
  * compatibility between pre-incremental genbank databases where refSeq
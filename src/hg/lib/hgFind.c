@@ -36,6 +36,7 @@
 #include "pipeline.h"
 #include "hgConfig.h"
 #include "trix.h"
+#include "wordIndex.h"
 #include "trackHub.h"
 #include "udc.h"
 #include "hubConnect.h"
@@ -371,16 +372,117 @@ return writeIx;
 }
 
 
-static struct slName *doGrepQuery(char *indexFile, char *table, char *key,
-				  char *extraOptions)
-/* grep -i key indexFile, return a list of ids (first word of each line). */
+static boolean keyIsWholeWord(char *key, char *text)
+/* Return TRUE if key occurs in text bounded by characters that are not letters,
+ * digits or underscores, as fgrep -w requires. */
+{
+char *s = text;
+int keyLen = strlen(key);
+while ((s = stringIn(key, s)) != NULL)
+    {
+    if ((s == text || !(isalnum(s[-1]) || s[-1] == '_')) &&
+        !(isalnum(s[keyLen]) || s[keyLen] == '_'))
+	return TRUE;
+    s += 1;
+    }
+return FALSE;
+}
+
+static struct slName *wordIndexQuery(char *wixFile, char **keyWords, int keyCount,
+				     boolean wholeWord)
+/* Find lines in memory mapped word index of grepIndex file that pass the same tests
+ * as the fgrep pipeline in doGrepQuery, and return a list of their ids in the same
+ * (reverse file) order.  Keys must be upper case.  The index finds candidate lines
+ * by intersecting the lines of the words that start with each key's leading
+ * letters and digits, and candidates are then checked exactly. */
+{
+struct wordIndex *wix = wordIndexOpen(wixFile);
+struct slName *idList = NULL;
+char *prefixes[HGFIND_MAX_KEYWORDS];
+int i;
+for (i=0;  i < keyCount;  i++)
+    {
+    char *key = keyWords[i];
+    char *s = key;
+    while (isalnum(*s))
+	s++;
+    prefixes[i] = cloneStringZ(key, s - key);
+    }
+int lineCount;
+bits32 *lines = wordIndexSearch(wix, keyCount, prefixes, &lineCount);
+for (i=0;  i < lineCount;  i++)
+    {
+    char *line = cloneString(wordIndexLine(wix, lines[i]));
+    touppers(line);
+    boolean wordsOk = TRUE;
+    if (wholeWord)
+	{
+	int j;
+	for (j=0;  j < keyCount && wordsOk;  j++)
+	    wordsOk = keyIsWholeWord(keyWords[j], line);
+	}
+    if (wordsOk)
+	{
+	char *rest = line;
+	char *id = nextWord(&rest);
+	rest = skipLeadingSpaces(rest);
+	if (allKeysPrefix(keyWords, keyCount, rest))
+	    {
+	    /* Ids are case sensitive, so take them from unmodified line. */
+	    char *origLine = skipLeadingSpaces(wordIndexLine(wix, lines[i]));
+	    struct slName *idEl = slNameNewN(origLine, strlen(id));
+	    slAddHead(&idList, idEl);
+	    }
+	}
+    freeMem(line);
+    }
+freeMem(lines);
+for (i=0;  i < keyCount;  i++)
+    freeMem(prefixes[i]);
+wordIndexClose(&wix);
+return idList;
+}
+
+static struct slName *fgrepQuery(char *indexFile, char **keyWords, int keyCount,
+				 char *extraOptions)
+/* Run fgrep pipeline for keys over indexFile, return list of ids of lines where
+ * all keys are word prefixes.  Keys must be upper case. */
 {
 struct pipeline *pl = NULL;
 struct slName *idList = NULL;
 struct lineFile *lf = NULL;
 char *id, *rest, *line;
-char *keyWords[HGFIND_MAX_KEYWORDS];
 char **cmds[HGFIND_MAX_KEYWORDS+1];
+
+makeCmds(cmds, keyWords, keyCount, extraOptions);
+pl = pipelineOpen(cmds, pipelineRead | pipelineNoAbort, indexFile, NULL, 0);
+lf = pipelineLineFile(pl);
+verbose(3, "\n***Running this fgrep command with pipeline from %s:\n*** %s\n\n",
+	indexFile, pipelineDesc(pl));
+while (lineFileNextReal(lf, &line))
+    {
+    id = nextWord(&line);
+    rest = skipLeadingSpaces(line);
+    touppers(rest);
+    if (allKeysPrefix(keyWords, keyCount, rest))
+	{
+	struct slName *idEl = slNameNew(id);
+	slAddHead(&idList, idEl);
+	}
+    }
+pipelineClose(&pl);  /* Takes care of lf too. */
+freeCmds(cmds, keyCount);
+return idList;
+}
+
+static struct slName *doGrepQuery(char *indexFile, char *table, char *key,
+				  char *extraOptions)
+/* grep -i key indexFile, return a list of ids (first word of each line).
+ * If there is a word index indexFile.wix made by textToWordIndex, search that
+ * in-process instead of running fgrep. */
+{
+struct slName *idList = NULL;
+char *keyWords[HGFIND_MAX_KEYWORDS];
 /* escape special chars here */
 char *escapedKey = sqlEscapeString(key); /* presumably this is the right way escape it? -Galt*/ 
 int keyCount;
@@ -390,27 +492,17 @@ keyCount = chopLine(escapedKey, keyWords);
 keyCount = removeTooCommon(table, keyWords, keyCount);
 if (keyCount > 0)
     {
+    char wixFile[PATH_LEN];
+    safef(wixFile, sizeof(wixFile), "%s.wix", indexFile);
     if (extraOptions == NULL)
 	extraOptions = "";
-    makeCmds(cmds, keyWords, keyCount, extraOptions);
-
-    pl = pipelineOpen(cmds, pipelineRead | pipelineNoAbort, indexFile, NULL, 0);
-    lf = pipelineLineFile(pl);
-    verbose(3, "\n***Running this fgrep command with pipeline from %s:\n*** %s\n\n",
-	    indexFile, pipelineDesc(pl));
-    while (lineFileNextReal(lf, &line))
+    if ((isEmpty(extraOptions) || sameString(extraOptions, "-w")) && fileExists(wixFile))
 	{
-	id = nextWord(&line);
-	rest = skipLeadingSpaces(line);
-	touppers(rest);
-	if (allKeysPrefix(keyWords, keyCount, rest))
-	    {
-	    struct slName *idEl = slNameNew(id);
-	    slAddHead(&idList, idEl);
-	    }
+	idList = wordIndexQuery(wixFile, keyWords, keyCount, isNotEmpty(extraOptions));
+	indexFile = wixFile;
 	}
-    pipelineClose(&pl);  /* Takes care of lf too. */
-    freeCmds(cmds, keyCount);
+    else
+	idList = fgrepQuery(indexFile, keyWords, keyCount, extraOptions);
     if (verboseLevel() >= 3)
 	{
 	int count = slCount(idList);
@@ -3510,7 +3602,8 @@ if (!(multiTerm) || (multiTerm && !foundIt))
         }
     // lastly search any included track hubs, or in the case of an assembly hub, any of the tracks
     if (hubCategoryList)
-        foundIt |= findBigBedPosInTdbList(cart, db, hubCategoryList, term, hgp, NULL, measureTiming);
+        foundIt |= findBigBedPosInTdbListLimit(cart, db, hubCategoryList, term, hgp, NULL,
+                                               measureTiming, limitResults);
     }
 
 // multiTerm searches must resolve to a single range on a chromosome, so don't
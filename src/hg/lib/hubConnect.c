@@ -8,6 +8,7 @@
  * See kent/LICENSE or http://genome.ucsc.edu/license/ for licensing information. */
 
 #include "common.h"
+#include <pthread.h>
 #include "linefile.h"
 #include "hash.h"
 #include "dystring.h"
@@ -20,6 +21,7 @@
 #include "hui.h"
 #include "errCatch.h"
 #include "obscure.h"
+#include "ra.h"
 #include "hgConfig.h"
 #include "grp.h"
 #include "udc.h"
@@ -216,6 +218,229 @@ time_t checkTime = udcCacheTimeout();
 return dateIsOlderBy(notOkStatus, "%F %T", checkTime);
 }
 
+/* Before the hubs in the cart are opened one at a time, worker threads read each
+ * hub's hub.txt, genomes.txt, and the trackDb and groups files for the current
+ * database into the udc cache, so the opening and parsing that follows reads local
+ * files rather than waiting on each remote host in turn.  Hubs that haven't arrived
+ * within hub.fetchTimeout seconds are skipped on this page rather than stalling it.
+ * The parsing stays on the main thread since opening a hub registers its genomes
+ * in process-wide hashes. */
+
+struct hubFetchData
+/* A hub being read into the udc cache by a worker thread. */
+    {
+    struct hubFetchData *next;
+    char *url;		/* URL of hub.txt. */
+    char *db;		/* Database to fetch trackDb for, may be NULL for none. */
+    };
+
+static pthread_mutex_t hfdMutex = PTHREAD_MUTEX_INITIALIZER;
+static struct hubFetchData *hfdList = NULL, *hfdRunning = NULL, *hfdDone = NULL;
+static struct hash *hubFetchTimedOut = NULL;	/* Error message for hubs that took too long. */
+
+#define MAX_TRACKDB_INCLUDE_DEPTH 10
+
+static void hubFetchTrackDb(char *url, int depth)
+/* Read trackDb file at url into the udc cache along with the files it includes. */
+{
+struct lineFile *lf = udcWrapShortLineFile(url, NULL, MAX_HUB_TRACKDB_FILE_SIZE);
+char *line;
+while (lineFileNextReal(lf, &line))
+    {
+    if (startsWithWord("include", line) && depth < MAX_TRACKDB_INCLUDE_DEPTH)
+	{
+	nextWord(&line);
+	char *file = nextWord(&line);
+	if (file != NULL)
+	    {
+	    char *incUrl = trackHubRelativeUrl(url, file);
+	    hubFetchTrackDb(incUrl, depth+1);
+	    freeMem(incUrl);
+	    }
+	}
+    }
+lineFileClose(&lf);
+}
+
+static void hubFetchFiles(struct hubFetchData *hfd)
+/* Read the files of hub that will be needed to open it into the udc cache. */
+{
+struct lineFile *lf = udcWrapShortLineFile(hfd->url, NULL, MAX_HUB_TRACKDB_FILE_SIZE);
+struct hash *hubRa = raNextRecord(lf);
+lineFileClose(&lf);
+if (hubRa == NULL || hashLookup(hubRa, "useOneFile"))
+    return;	// Nothing more to fetch, or trackHubOpen will report the problem.
+char *genomesFile = hashFindVal(hubRa, "genomesFile");
+if (genomesFile == NULL)
+    return;
+char *genomesUrl = trackHubRelativeUrl(hfd->url, genomesFile);
+lf = udcWrapShortLineFile(genomesUrl, NULL, MAX_HUB_GENOME_FILE_SIZE);
+struct hash *ra;
+while (hfd->db != NULL && (ra = raNextRecord(lf)) != NULL)
+    {
+    char *genome = hashFindVal(ra, "genome");
+    char *trackDb = hashFindVal(ra, "trackDb");
+    if (genome != NULL && trackDb != NULL
+       && (sameString(genome, hfd->db) || sameString(genome, hubConnectSkipHubPrefix(hfd->db))))
+	{
+	char *trackDbUrl = trackHubRelativeUrl(genomesUrl, trackDb);
+	hubFetchTrackDb(trackDbUrl, 0);
+	freeMem(trackDbUrl);
+	char *groups = hashFindVal(ra, "groups");
+	if (groups != NULL)
+	    {
+	    char *groupsUrl = trackHubRelativeUrl(genomesUrl, groups);
+	    struct lineFile *groupsLf = udcWrapShortLineFile(groupsUrl, NULL, MAX_HUB_GROUP_FILE_SIZE);
+	    lineFileClose(&groupsLf);
+	    freeMem(groupsUrl);
+	    }
+	hashFree(&ra);
+	break;
+	}
+    hashFree(&ra);
+    }
+lineFileClose(&lf);
+freeMem(genomesUrl);
+hashFree(&hubRa);
+}
+
+static void *hubFetchWorker(void *threadParam)
+/* Each thread fetches hubs until all work is done. */
+{
+pthread_detach(pthread_self());  // this thread will never join back with it's progenitor
+    // so that the main thread can go on without hubs that take too long.
+for (;;)
+    {
+    struct hubFetchData *hfd = NULL;
+    pthread_mutex_lock( &hfdMutex );
+    if (hfdList != NULL)
+	{
+	hfd = slPopHead(&hfdList);
+	slAddHead(&hfdRunning, hfd);
+	}
+    pthread_mutex_unlock( &hfdMutex );
+    if (hfd == NULL)
+	return NULL;
+
+    /* Errors are ignored here.  They'll come up again when the hub is opened. */
+    struct errCatch *errCatch = errCatchNew();
+    if (errCatchStart(errCatch))
+	hubFetchFiles(hfd);
+    errCatchEnd(errCatch);
+    errCatchFree(&errCatch);
+
+    pthread_mutex_lock( &hfdMutex );
+    slRemoveEl(&hfdRunning, hfd);
+    slAddHead(&hfdDone, hfd);
+    pthread_mutex_unlock( &hfdMutex );
+    }
+}
+
+static void hubFetchWait(int maxTimeInSeconds)
+/* Wait for fetch threads to finish.  Record hubs that are not done by then in
+ * hubFetchTimedOut. */
+{
+int maxTimeInMilliseconds = 1000 * maxTimeInSeconds;
+int waitTime = 0;
+for (;;)
+    {
+    pthread_mutex_lock( &hfdMutex );
+    boolean done = (hfdList == NULL && hfdRunning == NULL);
+    pthread_mutex_unlock( &hfdMutex );
+    if (done || waitTime >= maxTimeInMilliseconds)
+	break;
+    sleep1000(10); // milliseconds
+    waitTime += 10;
+    }
+pthread_mutex_lock( &hfdMutex );
+struct hubFetchData *unfinished = slCat(hfdList, hfdRunning), *hfd;
+hfdList = NULL;  // stop the workers from starting any more waiting hubs
+for (hfd = unfinished; hfd != NULL; hfd = hfd->next)
+    {
+    char message[1024];
+    safef(message, sizeof message, "Hub timed out: %s took more than %d seconds to load",
+	hfd->url, maxTimeInSeconds);
+    if (hubFetchTimedOut == NULL)
+	hubFetchTimedOut = hashNew(0);
+    hashAdd(hubFetchTimedOut, hfd->url, cloneString(message));
+    }
+// Running hubs stay with their threads, which may still be using them.
+hfdRunning = NULL;
+pthread_mutex_unlock( &hfdMutex );
+}
+
+static void hubFetchInParallel(struct sqlConnection *conn, struct slName *idList, char *db)
+/* Read files for the hubs with the given IDs into the udc cache with a pool of
+ * threads, waiting up to hub.fetchTimeout seconds for them.  IDs may be followed by a
+ * colon and a quickLift chain ID, in which case the hub's trackDb is not fetched
+ * since it is for a different database.  Only remote hubs that will be opened
+ * are fetched. */
+{
+int threadCount = atoi(cfgOptionDefault("hub.fetchThreads", "10"));
+if (threadCount <= 0)
+    return;
+struct hubFetchData *list = NULL, *hfd;
+struct hash *urlHash = hashNew(0);
+struct slName *id;
+for (id = idList; id != NULL; id = id->next)
+    {
+    char *copy = cloneString(id->name);
+    char *colon = strchr(copy, ':');
+    if (colon)
+        *colon = 0;
+    char hubName[64];
+    safef(hubName, sizeof(hubName), "hub_%s", copy);
+    if (grabHashedHub(hubName) == NULL)
+	{
+	char query[1024];
+	sqlSafef(query, sizeof(query),
+	    "select hubUrl, errorMessage, lastNotOkTime from %s where id=%d",
+	    getHubStatusTableName(), sqlSigned(copy));
+	struct sqlResult *sr = sqlGetResult(conn, query);
+	char **row = sqlNextRow(sr);
+	if (row != NULL && hasProtocol(row[0]) && !hashLookup(urlHash, row[0])
+	    && (isEmpty(row[1]) || hubTimeToCheck(NULL, row[2])))
+	    {
+	    AllocVar(hfd);
+	    hfd->url = hashStoreName(urlHash, row[0]);
+	    if (colon == NULL && db != NULL)
+		hfd->db = cloneString(db);
+	    slAddHead(&list, hfd);
+	    }
+	sqlFreeResult(&sr);
+	}
+    freeMem(copy);
+    }
+if (list == NULL)
+    {
+    hashFree(&urlHash);
+    return;
+    }
+slReverse(&list);
+
+udcDefaultDir();	// initialize udc before threads use it
+hfdList = list;
+threadCount = min(threadCount, slCount(list));
+int i;
+for (i = 0; i < threadCount; ++i)
+    {
+    pthread_t thread;
+    int rc = pthread_create(&thread, NULL, hubFetchWorker, NULL);
+    if (rc)
+	errAbort("Unexpected error %d from pthread_create(): %s", rc, strerror(rc));
+    }
+hubFetchWait(atoi(cfgOptionDefault("hub.fetchTimeout", "30")));
+
+/* Hubs that timed out keep their URL in the hash, the rest are done with. */
+pthread_mutex_lock( &hfdMutex );
+while ((hfd = slPopHead(&hfdDone)) != NULL)
+    {
+    freeMem(hfd->db);
+    freeMem(hfd);
+    }
+pthread_mutex_unlock( &hfdMutex );
+}
+
 /* Given a hub ID return associated status. Returns NULL if no such hub.  If hub
  * exists but has problems will return with errorMessage field filled in. */
 struct hubConnectStatus *hubConnectStatusForIdExt(struct sqlConnection *conn, int id, char *replaceDb, char *newDb, char *quickLiftChain)
@@ -236,7 +461,9 @@ if (row != NULL)
     hub->status = sqlUnsigned(row[1]);
     hub->errorMessage = cloneString(row[2]);
     hub->shortLabel = cloneString(row[4]);
-    if (isEmpty(row[2]) || hubTimeToCheck(hub, row[3]))
+    if (hubFetchTimedOut != NULL && hashLookup(hubFetchTimedOut, hub->hubUrl))
+	hub->errorMessage = cloneString(hashFindVal(hubFetchTimedOut, hub->hubUrl));
+    else if (isEmpty(row[2]) || hubTimeToCheck(hub, row[3]))
 	{
 	char *errorMessage = NULL;
 	hub->trackHub = fetchHub( hub, &errorMessage);
@@ -288,6 +515,19 @@ struct hubConnectStatus *hubConnectStatusListFromCartAll(struct cart *cart)
 struct hubConnectStatus *hubList = NULL, *hub;
 struct slPair *pair, *pairList = cartVarsWithPrefix(cart, hgHubConnectHubVarPrefix);
 struct sqlConnection *conn = hConnectCentral();
+struct slName *idList = NULL;
+for (pair = pairList; pair != NULL; pair = pair->next)
+    {
+    if (sameString(pair->val, "1"))
+	{
+	char idString[16];
+	safef(idString, sizeof(idString), "%d", hubIdFromCartName(pair->name));
+	slNameAddHead(&idList, idString);
+	}
+    }
+slReverse(&idList);
+hubFetchInParallel(conn, idList, NULL);
+slFreeList(&idList);
 for (pair = pairList; pair != NULL; pair = pair->next)
     {
     // is this hub turned connected??
@@ -313,6 +553,7 @@ struct hubConnectStatus *hubConnectStatusListFromCart(struct cart *cart)
 struct hubConnectStatus *hubList = NULL, *hub = NULL;
 struct slName *name, *nameList = hubConnectHubsInCart(cart);
 struct sqlConnection *conn = hConnectCentral();
+hubFetchInParallel(conn, nameList, cartOptionalString(cart, "db"));
 for (name = nameList; name != NULL; name = name->next)
     {
     // items in trackHub statement may need to be quickLifted.  This is implied
@@ -2,6 +2,7 @@
 /* Copyright (C) 2023 The Regents of the University of California 
  * See kent/LICENSE or http://genome.ucsc.edu/license/ for licensing information. */
 
+#include <pthread.h>
 #include "common.h"
 #include "obscure.h"
 #include "limits.h"
@@ -40,19 +41,139 @@ strcpy(insert, ".link.bb");
 return cloneString(linkBuffer);
 }
 
-struct bigBedInterval *quickLiftIntervals(char *quickLiftFile, struct bbiFile *bbi,   char *chrom, int start, int end, struct hash **pChainHash)
-/* Return intervals from "other" species that will map to the current window.
- * These intervals are NOT YET MAPPED to the current assembly.
- */
+struct quickLiftRange
+/* A range on the assembly we are lifting from. */
+    {
+    struct quickLiftRange *next;
+    char *chrom;		/* Chromosome in assembly we are lifting from. */
+    int start, end;		/* Half open zero based range. */
+    int chainCount;		/* Number of chains whose ranges were merged into this. */
+    };
+
+static int quickLiftRangeCmp(const void *va, const void *vb)
+/* Compare to sort on chrom then start. */
+{
+const struct quickLiftRange *a = *((struct quickLiftRange **)va);
+const struct quickLiftRange *b = *((struct quickLiftRange **)vb);
+int dif = strcmp(a->chrom, b->chrom);
+if (dif == 0)
+    dif = a->start - b->start;
+return dif;
+}
+
+struct quickLiftBlocks
+/* The chain blocks on one chromosome of the assembly we are lifting from, sorted by
+ * start, so that items that can't map can be skipped without parsing them. */
+    {
+    int count;			/* Number of blocks. */
+    int *starts;		/* Block starts, sorted. */
+    int *maxEnds;		/* Largest end of this and all previous blocks. */
+    };
+
+struct quickLiftChainSet
+/* The chains overlapping a window, shared by all tracks lifted through the same
+ * chain file, with the ranges they cover in the assembly we are lifting from. */
+    {
+    struct quickLiftChainSet *next;
+    struct hash *chainHash;		/* Swapped chains for remapBlockedBed, may be NULL. */
+    struct quickLiftRange *rangeList;	/* Merged ranges, sorted by chrom and start. */
+    struct hash *blocksHash;		/* quickLiftBlocks keyed by chrom. */
+    pthread_mutex_t remapMutex;		/* Held while remapBlockedBed uses chainHash. */
+    };
+
+/* Tracks may be loaded in parallel, so the cache is only touched with chainSetMutex held.
+ * Chain sets are not changed once they are cached, except for the scores and next
+ * pointers of the chains, which remapBlockedBed sets with the set's remapMutex held. */
+static pthread_mutex_t chainSetMutex = PTHREAD_MUTEX_INITIALIZER;
+static struct hash *chainSetCache = NULL;	/* quickLiftChainSets keyed by file and window. */
+
+static void addChainBlocks(struct hash *blocksHash, struct chain *chain)
+/* Add blocks of chain, which has already been swapped, to blocksHash. */
+{
+struct quickLiftBlocks *qlb = hashFindVal(blocksHash, chain->tName);
+if (qlb == NULL)
+    {
+    AllocVar(qlb);
+    hashAdd(blocksHash, chain->tName, qlb);
+    }
+int oldCount = qlb->count;
+qlb->count += slCount(chain->blockList);
+ExpandArray(qlb->starts, oldCount, qlb->count);
+ExpandArray(qlb->maxEnds, oldCount, qlb->count);
+struct cBlock *cb;
+int i = oldCount;
+for (cb = chain->blockList; cb != NULL; cb = cb->next, ++i)
+    {
+    qlb->starts[i] = cb->tStart;
+    qlb->maxEnds[i] = cb->tEnd;
+    }
+}
+
+struct quickLiftBlock
+/* Start and end of a block, for sorting. */
+    {
+    int start, end;
+    };
+
+static int quickLiftBlockCmp(const void *va, const void *vb)
+/* Compare to sort on start. */
+{
+const struct quickLiftBlock *a = va;
+const struct quickLiftBlock *b = vb;
+return a->start - b->start;
+}
+
+static void finishBlocks(struct quickLiftBlocks *qlb)
+/* Sort blocks on start and turn ends into running maximums. */
+{
+int i;
+struct quickLiftBlock *blocks;
+AllocArray(blocks, qlb->count);
+for (i = 0; i < qlb->count; ++i)
+    {
+    blocks[i].start = qlb->starts[i];
+    blocks[i].end = qlb->maxEnds[i];
+    }
+qsort(blocks, qlb->count, sizeof(blocks[0]), quickLiftBlockCmp);
+int maxEnd = 0;
+for (i = 0; i < qlb->count; ++i)
+    {
+    qlb->starts[i] = blocks[i].start;
+    maxEnd = max(maxEnd, blocks[i].end);
+    qlb->maxEnds[i] = maxEnd;
+    }
+freeMem(blocks);
+}
+
+static boolean overlapsBlocks(struct quickLiftChainSet *set, char *chrom, int start, int end)
+/* Return TRUE if start-end overlaps a chain block on chrom. */
+{
+struct quickLiftBlocks *qlb = hashFindVal(set->blocksHash, chrom);
+if (qlb == NULL)
+    return FALSE;
+/* Find last block starting before end. */
+int lo = 0, hi = qlb->count;
+while (lo < hi)
+    {
+    int mid = (lo + hi) / 2;
+    if (qlb->starts[mid] < end)
+	lo = mid + 1;
+    else
+	hi = mid;
+    }
+return lo > 0 && qlb->maxEnds[lo-1] > start;
+}
+
+static struct quickLiftChainSet *loadChainSet(char *quickLiftFile, char *chrom, int start, int end)
+/* Load the chains in window, and the merged ranges they cover in the other assembly. */
 {
 char *linkFileName = getLinkFile(quickLiftFile);
-// need to add some padding to these coordinates
-int padStart = start - 100000;
-if (padStart < 0)
-    padStart = 0;
-struct chain *chain, *chainList = chainLoadIdRangeHub(NULL, quickLiftFile, linkFileName, chrom, padStart, end+100000, -1);
-struct lm *lm = lmInit(0);
-struct bigBedInterval *bbList = NULL;
+struct chain *chain, *chainList = chainLoadIdRangeHub(NULL, quickLiftFile, linkFileName, chrom, start, end, -1);
+struct quickLiftChainSet *set;
+AllocVar(set);
+set->blocksHash = hashNew(0);
+pthread_mutex_init(&set->remapMutex, NULL);
+struct quickLiftRange *range, *rangeList = NULL;
 
 for(chain = chainList; chain; chain = chain->next)
     {
@@ -74,22 +195,159 @@ for(chain = chainList; chain; chain = chain->next)
             qEnd = cb->qEnd;
         }
 
-    // now grab the items 
-    struct bigBedInterval *thisInterval = NULL;
+    AllocVar(range);
+    range->chrom = chain->qName;
+    range->chainCount = 1;
     if (chain->qStrand == '-')
-        thisInterval = bigBedIntervalQuery(bbi, chain->qName, chain->qSize - qEnd, chain->qSize - qStart,  10000, lm);
+        {
+        range->start = chain->qSize - qEnd;
+        range->end = chain->qSize - qStart;
+        }
     else
-        thisInterval = bigBedIntervalQuery(bbi, chain->qName, qStart, qEnd, 10000, lm);
-    bbList = slCat(thisInterval, bbList);
+        {
+        range->start = qStart;
+        range->end = qEnd;
+        }
+    slAddHead(&rangeList, range);
     
     // for the mapping we're going to use the same chain we queried on to map the items, but we need to swap it
     chainSwap(chain);
 
-    if (*pChainHash == NULL)
-        *pChainHash = newHash(0);
-    liftOverAddChainHash(*pChainHash, chain);
+    if (set->chainHash == NULL)
+        set->chainHash = newHash(0);
+    liftOverAddChainHash(set->chainHash, chain);
+    addChainBlocks(set->blocksHash, chain);
+    }
+
+/* Merge overlapping ranges so each item is only fetched once. */
+slSort(&rangeList, quickLiftRangeCmp);
+struct quickLiftRange *last = NULL;
+while ((range = slPopHead(&rangeList)) != NULL)
+    {
+    if (last != NULL && sameString(last->chrom, range->chrom) && range->start <= last->end)
+        {
+        last->end = max(last->end, range->end);
+        last->chainCount += range->chainCount;
+        freeMem(range);
+        }
+    else
+        {
+        slAddHead(&set->rangeList, range);
+        last = range;
+        }
     }
+slReverse(&set->rangeList);
+
+struct hashEl *hel, *helList = hashElListHash(set->blocksHash);
+for (hel = helList; hel != NULL; hel = hel->next)
+    finishBlocks(hel->val);
+hashElFreeList(&helList);
+freeMem(linkFileName);
+return set;
+}
+
+static struct quickLiftChainSet *getChainSet(char *quickLiftFile, char *chrom, int start, int end)
+/* Return the chains in window, loading them only the first time they are asked for. */
+{
+char key[4096];
+safef(key, sizeof key, "%s %s:%d-%d", quickLiftFile, chrom, start, end);
+pthread_mutex_lock(&chainSetMutex);
+struct quickLiftChainSet *set = NULL;
+if (chainSetCache != NULL)
+    set = hashFindVal(chainSetCache, key);
+pthread_mutex_unlock(&chainSetMutex);
+if (set != NULL)
+    return set;
+
+/* Load without the lock so that an errAbort can't leave it held.  If another thread
+ * got there first, use its set. */
+struct quickLiftChainSet *newSet = loadChainSet(quickLiftFile, chrom, start, end);
+pthread_mutex_lock(&chainSetMutex);
+if (chainSetCache == NULL)
+    chainSetCache = hashNew(0);
+set = hashFindVal(chainSetCache, key);
+if (set == NULL)
+    {
+    set = newSet;
+    hashAdd(chainSetCache, key, set);
+    }
+pthread_mutex_unlock(&chainSetMutex);
+return set;
+}
+
+static boolean fetchedWithPrev(struct bigBedInterval *bb, struct quickLiftRange *prev,
+    struct slRef *prevLast)
+/* Return TRUE if bb was also returned by the query of prev, the range before it on the same
+ * chromosome.  If that query stopped at its maximum number of items, prevLast has the items
+ * with the largest start it got, otherwise it is NULL. */
+{
+if (bb->start >= prev->end)
+    return FALSE;
+if (prevLast == NULL)
+    return TRUE;
+struct bigBedInterval *last = prevLast->val;
+if (bb->start != last->start)
+    return bb->start < last->start;
+struct slRef *ref;
+for (ref = prevLast; ref != NULL; ref = ref->next)
+    {
+    last = ref->val;
+    if (last->end == bb->end && sameOk(last->rest, bb->rest))
+        return TRUE;
+    }
+return FALSE;
+}
 
+struct bigBedInterval *quickLiftIntervals(char *quickLiftFile, struct bbiFile *bbi,   char *chrom, int start, int end, struct quickLiftChainSet **pChainSet)
+/* Return intervals from "other" species that will map to the current window.
+ * These intervals are NOT YET MAPPED to the current assembly.
+ * The chains are loaded once per window and shared by all tracks using quickLiftFile,
+ * so *pChainSet must not be freed.  Pass it to quickLiftBed to map the intervals.
+ */
+{
+// need to add some padding to these coordinates
+int padStart = start - 100000;
+if (padStart < 0)
+    padStart = 0;
+struct quickLiftChainSet *set = getChainSet(quickLiftFile, chrom, padStart, end+100000);
+struct lm *lm = lmInit(0);
+struct bigBedInterval *bbList = NULL;
+struct quickLiftRange *range, *prev = NULL;
+struct slRef *prevLast = NULL;
+int maxItemsPerChain = 10000;
+
+for (range = set->rangeList; range != NULL; prev = range, range = range->next)
+    {
+    // now grab the items, as many as the chains merged into range could have had
+    int maxItems = maxItemsPerChain * range->chainCount;
+    struct bigBedInterval *bb, *next, *thisInterval = bigBedIntervalQuery(bbi, range->chrom,
+        range->start, range->end, maxItems, lm);
+
+    // If the query stopped at maxItems, note the last items it got before they move to bbList.
+    struct slRef *thisLast = NULL;
+    if (slCount(thisInterval) >= maxItems)
+        {
+        struct bigBedInterval *last = slLastEl(thisInterval);
+        for (bb = thisInterval; bb != NULL; bb = bb->next)
+            if (bb->start == last->start)
+                refAdd(&thisLast, bb);
+        }
+
+    // Items that reach back into the previous range were usually fetched with it.
+    boolean checkPrev = (prev != NULL && sameString(prev->chrom, range->chrom));
+    for (bb = thisInterval; bb != NULL; bb = next)
+        {
+        next = bb->next;
+        if (!checkPrev || !fetchedWithPrev(bb, prev, prevLast))
+            slAddHead(&bbList, bb);
+        }
+    slFreeList(&prevLast);
+    prevLast = thisLast;
+    }
+slFreeList(&prevLast);
+slReverse(&bbList);
+
+*pChainSet = set;
 return bbList;
 }
 
@@ -102,9 +360,9 @@ bed->chromStarts = needMem(sizeof(int));
 bed->chromStarts[0] = 0;
 }
 
-struct bed *quickLiftBed(struct bbiFile *bbi, struct hash *chainHash, struct bigBedInterval *bb)
-/* Using chains stored in chainHash, port a bigBedInterval from another assembly to a bed
- * on the reference.
+struct bed *quickLiftBed(struct bbiFile *bbi, struct quickLiftChainSet *set, struct bigBedInterval *bb)
+/* Using chains in set from quickLiftIntervals, port a bigBedInterval from another assembly
+ * to a bed on the reference.
  */
 {
 char startBuf[16], endBuf[16];
@@ -115,6 +373,13 @@ static int lastChromId = -1;
 bbiCachedChromLookup(bbi, bb->chromId, lastChromId, chromName, sizeof(chromName));
 //lastChromId=bb->chromId;
 
+if (set == NULL || set->chainHash == NULL)
+    return NULL;
+
+// Skip parsing items that fall between chain blocks since they can't be mapped.
+if (bb->end > bb->start && !overlapsBlocks(set, chromName, bb->start, bb->end))
+    return NULL;
+
 bigBedIntervalToRow(bb, chromName, startBuf, endBuf, bedRow, ArraySize(bedRow));
 
 struct bed *bed = bedLoadN(bedRow, bbi->definedFieldCount);
@@ -122,7 +387,11 @@ char *error;
 if (bbi->definedFieldCount < 12)
     make12(bed);
 
-if ((error = remapBlockedBed(chainHash, bed, 0.0, 0.1, TRUE, TRUE, NULL, NULL)) == NULL)
+// remapBlockedBed scores and sorts the shared chains, so only one thread at a time.
+pthread_mutex_lock(&set->remapMutex);
+error = remapBlockedBed(set->chainHash, bed, 0.0, 0.1, TRUE, TRUE, NULL, NULL);
+pthread_mutex_unlock(&set->remapMutex);
+if (error == NULL)
     return bed;
 //else
     //printf("bed %s error:%s<BR>", bed->name, error);
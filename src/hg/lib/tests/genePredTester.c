@@ -5,6 +5,7 @@
 #include "common.h"
 #include "genePred.h"
 #include "genePredReader.h"
+#include "genePredArray.h"
 #include "options.h"
 #include "psl.h"
 #include "gff.h"
@@ -43,6 +44,11 @@ errAbort(
     "  defined optional columns in file.  If -output is specified, the\n"
     "  objects are written to that file.\n"
     "\n"
+    "o readArray gpFile\n"
+    "  Read rows from the tab-separated file into a genePredArray, copy each\n"
+    "  record into a second genePredArray, and get them back as genePred\n"
+    "  objects.  If -output is specified, the objects are written to that file.\n"
+    "\n"
     "o fromPsl pslFile cdsFile \n"
     "  Create genePred objects from PSL.If -output is specified, the\n"
     "  objects are written to that file.\n"
@@ -249,6 +255,39 @@ genePredReaderFree(&gpr);
 checkNumRows(gpFile, numRows);
 }
 
+void readArray(char *gpFile)
+/* Implements the readArray task */
+{
+FILE *outFh = NULL;
+struct genePredArray *gpa = genePredArrayLoadFile(gpFile);
+struct genePredArray *copy = genePredArrayNew(0);
+int ix;
+
+if (gOutput != NULL)
+    outFh = mustOpen(gOutput, "w");
+
+for (ix = 0; ix < gpa->count; ix++)
+    {
+    struct genePred view;
+    genePredArrayGet(gpa, ix, &view);
+    genePredArrayAdd(copy, &view);
+    }
+for (ix = 0; ix < copy->count; ix++)
+    {
+    struct genePred *gp = genePredArrayToGenePred(copy, ix);
+    if (outFh != NULL)
+        genePredTabOut(gp, outFh);
+    if (ix == 0)
+        writeInfo(gp);
+    genePredFree(&gp);
+    }
+
+carefulClose(&outFh);
+checkNumRows(gpFile, copy->count);
+genePredArrayFree(&copy);
+genePredArrayFree(&gpa);
+}
+
 struct hash* loadCds(char* cdsFile)
 /* load a CDS file into a hash */
 {
@@ -407,6 +446,12 @@ else if (sameString(task, "readFile"))
         usage("readFile task requires one argument");
     readFile(argv[2]);
     }
+else if (sameString(task, "readArray"))
+    {
+    if (argc != 3)
+        usage("readArray task requires one argument");
+    readArray(argv[2]);
+    }
 else if (sameString(task, "fromPsl"))
     {
     if (argc != 4)
@@ -20,6 +20,7 @@ TEST_TBL=gpTest_${USER}
 #   - refSeqId.gp - with score
 #   - refSeqIdName2.gp - with score, name2
 #   - refSeqFrame.gp - with id, name2, cdsStat and frame fields (from mrnaToGene)
+#   - zeroExon.gp - genePredExt with a transcript that has no exons
 #   - acembly.gff - data files used to build various tracks
 #   - tigr.gff
 #   - twinscan.gtf
@@ -34,7 +35,7 @@ TEST_TBL=gpTest_${USER}
 #     frame on them.
 #   - spaceInName.gff - exon lines ended with extra space, which CDS lines didn't, resulting in two
 #     genePred records per gene.
-test: fileTests tableTests fromPslTests compatTblTests fromGxfTests
+test: fileTests arrayTests tableTests fromPslTests compatTblTests fromGxfTests
 
 ###
 # test of reading/writing tab-separated files.
@@ -70,6 +71,39 @@ doFileTest: mkout
 	diff -u expected/genePred/${id}.info ${OUT_DIR}/${id}.info
 	genePredCheck -verbose=0 ${OUT_DIR}/${id}.gp
 
+###
+# test of reading tab-separated files into genePredArrays, copying records into
+# another array and getting them back as genePreds.
+###
+arrayTests: arrayMinTest arrayIdName2Test arrayFrameTest arrayFrameStatTest arrayZeroExonTest
+doArrayTest = ${MAKE} -f genePredTests.mk doArrayTest
+
+arrayMinTest:
+	${doArrayTest} id=$@ inGp=refSeqMin.gp
+
+arrayIdName2Test:
+	${doArrayTest} id=$@ inGp=refSeqIdName2.gp
+
+arrayFrameTest:
+	${doArrayTest} id=$@ inGp=refSeqFrame.gp
+
+arrayFrameStatTest:
+	${doArrayTest} id=$@ inGp=refSeqFrameStat.gp
+
+# a transcript without exons between two with them
+arrayZeroExonTest:
+	${doArrayTest} id=$@ inGp=zeroExon.gp
+
+# Recursive target to run a genePredArray test.  Will diff the output
+# with the input, which should be identical.
+# Expects the following variables to be set:
+#  id - test id
+#  inGp - genePred (omitting dir)
+doArrayTest: mkout
+	${GENE_PRED_TESTER} -output=${OUT_DIR}/${id}.gp -info=${OUT_DIR}/${id}.info readArray input/genePred/${inGp}
+	diff -u input/genePred/${inGp} ${OUT_DIR}/${id}.gp
+	diff -u expected/genePred/${id}.info ${OUT_DIR}/${id}.info
+
 ###
 # Test of loading and reading database tables.  When ids are not auto-assigned,
 # then compare with input file, otherwise, we need an expected file.
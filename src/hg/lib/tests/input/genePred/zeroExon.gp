@@ -0,0 +1,3 @@
+NM_000017.1	chr12	+	119575618	119589763	119575641	119589204	10	119575618,119576781,119586741,119587111,119587592,119588035,119588288,119588575,119588895,119589051,	119575687,119576945,119586891,119587223,119587744,119588206,119588426,119588671,119588952,119589763,	1	one	cmpl	cmpl	0,0,2,2,0,2,2,2,2,2,
+noExons	chr1	+	1000	1000	1000	1000	0			3	three	none	none	
+NM_000066.1	chr1	-	56764802	56801567	56764994	56801540	12	56764802,56767400,56768925,56776439,56779286,56781411,56785145,56787638,56790276,56792359,56795610,56801447,	56765149,56767469,56769079,56776603,56779415,56781652,56785343,56787771,56790418,56792501,56795767,56801567,	2	two	cmpl	cmpl	1,1,0,1,1,0,0,2,1,0,2,1,
@@ -0,0 +1,244 @@
+/* quickLiftTester - test program for quickLift */
+
+/* Copyright (C) 2026 The Regents of the University of California
+ * See kent/LICENSE or http://genome.ucsc.edu/license/ for licensing information. */
+#include "common.h"
+#include "options.h"
+#include "dystring.h"
+#include "dnautil.h"
+#include "sqlNum.h"
+#include "localmem.h"
+#include "basicBed.h"
+#include "bigBed.h"
+#include "chain.h"
+#include "chainNetDbLoad.h"
+#include "liftOver.h"
+#include "pthreadDoList.h"
+#include "quickLift.h"
+
+void usage(char *msg)
+/* Explain usage and exit. */
+{
+errAbort(
+    "%s\n\n"
+    "quickLiftTester - test program for quickLift\n"
+    "\n"
+    "Usage:\n"
+    "   quickLiftTester [options] quickLift.bb items.bb chrom start end output\n"
+    "\n"
+    "Lift items in items.bb to chrom:start-end through the chains in quickLift.bb\n"
+    "(with links in quickLift.link.bb), a window at a time, and check that the\n"
+    "lifted items are the same as lifting them one chain at a time without the\n"
+    "shared chain cache.  The number of items fetched and lifted in each window is\n"
+    "written to output.\n"
+    "\n"
+    "Options:\n"
+    "  -windows=n - split range into this many windows, each lifted twice\n"
+    "  -threads=n - lift windows on this many threads\n",
+    msg);
+}
+
+static struct optionSpec options[] = {
+    {"windows", OPTION_INT},
+    {"threads", OPTION_INT},
+    {NULL, 0},
+};
+int gWindows = 1;
+int gThreads = 1;
+
+struct liftWindow
+/* A window to lift items to, and the items lifted. */
+    {
+    struct liftWindow *next;
+    char *chrom;		/* Chromosome on the assembly lifted to. */
+    int start, end;		/* Window. */
+    char *quickLiftFile;	/* Chains to lift through. */
+    char *itemFile;		/* Items to lift. */
+    struct slName *fetched;	/* Items fetched from the other assembly, sorted and unique. */
+    struct slName *lifted;	/* Lifted items as text, sorted and unique. */
+    };
+
+static void addInterval(struct slName **pList, struct bbiFile *bbi, struct bigBedInterval *bb)
+/* Add text of interval to list. */
+{
+char chromName[256];
+bbiCachedChromLookup(bbi, bb->chromId, -1, chromName, sizeof(chromName));
+struct dyString *dy = dyStringNew(0);
+dyStringPrintf(dy, "%s\t%u\t%u\t%s", chromName, bb->start, bb->end, naForNull(bb->rest));
+slNameAddHead(pList, dy->string);
+dyStringFree(&dy);
+}
+
+static void addBed(struct slName **pList, struct bed *bed)
+/* Add text of lifted bed to list. */
+{
+struct dyString *dy = dyStringNew(0);
+dyStringPrintf(dy, "%s\t%u\t%u\t%s\t%s\t%d\t", bed->chrom, bed->chromStart, bed->chromEnd,
+    bed->name, bed->strand, bed->blockCount);
+int i;
+for (i = 0; i < bed->blockCount; ++i)
+    dyStringPrintf(dy, "%d,", bed->blockSizes[i]);
+dyStringAppendC(dy, '\t');
+for (i = 0; i < bed->blockCount; ++i)
+    dyStringPrintf(dy, "%d,", bed->chromStarts[i]);
+slNameAddHead(pList, dy->string);
+dyStringFree(&dy);
+}
+
+static void finishList(struct slName **pList)
+/* Sort list and drop the items that are on it more than once. */
+{
+slUniqify(pList, slNameCmp, slNameFree);
+}
+
+static void liftCached(void *item, void *context)
+/* Lift items into window through quickLift.  Called by pthreadDoList. */
+{
+struct liftWindow *win = item;
+struct bbiFile *bbi = bigBedFileOpen(win->itemFile);
+struct quickLiftChainSet *chainSet = NULL;
+struct bigBedInterval *bb, *bbList = quickLiftIntervals(win->quickLiftFile, bbi, win->chrom,
+    win->start, win->end, &chainSet);
+for (bb = bbList; bb != NULL; bb = bb->next)
+    {
+    addInterval(&win->fetched, bbi, bb);
+    struct bed *bed = quickLiftBed(bbi, chainSet, bb);
+    if (bed != NULL)
+        addBed(&win->lifted, bed);
+    }
+finishList(&win->fetched);
+finishList(&win->lifted);
+bigBedFileClose(&bbi);
+}
+
+static void makeOneBlock(struct bed *bed)
+/* Give bed without blocks a single block. */
+{
+bed->blockCount = 1;
+AllocArray(bed->blockSizes, 1);
+AllocArray(bed->chromStarts, 1);
+bed->blockSizes[0] = bed->chromEnd - bed->chromStart;
+}
+
+static void liftByChain(struct liftWindow *win, struct slName **retFetched,
+    struct slName **retLifted)
+/* Lift items into window by querying the items under each chain separately, without
+ * the quickLift chain cache.  Return the items fetched and the items lifted. */
+{
+struct slName *fetched = NULL, *lifted = NULL;
+char linkFile[PATH_LEN];
+safef(linkFile, sizeof linkFile, "%s", win->quickLiftFile);
+chopSuffix(linkFile);
+safecat(linkFile, sizeof linkFile, ".link.bb");
+struct bbiFile *bbi = bigBedFileOpen(win->itemFile);
+struct lm *lm = lmInit(0);
+int padStart = max(0, win->start - 100000);
+struct chain *chain, *chainList = chainLoadIdRangeHub(NULL, win->quickLiftFile, linkFile,
+    win->chrom, padStart, win->end + 100000, -1);
+struct hash *chainHash = hashNew(0);
+struct bigBedInterval *bbList = NULL;
+for (chain = chainList; chain != NULL; chain = chain->next)
+    {
+    int qStart = chain->blockList->qStart, qEnd = chain->blockList->qEnd;
+    struct cBlock *cb;
+    for (cb = chain->blockList; cb != NULL; cb = cb->next)
+        {
+        qStart = min(qStart, cb->qStart);
+        qEnd = max(qEnd, cb->qEnd);
+        }
+    if (chain->qStrand == '-')
+        reverseIntRange(&qStart, &qEnd, chain->qSize);
+    bbList = slCat(bigBedIntervalQuery(bbi, chain->qName, qStart, qEnd, 10000, lm), bbList);
+    chainSwap(chain);
+    liftOverAddChainHash(chainHash, chain);
+    }
+struct bigBedInterval *bb;
+for (bb = bbList; bb != NULL; bb = bb->next)
+    {
+    char chromName[256], startBuf[16], endBuf[16];
+    char *bedRow[bbi->fieldCount];
+    addInterval(&fetched, bbi, bb);
+    bbiCachedChromLookup(bbi, bb->chromId, -1, chromName, sizeof(chromName));
+    bigBedIntervalToRow(bb, chromName, startBuf, endBuf, bedRow, ArraySize(bedRow));
+    struct bed *bed = bedLoadN(bedRow, bbi->definedFieldCount);
+    if (bbi->definedFieldCount < 12)
+        makeOneBlock(bed);
+    if (remapBlockedBed(chainHash, bed, 0.0, 0.1, TRUE, TRUE, NULL, NULL) == NULL)
+        addBed(&lifted, bed);
+    }
+finishList(&fetched);
+finishList(&lifted);
+lmCleanup(&lm);
+bigBedFileClose(&bbi);
+*retFetched = fetched;
+*retLifted = lifted;
+}
+
+static void checkList(struct liftWindow *win, char *what, struct slName *expected,
+    struct slName *got)
+/* Abort if the items on got are not the ones expected. */
+{
+struct slName *exp = expected, *el = got;
+for (; exp != NULL && el != NULL; exp = exp->next, el = el->next)
+    if (!sameString(exp->name, el->name))
+        break;
+if (exp != NULL || el != NULL)
+    errAbort("%s:%d-%d: expected %d %s items, got %d, first difference %s vs %s",
+        win->chrom, win->start, win->end, slCount(expected), what, slCount(got),
+        (exp != NULL ? exp->name : "end"), (el != NULL ? el->name : "end"));
+}
+
+static void checkWindow(struct liftWindow *win)
+/* Abort if the items fetched and lifted through the cache are not the ones fetched and
+ * lifted chain by chain. */
+{
+struct slName *fetched, *lifted;
+liftByChain(win, &fetched, &lifted);
+checkList(win, "fetched", fetched, win->fetched);
+checkList(win, "lifted", lifted, win->lifted);
+slFreeList(&fetched);
+slFreeList(&lifted);
+}
+
+void quickLiftTester(char *quickLiftFile, char *itemFile, char *chrom, int start, int end,
+    char *outFile)
+/* Lift the windows of range on threads and check them. */
+{
+struct liftWindow *win, *winList = NULL;
+int size = (end - start + gWindows - 1) / gWindows;
+int i, rep;
+for (rep = 0; rep < 2; ++rep)
+    for (i = 0; i < gWindows; ++i)
+        {
+        AllocVar(win);
+        win->chrom = chrom;
+        win->start = start + i*size;
+        win->end = min(end, win->start + size);
+        win->quickLiftFile = quickLiftFile;
+        win->itemFile = itemFile;
+        slAddHead(&winList, win);
+        }
+slReverse(&winList);
+pthreadDoList(gThreads, winList, liftCached, NULL);
+
+FILE *f = mustOpen(outFile, "w");
+for (win = winList; win != NULL; win = win->next)
+    {
+    checkWindow(win);
+    fprintf(f, "%s:%d-%d\t%d\t%d\n", win->chrom, win->start, win->end,
+        slCount(win->fetched), slCount(win->lifted));
+    }
+carefulClose(&f);
+}
+
+int main(int argc, char *argv[])
+/* Process command line. */
+{
+optionInit(&argc, argv, options);
+if (argc != 7)
+    usage("wrong # args");
+gWindows = optionInt("windows", gWindows);
+gThreads = optionInt("threads", gThreads);
+quickLiftTester(argv[1], argv[2], argv[3], sqlSigned(argv[4]), sqlSigned(argv[5]), argv[6]);
+return 0;
+}
@@ -12,6 +12,7 @@
 #include "hash.h"
 #include "indelShift.h"
 #include "iupac.h"
+#include "jsonLines.h"
 #include "jsonQuery.h"
 #include "linefile.h"
 #include "obscure.h"
@@ -51,6 +52,8 @@ errAbort(
   "                              or an alt sequence and the corresponding portion of its chrom.\n"
   "                              These use RefSeq accesions not UCSC chr names, so that multiple\n"
   "                              assemblies can be described in the same file.\n"
+  "   -threads=N                 Parse JSON with N threads (default 1).  Extraction and output\n"
+  "                              are still done by one thread, in input order.\n"
   );
 }
 
@@ -66,6 +69,7 @@ struct hash *ncToSeqWin = NULL;
 static struct optionSpec options[] = {
     {"freqSourceOrder", OPTION_STRING},
     {"equivRegions", OPTION_STRING},
+    {"threads", OPTION_INT},
     {NULL, 0},
 };
 
@@ -1795,8 +1799,8 @@ struct perAssembly
     {
     struct perAssembly *next;
     char *name;                  // assembly_name e.g. GRCh38.p12
-    char *placementPath;         // jsonQuery path to placements on assembly
-    char *plIsTopLevelPath;      // jsonQuery path to find whether placement is top level in assembly
+    struct jsonPath *placementPath;    // jsonQuery path to placements on assembly
+    struct jsonPath *plIsTopLevelPath; // jsonQuery path to whether placement is top level in assembly
     FILE *outF;                  // bigDbSnp output file
     FILE *outBad;                // buggy coords BED4 output file
     };
@@ -1809,8 +1813,8 @@ if (pPa)
     struct perAssembly *pa = *pPa;
     freeMem(pa->name);
     carefulClose(&pa->outF);
-    freeMem(pa->placementPath);
-    freeMem(pa->plIsTopLevelPath);
+    jsonPathFree(&pa->placementPath);
+    jsonPathFree(&pa->plIsTopLevelPath);
     freez(pPa);
     }
 }
@@ -1872,13 +1876,11 @@ for (spdiB = spdiBList;  spdiB != NULL;  spdiB = spdiB->next)
 fprintf(outBad, "%s\t%u\t%u\t%s\n", chrom, minChromStart, maxChromEnd, rsId);
 }
 
-static void parseDbSnpJson(char *line, struct perAssembly *assemblyProps,
-                           struct outStreams *outStreams)
-/* Each line of dbSNP's file contains one JSON blob describing an rs# variant.  Parse JSON,
- * extract the bits that we want to keep, print out BED+ and accompanying files. */
+static void parseDbSnpJson(struct jsonElement *top, struct lm *lm,
+                           struct perAssembly *assemblyProps, struct outStreams *outStreams)
+/* Each line of dbSNP's file contains one JSON blob describing an rs# variant.  Given parsed
+ * JSON, extract the bits that we want to keep, print out BED+ and accompanying files. */
 {
-struct lm *lm = lmInit(1<<16);
-struct jsonElement *top = jsonParseLm(line, lm);
 struct sharedProps *props = NULL;
 struct bigDbSnp *bds = NULL;
 struct slRef *allPlacements = jsonQueryElement(top, "top",
@@ -1889,7 +1891,7 @@ struct dyString *dyScratch = dyStringNew(0);
 struct perAssembly *ap;
 for (ap = assemblyProps;  ap != NULL;  ap = ap->next)
     {
-    struct slRef *placements = jsonQueryElement(top, "top", ap->placementPath, lm);
+    struct slRef *placements = jsonPathQueryElement(top, "top", ap->placementPath, lm);
     // Filter out scaffolds that are independent in some other assembly, but part of a regular
     // chrom in the current assembly
     struct slRef *plRef, *plRefNext, *filtered = NULL;
@@ -1897,7 +1899,8 @@ for (ap = assemblyProps;  ap != NULL;  ap = ap->next)
         {
         plRefNext = plRef->next;
         struct jsonElement *pl = plRef->val;
-        boolean isTopLevel = jsonQueryBoolean(pl, "placement", ap->plIsTopLevelPath, FALSE, lm);
+        boolean isTopLevel = jsonPathQueryBoolean(pl, "placement", ap->plIsTopLevelPath, FALSE,
+                                                  lm);
         if (isTopLevel)
             slAddHead(&filtered, plRef);
         }
@@ -1950,7 +1953,6 @@ for (ap = assemblyProps;  ap != NULL;  ap = ap->next)
     errCatchFree(&errCatch);
     }
 dyStringFree(&dyScratch);
-lmCleanup(&lm);
 }
 
 static struct slName *initFreqSourceOrder()
@@ -1986,10 +1988,12 @@ for (assembly = assemblies;  assembly != NULL;  assembly = assembly->next)
     struct dyString *dy = dyStringCreate("primary_snapshot_data.placements_with_allele"
                                   "[placement_annot.seq_id_traits_by_assembly[*].assembly_name=%s]",
                                          assembly->name);
-    ap->placementPath = dyStringCannibalize(&dy);
+    ap->placementPath = jsonPathCompile(dy->string);
+    dyStringFree(&dy);
     dy = dyStringCreate("placement_annot.seq_id_traits_by_assembly[assembly_name=%s].is_top_level",
                         assembly->name);
-    ap->plIsTopLevelPath = dyStringCannibalize(&dy);
+    ap->plIsTopLevelPath = jsonPathCompile(dy->string);
+    dyStringFree(&dy);
     char prefix[2048];
     safef(prefix, sizeof prefix, "%s.%s", outRoot, assembly->name);
     ap->outF = openOutFile("%s.bigDbSnp", prefix);
@@ -2048,9 +2052,17 @@ ncGrcToChrom = hashNew(0);
 ncToTwoBitChrom = hashNew(0);
 ncToSeqWin = hashNew(0);
 parseRefSeqToUcsc(refSeqToUcsc, ncGrcToChrom, ncToTwoBitChrom);
-char *line = NULL;
-while (lineFileNext(lf, &line, NULL))
-    parseDbSnpJson(line, assemblyProps, outStreams);
+// Parse a batch of lines in parallel, then extract from them in order.
+int threads = optionInt("threads", 1);
+if (threads < 1)
+    errAbort("-threads must be at least 1");
+struct jsonLine *jl, *jlList;
+while ((jlList = jsonLinesRead(lf, 64 * threads, threads)) != NULL)
+    {
+    for (jl = jlList;  jl != NULL;  jl = jl->next)
+        parseDbSnpJson(jl->el, jl->lm, assemblyProps, outStreams);
+    jsonLineFreeList(&jlList);
+    }
 lineFileClose(&lf);
 perAssemblyFreeList(&assemblyProps);
 outStreamsClose(&outStreams);
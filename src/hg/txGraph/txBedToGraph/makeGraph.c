@@ -22,6 +22,7 @@
  * for vertices and one for edges. At the end this is converted to the txGraph
  * structure. */
 
+#include <pthread.h>
 #include "common.h"
 #include "hash.h"
 #include "localmem.h"
@@ -61,6 +62,17 @@ struct edge
     struct vertex *start;	/* Starting vertex. */
     struct vertex *end;		/* Ending vertex. */
     struct evidence *evList;	/* List of evidence. */
+    struct evidence *evTail;	/* Last evidence in evList, so lists can be joined quickly. */
+    };
+
+struct graphHash
+/* Open addressing hash of vertices keyed by position and type, or of edges keyed by
+ * start and end vertex.  Used while building the graph, since looking these up in
+ * the trees for every block of every input is most of the work on deep clusters. */
+    {
+    void **table;		/* Vertices or edges, NULL for empty slots. */
+    int size;			/* Size of table, a power of two. */
+    int count;			/* Number of slots filled. */
     };
 
 
@@ -117,6 +129,115 @@ return FALSE;
 }
 
 
+static void evidenceAppend(struct edge *dest, struct edge *source)
+/* Move evidence from source to end of dest's evidence list. */
+{
+if (source->evList == NULL)
+    return;
+if (dest->evList == NULL)
+    dest->evList = source->evList;
+else
+    dest->evTail->next = source->evList;
+dest->evTail = source->evTail;
+source->evList = source->evTail = NULL;
+}
+
+static struct graphHash *graphHashNew()
+/* Return a new, empty vertex or edge hash. */
+{
+struct graphHash *gh;
+AllocVar(gh);
+gh->size = 1024;
+AllocArray(gh->table, gh->size);
+return gh;
+}
+
+static void graphHashFree(struct graphHash **pGh)
+/* Free up vertex or edge hash, but not what it refers to. */
+{
+struct graphHash *gh = *pGh;
+if (gh != NULL)
+    {
+    freeMem(gh->table);
+    freez(pGh);
+    }
+}
+
+static unsigned vertexHashVal(int position, enum ggVertexType type)
+/* Return hash value for vertex at position of type. */
+{
+return ((unsigned)position * 4 + (unsigned)type) * 2654435761u;
+}
+
+static unsigned edgeHashVal(struct vertex *start, struct vertex *end)
+/* Return hash value for edge between start and end. */
+{
+return vertexHashVal(start->position, start->type) ^ 
+	(vertexHashVal(end->position, end->type) * 40503u);
+}
+
+static void graphHashExpand(struct graphHash *gh, boolean isEdge)
+/* Double size of hash table and rehash what is in it. */
+{
+void **oldTable = gh->table;
+int oldSize = gh->size, i;
+gh->size *= 2;
+AllocArray(gh->table, gh->size);
+unsigned mask = gh->size - 1;
+for (i=0; i<oldSize; ++i)
+    {
+    void *item = oldTable[i];
+    if (item != NULL)
+        {
+	unsigned h;
+	if (isEdge)
+	    {
+	    struct edge *e = item;
+	    h = edgeHashVal(e->start, e->end);
+	    }
+	else
+	    {
+	    struct vertex *v = item;
+	    h = vertexHashVal(v->position, v->type);
+	    }
+	for (h &= mask; gh->table[h] != NULL; h = (h+1) & mask)
+	    ;
+	gh->table[h] = item;
+	}
+    }
+freeMem(oldTable);
+}
+
+static struct vertex **vertexHashSlot(struct graphHash *gh, int position, 
+	enum ggVertexType type)
+/* Return slot vertex at position of type is in, or empty slot it would go in. */
+{
+unsigned mask = gh->size - 1;
+unsigned h;
+for (h = vertexHashVal(position, type) & mask; gh->table[h] != NULL; h = (h+1) & mask)
+    {
+    struct vertex *v = gh->table[h];
+    if (v->position == position && v->type == type)
+        break;
+    }
+return (struct vertex **)&gh->table[h];
+}
+
+static struct edge **edgeHashSlot(struct graphHash *gh, struct vertex *start, 
+	struct vertex *end)
+/* Return slot edge from start to end is in, or empty slot it would go in. */
+{
+unsigned mask = gh->size - 1;
+unsigned h;
+for (h = edgeHashVal(start, end) & mask; gh->table[h] != NULL; h = (h+1) & mask)
+    {
+    struct edge *e = gh->table[h];
+    if (e->start == start && e->end == end)
+        break;
+    }
+return (struct edge **)&gh->table[h];
+}
+
 static struct vertex *matchingVertex(struct rbTree *tree, int position, enum ggVertexType type)
 /* Find matching vertex.  Return NULL if none. */
 {
@@ -126,35 +247,32 @@ temp.type = type;
 return rbTreeFind(tree, &temp);
 }
 
-static struct vertex *addUniqueVertex(struct rbTree *tree, int position, enum ggVertexType type)
+static struct vertex *addUniqueVertex(struct rbTree *tree, struct graphHash *vertexHash,
+	int position, enum ggVertexType type)
 /* Find existing vertex if it exists, otherwise create and return new one. */
 {
-struct vertex *v = matchingVertex(tree, position, type);
+struct vertex **slot = vertexHashSlot(vertexHash, position, type);
+struct vertex *v = *slot;
 if (v == NULL)
     {
     lmAllocVar(tree->lm, v);
     v->position = position;
     v->type = type;
     rbTreeAdd(tree, v);
+    *slot = v;
+    if (++vertexHash->count * 2 > vertexHash->size)
+        graphHashExpand(vertexHash, FALSE);
     }
 return v;
 }
 
-static struct edge *matchingEdge(struct rbTree *tree, struct vertex *start, struct vertex *end)
-/* Find matching edge. Return NULL if none. */
-{
-struct edge temp;
-temp.start = start;
-temp.end = end;
-return rbTreeFind(tree, &temp);
-}
-
-static struct edge *addUniqueEdge(struct rbTree *tree, struct vertex *start, struct vertex *end,
-	struct linkedBeds *lb)
+static struct edge *addUniqueEdge(struct rbTree *tree, struct graphHash *edgeHash,
+	struct vertex *start, struct vertex *end, struct linkedBeds *lb)
 /* Find existing edge if it exists.  Otherwise create and return new one. 
  * Regardless add lb as evidence to edge. */
 {
-struct edge *e = matchingEdge(tree, start, end);
+struct edge **slot = edgeHashSlot(edgeHash, start, end);
+struct edge *e = *slot;
 if (e == NULL)
     {
     lmAllocVar(tree->lm, e);
@@ -162,18 +280,23 @@ if (e == NULL)
     e->end = end;
     e->next = NULL;
     rbTreeAdd(tree, e);
+    *slot = e;
+    if (++edgeHash->count * 2 > edgeHash->size)
+        graphHashExpand(edgeHash, TRUE);
     }
 struct evidence *ev;
 lmAllocVar(tree->lm, ev);
 ev->lb = lb;
 ev->start = start->position;
 ev->end = end->position;
+if (e->evList == NULL)
+    e->evTail = ev;
 slAddHead(&e->evList, ev);
 return e;
 }
 
-static struct rbTree *makeVertexTree(struct linkedBeds *lbList)
-/* Make tree of unique vertices. */
+static struct rbTree *makeVertexTree(struct linkedBeds *lbList, struct graphHash *vertexHash)
+/* Make tree of unique vertices, also putting them in vertexHash. */
 {
 struct rbTree *vertexTree = rbTreeNew(vertexCmp);
 struct linkedBeds *lb;
@@ -183,16 +306,16 @@ for (lb = lbList; lb != NULL; lb = lb->next)
     for (bed = lb->bedList; bed != NULL; bed = bed->next)
         {
 	/* Add very beginning and end, they'll be soft. */
-	addUniqueVertex(vertexTree, bed->chromStart, ggSoftStart);
-	addUniqueVertex(vertexTree, bed->chromEnd, ggSoftEnd);
+	addUniqueVertex(vertexTree, vertexHash, bed->chromStart, ggSoftStart);
+	addUniqueVertex(vertexTree, vertexHash, bed->chromEnd, ggSoftEnd);
 
 	/* Add internal hard ends. */
 	int i, lastBlock = bed->blockCount-1;
 	for (i=0; i<lastBlock; ++i)
 	    {
-	    addUniqueVertex(vertexTree, 
+	    addUniqueVertex(vertexTree, vertexHash, 
 	    	bed->chromStart + bed->chromStarts[i] + bed->blockSizes[i], ggHardEnd);
-	    addUniqueVertex(vertexTree, 
+	    addUniqueVertex(vertexTree, vertexHash, 
 	    	bed->chromStart + bed->chromStarts[i+1], ggHardStart);
 	    }
 	}
@@ -200,10 +323,11 @@ for (lb = lbList; lb != NULL; lb = lb->next)
 return vertexTree;
 }
 
-static struct rbTree *makeEdgeTree(struct linkedBeds *lbList, struct rbTree *vertexTree)
-/* Make tree of unique edges. */
+static struct rbTree *makeEdgeTree(struct linkedBeds *lbList, struct graphHash *vertexHash)
+/* Make tree of unique edges, looking up vertices in vertexHash. */
 {
 struct rbTree *edgeTree = rbTreeNew(edgeCmp);
+struct graphHash *edgeHash = graphHashNew();
 struct linkedBeds *lb;
 for (lb = lbList; lb != NULL; lb = lb->next)
     {
@@ -213,33 +337,34 @@ for (lb = lbList; lb != NULL; lb = lb->next)
 	nextBed = bed->next;
 
 	/* Loop to add all introns and all but last exon. */
-	struct vertex *start = matchingVertex(vertexTree, bed->chromStart, ggSoftStart);
+	struct vertex *start = *vertexHashSlot(vertexHash, bed->chromStart, ggSoftStart);
 	int i, lastBlock = bed->blockCount-1;
 	for (i=0; i<lastBlock; ++i)
 	    {
 	    /* Add exon */
-	    struct vertex *end = matchingVertex(vertexTree,
+	    struct vertex *end = *vertexHashSlot(vertexHash,
 		start->position + bed->blockSizes[i], ggHardEnd);
-	    addUniqueEdge(edgeTree, start, end, lb);
+	    addUniqueEdge(edgeTree, edgeHash, start, end, lb);
 
 	    /* Add intron */
-	    start = matchingVertex(vertexTree, 
+	    start = *vertexHashSlot(vertexHash, 
 		    bed->chromStart + bed->chromStarts[i+1], ggHardStart);
-	    addUniqueEdge(edgeTree, end, start, lb);
+	    addUniqueEdge(edgeTree, edgeHash, end, start, lb);
 	    }
 
 	/* Add final exon */
-	struct vertex *end = matchingVertex(vertexTree, bed->chromEnd, ggSoftEnd);
-	addUniqueEdge(edgeTree, start, end, lb);
+	struct vertex *end = *vertexHashSlot(vertexHash, bed->chromEnd, ggSoftEnd);
+	addUniqueEdge(edgeTree, edgeHash, start, end, lb);
 
 	/* If there's another bed to go, add a soft intron connecting it. */
 	if (nextBed != NULL)
 	    {
-	    start = matchingVertex(vertexTree, nextBed->chromStart, ggSoftStart);
-	    addUniqueEdge(edgeTree, end, start, lb);
+	    start = *vertexHashSlot(vertexHash, nextBed->chromStart, ggSoftStart);
+	    addUniqueEdge(edgeTree, edgeHash, end, start, lb);
 	    }
 	}
     }
+graphHashFree(&edgeHash);
 return edgeTree;
 }
 
@@ -356,6 +481,18 @@ for (eRef = eRefList; eRef != NULL; eRef = eRef->next)
 return FALSE;
 }
 
+static struct dnaSeq *fetchSeq(struct nibTwoCache *seqCache, char *chromName, 
+	int start, int size)
+/* Fetch sequence from cache.  Graphs may be made in several threads at once, 
+ * and the cache is shared, so this is serialized. */
+{
+static pthread_mutex_t seqMutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_mutex_lock(&seqMutex);
+struct dnaSeq *seq = nibTwoCacheSeqPartExt(seqCache, chromName, start, size, FALSE, NULL);
+pthread_mutex_unlock(&seqMutex);
+return seq;
+}
+
 static boolean checkSnapOk(struct vertex *vOld, struct vertex *vNew, boolean isRev, 
 	int bleedSize, int maxUncheckedSize, struct nibTwoCache *seqCache, char *chromName)
 /* Load sequence that corresponds to bleed-over, and  make sure that sequence of next
@@ -371,13 +508,13 @@ if (isRev)
     {
     int oldStart = vOld->position;
     struct slRef *eRef;
-    struct dnaSeq *oldSeq = nibTwoCacheSeqPartExt(seqCache, chromName, oldStart, bleedSize, FALSE, NULL);
+    struct dnaSeq *oldSeq = fetchSeq(seqCache, chromName, oldStart, bleedSize);
     for (eRef = vNew->waysIn; eRef != NULL; eRef = eRef->next)
         {
 	struct edge *edge = eRef->val;
 	struct vertex *vRest = edge->start;
 	int newStart = vRest->position - bleedSize;
-	struct dnaSeq *newSeq = nibTwoCacheSeqPartExt(seqCache, chromName, newStart, bleedSize, FALSE, NULL);
+	struct dnaSeq *newSeq = fetchSeq(seqCache, chromName, newStart, bleedSize);
 	similar = checkSeqSimilar(oldSeq, newSeq, minScore);
 	dnaSeqFree(&newSeq);
 	if (similar)
@@ -389,13 +526,13 @@ else
     {
     int oldStart = vOld->position - bleedSize;
     struct slRef *eRef;
-    struct dnaSeq *oldSeq = nibTwoCacheSeqPartExt(seqCache, chromName, oldStart, bleedSize, FALSE, NULL);
+    struct dnaSeq *oldSeq = fetchSeq(seqCache, chromName, oldStart, bleedSize);
     for (eRef = vNew->waysOut; eRef != NULL; eRef = eRef->next)
         {
 	struct edge *edge = eRef->val;
 	struct vertex *vRest = edge->end;
 	int newStart = vRest->position;
-	struct dnaSeq *newSeq = nibTwoCacheSeqPartExt(seqCache, chromName, newStart, bleedSize, FALSE, NULL);
+	struct dnaSeq *newSeq = fetchSeq(seqCache, chromName, newStart, bleedSize);
 	similar = checkSeqSimilar(oldSeq, newSeq, minScore);
 	dnaSeqFree(&newSeq);
 	if (similar)
@@ -473,8 +610,7 @@ void mergeOrAddEdge(struct rbTree *edgeTree, struct edge *edge)
 struct edge *existing = rbTreeFind(edgeTree, edge);
 if (existing)
     {
-    existing->evList = slCat(existing->evList, edge->evList);
-    edge->evList = NULL;
+    evidenceAppend(existing, edge);
     }
 else
     rbTreeAdd(edgeTree, edge);
@@ -926,7 +1062,11 @@ for (ev = evList; ev != NULL; ev = nextEv)
     {
     nextEv = ev->next;
     if (rangeIntersection(ev->start, ev->end, start->position, end->position) > 0)
+        {
+	if (edge->evList == NULL)
+	    edge->evTail = ev;
         slAddHead(&edge->evList, ev);
+	}
     }
 
 return edge;
@@ -997,8 +1137,7 @@ for (edgeRef = edgeRefList; edgeRef != NULL; edgeRef = edgeRef->next)
 			 }
 		     if (enclosingEdge != NULL) 
 			 {
-			 enclosingEdge->evList = slCat(enclosingEdge->evList, edge->evList);
-			 edge->evList = NULL;
+			 evidenceAppend(enclosingEdge, edge);
 			 verbose(3, "Removing doubly-soft edge %d-%d, reassigning to %d-%d\n",
 				 s, e, enclosingEdge->start->position, 
 				 enclosingEdge->end->position);
@@ -1070,10 +1209,14 @@ for (edgeRef = edgeRefList; edgeRef != NULL; edgeRef = edgeRef->next)
             lmAllocVar(rangeTree->lm, mergeEdge);
             r->val = mergeEdge;
             }
-        mergeEdge->evidence = slCat(edge->evList, mergeEdge->evidence);
+        if (edge->evList != NULL)
+            {
+            edge->evTail->next = mergeEdge->evidence;
+            mergeEdge->evidence = edge->evList;
+            }
 	verbose(3, "Merging doubly-soft edge (%d,%d) into range (%d,%d)\n", 
 		start->position, end->position, r->start, r->end);
-        edge->evList = NULL;
+        edge->evList = edge->evTail = NULL;
         rbTreeRemove(edgeTree, edge);
 	}
     }
@@ -1223,12 +1366,14 @@ struct txGraph *makeGraph(struct linkedBeds *lbList, int maxBleedOver,
 char *chromName = lbList->bedList->chrom;
 
 /* Create tree of all unique vertices. */
-struct rbTree *vertexTree = makeVertexTree(lbList);
+struct graphHash *vertexHash = graphHashNew();
+struct rbTree *vertexTree = makeVertexTree(lbList, vertexHash);
 verbose(2, "%d unique vertices\n", vertexTree->n);
 
 /* Create tree of all unique edges */
-struct rbTree *edgeTree = makeEdgeTree(lbList, vertexTree);
+struct rbTree *edgeTree = makeEdgeTree(lbList, vertexHash);
 verbose(2, "%d unique edges\n", edgeTree->n);
+graphHashFree(&vertexHash);
 
 snapSoftToCloseHard(vertexTree, edgeTree, maxBleedOver, maxUncheckedBleed, seqCache, chromName);
 verbose(2, "%d edges, %d vertices after snapSoftToCloseHard\n", 
@@ -5,7 +5,8 @@
  *       Cluster input that overlaps at the exon level.
  *       Turn each cluster into a graph.
  * This module handles i/o and clustering.  The makeGraph module
- * handles the graph building. */
+ * handles the graph building.  Clusters are independent of each other, so
+ * graphs for the clusters on a strand can be built in parallel. */
 
 /* Copyright (C) 2008 The Regents of the University of California 
  * See kent/LICENSE or http://genome.ucsc.edu/license/ for licensing information. */
@@ -21,6 +22,7 @@
 #include "binRange.h"
 #include "txGraph.h"
 #include "nibTwo.h"
+#include "pthreadDoList.h"
 #include "txBedToGraph.h"
 
 int maxJoinSize = 70000;	/* This excludes most of the chr14 IG mess */
@@ -30,6 +32,7 @@ int maxUncheckedBleed = 3;
 struct nibTwoCache *seqCache = NULL;
 char *prefix = "a";
 double singleExonMaxOverlap = 0.60;
+int threads = 1;
 
 boolean trustedSource(char *sourceType)
 /* Return TRUE source type is trusted (refSeq or something similar). */ 
@@ -64,7 +67,8 @@ errAbort(
   "    -prefix=xyz - Use the given prefix for the graph names, default %s\n"
   "    -singleExonMaxOverlap=0.N - Maximum ratio of single exon that can overlap\n"
   "                                a multi-exon gene.  Default %g\n"
-  , maxJoinSize, maxBleedOver, maxUncheckedBleed, prefix, singleExonMaxOverlap
+  "    -threads=N - Number of threads to build graphs of clusters with. Default %d\n"
+  , maxJoinSize, maxBleedOver, maxUncheckedBleed, prefix, singleExonMaxOverlap, threads
   );
 }
 
@@ -76,6 +80,7 @@ static struct optionSpec options[] = {
    {"checkSeq", OPTION_STRING},
    {"prefix", OPTION_STRING},
    {"singleExonMaxOverlap", OPTION_FLOAT},
+   {"threads", OPTION_INT},
    {NULL, 0},
 };
 
@@ -143,7 +148,10 @@ struct lbCluster
     struct lbCluster *next;
     int chromStart,chromEnd;	/* Bounds of cluster. */
     struct linkedBeds *lbList;	/* Contents of cluster. */
+    struct linkedBeds *lbTail;	/* Last in lbList, so can merge quickly. */
     struct rbTree *exonTree;	/* Tree just used during creation. */
+    char *name;			/* Name of graph made from cluster. */
+    struct txGraph *graph;	/* Graph made from cluster, may be NULL. */
     };
 
 void lbClusterFree(struct lbCluster **pCluster)
@@ -155,6 +163,7 @@ void lbClusterFree(struct lbCluster **pCluster)
 struct lbCluster *cluster = *pCluster;
 if (cluster != NULL)
     {
+    freeMem(cluster->name);
     freeMem(cluster->exonTree);
     freez(pCluster);
     }
@@ -169,7 +178,7 @@ struct lbCluster *cluster;
 AllocVar(cluster);
 cluster->chromStart = lb->chromStart;
 cluster->chromEnd = lb->chromEnd;
-cluster->lbList = lb;
+cluster->lbList = cluster->lbTail = lb;
 lb->next = NULL;
 
 /* Fill in range tree with exons. */
@@ -192,10 +201,21 @@ void lbClusterMerge(struct lbCluster *a, struct lbCluster **pB)
 /* Merge b into a.  Destroys b. */
 {
 struct lbCluster *b = *pB;
-a->lbList = slCat(a->lbList, b->lbList);
-b->lbList = NULL;
+a->lbTail->next = b->lbList;
+a->lbTail = b->lbTail;
+b->lbList = b->lbTail = NULL;
 a->chromStart = min(a->chromStart, b->chromStart);
 a->chromEnd = max(a->chromEnd, b->chromEnd);
+
+/* Add smaller set of exons to bigger one, since the order of the union
+ * doesn't matter. Clusters that keep growing this way only have each exon
+ * re-added a logarithmic number of times. */
+if (a->exonTree->n < b->exonTree->n)
+    {
+    struct rbTree *swap = a->exonTree;
+    a->exonTree = b->exonTree;
+    b->exonTree = swap;
+    }
 struct range *range;
 for (range = rangeTreeList(b->exonTree); range != NULL; range = range->next)
     rangeTreeAdd(a->exonTree, range->start, range->end);
@@ -286,26 +306,40 @@ binKeeperFree(&bins);
 return clusterList;
 }
 
+void graphOneCluster(void *item, void *context)
+/* Make graph for one cluster, saving it in the cluster.  Called by pthreadDoList. */
+{
+struct lbCluster *cluster = item;
+cluster->graph = makeGraph(cluster->lbList, maxBleedOver, maxUncheckedBleed, 
+    seqCache, singleExonMaxOverlap, cluster->name);
+}
+
 struct txGraph *graphOneStrand(struct linkedBeds *lbList, int strandSizeLimit)
 /* Create a list of graphs based on lbList, which is already
  * sorted and restricted to a single strand of a single chromosome. 
  * The interval 0 to strandSizeLimit needs to encompass all the 
  * exons. */
 {
+/* Name clusters in order, so names don't depend on the order graphs are made in. */
 struct lbCluster *clusterList = clusterOneStrand(lbList, strandSizeLimit);
 struct lbCluster *cluster, *nextCluster;
-struct txGraph *graphList = NULL;
-for (cluster = clusterList; cluster != NULL; cluster = nextCluster)
+for (cluster = clusterList; cluster != NULL; cluster = cluster->next)
     {
     char name[128];
     static int id=0;
-    nextCluster = cluster->next;
     safef(name, sizeof(name), "%s%d", prefix, ++id);
+    cluster->name = cloneString(name);
     verbose(2, "Got cluster of %d called %s.\n", slCount(cluster->lbList), name);
-    struct txGraph *graph = makeGraph(cluster->lbList, maxBleedOver, maxUncheckedBleed, 
-    	seqCache, singleExonMaxOverlap, name);
-    if (graph != NULL)
-	slAddHead(&graphList, graph);
+    }
+
+/* Make graphs, then gather them up in cluster order. */
+pthreadDoList(threads, clusterList, graphOneCluster, NULL);
+struct txGraph *graphList = NULL;
+for (cluster = clusterList; cluster != NULL; cluster = nextCluster)
+    {
+    nextCluster = cluster->next;
+    if (cluster->graph != NULL)
+	slAddHead(&graphList, cluster->graph);
     lbClusterFree(&cluster);
     }
 slReverse(&graphList);
@@ -378,6 +412,7 @@ maxUncheckedBleed = optionInt("maxUncheckedBleed", maxUncheckedBleed);
 if (optionExists("checkSeq"))
    seqCache = nibTwoCacheNew(optionVal("checkSeq", NULL));
 prefix = optionVal("prefix", prefix);
+threads = optionInt("threads", threads);
 if (argc < 4 || argc%2 != 0)
     usage();
 txBedToGraph(argv[argc-1], argv+1, argc/2-1);
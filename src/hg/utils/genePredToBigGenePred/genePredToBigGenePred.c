@@ -5,6 +5,7 @@
 #include "hash.h"
 #include "options.h"
 #include "genePred.h"
+#include "genePredArray.h"
 #include "bigGenePred.h"
 #include "jksql.h"
 #include "memgfx.h"
@@ -71,6 +72,7 @@ unsigned blockStarts[MAX_BLOCKS];
 void outBigGenePred(FILE *fp, struct genePred *gp)
 {
 struct bigGenePred bgp;
+boolean addedFrames = FALSE;
 
 if (gp->exonCount > MAX_BLOCKS)
     errAbort("genePred has more than %d exons, make MAX_BLOCKS bigger in source", MAX_BLOCKS);
@@ -85,7 +87,10 @@ if (gp->exonFrames == NULL)
         gp->exonFrames = cds->exonFrames;
         }
     else
+        {
         genePredAddExonFrames(gp);
+        addedFrames = TRUE;
+        }
     }
 
 bgp.chrom = gp->chrom;
@@ -150,24 +155,39 @@ if (geneTypeHash)
     bgp.geneType = hashFindVal(geneTypeHash, gp->name);
 
 bigGenePredOutput(&bgp, fp, '\t', '\n');
+if (addedFrames)
+    {
+    // gp may be a view into a genePredArray, so don't leave our frames attached to it.
+    freez(&gp->exonFrames);
+    gp->optFields &= ~genePredExonFramesFld;
+    }
 }
 
 void genePredToBigGenePred(char *genePredFile, char *bigGeneOutput)
 /* genePredToBigGenePred - converts genePred or genePredExt to bigGenePred. */
 {
-struct genePred *gp;
+FILE *fp = mustOpen(bigGeneOutput, "w");
 if (isKnown)
-    gp = genePredKnownLoadAll(genePredFile) ;
+    {
+    struct genePred *gp = genePredKnownLoadAll(genePredFile) ;
+    for(; gp ; gp = gp->next)
+        {
+        outBigGenePred(fp, gp);
+        }
+    }
 else
-    gp = genePredExtLoadAll(genePredFile) ;
-
-FILE *fp = mustOpen(bigGeneOutput, "w");
-
-for(; gp ; gp = gp->next)
     {
-    outBigGenePred(fp, gp);
+    struct genePredArray *gpa = genePredArrayLoadFile(genePredFile);
+    int ix;
+    for (ix = 0; ix < gpa->count; ix++)
+        {
+        struct genePred gp;
+        genePredArrayGet(gpa, ix, &gp);
+        outBigGenePred(fp, &gp);
+        }
+    genePredArrayFree(&gpa);
     }
-
+carefulClose(&fp);
 }
 
 
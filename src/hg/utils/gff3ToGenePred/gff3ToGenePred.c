@@ -9,6 +9,7 @@
 #include "options.h"
 #include "gff3.h"
 #include "genePred.h"
+#include "pthreadDoList.h"
 
 #define LEAK_CHECK 0  // set to 1 to free all memory
 
@@ -48,6 +49,17 @@ errAbort(
   "  -refseqHacks - enable various hacks to make RefSeq conversion work:\n"
   "     This turns on -useName, -allowMinimalGenes, and -processAllGeneChildren.\n"
   "     It try harder to find an accession in attributes\n"
+  "  -stream - read and convert the GFF3 a group of related records at a time rather\n"
+  "   than loading it all, so memory use is bounded by the largest gene.  Groups end at\n"
+  "   ### directives, changes of seqid, or where a record starts after the end of all records\n"
+  "   in the group and none of them reference records not yet read.  If that would separate\n"
+  "   records that reference each other or records with the same ID, or the input is stdin,\n"
+  "   the file is loaded as a whole.  The genePreds and -unprocessedRootsOut records are in\n"
+  "   the same order within a group as without -stream, but groups are in file order.\n"
+  "  -threads=N - with -stream, convert N groups in parallel.  Output is unchanged, except\n"
+  "   when -maxConvertErrors is reached: the group that reaches it is converted as if the\n"
+  "   groups before it in the same batch had no errors, so it may have more errors and\n"
+  "   output than without -threads.\n"
   "\n"
   "This converts:\n"
   "   - top-level gene records with RNA records\n"
@@ -86,6 +98,8 @@ static struct optionSpec options[] = {
     {"processAllGeneChildren", OPTION_BOOLEAN},
     {"refseqHacks", OPTION_BOOLEAN},
     {"unprocessedRootsOut", OPTION_STRING},
+    {"stream", OPTION_BOOLEAN},
+    {"threads", OPTION_INT},
     {NULL, 0},
 };
 static boolean useName = FALSE;
@@ -99,7 +113,9 @@ static boolean processAllGeneChildren = FALSE;
 static boolean refseqHacks = FALSE;
 static int maxParseErrors = 50;  // maximum number of errors during parse
 static int maxConvertErrors = 50;  // maximum number of errors during conversion
-static int convertErrCnt = 0;  // number of convert errors
+static int convertErrCnt = 0;  // number of convert errors in output so far
+static boolean stream = FALSE;
+static int threads = 1;
 
 static FILE *outAttrsFp = NULL;
 static FILE *outBadFp = NULL;
@@ -148,50 +164,81 @@ static char** transFeatures[] = {
     NULL
 };
 
-static void cnvError(char *format, ...)
+struct convertOut
+/* Where the conversion of a set of GFF3 records writes.  When converting
+ * groups of records in parallel, each group writes to memory. */
+{
+    FILE *gpFh;      /* genePreds */
+    FILE *attrsFh;   /* -attrsOut, or NULL */
+    FILE *badFh;     /* -bad, or NULL */
+    FILE *rootsFh;   /* -unprocessedRootsOut, or NULL */
+    FILE *errFh;     /* conversion errors and warnings */
+    int errCnt;      /* number of conversion errors */
+};
+
+static void cnvError(struct convertOut *out, char *format, ...)
+#if defined(__GNUC__)
+__attribute__((format(printf, 2, 3)))
+#endif
+;
+
+static void cnvError(struct convertOut *out, char *format, ...)
 /* print a GFF3 to gene conversion error.  This will return.  Code must check
  * for error count to be exceeded and unwind to the top level to print a usefull
  * error message and abort. */
 {
 if (warnAndContinue)
-    fputs("Warning: skipping: ", stderr);
+    fputs("Warning: skipping: ", out->errFh);
 else
-    fputs("Error: ", stderr);
+    fputs("Error: ", out->errFh);
 va_list args;
 va_start(args, format);
-vfprintf(stderr, format, args);
+vfprintf(out->errFh, format, args);
 va_end(args);
-fputc('\n', stderr);
-convertErrCnt++;
+fputc('\n', out->errFh);
+out->errCnt++;
 }
 
-static char *mkAnnAddrKey(struct gff3Ann *ann)
-/* create a key for a gff3Ann from its address.  WARNING: static return */
+static boolean tooManyErrors(struct convertOut *out)
+/* have the maximum number of conversion errors been reached? */
 {
-static char buf[64];
-safef(buf, sizeof(buf), "%lu", (unsigned long)ann);
+return convertErrCnt + out->errCnt >= maxConvertErrors;
+}
+
+static char *mkAnnAddrKey(struct gff3Ann *ann, char *buf, int bufSize)
+/* create a key for a gff3Ann from its address in buf */
+{
+safef(buf, bufSize, "%lu", (unsigned long)ann);
 return buf;
 }
 
 static boolean isProcessed(struct hash *processed, struct gff3Ann *ann)
 /* has an ann record be processed? */
 {
-return hashLookup(processed, mkAnnAddrKey(ann)) != NULL;
+char buf[64];
+return hashLookup(processed, mkAnnAddrKey(ann, buf, sizeof(buf))) != NULL;
 }
 
 static void recProcessed(struct hash *processed, struct gff3Ann *ann)
 /* add an ann record to processed hash */
 {
-hashAdd(processed, mkAnnAddrKey(ann), ann);
+char buf[64];
+hashAdd(processed, mkAnnAddrKey(ann, buf, sizeof(buf)), ann);
 }
 
-static struct gff3File *loadGff3(char *inGff3File)
-/* load GFF3 into memory */
+static unsigned parseFlags()
+/* flags for parsing the GFF3 file */
 {
 unsigned flags = 0;
 if (warnAndContinue)
     flags |= GFF3_WARN_WHEN_POSSIBLE;
-struct gff3File *gff3File = gff3FileOpen(inGff3File, maxParseErrors, flags, NULL);
+return flags;
+}
+
+static struct gff3File *loadGff3(char *inGff3File)
+/* load GFF3 into memory */
+{
+struct gff3File *gff3File = gff3FileOpen(inGff3File, maxParseErrors, parseFlags(), NULL);
 if (gff3File->errCnt > 0)
     errAbort("%d errors parsing GFF3 file: %s", gff3File->errCnt, inGff3File); 
 return gff3File;
@@ -352,12 +399,13 @@ if (isEmpty(name2))
 return name2;
 }
 
-static struct genePred *makeGenePred(struct gff3Ann *gene, struct gff3Ann *mrna, struct gff3AnnRef *exons, struct gff3AnnRef *cdsBlks)
+static struct genePred *makeGenePred(struct convertOut *out, struct gff3Ann *gene, struct gff3Ann *mrna,
+                                     struct gff3AnnRef *exons, struct gff3AnnRef *cdsBlks)
 /* construct the empty genePred, return NULL on a failure. */
 {
 if (exons == NULL)
     {
-    cnvError("no exons defined for mRNA %s", mrna->id);
+    cnvError(out, "no exons defined for mRNA %s", mrna->id);
     return NULL;
     }
 
@@ -368,7 +416,7 @@ int cdsEnd = (cdsBlks == NULL) ? txEnd : ((struct gff3AnnRef*)slLastEl(cdsBlks))
 
 if ((mrna->strand == NULL) || (mrna->strand[0] == '?'))
     {
-    cnvError("invalid strand for mRNA %s", mrna->id);
+    cnvError(out, "invalid strand for mRNA %s", mrna->id);
     return NULL;
     }
 
@@ -421,7 +469,7 @@ fprintf(outAttrsFp, "%s\tEnd\t%u\n", name, ann->end);
 fprintf(outAttrsFp, "%s\tStrand\t%s\n", name, ann->strand);
 }
 
-static void outputGenePred(struct gff3Ann *mrna, FILE *gpFh, struct genePred *gp)
+static void outputGenePred(struct convertOut *out, struct gff3Ann *mrna, struct genePred *gp)
 /* validate and output a genePred */
 {
 if (gp->name == NULL)
@@ -431,18 +479,18 @@ char description[PATH_LEN];
 safef(description, sizeof(description), "genePred from GFF3: %s:%d",
       ((mrna->file != NULL) ? mrna->file->fileName : "<unknown>"),
       mrna->lineNum);
-int ret = genePredCheck(description, stderr, -1, gp);
+int ret = genePredCheck(description, out->errFh, -1, gp);
 if (ret == 0)
     {
-    genePredTabOut(gp, gpFh);
-    if (outAttrsFp)
-        doOutAttrs(outAttrsFp, gp->name,  mrna);
+    genePredTabOut(gp, out->gpFh);
+    if (out->attrsFh)
+        doOutAttrs(out->attrsFh, gp->name,  mrna);
     }
 else
     {
-    if (outBadFp)
-        genePredTabOut(gp, outBadFp);
-    cnvError("invalid genePred created: %s %s:%d-%d", gp->name, gp->chrom, gp->txStart, gp->txEnd);
+    if (out->badFh)
+        genePredTabOut(gp, out->badFh);
+    cnvError(out, "invalid genePred created: %s %s:%d-%d", gp->name, gp->chrom, gp->txStart, gp->txEnd);
     }
 }
 
@@ -483,7 +531,7 @@ for (blk = blks; blk != NULL; prevBlk = blk, blk = blk->next)
     }
 }
 
-static int findCdsExon(struct genePred *gp, struct gff3Ann *cds)
+static int findCdsExon(struct convertOut *out, struct genePred *gp, struct gff3Ann *cds)
 /* search for the exon containing the CDS, starting with iExon+1, return -1 on error */
 {
 // don't use cached iExon.  Will fail on ribosomal frame-shifted genes
@@ -494,18 +542,18 @@ for (iExon=0; iExon < gp->exonCount; iExon++)
     if ((gp->exonStarts[iExon] <= cds->start) && (cds->end <= gp->exonEnds[iExon]))
         return iExon;
     }
-cnvError("no exon in %s contains CDS %d-%d", gp->name, cds->start, cds->end);
+cnvError(out, "no exon in %s contains CDS %d-%d", gp->name, cds->start, cds->end);
 return -1;
 }
 
-static boolean validateCds(struct genePred *gp, struct gff3AnnRef *cdsBlks)
+static boolean validateCds(struct convertOut *out, struct genePred *gp, struct gff3AnnRef *cdsBlks)
 /* Validate that the CDS is contained within exons.  If this is not
  * true, the code to assign frames will generate bad genePreds. */
 {
 struct gff3AnnRef *cds;
 for (cds = cdsBlks; cds != NULL; cds = cds->next)
     {
-    if (findCdsExon(gp, cds->ann) < 0)
+    if (findCdsExon(out, gp, cds->ann) < 0)
         return FALSE; // error
     }
 return TRUE;
@@ -623,7 +671,7 @@ slSort(&cdsUtrBlks, gff3AnnRefLocCmp);
 return cdsUtrBlks;
 }
 
-static struct genePred *mrnaToGenePred(struct gff3Ann *gene, struct gff3Ann *mrna)
+static struct genePred *mrnaToGenePred(struct convertOut *out, struct gff3Ann *gene, struct gff3Ann *mrna)
 /* construct a genePred from an mRNA or transript record, return NULL if there is an error.
  * The gene argument maybe null if there isn't a gene parent */
 {
@@ -642,11 +690,11 @@ if (useExons == NULL) // if we don't have any exons, just use the feature
 	cdsBlks = useExons;
     }
 
-struct genePred *gp = makeGenePred((gene != NULL) ? gene : mrna, mrna, useExons, cdsBlks);
+struct genePred *gp = makeGenePred(out, (gene != NULL) ? gene : mrna, mrna, useExons, cdsBlks);
 if (gp != NULL)
     {
     addExons(gp, useExons);
-    if (!validateCds(gp, cdsBlks))
+    if (!validateCds(out, gp, cdsBlks))
         genePredFree(&gp);
     else
         addExonFrames(gp, cdsBlks);
@@ -657,12 +705,12 @@ slFreeList(&cdsUtrBlks);
 return gp;  // NULL if error above
 }
 
-static struct genePred *standaloneGeneToGenePred(struct gff3Ann *gene)
+static struct genePred *standaloneGeneToGenePred(struct convertOut *out, struct gff3Ann *gene)
 /* construct a genePred using only the gene record and no children */
 {
 // fake structure so entire gene becomes one block
 struct gff3AnnRef fakeExons = {NULL, gene};
-struct genePred *gp = makeGenePred(gene, gene, &fakeExons, NULL);
+struct genePred *gp = makeGenePred(out, gene, gene, &fakeExons, NULL);
 if (gp != NULL)
     addExons(gp, &fakeExons);
 return gp;  // NULL if error above
@@ -678,15 +726,15 @@ return haveChildTypeMatch(gene, cdsFeatures)
     && haveChildTypeMatch(gene, cdjvFeatures);
 }
 
-static void fixNcbiLikeSegmentGene(struct gff3Ann *gene)
+static void fixNcbiLikeSegmentGene(struct convertOut *out, struct gff3Ann *gene)
 /* adjust gene structure (see above) dropping CDS annotation and keeping
  * [CDJV]_gene_segment features as `transcripts' along with their exons.
  * Sometimes the CDS extends outside of exon bounds.  For multi-transcript
  * genes it is hard to figure out where to put the CDS. */
 {
 // Drop CDS, always starting search from start due to removing
-warn("Warning: dropping CDS from %s %s at %s:%d-%d as we are unable to convert this form of annotation to genePred",
-     gene->type, getGeneName(gene), gene->seqid, gene->start, gene->end);
+fprintf(out->errFh, "Warning: dropping CDS from %s %s at %s:%d-%d as we are unable to convert this form of annotation to genePred\n",
+        gene->type, getGeneName(gene), gene->seqid, gene->start, gene->end);
 struct gff3Ann *cdsAnn;
 while ((cdsAnn = findChildTypeMatch(gene, NULL, cdsFeatures)) != NULL)
     gff3UnlinkChild(gene, cdsAnn);
@@ -723,73 +771,73 @@ static boolean shouldProcessGeneAsTranscript(struct gff3Ann *gene)
 return allowMinimalGenes && haveChildTypeMatch(gene, cdsExonFeatures);
 }
 
-static void processTranscript(FILE *gpFh, struct gff3Ann *gene, struct gff3Ann *mrna,
+static void processTranscript(struct convertOut *out, struct gff3Ann *gene, struct gff3Ann *mrna,
                               struct hash *processed)
 /* process a mRNA/transcript node in the tree; gene can be NULL. Error count
    increment on error and genePred discarded */
 {
 recProcessed(processed, mrna);
 
-struct genePred *gp = mrnaToGenePred(gene, mrna);
+struct genePred *gp = mrnaToGenePred(out, gene, mrna);
 if (gp != NULL)
     {
-    outputGenePred(mrna, gpFh, gp);
+    outputGenePred(out, mrna, gp);
     genePredFree(&gp);
     }
 }
 
-static void processGeneTranscripts(FILE *gpFh, struct gff3Ann *gene, struct hash *processed)
+static void processGeneTranscripts(struct convertOut *out, struct gff3Ann *gene, struct hash *processed)
 /* process transcript records of a gene */
 {
-if (outAttrsFp)
-    doOutAttrs(outAttrsFp, gene->id,  gene);
+if (out->attrsFh)
+    doOutAttrs(out->attrsFh, gene->id,  gene);
 struct gff3AnnRef *child;
 for (child = gene->children; child != NULL; child = child->next)
     {
     if (shouldProcessAsTranscript(child->ann) 
         && !isProcessed(processed, child->ann))
-        processTranscript(gpFh, gene, child->ann, processed);
-    if ((convertErrCnt >= maxConvertErrors) && !warnAndContinue)
+        processTranscript(out, gene, child->ann, processed);
+    if (tooManyErrors(out) && !warnAndContinue)
         break;
     }
 }
 
-static void processGeneStandalone(FILE *gpFh, struct gff3Ann *gene, struct hash *processed)
+static void processGeneStandalone(struct convertOut *out, struct gff3Ann *gene, struct hash *processed)
 /* process a gene as a single entry with ignoring non-supported children */
 {
-struct genePred *gp = standaloneGeneToGenePred(gene);
+struct genePred *gp = standaloneGeneToGenePred(out, gene);
 if (gp != NULL)
     {
-    outputGenePred(gene, gpFh, gp);
+    outputGenePred(out, gene, gp);
     genePredFree(&gp);
     }
 }
 
-static void processGene(FILE *gpFh, struct gff3Ann *gene, struct hash *processed)
+static void processGene(struct convertOut *out, struct gff3Ann *gene, struct hash *processed)
 /* process a gene node in the tree.  Stop process if maximum errors reached */
 {
 recProcessed(processed, gene);
 if (isNcbiLikeSegmentGene(gene))
-    fixNcbiLikeSegmentGene(gene);
+    fixNcbiLikeSegmentGene(out, gene);
 
 if (shouldProcessGeneAsTranscript(gene))
-    processTranscript(gpFh, NULL, gene, processed);
+    processTranscript(out, NULL, gene, processed);
 else if (shouldProcessGeneAsStandard(gene))
-    processGeneTranscripts(gpFh, gene, processed);
+    processGeneTranscripts(out, gene, processed);
 else if (allowMinimalGenes)
-    processGeneStandalone(gpFh, gene, processed);
+    processGeneStandalone(out, gene, processed);
 }
 
-static void processRoot(FILE *gpFh, struct gff3Ann *node, struct hash *processed)
+static void processRoot(struct convertOut *out, struct gff3Ann *node, struct hash *processed)
 /* process a root node in the tree */
 {
 if (featTypeMatch(node->type, geneFeatures))
-    processGene(gpFh, node, processed);
+    processGene(out, node, processed);
 else if (shouldProcessAsTranscript(node))
-    processTranscript(gpFh, NULL, node, processed);
+    processTranscript(out, NULL, node, processed);
 }
 
-static void processRoots(FILE *gpFh, struct gff3AnnRef *roots, struct hash *processed)
+static void processRoots(struct convertOut *out, struct gff3AnnRef *roots, struct hash *processed)
 /* process all root node in the tree */
 {
 struct gff3AnnRef *root;
@@ -797,35 +845,186 @@ for (root = roots; root != NULL; root = root->next)
     {
     if (!isProcessed(processed, root->ann))
         {
-        processRoot(gpFh, root->ann, processed);
-        if (convertErrCnt >= maxConvertErrors)
+        processRoot(out, root->ann, processed);
+        if (tooManyErrors(out))
             break;
         }
     }
 }
 
-static void writeUnprocessedRoots(struct gff3AnnRef *roots, struct hash *processed)
+static void writeUnprocessedRoots(struct convertOut *out, struct gff3AnnRef *roots, struct hash *processed)
 /* output unprocessed records */
 {
 struct gff3AnnRef *root;
 for (root = roots; root != NULL; root = root->next)
     {
     if (!isProcessed(processed, root->ann))
-        gff3AnnWrite(root->ann, outUnprocessedRootsFp);
+        gff3AnnWrite(root->ann, out->rootsFh);
+    }
+}
+
+static void convertRecords(struct convertOut *out, struct gff3File *gff3File)
+/* convert a GFF3 file, or a group of records streamed from one */
+{
+// hash of nodes ptrs, prevents dup processing due to dup parents
+struct hash *processed = hashNew((gff3File->streamFile != NULL) ? 8 : 12);
+processRoots(out, gff3File->roots, processed);
+if (out->rootsFh != NULL)
+    writeUnprocessedRoots(out, gff3File->roots, processed);
+hashFree(&processed);
+}
+
+struct memOut
+/* Text written to a memory stream */
+{
+    char *text;
+    size_t size;
+};
+
+struct groupConvert
+/* A group of GFF3 records converted in parallel with other groups, with
+ * output kept in memory until it can be written in input order. */
+{
+    struct groupConvert *next;
+    struct gff3File *group;   /* records to convert */
+    struct convertOut out;    /* memory streams written by conversion */
+    struct memOut gpMem, attrsMem, badMem, rootsMem, errMem;  /* their text */
+};
+
+static FILE *memOutOpen(struct memOut *mem, FILE *fh)
+/* open a memory stream to hold output for fh, or return NULL if fh is NULL */
+{
+if (fh == NULL)
+    return NULL;
+FILE *memFh = open_memstream(&mem->text, &mem->size);
+if (memFh == NULL)
+    errnoAbort("Can't open memory stream for conversion output");
+return memFh;
+}
+
+static void memOutWrite(struct memOut *mem, FILE *fh)
+/* write text from a closed memory stream to fh and free it */
+{
+if (mem->text != NULL)
+    {
+    mustWrite(fh, mem->text, mem->size);
+    freez(&mem->text);
+    }
+}
+
+static void convertGroup(void *item, void *context)
+/* Convert a group of records to memory.  Called by pthreadDoList. */
+{
+struct groupConvert *gc = item;
+struct convertOut *fileOut = context;
+gc->out.gpFh = memOutOpen(&gc->gpMem, fileOut->gpFh);
+gc->out.attrsFh = memOutOpen(&gc->attrsMem, fileOut->attrsFh);
+gc->out.badFh = memOutOpen(&gc->badMem, fileOut->badFh);
+gc->out.rootsFh = memOutOpen(&gc->rootsMem, fileOut->rootsFh);
+gc->out.errFh = memOutOpen(&gc->errMem, fileOut->errFh);
+convertRecords(&gc->out, gc->group);
+carefulClose(&gc->out.gpFh);
+carefulClose(&gc->out.attrsFh);
+carefulClose(&gc->out.badFh);
+carefulClose(&gc->out.rootsFh);
+carefulClose(&gc->out.errFh);
+}
+
+static void writeGroupConvert(struct groupConvert *gc, struct convertOut *fileOut)
+/* write output of a group converted to memory */
+{
+memOutWrite(&gc->errMem, fileOut->errFh);
+memOutWrite(&gc->gpMem, fileOut->gpFh);
+memOutWrite(&gc->attrsMem, fileOut->attrsFh);
+memOutWrite(&gc->badMem, fileOut->badFh);
+memOutWrite(&gc->rootsMem, fileOut->rootsFh);
+convertErrCnt += gc->out.errCnt;
+}
+
+static void groupConvertFreeList(struct groupConvert **gcList)
+/* free a list of groupConvert objects and their groups */
+{
+struct groupConvert *gc;
+for (gc = *gcList; gc != NULL; gc = gc->next)
+    {
+    gff3FileFree(&gc->group);
+    freeMem(gc->gpMem.text);
+    freeMem(gc->attrsMem.text);
+    freeMem(gc->badMem.text);
+    freeMem(gc->rootsMem.text);
+    freeMem(gc->errMem.text);
+    }
+slFreeList(gcList);
+}
+
+static struct groupConvert *readGroupBatch(struct gff3File *gff3File, int maxCount)
+/* read up to maxCount groups of records from a stream */
+{
+struct groupConvert *batch = NULL;
+struct gff3File *group;
+int count;
+for (count = 0; (count < maxCount) && ((group = gff3FileNextGroup(gff3File)) != NULL); count++)
+    {
+    struct groupConvert *gc;
+    AllocVar(gc);
+    gc->group = group;
+    slAddHead(&batch, gc);
+    }
+slReverse(&batch);
+return batch;
+}
+
+static void convertGroupsParallel(struct convertOut *fileOut, struct gff3File *gff3File)
+/* convert batches of groups read from a stream in parallel, writing their
+ * output in input order */
+{
+struct groupConvert *batch;
+while ((convertErrCnt < maxConvertErrors)
+       && ((batch = readGroupBatch(gff3File, 16*threads)) != NULL))
+    {
+    pthreadDoList(threads, batch, convertGroup, fileOut);
+    struct groupConvert *gc;
+    for (gc = batch; (gc != NULL) && (convertErrCnt < maxConvertErrors); gc = gc->next)
+        writeGroupConvert(gc, fileOut);
+    groupConvertFreeList(&batch);
+    }
+}
+
+static void convertStream(struct convertOut *fileOut, char *inGff3File)
+/* convert a GFF3 file a group of records at a time */
+{
+struct gff3File *gff3File = gff3FileOpenStream(inGff3File, maxParseErrors, parseFlags(), NULL);
+if (threads > 1)
+    convertGroupsParallel(fileOut, gff3File);
+else
+    {
+    struct gff3File *group;
+    while (!tooManyErrors(fileOut) && ((group = gff3FileNextGroup(gff3File)) != NULL))
+        {
+        convertRecords(fileOut, group);
+        gff3FileFree(&group);
+        }
     }
+gff3FileFree(&gff3File);
 }
 
 static void gff3ToGenePred(char *inGff3File, char *outGpFile)
 /* gff3ToGenePred - convert a GFF3 file to a genePred file. */
 {
-// hash of nodes ptrs, prevents dup processing due to dup parents
-struct hash *processed = hashNew(12);
-struct gff3File *gff3File = loadGff3(inGff3File);
-FILE *gpFh = mustOpen(outGpFile, "w");
-processRoots(gpFh, gff3File->roots, processed);
-carefulClose(&gpFh);
-if (outUnprocessedRootsFp != NULL)
-    writeUnprocessedRoots(gff3File->roots,  processed);
+struct convertOut out = {NULL, outAttrsFp, outBadFp, outUnprocessedRootsFp, stderr, 0};
+out.gpFh = mustOpen(outGpFile, "w");
+if (stream)
+    convertStream(&out, inGff3File);
+else
+    {
+    struct gff3File *gff3File = loadGff3(inGff3File);
+    convertRecords(&out, gff3File);
+#if LEAK_CHECK  // free memory for leak debugging if 1
+    gff3FileFree(&gff3File);
+#endif
+    }
+carefulClose(&out.gpFh);
+convertErrCnt += out.errCnt;
 if (convertErrCnt > 0)
     {
     if (warnAndContinue)
@@ -833,11 +1032,6 @@ if (convertErrCnt > 0)
     else
         errAbort("%d errors converting GFF3 file: %s", convertErrCnt, inGff3File);
     }
-
-#if LEAK_CHECK  // free memory for leak debugging if 1
-gff3FileFree(&gff3File);
-hashFree(&processed);
-#endif
 }
 
 int main(int argc, char *argv[])
@@ -870,6 +1064,8 @@ if (refseqHacks)
     allowMinimalGenes = TRUE;
     processAllGeneChildren = TRUE;
     }
+stream = optionExists("stream");
+threads = optionInt("threads", threads);
 char *bad = optionVal("bad", NULL);
 if (bad != NULL)
     outBadFp = mustOpen(bad, "w");
@@ -0,0 +1,5 @@
+ENST04835233199	JAGYVI010000001.1	+	10318	12856	12856	12856	6	10318,11058,11666,12104,12162,12405,	10677,11167,12102,12161,12404,12856,	0	gene:ENSG04835059029	none	none	-1,-1,-1,-1,-1,-1,
+ENST04835233201	JAGYVI010000001.1	-	33018	34489	34489	34489	2	33018,34128,	33889,34489,	0	FAM138B	none	none	-1,-1,
+ENST04835233204	JAGYVI010000001.1	+	58642	60369	60369	60369	6	58642,59038,59099,59195,59547,59788,	59037,59098,59190,59546,59704,60369,	0	gene:ENSG04835059034	none	none	-1,-1,-1,-1,-1,-1,
+ENST04835101259	JAGYVI010000001.1	+	20800525	20800654	20800654	20800654	1	20800525,	20800654,	0	SNORA30B	none	none	-1,
+ENST04835116634	JAGYVI010000005.1	+	7013406	7013590	7013590	7013590	1	7013406,	7013590,	0	gene:ENSG04835029986	none	none	-1,
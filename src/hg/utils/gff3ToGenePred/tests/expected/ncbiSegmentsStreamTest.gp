@@ -0,0 +1,14 @@
+LOC109201834	NC_031969.1	+	532791	533929	533929	533929	2	532791,533254,	533146,533929,	0	LOC109201834	incmpl	incmpl	-1,-1,
+TRBD1	NC_000007.14	+	142786212	142786224	142786224	142786224	1	142786212,	142786224,	0	TRBD1	incmpl	incmpl	-1,
+TRBJ1-1	NC_000007.14	+	142786879	142786927	142786927	142786927	1	142786879,	142786927,	0	TRBJ1-1	incmpl	incmpl	-1,
+NM_001005221.2	NC_000001.11	-	450739	451678	450739	451678	1	450739,	451678,	0	OR4F29	incmpl	incmpl	0,
+IGHG3	NT_187600.1	-	233682	239174	239174	239174	9	233682,235581,237013,237425,237873,238061,238249,238437,238880,	233766,235712,237328,237755,237918,238106,238294,238488,239174,	0	IGHG3	incmpl	incmpl	-1,-1,-1,-1,-1,-1,-1,-1,-1,
+IGKV1-32	NW_012132915.1	-	362366	362841	362841	362841	2	362366,362786,	362668,362841,	0	IGKV1-32	incmpl	incmpl	-1,-1,
+IGKV1-32	NW_012132915.1	-	362366	362841	362841	362841	2	362366,362786,	362668,362841,	0	IGKV1-32	incmpl	incmpl	-1,-1,
+IGKV1-33	NW_012132915.1	-	376826	377301	377301	377301	2	376826,377246,	377122,377301,	0	IGKV1-33	incmpl	incmpl	-1,-1,
+Traj1	NT_039614.1	+	1656110	1656139	1656139	1656139	1	1656110,	1656139,	0	Traj1	incmpl	incmpl	-1,
+Trac	NT_039614.1	+	1657817	1661492	1661492	1661492	4	1657817,1659409,1660284,1660988,	1658078,1659445,1660392,1661492,	0	Trac	incmpl	incmpl	-1,-1,-1,-1,
+Traj1	NC_000080.6	+	54218813	54218842	54218842	54218842	1	54218813,	54218842,	0	Traj1	incmpl	incmpl	-1,
+Trac	NC_000080.6	+	54220520	54224198	54224198	54224198	4	54220520,54222114,54222990,54223694,	54220781,54222150,54223098,54224198,	0	Trac	incmpl	incmpl	-1,-1,-1,-1,
+Ighv1-33	NC_000078.6	-	114843692	114844083	114844083	114844083	2	114843692,114844037,	114843955,114844083,	0	Ighv1-33	incmpl	incmpl	-1,-1,
+Ighv1-34	NC_000078.6	-	114851189	114851483	114851483	114851483	1	114851189,	114851483,	0	Ighv1-34	incmpl	incmpl	-1,
@@ -0,0 +1,300 @@
+mrna0	chr1	+	1099	1900	1900	1900	2	1099,1599,	1400,1900,	0	gene0	none	none	-1,-1,
+mrna1	chr1	+	11099	11900	11900	11900	2	11099,11599,	11400,11900,	0	gene1	none	none	-1,-1,
+mrna2	chr1	+	21099	21900	21900	21900	2	21099,21599,	21400,21900,	0	gene2	none	none	-1,-1,
+mrna3	chr1	+	31099	31900	31900	31900	2	31099,31599,	31400,31900,	0	gene3	none	none	-1,-1,
+mrna4	chr1	+	41099	41900	41900	41900	2	41099,41599,	41400,41900,	0	gene4	none	none	-1,-1,
+mrna5	chr1	+	51099	51900	51900	51900	2	51099,51599,	51400,51900,	0	gene5	none	none	-1,-1,
+mrna6	chr1	+	61099	61900	61900	61900	2	61099,61599,	61400,61900,	0	gene6	none	none	-1,-1,
+mrna7	chr1	+	71099	71900	71900	71900	2	71099,71599,	71400,71900,	0	gene7	none	none	-1,-1,
+mrna8	chr1	+	81099	81900	81900	81900	2	81099,81599,	81400,81900,	0	gene8	none	none	-1,-1,
+mrna9	chr1	+	91099	91900	91900	91900	2	91099,91599,	91400,91900,	0	gene9	none	none	-1,-1,
+mrna10	chr1	+	101099	101900	101900	101900	2	101099,101599,	101400,101900,	0	gene10	none	none	-1,-1,
+mrna11	chr1	+	111099	111900	111900	111900	2	111099,111599,	111400,111900,	0	gene11	none	none	-1,-1,
+mrna12	chr1	+	121099	121900	121900	121900	2	121099,121599,	121400,121900,	0	gene12	none	none	-1,-1,
+mrna13	chr1	+	131099	131900	131900	131900	2	131099,131599,	131400,131900,	0	gene13	none	none	-1,-1,
+mrna14	chr1	+	141099	141900	141900	141900	2	141099,141599,	141400,141900,	0	gene14	none	none	-1,-1,
+mrna15	chr1	+	151099	151900	151900	151900	2	151099,151599,	151400,151900,	0	gene15	none	none	-1,-1,
+mrna16	chr1	+	161099	161900	161900	161900	2	161099,161599,	161400,161900,	0	gene16	none	none	-1,-1,
+mrna17	chr1	+	171099	171900	171900	171900	2	171099,171599,	171400,171900,	0	gene17	none	none	-1,-1,
+mrna18	chr1	+	181099	181900	181900	181900	2	181099,181599,	181400,181900,	0	gene18	none	none	-1,-1,
+mrna19	chr1	+	191099	191900	191900	191900	2	191099,191599,	191400,191900,	0	gene19	none	none	-1,-1,
+mrna20	chr1	+	201099	201900	201900	201900	2	201099,201599,	201400,201900,	0	gene20	none	none	-1,-1,
+mrna21	chr1	+	211099	211900	211900	211900	2	211099,211599,	211400,211900,	0	gene21	none	none	-1,-1,
+mrna22	chr1	+	221099	221900	221900	221900	2	221099,221599,	221400,221900,	0	gene22	none	none	-1,-1,
+mrna23	chr1	+	231099	231900	231900	231900	2	231099,231599,	231400,231900,	0	gene23	none	none	-1,-1,
+mrna24	chr1	+	241099	241900	241900	241900	2	241099,241599,	241400,241900,	0	gene24	none	none	-1,-1,
+mrna25	chr1	+	251099	251900	251900	251900	2	251099,251599,	251400,251900,	0	gene25	none	none	-1,-1,
+mrna26	chr1	+	261099	261900	261900	261900	2	261099,261599,	261400,261900,	0	gene26	none	none	-1,-1,
+mrna27	chr1	+	271099	271900	271900	271900	2	271099,271599,	271400,271900,	0	gene27	none	none	-1,-1,
+mrna28	chr1	+	281099	281900	281900	281900	2	281099,281599,	281400,281900,	0	gene28	none	none	-1,-1,
+mrna29	chr1	+	291099	291900	291900	291900	2	291099,291599,	291400,291900,	0	gene29	none	none	-1,-1,
+mrna30	chr1	+	301099	301900	301900	301900	2	301099,301599,	301400,301900,	0	gene30	none	none	-1,-1,
+mrna31	chr1	+	311099	311900	311900	311900	2	311099,311599,	311400,311900,	0	gene31	none	none	-1,-1,
+mrna32	chr1	+	321099	321900	321900	321900	2	321099,321599,	321400,321900,	0	gene32	none	none	-1,-1,
+mrna33	chr1	+	331099	331900	331900	331900	2	331099,331599,	331400,331900,	0	gene33	none	none	-1,-1,
+mrna34	chr1	+	341099	341900	341900	341900	2	341099,341599,	341400,341900,	0	gene34	none	none	-1,-1,
+mrna35	chr1	+	351099	351900	351900	351900	2	351099,351599,	351400,351900,	0	gene35	none	none	-1,-1,
+mrna36	chr1	+	361099	361900	361900	361900	2	361099,361599,	361400,361900,	0	gene36	none	none	-1,-1,
+mrna37	chr1	+	371099	371900	371900	371900	2	371099,371599,	371400,371900,	0	gene37	none	none	-1,-1,
+mrna38	chr1	+	381099	381900	381900	381900	2	381099,381599,	381400,381900,	0	gene38	none	none	-1,-1,
+mrna39	chr1	+	391099	391900	391900	391900	2	391099,391599,	391400,391900,	0	gene39	none	none	-1,-1,
+mrna40	chr1	+	401099	401900	401900	401900	2	401099,401599,	401400,401900,	0	gene40	none	none	-1,-1,
+mrna41	chr1	+	411099	411900	411900	411900	2	411099,411599,	411400,411900,	0	gene41	none	none	-1,-1,
+mrna42	chr1	+	421099	421900	421900	421900	2	421099,421599,	421400,421900,	0	gene42	none	none	-1,-1,
+mrna43	chr1	+	431099	431900	431900	431900	2	431099,431599,	431400,431900,	0	gene43	none	none	-1,-1,
+mrna44	chr1	+	441099	441900	441900	441900	2	441099,441599,	441400,441900,	0	gene44	none	none	-1,-1,
+mrna45	chr1	+	451099	451900	451900	451900	2	451099,451599,	451400,451900,	0	gene45	none	none	-1,-1,
+mrna46	chr1	+	461099	461900	461900	461900	2	461099,461599,	461400,461900,	0	gene46	none	none	-1,-1,
+mrna47	chr1	+	471099	471900	471900	471900	2	471099,471599,	471400,471900,	0	gene47	none	none	-1,-1,
+mrna48	chr1	+	481099	481900	481900	481900	2	481099,481599,	481400,481900,	0	gene48	none	none	-1,-1,
+mrna49	chr1	+	491099	491900	491900	491900	2	491099,491599,	491400,491900,	0	gene49	none	none	-1,-1,
+mrna50	chr1	+	501099	501900	501900	501900	2	501099,501599,	501400,501900,	0	gene50	none	none	-1,-1,
+mrna51	chr1	+	511099	511900	511900	511900	2	511099,511599,	511400,511900,	0	gene51	none	none	-1,-1,
+mrna52	chr1	+	521099	521900	521900	521900	2	521099,521599,	521400,521900,	0	gene52	none	none	-1,-1,
+mrna53	chr1	+	531099	531900	531900	531900	2	531099,531599,	531400,531900,	0	gene53	none	none	-1,-1,
+mrna54	chr1	+	541099	541900	541900	541900	2	541099,541599,	541400,541900,	0	gene54	none	none	-1,-1,
+mrna55	chr1	+	551099	551900	551900	551900	2	551099,551599,	551400,551900,	0	gene55	none	none	-1,-1,
+mrna56	chr1	+	561099	561900	561900	561900	2	561099,561599,	561400,561900,	0	gene56	none	none	-1,-1,
+mrna57	chr1	+	571099	571900	571900	571900	2	571099,571599,	571400,571900,	0	gene57	none	none	-1,-1,
+mrna58	chr1	+	581099	581900	581900	581900	2	581099,581599,	581400,581900,	0	gene58	none	none	-1,-1,
+mrna59	chr1	+	591099	591900	591900	591900	2	591099,591599,	591400,591900,	0	gene59	none	none	-1,-1,
+mrna60	chr1	+	601099	601900	601900	601900	2	601099,601599,	601400,601900,	0	gene60	none	none	-1,-1,
+mrna61	chr1	+	611099	611900	611900	611900	2	611099,611599,	611400,611900,	0	gene61	none	none	-1,-1,
+mrna62	chr1	+	621099	621900	621900	621900	2	621099,621599,	621400,621900,	0	gene62	none	none	-1,-1,
+mrna63	chr1	+	631099	631900	631900	631900	2	631099,631599,	631400,631900,	0	gene63	none	none	-1,-1,
+mrna64	chr1	+	641099	641900	641900	641900	2	641099,641599,	641400,641900,	0	gene64	none	none	-1,-1,
+mrna65	chr1	+	651099	651900	651900	651900	2	651099,651599,	651400,651900,	0	gene65	none	none	-1,-1,
+mrna66	chr1	+	661099	661900	661900	661900	2	661099,661599,	661400,661900,	0	gene66	none	none	-1,-1,
+mrna67	chr1	+	671099	671900	671900	671900	2	671099,671599,	671400,671900,	0	gene67	none	none	-1,-1,
+mrna68	chr1	+	681099	681900	681900	681900	2	681099,681599,	681400,681900,	0	gene68	none	none	-1,-1,
+mrna69	chr1	+	691099	691900	691900	691900	2	691099,691599,	691400,691900,	0	gene69	none	none	-1,-1,
+mrna70	chr1	+	701099	701900	701900	701900	2	701099,701599,	701400,701900,	0	gene70	none	none	-1,-1,
+mrna71	chr1	+	711099	711900	711900	711900	2	711099,711599,	711400,711900,	0	gene71	none	none	-1,-1,
+mrna72	chr1	+	721099	721900	721900	721900	2	721099,721599,	721400,721900,	0	gene72	none	none	-1,-1,
+mrna73	chr1	+	731099	731900	731900	731900	2	731099,731599,	731400,731900,	0	gene73	none	none	-1,-1,
+mrna74	chr1	+	741099	741900	741900	741900	2	741099,741599,	741400,741900,	0	gene74	none	none	-1,-1,
+mrna75	chr1	+	751099	751900	751900	751900	2	751099,751599,	751400,751900,	0	gene75	none	none	-1,-1,
+mrna76	chr1	+	761099	761900	761900	761900	2	761099,761599,	761400,761900,	0	gene76	none	none	-1,-1,
+mrna77	chr1	+	771099	771900	771900	771900	2	771099,771599,	771400,771900,	0	gene77	none	none	-1,-1,
+mrna78	chr1	+	781099	781900	781900	781900	2	781099,781599,	781400,781900,	0	gene78	none	none	-1,-1,
+mrna79	chr1	+	791099	791900	791900	791900	2	791099,791599,	791400,791900,	0	gene79	none	none	-1,-1,
+mrna80	chr1	+	801099	801900	801900	801900	2	801099,801599,	801400,801900,	0	gene80	none	none	-1,-1,
+mrna81	chr1	+	811099	811900	811900	811900	2	811099,811599,	811400,811900,	0	gene81	none	none	-1,-1,
+mrna82	chr1	+	821099	821900	821900	821900	2	821099,821599,	821400,821900,	0	gene82	none	none	-1,-1,
+mrna83	chr1	+	831099	831900	831900	831900	2	831099,831599,	831400,831900,	0	gene83	none	none	-1,-1,
+mrna84	chr1	+	841099	841900	841900	841900	2	841099,841599,	841400,841900,	0	gene84	none	none	-1,-1,
+mrna85	chr1	+	851099	851900	851900	851900	2	851099,851599,	851400,851900,	0	gene85	none	none	-1,-1,
+mrna86	chr1	+	861099	861900	861900	861900	2	861099,861599,	861400,861900,	0	gene86	none	none	-1,-1,
+mrna87	chr1	+	871099	871900	871900	871900	2	871099,871599,	871400,871900,	0	gene87	none	none	-1,-1,
+mrna88	chr1	+	881099	881900	881900	881900	2	881099,881599,	881400,881900,	0	gene88	none	none	-1,-1,
+mrna89	chr1	+	891099	891900	891900	891900	2	891099,891599,	891400,891900,	0	gene89	none	none	-1,-1,
+mrna90	chr1	+	901099	901900	901900	901900	2	901099,901599,	901400,901900,	0	gene90	none	none	-1,-1,
+mrna91	chr1	+	911099	911900	911900	911900	2	911099,911599,	911400,911900,	0	gene91	none	none	-1,-1,
+mrna92	chr1	+	921099	921900	921900	921900	2	921099,921599,	921400,921900,	0	gene92	none	none	-1,-1,
+mrna93	chr1	+	931099	931900	931900	931900	2	931099,931599,	931400,931900,	0	gene93	none	none	-1,-1,
+mrna94	chr1	+	941099	941900	941900	941900	2	941099,941599,	941400,941900,	0	gene94	none	none	-1,-1,
+mrna95	chr1	+	951099	951900	951900	951900	2	951099,951599,	951400,951900,	0	gene95	none	none	-1,-1,
+mrna96	chr1	+	961099	961900	961900	961900	2	961099,961599,	961400,961900,	0	gene96	none	none	-1,-1,
+mrna97	chr1	+	971099	971900	971900	971900	2	971099,971599,	971400,971900,	0	gene97	none	none	-1,-1,
+mrna98	chr1	+	981099	981900	981900	981900	2	981099,981599,	981400,981900,	0	gene98	none	none	-1,-1,
+mrna99	chr1	+	991099	991900	991900	991900	2	991099,991599,	991400,991900,	0	gene99	none	none	-1,-1,
+mrna100	chr1	+	1001099	1001900	1001900	1001900	2	1001099,1001599,	1001400,1001900,	0	gene100	none	none	-1,-1,
+mrna101	chr1	+	1011099	1011900	1011900	1011900	2	1011099,1011599,	1011400,1011900,	0	gene101	none	none	-1,-1,
+mrna102	chr1	+	1021099	1021900	1021900	1021900	2	1021099,1021599,	1021400,1021900,	0	gene102	none	none	-1,-1,
+mrna103	chr1	+	1031099	1031900	1031900	1031900	2	1031099,1031599,	1031400,1031900,	0	gene103	none	none	-1,-1,
+mrna104	chr1	+	1041099	1041900	1041900	1041900	2	1041099,1041599,	1041400,1041900,	0	gene104	none	none	-1,-1,
+mrna105	chr1	+	1051099	1051900	1051900	1051900	2	1051099,1051599,	1051400,1051900,	0	gene105	none	none	-1,-1,
+mrna106	chr1	+	1061099	1061900	1061900	1061900	2	1061099,1061599,	1061400,1061900,	0	gene106	none	none	-1,-1,
+mrna107	chr1	+	1071099	1071900	1071900	1071900	2	1071099,1071599,	1071400,1071900,	0	gene107	none	none	-1,-1,
+mrna108	chr1	+	1081099	1081900	1081900	1081900	2	1081099,1081599,	1081400,1081900,	0	gene108	none	none	-1,-1,
+mrna109	chr1	+	1091099	1091900	1091900	1091900	2	1091099,1091599,	1091400,1091900,	0	gene109	none	none	-1,-1,
+mrna110	chr1	+	1101099	1101900	1101900	1101900	2	1101099,1101599,	1101400,1101900,	0	gene110	none	none	-1,-1,
+mrna111	chr1	+	1111099	1111900	1111900	1111900	2	1111099,1111599,	1111400,1111900,	0	gene111	none	none	-1,-1,
+mrna112	chr1	+	1121099	1121900	1121900	1121900	2	1121099,1121599,	1121400,1121900,	0	gene112	none	none	-1,-1,
+mrna113	chr1	+	1131099	1131900	1131900	1131900	2	1131099,1131599,	1131400,1131900,	0	gene113	none	none	-1,-1,
+mrna114	chr1	+	1141099	1141900	1141900	1141900	2	1141099,1141599,	1141400,1141900,	0	gene114	none	none	-1,-1,
+mrna115	chr1	+	1151099	1151900	1151900	1151900	2	1151099,1151599,	1151400,1151900,	0	gene115	none	none	-1,-1,
+mrna116	chr1	+	1161099	1161900	1161900	1161900	2	1161099,1161599,	1161400,1161900,	0	gene116	none	none	-1,-1,
+mrna117	chr1	+	1171099	1171900	1171900	1171900	2	1171099,1171599,	1171400,1171900,	0	gene117	none	none	-1,-1,
+mrna118	chr1	+	1181099	1181900	1181900	1181900	2	1181099,1181599,	1181400,1181900,	0	gene118	none	none	-1,-1,
+mrna119	chr1	+	1191099	1191900	1191900	1191900	2	1191099,1191599,	1191400,1191900,	0	gene119	none	none	-1,-1,
+mrna120	chr1	+	1201099	1201900	1201900	1201900	2	1201099,1201599,	1201400,1201900,	0	gene120	none	none	-1,-1,
+mrna121	chr1	+	1211099	1211900	1211900	1211900	2	1211099,1211599,	1211400,1211900,	0	gene121	none	none	-1,-1,
+mrna122	chr1	+	1221099	1221900	1221900	1221900	2	1221099,1221599,	1221400,1221900,	0	gene122	none	none	-1,-1,
+mrna123	chr1	+	1231099	1231900	1231900	1231900	2	1231099,1231599,	1231400,1231900,	0	gene123	none	none	-1,-1,
+mrna124	chr1	+	1241099	1241900	1241900	1241900	2	1241099,1241599,	1241400,1241900,	0	gene124	none	none	-1,-1,
+mrna125	chr1	+	1251099	1251900	1251900	1251900	2	1251099,1251599,	1251400,1251900,	0	gene125	none	none	-1,-1,
+mrna126	chr1	+	1261099	1261900	1261900	1261900	2	1261099,1261599,	1261400,1261900,	0	gene126	none	none	-1,-1,
+mrna127	chr1	+	1271099	1271900	1271900	1271900	2	1271099,1271599,	1271400,1271900,	0	gene127	none	none	-1,-1,
+mrna128	chr1	+	1281099	1281900	1281900	1281900	2	1281099,1281599,	1281400,1281900,	0	gene128	none	none	-1,-1,
+mrna129	chr1	+	1291099	1291900	1291900	1291900	2	1291099,1291599,	1291400,1291900,	0	gene129	none	none	-1,-1,
+mrna130	chr1	+	1301099	1301900	1301900	1301900	2	1301099,1301599,	1301400,1301900,	0	gene130	none	none	-1,-1,
+mrna131	chr1	+	1311099	1311900	1311900	1311900	2	1311099,1311599,	1311400,1311900,	0	gene131	none	none	-1,-1,
+mrna132	chr1	+	1321099	1321900	1321900	1321900	2	1321099,1321599,	1321400,1321900,	0	gene132	none	none	-1,-1,
+mrna133	chr1	+	1331099	1331900	1331900	1331900	2	1331099,1331599,	1331400,1331900,	0	gene133	none	none	-1,-1,
+mrna134	chr1	+	1341099	1341900	1341900	1341900	2	1341099,1341599,	1341400,1341900,	0	gene134	none	none	-1,-1,
+mrna135	chr1	+	1351099	1351900	1351900	1351900	2	1351099,1351599,	1351400,1351900,	0	gene135	none	none	-1,-1,
+mrna136	chr1	+	1361099	1361900	1361900	1361900	2	1361099,1361599,	1361400,1361900,	0	gene136	none	none	-1,-1,
+mrna137	chr1	+	1371099	1371900	1371900	1371900	2	1371099,1371599,	1371400,1371900,	0	gene137	none	none	-1,-1,
+mrna138	chr1	+	1381099	1381900	1381900	1381900	2	1381099,1381599,	1381400,1381900,	0	gene138	none	none	-1,-1,
+mrna139	chr1	+	1391099	1391900	1391900	1391900	2	1391099,1391599,	1391400,1391900,	0	gene139	none	none	-1,-1,
+mrna140	chr1	+	1401099	1401900	1401900	1401900	2	1401099,1401599,	1401400,1401900,	0	gene140	none	none	-1,-1,
+mrna141	chr1	+	1411099	1411900	1411900	1411900	2	1411099,1411599,	1411400,1411900,	0	gene141	none	none	-1,-1,
+mrna142	chr1	+	1421099	1421900	1421900	1421900	2	1421099,1421599,	1421400,1421900,	0	gene142	none	none	-1,-1,
+mrna143	chr1	+	1431099	1431900	1431900	1431900	2	1431099,1431599,	1431400,1431900,	0	gene143	none	none	-1,-1,
+mrna144	chr1	+	1441099	1441900	1441900	1441900	2	1441099,1441599,	1441400,1441900,	0	gene144	none	none	-1,-1,
+mrna145	chr1	+	1451099	1451900	1451900	1451900	2	1451099,1451599,	1451400,1451900,	0	gene145	none	none	-1,-1,
+mrna146	chr1	+	1461099	1461900	1461900	1461900	2	1461099,1461599,	1461400,1461900,	0	gene146	none	none	-1,-1,
+mrna147	chr1	+	1471099	1471900	1471900	1471900	2	1471099,1471599,	1471400,1471900,	0	gene147	none	none	-1,-1,
+mrna148	chr1	+	1481099	1481900	1481900	1481900	2	1481099,1481599,	1481400,1481900,	0	gene148	none	none	-1,-1,
+mrna149	chr1	+	1491099	1491900	1491900	1491900	2	1491099,1491599,	1491400,1491900,	0	gene149	none	none	-1,-1,
+mrna150	chr1	+	1501099	1501900	1501900	1501900	2	1501099,1501599,	1501400,1501900,	0	gene150	none	none	-1,-1,
+mrna151	chr1	+	1511099	1511900	1511900	1511900	2	1511099,1511599,	1511400,1511900,	0	gene151	none	none	-1,-1,
+mrna152	chr1	+	1521099	1521900	1521900	1521900	2	1521099,1521599,	1521400,1521900,	0	gene152	none	none	-1,-1,
+mrna153	chr1	+	1531099	1531900	1531900	1531900	2	1531099,1531599,	1531400,1531900,	0	gene153	none	none	-1,-1,
+mrna154	chr1	+	1541099	1541900	1541900	1541900	2	1541099,1541599,	1541400,1541900,	0	gene154	none	none	-1,-1,
+mrna155	chr1	+	1551099	1551900	1551900	1551900	2	1551099,1551599,	1551400,1551900,	0	gene155	none	none	-1,-1,
+mrna156	chr1	+	1561099	1561900	1561900	1561900	2	1561099,1561599,	1561400,1561900,	0	gene156	none	none	-1,-1,
+mrna157	chr1	+	1571099	1571900	1571900	1571900	2	1571099,1571599,	1571400,1571900,	0	gene157	none	none	-1,-1,
+mrna158	chr1	+	1581099	1581900	1581900	1581900	2	1581099,1581599,	1581400,1581900,	0	gene158	none	none	-1,-1,
+mrna159	chr1	+	1591099	1591900	1591900	1591900	2	1591099,1591599,	1591400,1591900,	0	gene159	none	none	-1,-1,
+mrna160	chr1	+	1601099	1601900	1601900	1601900	2	1601099,1601599,	1601400,1601900,	0	gene160	none	none	-1,-1,
+mrna161	chr1	+	1611099	1611900	1611900	1611900	2	1611099,1611599,	1611400,1611900,	0	gene161	none	none	-1,-1,
+mrna162	chr1	+	1621099	1621900	1621900	1621900	2	1621099,1621599,	1621400,1621900,	0	gene162	none	none	-1,-1,
+mrna163	chr1	+	1631099	1631900	1631900	1631900	2	1631099,1631599,	1631400,1631900,	0	gene163	none	none	-1,-1,
+mrna164	chr1	+	1641099	1641900	1641900	1641900	2	1641099,1641599,	1641400,1641900,	0	gene164	none	none	-1,-1,
+mrna165	chr1	+	1651099	1651900	1651900	1651900	2	1651099,1651599,	1651400,1651900,	0	gene165	none	none	-1,-1,
+mrna166	chr1	+	1661099	1661900	1661900	1661900	2	1661099,1661599,	1661400,1661900,	0	gene166	none	none	-1,-1,
+mrna167	chr1	+	1671099	1671900	1671900	1671900	2	1671099,1671599,	1671400,1671900,	0	gene167	none	none	-1,-1,
+mrna168	chr1	+	1681099	1681900	1681900	1681900	2	1681099,1681599,	1681400,1681900,	0	gene168	none	none	-1,-1,
+mrna169	chr1	+	1691099	1691900	1691900	1691900	2	1691099,1691599,	1691400,1691900,	0	gene169	none	none	-1,-1,
+mrna170	chr1	+	1701099	1701900	1701900	1701900	2	1701099,1701599,	1701400,1701900,	0	gene170	none	none	-1,-1,
+mrna171	chr1	+	1711099	1711900	1711900	1711900	2	1711099,1711599,	1711400,1711900,	0	gene171	none	none	-1,-1,
+mrna172	chr1	+	1721099	1721900	1721900	1721900	2	1721099,1721599,	1721400,1721900,	0	gene172	none	none	-1,-1,
+mrna173	chr1	+	1731099	1731900	1731900	1731900	2	1731099,1731599,	1731400,1731900,	0	gene173	none	none	-1,-1,
+mrna174	chr1	+	1741099	1741900	1741900	1741900	2	1741099,1741599,	1741400,1741900,	0	gene174	none	none	-1,-1,
+mrna175	chr1	+	1751099	1751900	1751900	1751900	2	1751099,1751599,	1751400,1751900,	0	gene175	none	none	-1,-1,
+mrna176	chr1	+	1761099	1761900	1761900	1761900	2	1761099,1761599,	1761400,1761900,	0	gene176	none	none	-1,-1,
+mrna177	chr1	+	1771099	1771900	1771900	1771900	2	1771099,1771599,	1771400,1771900,	0	gene177	none	none	-1,-1,
+mrna178	chr1	+	1781099	1781900	1781900	1781900	2	1781099,1781599,	1781400,1781900,	0	gene178	none	none	-1,-1,
+mrna179	chr1	+	1791099	1791900	1791900	1791900	2	1791099,1791599,	1791400,1791900,	0	gene179	none	none	-1,-1,
+mrna180	chr1	+	1801099	1801900	1801900	1801900	2	1801099,1801599,	1801400,1801900,	0	gene180	none	none	-1,-1,
+mrna181	chr1	+	1811099	1811900	1811900	1811900	2	1811099,1811599,	1811400,1811900,	0	gene181	none	none	-1,-1,
+mrna182	chr1	+	1821099	1821900	1821900	1821900	2	1821099,1821599,	1821400,1821900,	0	gene182	none	none	-1,-1,
+mrna183	chr1	+	1831099	1831900	1831900	1831900	2	1831099,1831599,	1831400,1831900,	0	gene183	none	none	-1,-1,
+mrna184	chr1	+	1841099	1841900	1841900	1841900	2	1841099,1841599,	1841400,1841900,	0	gene184	none	none	-1,-1,
+mrna185	chr1	+	1851099	1851900	1851900	1851900	2	1851099,1851599,	1851400,1851900,	0	gene185	none	none	-1,-1,
+mrna186	chr1	+	1861099	1861900	1861900	1861900	2	1861099,1861599,	1861400,1861900,	0	gene186	none	none	-1,-1,
+mrna187	chr1	+	1871099	1871900	1871900	1871900	2	1871099,1871599,	1871400,1871900,	0	gene187	none	none	-1,-1,
+mrna188	chr1	+	1881099	1881900	1881900	1881900	2	1881099,1881599,	1881400,1881900,	0	gene188	none	none	-1,-1,
+mrna189	chr1	+	1891099	1891900	1891900	1891900	2	1891099,1891599,	1891400,1891900,	0	gene189	none	none	-1,-1,
+mrna190	chr1	+	1901099	1901900	1901900	1901900	2	1901099,1901599,	1901400,1901900,	0	gene190	none	none	-1,-1,
+mrna191	chr1	+	1911099	1911900	1911900	1911900	2	1911099,1911599,	1911400,1911900,	0	gene191	none	none	-1,-1,
+mrna192	chr1	+	1921099	1921900	1921900	1921900	2	1921099,1921599,	1921400,1921900,	0	gene192	none	none	-1,-1,
+mrna193	chr1	+	1931099	1931900	1931900	1931900	2	1931099,1931599,	1931400,1931900,	0	gene193	none	none	-1,-1,
+mrna194	chr1	+	1941099	1941900	1941900	1941900	2	1941099,1941599,	1941400,1941900,	0	gene194	none	none	-1,-1,
+mrna195	chr1	+	1951099	1951900	1951900	1951900	2	1951099,1951599,	1951400,1951900,	0	gene195	none	none	-1,-1,
+mrna196	chr1	+	1961099	1961900	1961900	1961900	2	1961099,1961599,	1961400,1961900,	0	gene196	none	none	-1,-1,
+mrna197	chr1	+	1971099	1971900	1971900	1971900	2	1971099,1971599,	1971400,1971900,	0	gene197	none	none	-1,-1,
+mrna198	chr1	+	1981099	1981900	1981900	1981900	2	1981099,1981599,	1981400,1981900,	0	gene198	none	none	-1,-1,
+mrna199	chr1	+	1991099	1991900	1991900	1991900	2	1991099,1991599,	1991400,1991900,	0	gene199	none	none	-1,-1,
+mrna200	chr1	+	2001099	2001900	2001900	2001900	2	2001099,2001599,	2001400,2001900,	0	gene200	none	none	-1,-1,
+mrna201	chr1	+	2011099	2011900	2011900	2011900	2	2011099,2011599,	2011400,2011900,	0	gene201	none	none	-1,-1,
+mrna202	chr1	+	2021099	2021900	2021900	2021900	2	2021099,2021599,	2021400,2021900,	0	gene202	none	none	-1,-1,
+mrna203	chr1	+	2031099	2031900	2031900	2031900	2	2031099,2031599,	2031400,2031900,	0	gene203	none	none	-1,-1,
+mrna204	chr1	+	2041099	2041900	2041900	2041900	2	2041099,2041599,	2041400,2041900,	0	gene204	none	none	-1,-1,
+mrna205	chr1	+	2051099	2051900	2051900	2051900	2	2051099,2051599,	2051400,2051900,	0	gene205	none	none	-1,-1,
+mrna206	chr1	+	2061099	2061900	2061900	2061900	2	2061099,2061599,	2061400,2061900,	0	gene206	none	none	-1,-1,
+mrna207	chr1	+	2071099	2071900	2071900	2071900	2	2071099,2071599,	2071400,2071900,	0	gene207	none	none	-1,-1,
+mrna208	chr1	+	2081099	2081900	2081900	2081900	2	2081099,2081599,	2081400,2081900,	0	gene208	none	none	-1,-1,
+mrna209	chr1	+	2091099	2091900	2091900	2091900	2	2091099,2091599,	2091400,2091900,	0	gene209	none	none	-1,-1,
+mrna210	chr1	+	2101099	2101900	2101900	2101900	2	2101099,2101599,	2101400,2101900,	0	gene210	none	none	-1,-1,
+mrna211	chr1	+	2111099	2111900	2111900	2111900	2	2111099,2111599,	2111400,2111900,	0	gene211	none	none	-1,-1,
+mrna212	chr1	+	2121099	2121900	2121900	2121900	2	2121099,2121599,	2121400,2121900,	0	gene212	none	none	-1,-1,
+mrna213	chr1	+	2131099	2131900	2131900	2131900	2	2131099,2131599,	2131400,2131900,	0	gene213	none	none	-1,-1,
+mrna214	chr1	+	2141099	2141900	2141900	2141900	2	2141099,2141599,	2141400,2141900,	0	gene214	none	none	-1,-1,
+mrna215	chr1	+	2151099	2151900	2151900	2151900	2	2151099,2151599,	2151400,2151900,	0	gene215	none	none	-1,-1,
+mrna216	chr1	+	2161099	2161900	2161900	2161900	2	2161099,2161599,	2161400,2161900,	0	gene216	none	none	-1,-1,
+mrna217	chr1	+	2171099	2171900	2171900	2171900	2	2171099,2171599,	2171400,2171900,	0	gene217	none	none	-1,-1,
+mrna218	chr1	+	2181099	2181900	2181900	2181900	2	2181099,2181599,	2181400,2181900,	0	gene218	none	none	-1,-1,
+mrna219	chr1	+	2191099	2191900	2191900	2191900	2	2191099,2191599,	2191400,2191900,	0	gene219	none	none	-1,-1,
+mrna220	chr1	+	2201099	2201900	2201900	2201900	2	2201099,2201599,	2201400,2201900,	0	gene220	none	none	-1,-1,
+mrna221	chr1	+	2211099	2211900	2211900	2211900	2	2211099,2211599,	2211400,2211900,	0	gene221	none	none	-1,-1,
+mrna222	chr1	+	2221099	2221900	2221900	2221900	2	2221099,2221599,	2221400,2221900,	0	gene222	none	none	-1,-1,
+mrna223	chr1	+	2231099	2231900	2231900	2231900	2	2231099,2231599,	2231400,2231900,	0	gene223	none	none	-1,-1,
+mrna224	chr1	+	2241099	2241900	2241900	2241900	2	2241099,2241599,	2241400,2241900,	0	gene224	none	none	-1,-1,
+mrna225	chr1	+	2251099	2251900	2251900	2251900	2	2251099,2251599,	2251400,2251900,	0	gene225	none	none	-1,-1,
+mrna226	chr1	+	2261099	2261900	2261900	2261900	2	2261099,2261599,	2261400,2261900,	0	gene226	none	none	-1,-1,
+mrna227	chr1	+	2271099	2271900	2271900	2271900	2	2271099,2271599,	2271400,2271900,	0	gene227	none	none	-1,-1,
+mrna228	chr1	+	2281099	2281900	2281900	2281900	2	2281099,2281599,	2281400,2281900,	0	gene228	none	none	-1,-1,
+mrna229	chr1	+	2291099	2291900	2291900	2291900	2	2291099,2291599,	2291400,2291900,	0	gene229	none	none	-1,-1,
+mrna230	chr1	+	2301099	2301900	2301900	2301900	2	2301099,2301599,	2301400,2301900,	0	gene230	none	none	-1,-1,
+mrna231	chr1	+	2311099	2311900	2311900	2311900	2	2311099,2311599,	2311400,2311900,	0	gene231	none	none	-1,-1,
+mrna232	chr1	+	2321099	2321900	2321900	2321900	2	2321099,2321599,	2321400,2321900,	0	gene232	none	none	-1,-1,
+mrna233	chr1	+	2331099	2331900	2331900	2331900	2	2331099,2331599,	2331400,2331900,	0	gene233	none	none	-1,-1,
+mrna234	chr1	+	2341099	2341900	2341900	2341900	2	2341099,2341599,	2341400,2341900,	0	gene234	none	none	-1,-1,
+mrna235	chr1	+	2351099	2351900	2351900	2351900	2	2351099,2351599,	2351400,2351900,	0	gene235	none	none	-1,-1,
+mrna236	chr1	+	2361099	2361900	2361900	2361900	2	2361099,2361599,	2361400,2361900,	0	gene236	none	none	-1,-1,
+mrna237	chr1	+	2371099	2371900	2371900	2371900	2	2371099,2371599,	2371400,2371900,	0	gene237	none	none	-1,-1,
+mrna238	chr1	+	2381099	2381900	2381900	2381900	2	2381099,2381599,	2381400,2381900,	0	gene238	none	none	-1,-1,
+mrna239	chr1	+	2391099	2391900	2391900	2391900	2	2391099,2391599,	2391400,2391900,	0	gene239	none	none	-1,-1,
+mrna240	chr1	+	2401099	2401900	2401900	2401900	2	2401099,2401599,	2401400,2401900,	0	gene240	none	none	-1,-1,
+mrna241	chr1	+	2411099	2411900	2411900	2411900	2	2411099,2411599,	2411400,2411900,	0	gene241	none	none	-1,-1,
+mrna242	chr1	+	2421099	2421900	2421900	2421900	2	2421099,2421599,	2421400,2421900,	0	gene242	none	none	-1,-1,
+mrna243	chr1	+	2431099	2431900	2431900	2431900	2	2431099,2431599,	2431400,2431900,	0	gene243	none	none	-1,-1,
+mrna244	chr1	+	2441099	2441900	2441900	2441900	2	2441099,2441599,	2441400,2441900,	0	gene244	none	none	-1,-1,
+mrna245	chr1	+	2451099	2451900	2451900	2451900	2	2451099,2451599,	2451400,2451900,	0	gene245	none	none	-1,-1,
+mrna246	chr1	+	2461099	2461900	2461900	2461900	2	2461099,2461599,	2461400,2461900,	0	gene246	none	none	-1,-1,
+mrna247	chr1	+	2471099	2471900	2471900	2471900	2	2471099,2471599,	2471400,2471900,	0	gene247	none	none	-1,-1,
+mrna248	chr1	+	2481099	2481900	2481900	2481900	2	2481099,2481599,	2481400,2481900,	0	gene248	none	none	-1,-1,
+mrna249	chr1	+	2491099	2491900	2491900	2491900	2	2491099,2491599,	2491400,2491900,	0	gene249	none	none	-1,-1,
+mrna250	chr1	+	2501099	2501900	2501900	2501900	2	2501099,2501599,	2501400,2501900,	0	gene250	none	none	-1,-1,
+mrna251	chr1	+	2511099	2511900	2511900	2511900	2	2511099,2511599,	2511400,2511900,	0	gene251	none	none	-1,-1,
+mrna252	chr1	+	2521099	2521900	2521900	2521900	2	2521099,2521599,	2521400,2521900,	0	gene252	none	none	-1,-1,
+mrna253	chr1	+	2531099	2531900	2531900	2531900	2	2531099,2531599,	2531400,2531900,	0	gene253	none	none	-1,-1,
+mrna254	chr1	+	2541099	2541900	2541900	2541900	2	2541099,2541599,	2541400,2541900,	0	gene254	none	none	-1,-1,
+mrna255	chr1	+	2551099	2551900	2551900	2551900	2	2551099,2551599,	2551400,2551900,	0	gene255	none	none	-1,-1,
+mrna256	chr1	+	2561099	2561900	2561900	2561900	2	2561099,2561599,	2561400,2561900,	0	gene256	none	none	-1,-1,
+mrna257	chr1	+	2571099	2571900	2571900	2571900	2	2571099,2571599,	2571400,2571900,	0	gene257	none	none	-1,-1,
+mrna258	chr1	+	2581099	2581900	2581900	2581900	2	2581099,2581599,	2581400,2581900,	0	gene258	none	none	-1,-1,
+mrna259	chr1	+	2591099	2591900	2591900	2591900	2	2591099,2591599,	2591400,2591900,	0	gene259	none	none	-1,-1,
+mrna260	chr1	+	2601099	2601900	2601900	2601900	2	2601099,2601599,	2601400,2601900,	0	gene260	none	none	-1,-1,
+mrna261	chr1	+	2611099	2611900	2611900	2611900	2	2611099,2611599,	2611400,2611900,	0	gene261	none	none	-1,-1,
+mrna262	chr1	+	2621099	2621900	2621900	2621900	2	2621099,2621599,	2621400,2621900,	0	gene262	none	none	-1,-1,
+mrna263	chr1	+	2631099	2631900	2631900	2631900	2	2631099,2631599,	2631400,2631900,	0	gene263	none	none	-1,-1,
+mrna264	chr1	+	2641099	2641900	2641900	2641900	2	2641099,2641599,	2641400,2641900,	0	gene264	none	none	-1,-1,
+mrna265	chr1	+	2651099	2651900	2651900	2651900	2	2651099,2651599,	2651400,2651900,	0	gene265	none	none	-1,-1,
+mrna266	chr1	+	2661099	2661900	2661900	2661900	2	2661099,2661599,	2661400,2661900,	0	gene266	none	none	-1,-1,
+mrna267	chr1	+	2671099	2671900	2671900	2671900	2	2671099,2671599,	2671400,2671900,	0	gene267	none	none	-1,-1,
+mrna268	chr1	+	2681099	2681900	2681900	2681900	2	2681099,2681599,	2681400,2681900,	0	gene268	none	none	-1,-1,
+mrna269	chr1	+	2691099	2691900	2691900	2691900	2	2691099,2691599,	2691400,2691900,	0	gene269	none	none	-1,-1,
+mrna270	chr1	+	2701099	2701900	2701900	2701900	2	2701099,2701599,	2701400,2701900,	0	gene270	none	none	-1,-1,
+mrna271	chr1	+	2711099	2711900	2711900	2711900	2	2711099,2711599,	2711400,2711900,	0	gene271	none	none	-1,-1,
+mrna272	chr1	+	2721099	2721900	2721900	2721900	2	2721099,2721599,	2721400,2721900,	0	gene272	none	none	-1,-1,
+mrna273	chr1	+	2731099	2731900	2731900	2731900	2	2731099,2731599,	2731400,2731900,	0	gene273	none	none	-1,-1,
+mrna274	chr1	+	2741099	2741900	2741900	2741900	2	2741099,2741599,	2741400,2741900,	0	gene274	none	none	-1,-1,
+mrna275	chr1	+	2751099	2751900	2751900	2751900	2	2751099,2751599,	2751400,2751900,	0	gene275	none	none	-1,-1,
+mrna276	chr1	+	2761099	2761900	2761900	2761900	2	2761099,2761599,	2761400,2761900,	0	gene276	none	none	-1,-1,
+mrna277	chr1	+	2771099	2771900	2771900	2771900	2	2771099,2771599,	2771400,2771900,	0	gene277	none	none	-1,-1,
+mrna278	chr1	+	2781099	2781900	2781900	2781900	2	2781099,2781599,	2781400,2781900,	0	gene278	none	none	-1,-1,
+mrna279	chr1	+	2791099	2791900	2791900	2791900	2	2791099,2791599,	2791400,2791900,	0	gene279	none	none	-1,-1,
+mrna280	chr1	+	2801099	2801900	2801900	2801900	2	2801099,2801599,	2801400,2801900,	0	gene280	none	none	-1,-1,
+mrna281	chr1	+	2811099	2811900	2811900	2811900	2	2811099,2811599,	2811400,2811900,	0	gene281	none	none	-1,-1,
+mrna282	chr1	+	2821099	2821900	2821900	2821900	2	2821099,2821599,	2821400,2821900,	0	gene282	none	none	-1,-1,
+mrna283	chr1	+	2831099	2831900	2831900	2831900	2	2831099,2831599,	2831400,2831900,	0	gene283	none	none	-1,-1,
+mrna284	chr1	+	2841099	2841900	2841900	2841900	2	2841099,2841599,	2841400,2841900,	0	gene284	none	none	-1,-1,
+mrna285	chr1	+	2851099	2851900	2851900	2851900	2	2851099,2851599,	2851400,2851900,	0	gene285	none	none	-1,-1,
+mrna286	chr1	+	2861099	2861900	2861900	2861900	2	2861099,2861599,	2861400,2861900,	0	gene286	none	none	-1,-1,
+mrna287	chr1	+	2871099	2871900	2871900	2871900	2	2871099,2871599,	2871400,2871900,	0	gene287	none	none	-1,-1,
+mrna288	chr1	+	2881099	2881900	2881900	2881900	2	2881099,2881599,	2881400,2881900,	0	gene288	none	none	-1,-1,
+mrna289	chr1	+	2891099	2891900	2891900	2891900	2	2891099,2891599,	2891400,2891900,	0	gene289	none	none	-1,-1,
+mrna290	chr1	+	2901099	2901900	2901900	2901900	2	2901099,2901599,	2901400,2901900,	0	gene290	none	none	-1,-1,
+mrna291	chr1	+	2911099	2911900	2911900	2911900	2	2911099,2911599,	2911400,2911900,	0	gene291	none	none	-1,-1,
+mrna292	chr1	+	2921099	2921900	2921900	2921900	2	2921099,2921599,	2921400,2921900,	0	gene292	none	none	-1,-1,
+mrna293	chr1	+	2931099	2931900	2931900	2931900	2	2931099,2931599,	2931400,2931900,	0	gene293	none	none	-1,-1,
+mrna294	chr1	+	2941099	2941900	2941900	2941900	2	2941099,2941599,	2941400,2941900,	0	gene294	none	none	-1,-1,
+mrna295	chr1	+	2951099	2951900	2951900	2951900	2	2951099,2951599,	2951400,2951900,	0	gene295	none	none	-1,-1,
+mrna296	chr1	+	2961099	2961900	2961900	2961900	2	2961099,2961599,	2961400,2961900,	0	gene296	none	none	-1,-1,
+mrna297	chr1	+	2971099	2971900	2971900	2971900	2	2971099,2971599,	2971400,2971900,	0	gene297	none	none	-1,-1,
+mrna298	chr1	+	2981099	2981900	2981900	2981900	2	2981099,2981599,	2981400,2981900,	0	gene298	none	none	-1,-1,
+mrna299	chr1	+	2991099	2991900	2991900	2991900	2	2991099,2991599,	2991400,2991900,	0	gene299	none	none	-1,-1,
@@ -32,7 +32,11 @@ errAbort(
   "     -geneNameAsName2 - if specified, use gene_name for the name2 field\n"
   "      instead of gene_id.\n"
   "     -includeVersion - it gene_version and/or transcript_version attributes exist, include the version\n"
-  "      in the corresponding identifiers.\n");
+  "      in the corresponding identifiers.\n"
+  "     -stream - convert a chunk of the GTF at a time rather than loading it all.  If lines\n"
+  "      are grouped by chromosome and none start before the last gene line, chunks end at\n"
+  "      gene lines that start after the end of the chunk, otherwise at chromosome changes.\n"
+  "      Unsorted input is loaded as a whole.  A transcript split between chunks is an error.\n");
 }
 
 static struct optionSpec options[] = {
@@ -45,6 +49,7 @@ static struct optionSpec options[] = {
     {"impliedStopAfterCds", OPTION_BOOLEAN},
     {"geneNameAsName2", OPTION_BOOLEAN},
     {"includeVersion", OPTION_BOOLEAN},
+    {"stream", OPTION_BOOLEAN},
     {NULL, 0},
 };
 boolean clGenePredExt = FALSE;  /* include frame and geneName */
@@ -54,6 +59,7 @@ struct slName *clSourcePrefixes; /* list of source prefixes to match */
 boolean clIncludeVersion = FALSE; /* add version numbers to identifiers if available */
 unsigned clGxfOptions = 0;       /* options for converting GTF/GFF */
 boolean doSimple = FALSE;      /* only check column validity */
+boolean clStream = FALSE;      /* convert a chunk at a time */
 int badGroupCount = 0;  /* count of inconsistent groups found */
 
 
@@ -184,16 +190,68 @@ if (clSourcePrefixes != NULL)
 return TRUE;
 }
 
+static void checkIsGtf(struct gffFile *gtf, char *gtfFile)
+/* abort if the file isn't GTF */
+{
+if (!gtf->isGtf)
+    errAbort("%s doesn't appear to be a GTF file (GFF not supported by this program)", gtfFile);
+}
+
+static void convertGroups(struct gffFile *gtf, FILE *gpFh, FILE *infoFh)
+/* convert the grouped lines of a GTF file or chunk of one */
+{
+struct gffGroup *group;
+if (!doSimple)
+    for (group = gtf->groupList; group != NULL; group = group->next)
+	if (inclGroup(group))
+	    gtfGroupToGenePred(gtf, group, gpFh, infoFh);
+}
+
+static void checkChunkGroups(struct gffFile *gtf, struct hash *doneGroups)
+/* abort if a group in a chunk was in an earlier chunk, as happens with a
+ * transcript on more than one chromosome */
+{
+struct gffGroup *group;
+for (group = gtf->groupList; group != NULL; group = group->next)
+    {
+    if (hashLookup(doneGroups, group->name) != NULL)
+        errAbort("transcript %s on %s is also in an earlier part of %s, which can't be converted with -stream",
+                 group->name, group->seq, gtf->fileName);
+    hashAdd(doneGroups, group->name, NULL);
+    }
+}
+
+static void convertStream(char *gtfFile, FILE *gpFh, FILE *infoFh)
+/* convert a GTF file a chunk at a time */
+{
+boolean isSorted = gffIsSortedByGene(gtfFile);
+struct lineFile *lf = lineFileOpen(gtfFile, TRUE);
+struct hash *doneGroups = hashNew(16);
+struct gffFile *gtf;
+while ((gtf = gffReadNextChunk(lf, isSorted)) != NULL)
+    {
+    checkIsGtf(gtf, gtfFile);
+    gffGroupLines(gtf);
+    checkChunkGroups(gtf, doneGroups);
+    convertGroups(gtf, gpFh, infoFh);
+    gffFileFree(&gtf);
+    }
+hashFree(&doneGroups);
+lineFileClose(&lf);
+}
+
 static void gtfToGenePred(char *gtfFile, char *gpFile, char *infoFile)
 /* gtfToGenePred -  convert a GTF file to a genePred.. */
 {
-struct gffFile *gtf = gffRead(gtfFile);
+struct gffFile *gtf = NULL;
 FILE *gpFh, *infoFh = NULL;
-struct gffGroup *group;
 
-if (!gtf->isGtf)
-    errAbort("%s doesn't appear to be a GTF file (GFF not supported by this program)", gtfFile);
-gffGroupLines(gtf);
+if (!clStream)
+    {
+    gtf = gffRead(gtfFile);
+    checkIsGtf(gtf, gtfFile);
+    gffGroupLines(gtf);
+    }
 gpFh = mustOpen(gpFile, "w");
 if (infoFile != NULL)
     {
@@ -201,10 +259,10 @@ if (infoFile != NULL)
     fputs(infoHeader, infoFh);
     }
 
-if (!doSimple)
-    for (group = gtf->groupList; group != NULL; group = group->next)
-	if (inclGroup(group))
-	    gtfGroupToGenePred(gtf, group, gpFh, infoFh);
+if (clStream)
+    convertStream(gtfFile, gpFh, infoFh);
+else
+    convertGroups(gtf, gpFh, infoFh);
 
 carefulClose(&gpFh);
 gffFileFree(&gtf);
@@ -222,6 +280,7 @@ clIgnoreGroupsWithoutExons = optionExists("ignoreGroupsWithoutExons");
 clAllErrors = optionExists("allErrors");
 clIncludeVersion = optionExists("includeVersion");
 clSourcePrefixes = optionMultiVal("sourcePrefix", NULL);
+clStream = optionExists("stream");
 if (optionExists("impliedStopAfterCds"))
     clGxfOptions |= genePredGxfImpliedStopAfterCds;
 if (optionExists("geneNameAsName2"))
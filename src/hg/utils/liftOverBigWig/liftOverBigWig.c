@@ -0,0 +1,453 @@
+/* liftOverBigWig - Move a bigWig file to another assembly through a liftOver chain file. */
+
+/* This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+
+#include "common.h"
+#include "linefile.h"
+#include "hash.h"
+#include "options.h"
+#include "localmem.h"
+#include "rangeTree.h"
+#include "chain.h"
+#include "bbiFile.h"
+#include "bwgInternal.h"
+#include "bigWig.h"
+
+static int blockSize = 256;
+static int itemsPerSlot = 1024;
+static boolean doCompress = TRUE;
+static int threads = 1;
+
+void usage()
+/* Explain usage and exit. */
+{
+errAbort(
+  "liftOverBigWig - Move a bigWig file to another assembly through a liftOver chain file.\n"
+  "usage:\n"
+  "   liftOverBigWig input.srcDb.bw srcDbToDestDb.over.chain.gz destDb.chrom.sizes output.destDb.bw\n"
+  "Each run of data is projected through the aligned blocks of every chain that covers it.\n"
+  "Parts of runs in chain gaps or not covered by chains are dropped.  Where lifted runs\n"
+  "overlap in the new assembly, the bases come from the highest scoring chain.  Adjacent\n"
+  "runs with the same value are merged, and the result, with zoom levels, is written\n"
+  "directly to output.destDb.bw.\n"
+  "options:\n"
+  "   -blockSize=N - Number of items to bundle in r-tree.  Default %d\n"
+  "   -itemsPerSlot=N - Number of data points bundled at lowest level. Default %d\n"
+  "   -unc - If set, do not use compression.\n"
+  "   -threads=N - Number of threads to uncompress input with.  Default %d\n"
+  , blockSize, itemsPerSlot, threads
+  );
+}
+
+static struct optionSpec options[] = {
+   {"blockSize", OPTION_INT},
+   {"itemsPerSlot", OPTION_INT},
+   {"unc", OPTION_BOOLEAN},
+   {"threads", OPTION_INT},
+   {NULL, 0},
+};
+
+struct liftPiece
+/* A run of data lifted to the new assembly. */
+    {
+    bits32 start, end;		/* Position in new chromosome, half open. */
+    float val;			/* Value of data. */
+    bits32 rank;		/* Rank of chain by score, 0 for best. */
+    };
+
+struct targetChrom
+/* Lifted data on a chromosome of new assembly. */
+    {
+    struct targetChrom *next;
+    char *name;			/* Chromosome name, not allocated here. */
+    struct liftPiece *pieces;	/* Lifted runs, in order lifted. */
+    size_t pieceCount;		/* Number of pieces used. */
+    size_t pieceAlloc;		/* Number of pieces allocated. */
+    };
+
+struct liftChain
+/* A chain and where we are in it while sweeping along old chromosome. */
+    {
+    struct liftChain *next;
+    struct chain *chain;	/* The chain. */
+    struct cBlock *block;	/* First block that may still overlap input. */
+    bits32 rank;		/* Rank of chain by score, 0 for best. */
+    struct targetChrom *target;	/* Where lifted data goes. */
+    };
+
+struct sourceChrom
+/* Chains on a chromosome of old assembly. */
+    {
+    char *name;			/* Chromosome name, not allocated here. */
+    struct liftChain **chains;	/* Chains sorted by start. */
+    int chainCount;		/* Number of chains. */
+    };
+
+static int chainCmpScoreId(const void *va, const void *vb)
+/* Compare to sort by score descending, and then id, so ranks are deterministic. */
+{
+const struct chain *a = *((struct chain **)va);
+const struct chain *b = *((struct chain **)vb);
+if (a->score > b->score)
+    return -1;
+if (a->score < b->score)
+    return 1;
+return a->id - b->id;
+}
+
+static int liftChainCmpStart(const void *va, const void *vb)
+/* Compare to sort by start in old chromosome. */
+{
+const struct liftChain *a = *((struct liftChain **)va);
+const struct liftChain *b = *((struct liftChain **)vb);
+return a->chain->tStart - b->chain->tStart;
+}
+
+static struct hash *readChains(char *fileName, struct hash *targetHash)
+/* Read chains into a hash of sourceChroms keyed by old chromosome name, making a
+ * targetChrom in targetHash for each new chromosome. */
+{
+struct lineFile *lf = lineFileOpen(fileName, TRUE);
+struct chain *chain, *chainList = NULL;
+while ((chain = chainRead(lf)) != NULL)
+    slAddHead(&chainList, chain);
+lineFileClose(&lf);
+slSort(&chainList, chainCmpScoreId);
+
+/* Make up liftChains, grouped by old chromosome. */
+struct hash *sourceHash = hashNew(0);
+struct hash *listHash = hashNew(0);
+bits32 rank = 0;
+for (chain = chainList; chain != NULL; chain = chain->next)
+    {
+    struct liftChain *lc;
+    AllocVar(lc);
+    lc->chain = chain;
+    lc->rank = rank++;
+    struct targetChrom *target = hashFindVal(targetHash, chain->qName);
+    if (target == NULL)
+        {
+	AllocVar(target);
+	hashAddSaveName(targetHash, chain->qName, target, &target->name);
+	}
+    lc->target = target;
+    struct hashEl *hel = hashLookup(listHash, chain->tName);
+    if (hel == NULL)
+        hel = hashAdd(listHash, chain->tName, NULL);
+    slAddHead(&hel->val, lc);
+    }
+
+/* Turn lists into arrays sorted by start. */
+struct hashEl *hel, *helList = hashElListHash(listHash);
+for (hel = helList; hel != NULL; hel = hel->next)
+    {
+    struct liftChain *lc, *lcList = hel->val;
+    struct sourceChrom *source;
+    AllocVar(source);
+    hashAddSaveName(sourceHash, hel->name, source, &source->name);
+    source->chainCount = slCount(lcList);
+    AllocArray(source->chains, source->chainCount);
+    int i = 0;
+    for (lc = lcList; lc != NULL; lc = lc->next)
+        source->chains[i++] = lc;
+    qsort(source->chains, source->chainCount, sizeof(source->chains[0]), liftChainCmpStart);
+    }
+hashElFreeList(&helList);
+hashFree(&listHash);
+return sourceHash;
+}
+
+static void addPiece(struct targetChrom *target, bits32 start, bits32 end, float val,
+	bits32 rank)
+/* Add lifted run to target. */
+{
+if (target->pieceCount >= target->pieceAlloc)
+    {
+    size_t newAlloc = (target->pieceAlloc == 0 ? 1024 : target->pieceAlloc * 2);
+    ExpandArray(target->pieces, target->pieceAlloc, newAlloc);
+    target->pieceAlloc = newAlloc;
+    }
+struct liftPiece *piece = &target->pieces[target->pieceCount++];
+piece->start = start;
+piece->end = end;
+piece->val = val;
+piece->rank = rank;
+}
+
+static void liftRun(struct liftChain **pActive, bits32 start, bits32 end, float val)
+/* Project run through blocks of active chains.  Runs must be passed in order of
+ * start within a chromosome, since chains and blocks left behind are dropped. */
+{
+struct liftChain *lc, *next, *stillActive = NULL;
+for (lc = *pActive; lc != NULL; lc = next)
+    {
+    next = lc->next;
+    struct chain *chain = lc->chain;
+    if (chain->tEnd <= start)
+        continue;
+    slAddHead(&stillActive, lc);
+    struct cBlock *b;
+    while ((b = lc->block) != NULL && b->tEnd <= start)
+        lc->block = b->next;
+    for (; b != NULL && b->tStart < end; b = b->next)
+        {
+	int s = max(start, b->tStart);
+	int e = min(end, b->tEnd);
+	if (s >= e)
+	    continue;
+	int qs = b->qStart + (s - b->tStart);
+	int qe = qs + (e - s);
+	if (chain->qStrand == '-')
+	    {
+	    int tmp = chain->qSize - qe;
+	    qe = chain->qSize - qs;
+	    qs = tmp;
+	    }
+	addPiece(lc->target, qs, qe, val, lc->rank);
+	}
+    }
+slReverse(&stillActive);
+*pActive = stillActive;
+}
+
+static void liftBigWig(char *inName, struct hash *sourceHash)
+/* Stream through input bigWig, lifting each run into its targetChroms. */
+{
+struct bbiFile *bwf = bigWigFileOpen(inName);
+struct bigWigStream *bws = bigWigStreamOpen(bwf, NULL, 0, 0, threads);
+struct bbiInterval *iv;
+char *chrom = NULL;
+struct sourceChrom *source = NULL;
+struct liftChain *active = NULL;
+int nextChain = 0;
+bits32 lastStart = 0;
+while ((iv = bigWigStreamNext(bws)) != NULL)
+    {
+    if (chrom == NULL || !sameString(bws->chrom, chrom))
+        {
+	freeMem(chrom);
+	chrom = cloneString(bws->chrom);
+	source = hashFindVal(sourceHash, chrom);
+	active = NULL;
+	nextChain = 0;
+	lastStart = 0;
+	}
+    if (source == NULL)
+        continue;
+    if (iv->start < lastStart)
+        errAbort("%s is not sorted on %s at %u", inName, chrom, iv->start);
+    lastStart = iv->start;
+    while (nextChain < source->chainCount
+	    && source->chains[nextChain]->chain->tStart < iv->end)
+        {
+	struct liftChain *lc = source->chains[nextChain++];
+	lc->block = lc->chain->blockList;
+	slAddTail(&active, lc);
+	}
+    liftRun(&active, iv->start, iv->end, iv->val);
+    }
+freeMem(chrom);
+bigWigStreamClose(&bws);
+bigWigFileClose(&bwf);
+}
+
+static int liftPieceCmpStart(const void *va, const void *vb)
+/* Compare to sort by start, then rank, end and value. */
+{
+const struct liftPiece *a = va;
+const struct liftPiece *b = vb;
+if (a->start != b->start)
+    return (a->start < b->start ? -1 : 1);
+if (a->rank != b->rank)
+    return (a->rank < b->rank ? -1 : 1);
+if (a->end != b->end)
+    return (a->end < b->end ? -1 : 1);
+return (a->val < b->val ? -1 : (a->val > b->val));
+}
+
+static int liftPieceCmpRank(const void *va, const void *vb)
+/* Compare to sort by rank, and then as liftPieceCmpStart does. */
+{
+const struct liftPiece *a = va;
+const struct liftPiece *b = vb;
+if (a->rank != b->rank)
+    return (a->rank < b->rank ? -1 : 1);
+return liftPieceCmpStart(va, vb);
+}
+
+static void outputRun(struct bwgBedGraphItem **pList, bits32 start, bits32 end, float val,
+	struct lm *lm)
+/* Add run to head of list, merging it with head if they abut and have the same value. */
+{
+struct bwgBedGraphItem *item = *pList;
+if (item != NULL && item->end == start && item->val == val)
+    item->end = end;
+else
+    {
+    lmAllocVar(lm, item);
+    item->start = start;
+    item->end = end;
+    item->val = val;
+    slAddHead(pList, item);
+    }
+}
+
+static void outputOverlapping(struct liftPiece *pieces, int pieceCount,
+	struct bwgBedGraphItem **pList, struct lm *lm)
+/* Output a set of pieces that overlap each other, keeping each base from the best
+ * ranked piece that covers it. */
+{
+qsort(pieces, pieceCount, sizeof(pieces[0]), liftPieceCmpRank);
+struct rbTree *covered = rangeTreeNew();
+struct liftPiece *kept = NULL;
+int keptCount = 0, keptAlloc = 0;
+int i;
+for (i=0; i<pieceCount; ++i)
+    {
+    struct liftPiece *piece = &pieces[i];
+    struct range *r, *rList = rangeTreeAllOverlapping(covered, piece->start, piece->end);
+    bits32 s = piece->start;
+    for (r = rList; ; r = r->next)
+        {
+	bits32 e = (r == NULL ? piece->end : r->start);
+	if (s < e)
+	    {
+	    if (keptCount >= keptAlloc)
+	        {
+		int newAlloc = (keptAlloc == 0 ? 16 : keptAlloc * 2);
+		ExpandArray(kept, keptAlloc, newAlloc);
+		keptAlloc = newAlloc;
+		}
+	    kept[keptCount] = *piece;
+	    kept[keptCount].start = s;
+	    kept[keptCount].end = e;
+	    ++keptCount;
+	    }
+	if (r == NULL)
+	    break;
+	s = max(s, r->end);
+	}
+    rangeTreeAdd(covered, piece->start, piece->end);
+    }
+qsort(kept, keptCount, sizeof(kept[0]), liftPieceCmpStart);
+for (i=0; i<keptCount; ++i)
+    outputRun(pList, kept[i].start, kept[i].end, kept[i].val, lm);
+freeMem(kept);
+rbTreeFree(&covered);
+}
+
+static struct bwgBedGraphItem *targetItems(struct targetChrom *target, struct lm *lm)
+/* Sort pieces of target, resolve overlaps between them, and return them as a
+ * list of bedGraph items. */
+{
+struct liftPiece *pieces = target->pieces;
+size_t count = target->pieceCount;
+qsort(pieces, count, sizeof(pieces[0]), liftPieceCmpStart);
+struct bwgBedGraphItem *list = NULL;
+size_t i = 0;
+while (i < count)
+    {
+    /* Find set of pieces that overlap each other. */
+    bits32 end = pieces[i].end;
+    size_t j;
+    for (j = i+1; j < count && pieces[j].start < end; ++j)
+        end = max(end, pieces[j].end);
+    if (j == i+1)
+        outputRun(&list, pieces[i].start, pieces[i].end, pieces[i].val, lm);
+    else
+        {
+	verbose(2, "Resolving %d overlapping pieces at %s:%u-%u\n",
+	    (int)(j-i), target->name, pieces[i].start, end);
+        outputOverlapping(pieces+i, j-i, &list, lm);
+	}
+    i = j;
+    }
+slReverse(&list);
+return list;
+}
+
+static int targetChromCmpName(const void *va, const void *vb)
+/* Compare to sort by name. */
+{
+const struct targetChrom *a = *((struct targetChrom **)va);
+const struct targetChrom *b = *((struct targetChrom **)vb);
+return strcmp(a->name, b->name);
+}
+
+static struct bwgSection *makeSections(struct hash *targetHash, struct lm *lm)
+/* Make sorted list of bedGraph sections out of lifted data. */
+{
+struct targetChrom *target, *targetList = NULL;
+struct hashEl *hel, *helList = hashElListHash(targetHash);
+for (hel = helList; hel != NULL; hel = hel->next)
+    {
+    target = hel->val;
+    if (target->pieceCount > 0)
+	slAddHead(&targetList, target);
+    }
+hashElFreeList(&helList);
+slSort(&targetList, targetChromCmpName);
+
+struct bwgSection *sectionList = NULL;
+for (target = targetList; target != NULL; target = target->next)
+    {
+    struct bwgBedGraphItem *item, *nextItem = targetItems(target, lm);
+    freez(&target->pieces);
+    target->pieceCount = target->pieceAlloc = 0;
+    while ((item = nextItem) != NULL)
+        {
+	struct bwgSection *section;
+	lmAllocVar(lm, section);
+	section->chrom = target->name;
+	section->start = item->start;
+	section->type = bwgTypeBedGraph;
+	section->items.bedGraphList = item;
+	int sectionSize = 1;
+	while (sectionSize < itemsPerSlot && item->next != NULL)
+	    {
+	    item = item->next;
+	    ++sectionSize;
+	    }
+	nextItem = item->next;
+	item->next = NULL;
+	section->end = item->end;
+	section->itemCount = sectionSize;
+	slAddHead(&sectionList, section);
+	}
+    }
+slReverse(&sectionList);
+return sectionList;
+}
+
+void liftOverBigWig(char *inName, char *chainFile, char *chromSizes, char *outName)
+/* liftOverBigWig - Move a bigWig file to another assembly through a liftOver chain file. */
+{
+struct hash *chromSizeHash = bbiChromSizesFromFile(chromSizes);
+struct hash *targetHash = hashNew(0);
+struct hash *sourceHash = readChains(chainFile, targetHash);
+liftBigWig(inName, sourceHash);
+struct lm *lm = lmInit(0);
+struct bwgSection *sectionList = makeSections(targetHash, lm);
+if (sectionList == NULL)
+    errAbort("No data in %s lifted through %s", inName, chainFile);
+bwgCreate(sectionList, chromSizeHash, blockSize, itemsPerSlot, doCompress, FALSE, FALSE,
+    FALSE, outName);
+lmCleanup(&lm);
+}
+
+int main(int argc, char *argv[])
+/* Process command line. */
+{
+optionInit(&argc, argv, options);
+blockSize = optionInt("blockSize", blockSize);
+itemsPerSlot = optionInt("itemsPerSlot", itemsPerSlot);
+doCompress = !optionExists("unc");
+threads = optionInt("threads", threads);
+if (argc != 5)
+    usage();
+if (itemsPerSlot < 1 || itemsPerSlot > 0xffff)
+    errAbort("itemsPerSlot must be between 1 and 65535");
+liftOverBigWig(argv[1], argv[2], argv[3], argv[4]);
+return 0;
+}
@@ -8,6 +8,8 @@
 #include "dnaLoad.h"
 #include "bed.h"
 #include "iupac.h"
+#include "localmem.h"
+#include "oligoScan.h"
 
 #define oligoMatchDefault "aaaaa"
 
@@ -39,125 +41,75 @@ if (s == NULL)
 return s;
 }
 
-char *oligoMatchName(struct bed *bed, char *queryName)
-/* Return name for oligo, which is just the base position. */
+void oligoMatchName(char *queryName, char strand, int chromStart, char *buf, int bufSize)
+/* Put name for oligo match, which is the query name, strand and base position, in buf. */
 {
-char buf[22];
-buf[0] = bed->strand[0];
-safef(buf+1, ArraySize(buf)-1, "%d", bed->chromStart+1);
-// because oligoMatch utility supports multiple query oligos, 
+// because oligoMatch utility supports multiple query oligos,
 // include the oligo name in the output.
-char result[1024];
-safef(result, sizeof result, "%s%s", queryName, buf);
-return cloneString(result);
+safef(buf, bufSize, "%s%c%d", queryName, strand, chromStart+1);
 }
 
-char *stringInWrapper(char *needle, char *haystack)
-/* Wrapper around string in to make it so it's a function rather than a macro. */
+int oligoHitPatCmp(const void *va, const void *vb)
+/* Compare oligoHits to sort by oligo, then position, then strand. */
 {
-return stringIn(needle, haystack);
+const struct oligoHit *a = *((struct oligoHit **)va);
+const struct oligoHit *b = *((struct oligoHit **)vb);
+int dif = a->patIx - b->patIx;
+if (dif == 0)
+    dif = a->start - b->start;
+if (dif == 0)
+    dif = a->strand - b->strand;
+return dif;
 }
 
-
-struct bed *oligoMatch(struct dnaSeq *target, struct dnaSeq *query)
-/* Create list of perfect matches to oligo on either strand. */
+void oligoMatch(struct oligoScanner *scanner, struct dnaSeq *target, FILE *f)
+/* Write perfect matches of all oligos in scanner on either strand of target to f.
+ * Output is ordered by oligo, then position, with plus strand first at ties. */
 {
-char *dna = target->dna;
-char *fOligo = oligoMatchSeq(query->dna);
-char *(*finder)(char *needle, char *haystack) = (anyIupac(fOligo) ? iupacIn : stringInWrapper);
-int oligoSize = strlen(fOligo);
-char *rOligo = cloneString(fOligo);
-char *rMatch = NULL, *fMatch = NULL;
-struct bed *bedList = NULL, *bed;
-char strand;
-int count = 0;
-
-tolowers(dna);
-if (oligoSize >= 2)
+struct lm *lm = lmInit(0);
+struct oligoHit *hitList = oligoScanHits(scanner, target->dna, target->size, lm);
+slSort(&hitList, oligoHitPatCmp);
+char name[1024];
+struct bed bed;
+ZeroVar(&bed);
+bed.chrom = target->name;
+bed.name = name;
+struct oligoHit *hit;
+for (hit = hitList; hit != NULL; hit = hit->next)
     {
-    fMatch = finder(fOligo, dna);
-    iupacReverseComplement(rOligo, oligoSize);
-    if (sameString(rOligo, fOligo))
-        rOligo = NULL;
-    else
-	rMatch = finder(rOligo, dna);
-    for (;;)
-        {
-	char *oneMatch = NULL;
-	if (rMatch == NULL)
-	    {
-	    if (fMatch == NULL)
-	        break;
-	    else
-		{
-	        oneMatch = fMatch;
-		fMatch = finder(fOligo, fMatch+1);
-		strand = '+';
-		}
-	    }
-	else if (fMatch == NULL)
-	    {
-
-	    oneMatch = rMatch;
-	    rMatch = finder(rOligo, rMatch+1);
-	    strand = '-';
-	    }
-	else if (rMatch < fMatch)
-	    {
-	    oneMatch = rMatch;
-	    rMatch = finder(rOligo, rMatch+1);
-	    strand = '-';
-	    }
-	else
-	    {
-	    oneMatch = fMatch;
-	    fMatch = finder(fOligo, fMatch+1);
-	    strand = '+';
-	    }
-	++count;
-	AllocVar(bed);
-	bed->chrom = cloneString(target->name);
-	bed->chromStart = oneMatch - dna;
-	bed->chromEnd = bed->chromStart + oligoSize;
-	bed->strand[0] = strand;
-	bed->name = oligoMatchName(bed, query->name);
-	slAddHead(&bedList, bed);
-	}
-    slReverse(&bedList);
+    struct dnaSeq *query = hit->patVal;
+    bed.chromStart = hit->start;
+    bed.chromEnd = hit->end;
+    bed.strand[0] = hit->strand;
+    oligoMatchName(query->name, hit->strand, hit->start, name, sizeof name);
+    bedTabOutN(&bed, 6, f);
     }
-return bedList;
-}
-
-void outputBed6(struct bed *bedList, char *output)
-/* self-explainatory */
-{
-FILE *outputFile = mustOpen(output, "w");
-struct bed *bed = NULL;
-for (bed = bedList; bed != NULL; bed = bed->next)
-    bedTabOutN(bed, 6, outputFile);
-carefulClose(&outputFile);
+lmCleanup(&lm);
 }
 
 int main(int argc, char *argv[])
 /* The program */
 {
-struct bed *bedList = NULL;
-struct dnaSeq *targets = NULL, *target;
-struct dnaSeq *queries = NULL, *query;
+struct dnaSeq *queries = NULL, *query, *target;
 if (argc != 4)
     usage();
-targets = dnaLoadAll(argv[2]);
 queries = dnaLoadAll(argv[1]);
-for (target = targets; target != NULL; target = target->next)
-    for (query = queries; query != NULL; query = query->next)
-	{
-	struct bed *oneList = oligoMatch(target, query);
-	bedList = slCat(bedList, oneList);
-	}
-outputBed6(bedList, argv[3]);
-bedFreeList(&bedList);
-dnaSeqFreeList(&targets);
+
+/* Put all oligos in one scanner so each target is read just once. */
+struct oligoScanner *scanner = oligoScannerNew(TRUE, FALSE);
+for (query = queries; query != NULL; query = query->next)
+    oligoScannerAdd(scanner, oligoMatchSeq(query->dna), TRUE, query);
+
+struct dnaLoad *dl = dnaLoadOpen(argv[2]);
+FILE *f = mustOpen(argv[3], "w");
+while ((target = dnaLoadNext(dl)) != NULL)
+    {
+    oligoMatch(scanner, target, f);
+    dnaSeqFree(&target);
+    }
+carefulClose(&f);
+dnaLoadClose(&dl);
+oligoScannerFree(&scanner);
 dnaSeqFreeList(&queries);
 return 0;
 }
-
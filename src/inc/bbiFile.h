@@ -149,6 +149,51 @@ struct fileOffsetSize *bbiOverlappingBlocks(struct bbiFile *bbi, struct cirTreeF
 	char *chrom, bits32 start, bits32 end, bits32 *retChromId);
 /* Fetch list of file blocks that contain items overlapping chromosome range. */
  
+struct bbiStreamBlock
+/* A block of unzoomed data read and inflated by a bbiBlockStream. */
+    {
+    struct bbiStreamBlock *next;	/* Next in list. */
+    bits64 offset;		/* Position of block in file. */
+    bits64 size;		/* Size of block in file. */
+    char *chrom;		/* Chromosome block was found for. */
+    bits32 chromId;		/* Id of chromosome. */
+    bits32 start, end;		/* Range within chromosome block was found for. */
+    char *data;			/* Inflated contents of block. */
+    int dataSize;		/* Size of inflated contents. */
+    char *raw;			/* Contents as read from file. */
+    char *buf;			/* Buffer that compressed contents are inflated into. */
+    };
+
+struct bbiBlockStream
+/* Returns the unzoomed data blocks overlapping a range, or a whole file, in
+ * order, reading a batch at a time and inflating the batch on several threads. */
+    {
+    struct bbiBlockStream *next;	/* Next in list. */
+    struct bbiFile *bbi;		/* File we are reading. */
+    int threadCount;			/* Number of threads to inflate with. */
+    int batchSize;			/* Maximum number of blocks in a batch. */
+    struct bbiStreamBlock *todo;	/* Blocks not yet read. */
+    struct bbiStreamBlock *batch;	/* Current batch, read and inflated. */
+    struct bbiStreamBlock *current;	/* Block last returned. */
+    char **bufs;			/* Inflate buffers, one per block of batch. */
+    char *readBuf;			/* Holds compressed batch. */
+    bits64 readBufSize;			/* Allocated size of readBuf. */
+    struct lm *lm;			/* Blocks and chromosome names live here. */
+    };
+
+struct bbiBlockStream *bbiBlockStreamOpen(struct bbiFile *bbi, char *chrom,
+	bits32 start, bits32 end, bits32 pad, int threadCount);
+/* Set up to return unzoomed data blocks with items overlapping chrom:start-end,
+ * widened by pad bases on each side, or all blocks of all chromosomes if chrom is
+ * NULL.  Blocks come in the same order as separate queries of each chromosome in
+ * bbiChromList order would return them.  Up to threadCount threads inflate blocks. */
+
+struct bbiStreamBlock *bbiBlockStreamNext(struct bbiBlockStream *bs);
+/* Return next block or NULL at end.  The block is valid until the next call. */
+
+void bbiBlockStreamClose(struct bbiBlockStream **pBs);
+/* Free up block stream.  Does not close the bbiFile. */
+
 struct bbiChromIdSize
 /* We store an id/size pair in chromBpt bPlusTree */
     {
@@ -0,0 +1,99 @@
+/* bedArray - hold many bed records compactly, a column at a time.  Rather than a
+ * separately allocated struct, name, and blockSizes and chromStarts arrays for each
+ * record, each field is one array indexed by record number, block lists for all
+ * records share two pools, chromosome names are stored once each, and item names
+ * are packed into local memory.  This takes several times less memory than a list
+ * of struct bed when there are millions of records.
+ *
+ * The arrays have the same names as the fields in struct bed, so bed->chromStart
+ * becomes ba->chromStart[ix].  The block lists for record ix start at
+ * ba->blockOffset[ix] in ba->blockSizes and ba->chromStarts; bedArrayBlockSizes and
+ * bedArrayChromStarts return pointers to them.  bedArrayGet fills in a struct bed
+ * that points into the array for code that wants one.
+ *
+ * This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+
+#ifndef BEDARRAY_H
+#define BEDARRAY_H
+
+#ifndef BED_H
+#include "basicBed.h"
+#endif
+
+#ifndef LOCALMEM_H
+#include "localmem.h"
+#endif
+
+#ifndef HASH_H
+#include "hash.h"
+#endif
+
+#define BED_ARRAY_MAX_FIELDS 12	/* Fields past blockStarts aren't kept. */
+
+struct bedArray
+/* Many bed records stored a field at a time. */
+    {
+    struct bedArray *next;	/* Next in list. */
+    int fieldCount;		/* Number of bed fields kept, 3 to 12. */
+    int count;			/* Number of records. */
+    int alloc;			/* Allocated size of per-record arrays. */
+    char **chrom;		/* Chromosome, shared by all records on it. */
+    unsigned *chromStart;	/* Start position in chromosome. */
+    unsigned *chromEnd;		/* End position in chromosome. */
+    char **name;		/* Name of item.  NULL unless fieldCount > 3. */
+    int *score;			/* Score.  NULL unless fieldCount > 4. */
+    char *strand;		/* + or - or 0.  NULL unless fieldCount > 5. */
+    unsigned *thickStart;	/* Start of thick part.  NULL unless fieldCount > 6. */
+    unsigned *thickEnd;		/* End of thick part.  NULL unless fieldCount > 7. */
+    unsigned *itemRgb;		/* RGB 8 bits each.  NULL unless fieldCount > 8. */
+    int *blockCount;		/* Number of blocks.  NULL unless fieldCount > 9. */
+    int *blockOffset;		/* Where record's blocks start in pools, -1 if it has none. */
+    int *blockSizes;		/* Pool of block sizes for all records. */
+    int *chromStarts;		/* Pool of block starts relative to chromStart. */
+    int blockUsed;		/* Number of entries used in block pools. */
+    int blockAlloc;		/* Allocated size of block pools. */
+    struct hash *chromHash;	/* Chromosome names, each stored once. */
+    struct lm *lm;		/* Item names live here. */
+    };
+
+#define bedArrayBlockSizes(ba, ix) \
+    ((ba)->blockOffset[ix] < 0 ? NULL : (ba)->blockSizes + (ba)->blockOffset[ix])
+/* Return blockSizes array of record ix, or NULL if it has no blocks. */
+
+#define bedArrayChromStarts(ba, ix) \
+    ((ba)->blockOffset[ix] < 0 ? NULL : (ba)->chromStarts + (ba)->blockOffset[ix])
+/* Return chromStarts array of record ix, or NULL if it has no blocks. */
+
+struct bedArray *bedArrayNew(int fieldCount, int sizeGuess);
+/* Return a new empty bedArray that keeps fieldCount fields of each record.
+ * sizeGuess is how many records to allocate room for at first, and may be 0. */
+
+void bedArrayFree(struct bedArray **pBa);
+/* Free up bedArray and everything in it. */
+
+int bedArrayAddRow(struct bedArray *ba, char **row, int wordCount);
+/* Parse a bed in row, which has wordCount words, into a new record, and return its
+ * index.  Fields missing from row get the same defaults as in bedLoadN, except that a
+ * row with blockSizes but no chromStarts gets chromStarts of zero.  A blockCount with
+ * no block lists is kept, as bedLoadN does. */
+
+int bedArrayAddBed(struct bedArray *ba, struct bed *bed);
+/* Copy bed into a new record and return its index. */
+
+struct bedArray *bedArrayLoadFile(char *fileName, int fieldCount);
+/* Load all beds in a tab-separated file.  If fieldCount is zero it is set from the
+ * first line of the file.  Dispose of this with bedArrayFree(). */
+
+void bedArrayGet(struct bedArray *ba, int ix, struct bed *bed);
+/* Fill in bed from record ix.  The strings and block arrays in bed point into ba,
+ * so bed must not be freed with bedFree, and must not be used after more records
+ * are added to ba. */
+
+struct bed *bedArrayToBed(struct bedArray *ba, int ix);
+/* Return a separately allocated copy of record ix. Free it with bedFree. */
+
+void bedArraySort(struct bedArray *ba);
+/* Sort records by chrom, then chromStart. */
+
+#endif /* BEDARRAY_H */
@@ -32,6 +32,13 @@
  *        }
  *    bigBedFileClose(&bbi);
  *
+ * or, reading and uncompressing blocks ahead on several threads,
+ *    struct bigBedStream *bbs = bigBedStreamOpen(bbi, NULL, 0, 0, threadCount);
+ *    struct bigBedInterval *el;
+ *    while ((el = bigBedStreamNext(bbs)) != NULL)
+ *        // do something involving bbs->chrom, el->start, el->end
+ *    bigBedStreamClose(&bbs);
+ *
  * The processes for streaming through or doing interval queries on a bigWig file are very 
  * similar. */
 
@@ -69,6 +76,31 @@ struct bigBedInterval *bigBedIntervalQuery(struct bbiFile *bbi, char *chrom,
 /* Get data for interval.  Return list allocated out of lm.  Set maxItems to maximum
  * number of items to return, or to 0 for all items. */
 
+struct bigBedStream
+/* Returns items of a bigBed overlapping a range, or all items in file, one at a time
+ * without building a list. */
+    {
+    struct bigBedStream *next;		/* Next in list. */
+    struct bbiBlockStream *blocks;	/* Source of uncompressed blocks. */
+    struct bbiStreamBlock *block;	/* Block we are in. */
+    char *pt, *end;			/* Position in and end of block data. */
+    char *chrom;			/* Chromosome of last item returned. */
+    struct bigBedInterval interval;	/* Last item returned. */
+    };
+
+struct bigBedStream *bigBedStreamOpen(struct bbiFile *bbi, char *chrom,
+	bits32 start, bits32 end, int threadCount);
+/* Set up to return the same items as bigBedIntervalQuery(bbi, chrom, start, end)
+ * would, in the same order, or if chrom is NULL all items in file in bbiChromList
+ * order.  Up to threadCount threads uncompress blocks ahead of the reader. */
+
+struct bigBedInterval *bigBedStreamNext(struct bigBedStream *bbs);
+/* Return next item or NULL at end.  The item, including rest, is only valid until
+ * the next call, and bbs->chrom is set to its chromosome. */
+
+void bigBedStreamClose(struct bigBedStream **pBbs);
+/* Free up bigBed stream.  Does not close the bbiFile. */
+
 int bigBedIntervalToRow(struct bigBedInterval *interval, char *chrom, char *startBuf, char *endBuf,
 	char **row, int rowSize);
 /* Convert bigBedInterval into an array of chars equivalent to what you'd get by
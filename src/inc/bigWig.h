@@ -10,7 +10,8 @@
  * you want to display.
  *
  * To read all the data out of a bigWig get the chromosome info with bbiChromList
- * and then fetch all of it for each chromosome using bigWigIntervalQuery.
+ * and then fetch all of it for each chromosome using bigWigIntervalQuery, or read it
+ * all in one pass with bigWigStreamOpen and bigWigStreamNext.
  *
  * See also the module bbiFile that has a description of they structure of
  * a bigWig file, and lower level routines used to implement this interface.
@@ -62,6 +63,35 @@ struct bbiInterval *bigWigIntervalQuery(struct bbiFile *bwf, char *chrom, bits32
 	struct lm *lm);
 /* Get data for interval.  Return list allocated out of lm. */
 
+struct bigWigStream
+/* Returns data of a bigWig overlapping a range, or all data in file, an interval at
+ * a time without building a list. */
+    {
+    struct bigWigStream *next;		/* Next in list. */
+    struct bbiBlockStream *blocks;	/* Source of uncompressed blocks. */
+    struct bbiStreamBlock *block;	/* Block we are in. */
+    char *pt;				/* Position in block data. */
+    int itemsLeft;			/* Items left in block. */
+    UBYTE type;				/* Section type of block, a bwgSectionType. */
+    bits32 itemStep, itemSpan;		/* Step and span from section header. */
+    bits32 fixedStart;			/* Start of next item in fixedStep sections. */
+    char *chrom;			/* Chromosome of last interval returned. */
+    struct bbiInterval interval;	/* Last interval returned. */
+    };
+
+struct bigWigStream *bigWigStreamOpen(struct bbiFile *bwf, char *chrom,
+	bits32 start, bits32 end, int threadCount);
+/* Set up to return the same intervals as bigWigIntervalQuery(bwf, chrom, start, end)
+ * would, in the same order, or if chrom is NULL all intervals in file in bbiChromList
+ * order.  Up to threadCount threads uncompress blocks ahead of the reader. */
+
+struct bbiInterval *bigWigStreamNext(struct bigWigStream *bws);
+/* Return next interval or NULL at end.  The interval is only valid until the next
+ * call, and bws->chrom is set to its chromosome. */
+
+void bigWigStreamClose(struct bigWigStream **pBws);
+/* Free up bigWig stream.  Does not close the bbiFile. */
+
 int bigWigIntervalDump(struct bbiFile *bwf, char *chrom, bits32 start, bits32 end, int maxCount,
 	FILE *out);
 /* Print out info on bigWig parts that intersect chrom:start-end.   Set maxCount to 0 if you 
@@ -0,0 +1,44 @@
+/* binPack - compact binary encoding of numbers and strings in memory.  Unsigned
+ * integers are written seven bits per byte, low bits first, with the high bit of
+ * each byte set if more bytes follow, so small numbers take one byte.  Signed
+ * integers are zig-zag mapped to unsigned first so small negative numbers are
+ * small too.  Strings are written with their terminating zero so that they can be
+ * used in place when read back.  The autoSql -lm option generates Pack and Unpack
+ * routines built on these.
+ *
+ * This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+
+#ifndef BINPACK_H
+#define BINPACK_H
+
+#ifndef DYSTRING_H
+#include "dystring.h"
+#endif
+
+void binPackUnsigned(struct dyString *dy, bits64 x);
+/* Append x to dy in one to ten bytes. */
+
+void binPackSigned(struct dyString *dy, long long x);
+/* Append x to dy in one to ten bytes. */
+
+void binPackString(struct dyString *dy, char *s);
+/* Append s including terminating zero to dy.  NULL is written as empty string. */
+
+#define binPackOne(dy, var) dyStringAppendN(dy, (char *)(&var), sizeof(var))
+/* Append var to dy as is, in this machine's byte order.  Used for floating point. */
+
+bits64 binUnpackUnsigned(char **pS);
+/* Read an unsigned number written by binPackUnsigned from *pS and advance *pS past it. */
+
+long long binUnpackSigned(char **pS);
+/* Read a signed number written by binPackSigned from *pS and advance *pS past it. */
+
+char *binUnpackString(char **pS);
+/* Return string written by binPackString at *pS and advance *pS past it.  The
+ * string is not copied, so it is only good as long as the buffer is. */
+
+#define binUnpackOne(pS, var) memReadOne(pS, var)
+/* Read var written by binPackOne from *pS and advance *pS past it. */
+
+#endif /* BINPACK_H */
@@ -0,0 +1,110 @@
+/* dnaMotifScan - score position weight matrix motifs at every position of long
+ * sequences.  A dnaMotif is compiled once into a table of log2-odds scores for each
+ * group of four columns, indexed by all 625 possible four base words (A, C, G, T
+ * or other).  The sequence is converted once into those four base word codes, and
+ * then shared by all the motifs scanned over it, so scoring a position takes one table
+ * lookup per four columns rather than a character switch per column.  When a
+ * threshold is set, scoring of a position stops as soon as the best possible score of
+ * the columns that are left can't bring it up to the threshold.
+ *
+ * Scores are the same as dnaMotifBitScore and dnaMotifBitScoreWithMark0Bg give, to
+ * within floating point rounding.
+ *
+ * This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+
+// Typical use:
+//
+//    for (motif = motifList; motif != NULL; motif = motif->next)
+//        {
+//        pwm = dnaMotifPwmNew(motif, NULL, '+');
+//        pwm->threshold = dnaMotifPwmRelativeScore(pwm, 0.85);
+//        slAddHead(&pwmList, pwm);
+//        ...likewise for '-' strand...
+//        }
+//    struct dnaMotifScanSeq *ss = dnaMotifScanSeqNew(seq->dna, seq->size);
+//    dnaMotifScan(pwmList, ss, hitFunc, context);
+//    dnaMotifScanSeqFree(&ss);
+
+#ifndef DNAMOTIFSCAN_H
+#define DNAMOTIFSCAN_H
+
+#ifndef DNAMOTIF_H
+#include "dnaMotif.h"
+#endif
+
+#define DNA_MOTIF_SCAN_GROUP 4		/* Number of motif columns per table lookup. */
+#define DNA_MOTIF_SCAN_WORDS 625	/* Number of distinct codes for a group (5^4). */
+
+struct dnaMotifPwm
+/* A motif compiled to log2-odds score tables for fast scanning on one strand. */
+    {
+    struct dnaMotifPwm *next;	/* Next in list. */
+    struct dnaMotif *motif;	/* Motif this was compiled from.  Not owned. */
+    char strand;		/* '+' or '-'.  Minus strand tables hold reverse complement. */
+    int columnCount;		/* Number of columns in motif. */
+    int groupCount;		/* Number of groups of four columns, last one padded. */
+    float *groupScores;		/* DNA_MOTIF_SCAN_WORDS scores for each group. */
+    float *bestRest;		/* bestRest[g] is best possible score of groups g and up. */
+    double minScore;		/* Lowest possible score of an ACGT sequence. */
+    double maxScore;		/* Highest possible score. */
+    double threshold;		/* Positions scoring lower are not reported by dnaMotifScan. */
+    };
+
+struct dnaMotifScanSeq
+/* A sequence converted to four base word codes for scanning. */
+    {
+    struct dnaMotifScanSeq *next;	/* Next in list. */
+    int size;			/* Number of bases in sequence. */
+    unsigned short *words;	/* Code of four bases starting at each position, plus padding. */
+    };
+
+typedef void (*dnaMotifScanHitFunc)(void *context, struct dnaMotifPwm *pwm,
+	int start, double score);
+/* Function called on each position scoring at least the threshold in dnaMotifScan.
+ * Start is in forward strand coordinates for both strands. */
+
+struct dnaMotifPwm *dnaMotifPwmNew(struct dnaMotif *motif, double mark0[5], char strand);
+/* Compile a probabalistic motif (see dnaMotifMakeProbabalistic) into score tables.
+ * If mark0 is non-NULL it is a 0-order background model as made by dnaMark0,
+ * otherwise the background is uniform.  If strand is '-' the tables score the
+ * reverse complement of the motif against the forward strand sequence.  The
+ * threshold starts out so low that every position is reported. */
+
+void dnaMotifPwmFree(struct dnaMotifPwm **pPwm);
+/* Free up compiled motif. */
+
+void dnaMotifPwmFreeList(struct dnaMotifPwm **pList);
+/* Free a list of compiled motifs. */
+
+double dnaMotifPwmRelativeScore(struct dnaMotifPwm *pwm, double fraction);
+/* Return the score that is fraction of the way from the lowest to the highest
+ * possible score of pwm.  Useful for setting pwm->threshold. */
+
+struct dnaMotifScanSeq *dnaMotifScanSeqNew(DNA *dna, int size);
+/* Convert dna into four base word codes for scanning.  Any character other than
+ * upper or lower case A, C, G, T is treated as N. */
+
+void dnaMotifScanSeqFree(struct dnaMotifScanSeq **pSs);
+/* Free up a converted sequence. */
+
+double dnaMotifPwmScoreAt(struct dnaMotifPwm *pwm, struct dnaMotifScanSeq *ss, int start);
+/* Return score of pwm at start, which must be at most ss->size - pwm->columnCount. */
+
+void dnaMotifPwmScoreAll(struct dnaMotifPwm *pwm, struct dnaMotifScanSeq *ss,
+	float *scores);
+/* Put score of pwm at each position of ss into scores, which must have room for
+ * ss->size - pwm->columnCount + 1 values.  Ignores pwm->threshold. */
+
+void dnaMotifPwmScan(struct dnaMotifPwm *pwm, struct dnaMotifScanSeq *ss,
+	dnaMotifScanHitFunc hitFunc, void *context);
+/* Call hitFunc on every position where pwm scores at least pwm->threshold, in order
+ * of position.  Scoring of a position stops as soon as the rest of the motif can't
+ * make up the difference. */
+
+void dnaMotifScan(struct dnaMotifPwm *pwmList, struct dnaMotifScanSeq *ss,
+	dnaMotifScanHitFunc hitFunc, void *context);
+/* Call hitFunc on every position where a motif in pwmList scores at least its
+ * threshold.  Hits are reported motif by motif, in order of position. */
+
+#endif /* DNAMOTIFSCAN_H */
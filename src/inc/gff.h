@@ -7,6 +7,10 @@
 #ifndef GFF_H
 #define GFF_H
 
+#ifndef LINEFILE_H
+#include "linefile.h"
+#endif
+
 struct gffLine
 /* A parsed line in a GFF file. */
     {
@@ -126,6 +130,20 @@ void gffFileAddRow(struct gffFile *gff, int baseOffset, char *words[], int wordC
 void gffFileFree(struct gffFile **pGff);
 /* Free up a gff file. */
 
+boolean gffIsSortedByGene(char *fileName);
+/* Check if the lines of a GFF or GTF file are grouped by sequence, with no
+ * line starting before the last gene line of its sequence, so that
+ * gffReadNextChunk can end chunks at genes.  Standard input can't be read
+ * twice, so is treated as unsorted. */
+
+struct gffFile *gffReadNextChunk(struct lineFile *lf, boolean isSorted);
+/* Read the next chunk of lines from lf into a new gffFile, or return NULL at
+ * the end of the file.  If isSorted is set from gffIsSortedByGene, a chunk
+ * ends at a change of sequence or a gene line starting after the end of all
+ * lines in the chunk, so memory is bounded by the largest set of overlapping
+ * genes.  Otherwise the rest of the file is one chunk.  Lists are in file
+ * order as with gffRead, so gffGroupLines can be used on the chunk. */
+
 int gffLineCmp(const void *va, const void *vb);
 /* Compare two gffLines (for use in slSort, etc.) . */
 
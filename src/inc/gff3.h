@@ -199,6 +199,11 @@ struct gff3File
     unsigned int flags;     /* flags controlling parsing */
     int maxErr;             /* maximum number of errors before aborting */
     int errCnt;             /* error count */
+    struct gff3File *streamFile;  /* for a group of records returned by
+                                   * gff3FileNextGroup, the file being streamed,
+                                   * which counts errors for all groups */
+    struct gff3Stream *stream;    /* state of reading a file opened with
+                                   * gff3FileOpenStream, otherwise NULL */
 };
 
 
@@ -249,6 +254,24 @@ struct gff3File *gff3FileOpen(char *fileName, int maxErr, unsigned flags, FILE *
  * less than zero does not stop reports all errors. Write errors to errFh,
  * if NULL, use stderr.  See above flags. */
 
+struct gff3File *gff3FileOpenStream(char *fileName, int maxErr, unsigned flags, FILE *errFh);
+/* Open a GFF3 file to be read a group of related records at a time with
+ * gff3FileNextGroup, rather than all at once.  Arguments are as for
+ * gff3FileOpen.  The file is read once to find groups, which end at ###
+ * directives, changes of seqid, or records starting past the end of all
+ * records in the group, once none of them reference records not yet read.
+ * If that would separate a record from one it references, or put an ID in
+ * more than one group, the file is read as one group.  Meta-data is kept in
+ * the returned object and is complete once all groups have been read. */
+
+struct gff3File *gff3FileNextGroup(struct gff3File *g3f);
+/* Read and resolve the next group of records from a file opened with
+ * gff3FileOpenStream.  The group is returned as a gff3File object with its
+ * own anns, roots and memory, which is freed with gff3FileFree
+ * independently of g3f and other groups.  Returns NULL at the end of file.
+ * Aborts once a group has parse errors, after reporting errors in the rest
+ * of the file up to maxErr. */
+
 void gff3FileFree(struct gff3File **g3fPtr);
 /* Free a gff3File object */
 
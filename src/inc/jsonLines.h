@@ -0,0 +1,36 @@
+/* jsonLines - read files with one JSON object per line, parsing batches of lines in
+ * parallel.  Each line is parsed into its own local memory so that lines can be handled
+ * and freed one at a time. */
+
+/* This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+
+#ifndef JSONLINES_H
+#define JSONLINES_H
+
+#include "jsonParse.h"
+#include "linefile.h"
+
+struct jsonLine
+/* One line of a line-delimited JSON file, parsed. */
+    {
+    struct jsonLine *next;
+    int lineIx;                 /* Line number in file. */
+    char *text;                 /* Text of line, allocated in lm. */
+    struct lm *lm;              /* Memory for text and el.  Use for queries on el too. */
+    struct jsonElement *el;     /* Parsed JSON. */
+    char *error;                /* Parse error message, NULL if none. */
+    };
+
+struct jsonLine *jsonLinesRead(struct lineFile *lf, int maxCount, int threadCount);
+/* Read up to maxCount lines from lf and parse each as JSON, using up to threadCount threads.
+ * Return list in file order, or NULL at end of file.  Aborts with file name and line number
+ * if a line is not valid JSON.  Free with jsonLineFreeList. */
+
+void jsonLineFree(struct jsonLine **pJl);
+/* Free up a jsonLine including its local memory. */
+
+void jsonLineFreeList(struct jsonLine **pList);
+/* Free up a list of jsonLines. */
+
+#endif /* JSONLINES_H */
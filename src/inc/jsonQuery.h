@@ -24,6 +24,64 @@
 
 #include "jsonParse.h"
 
+struct jsonPath
+/* A path parsed by jsonPathCompile, for running the same query on many jsonElements without
+ * parsing the path each time. */
+    {
+    char *text;                 // Path as given, for error messages
+    struct jsonPathStep *steps; // Components of path, NULL for the queried element itself
+    };
+
+struct jsonPath *jsonPathCompileLm(char *path, struct lm *lm);
+#define jsonPathCompile(path) jsonPathCompileLm(path, NULL)
+/* Parse path once into a form that can be used to query many jsonElements quickly.
+ * If lm is NULL, free with jsonPathFree when done. */
+
+void jsonPathFree(struct jsonPath **pJp);
+/* Free up a jsonPath compiled without lm. */
+
+/* The jsonPathQuery* functions are like the jsonQuery* functions below, but take a compiled
+ * path instead of a path string. */
+
+struct slRef *jsonPathQueryElement(struct jsonElement *el, char *name, struct jsonPath *jp,
+                                   struct lm *lm);
+/* Return a ref list of jsonElement descendants of el that match compiled path jp.
+ * name is for error reporting. */
+
+struct slRef *jsonPathQueryElementList(struct slRef *inList, char *name, struct jsonPath *jp,
+                                       struct lm *lm);
+/* Return a ref list of jsonElement descendants matching compiled path jp of all jsonElements
+ * in inList.  name is for error reporting. */
+
+char *jsonPathQueryString(struct jsonElement *el, char *name, struct jsonPath *jp, struct lm *lm);
+/* Alloc & return the string value at the end of compiled path jp in el. May be NULL. */
+
+long jsonPathQueryInt(struct jsonElement *el, char *name, struct jsonPath *jp, long defaultVal,
+                      struct lm *lm);
+/* Return the int value at compiled path jp in el, or defaultVal if not found. */
+
+boolean jsonPathQueryBoolean(struct jsonElement *el, char *name, struct jsonPath *jp,
+                             boolean defaultVal, struct lm *lm);
+/* Return the boolean value at compiled path jp in el, or defaultVal if not found. */
+
+struct slName *jsonPathQueryStrings(struct jsonElement *el, char *name, struct jsonPath *jp,
+                                    struct lm *lm);
+/* Alloc & return a list of string values matching compiled path jp in el. May be NULL. */
+
+struct slInt *jsonPathQueryInts(struct jsonElement *el, char *name, struct jsonPath *jp,
+                                struct lm *lm);
+/* Alloc & return a list of int values matching compiled path jp in el. May be NULL. */
+
+struct slName *jsonPathQueryStringList(struct slRef *inList, char *name, struct jsonPath *jp,
+                                       struct lm *lm);
+/* Alloc & return a list of string values matching compiled path jp in all elements of inList.
+ * May be NULL. */
+
+struct slInt *jsonPathQueryIntList(struct slRef *inList, char *name, struct jsonPath *jp,
+                                   struct lm *lm);
+/* Alloc & return a list of int values matching compiled path jp in all elements of inList.
+ * May be NULL. */
+
 struct slRef *jsonQueryElement(struct jsonElement *el, char *name, char *path, struct lm *lm);
 /* Return a ref list of jsonElement descendants of el that match path.
  * name is for error reporting. */
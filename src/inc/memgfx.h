@@ -190,6 +190,17 @@ void mgPutSegZeroClear(struct memGfx *mg, int x, int y, int width, Color *dots);
 void mgDrawBox(struct memGfx *mg, int x, int y, int width, int height, Color color);
 /* Draw a (horizontal) box */
 
+struct mgSpan
+/* A box to draw with mgDrawSpans. */
+    {
+    int x, width;	/* Horizontal position and size in pixels. */
+    Color color;	/* Color to draw in. */
+    };
+
+void mgDrawSpans(struct memGfx *mg, int y, int height, struct mgSpan *spans, int spanCount);
+/* Draw spanCount boxes that all run from y to y+height.  This gives the same
+ * result as calling mgDrawBox on each in turn, but is faster. */
+
 void mgDrawLine(struct memGfx *mg, int x1, int y1, int x2, int y2, Color color);
 /* Draw a line from one point to another. */
 
@@ -14,8 +14,14 @@
 //    char *val = mmHashFindVal(mmh, itemName);
 //    ...
 //    mmHashFree(&mmh);
+//
+// * or, for big tables, stream keys and values into a version 2 file without a hash in memory
+//    struct mmHashBuilder *mhb = mmHashBuilderNew(pathToFile, NULL, 0);
+//    mmHashBuilderAdd(mhb, key, val);   ... for each item
+//    mmHashBuilderFinish(&mhb);
+//   mmHashFromFile reads both versions.
 
-// Memory mapped file layout:
+// Version 1 memory mapped file layout:
 //
 // * magic bytes    [7 bytes]  0xF0 m m h v 1 0x0F
 // * powerOfTwoSize [1 byte]
@@ -29,6 +35,27 @@
 // They are 8 bytes because 4 bytes would limit the total size of the file (buckets, keys, values,
 // overhead) to 4GB which is a limit we could conceivably run up against with lots of large values.
 // 8 bytes seems wasteful but at least it's aligned.
+//
+// Version 2 memory mapped file layout, all numbers 8 byte aligned:
+//
+// * magic bytes    [7 bytes]  0xF0 m m h v 2 0x0F
+// * reserved       [1 byte]
+// * keyCount       [8 bytes]
+// * bucketCount    [8 bytes]  number of buckets keys are hashed into
+// * slotCount      [8 bytes]  a bit more than keyCount, number of places keys hash to
+// * seed           [8 bytes]  seed of key hash function
+// * pilotsOffset   [8 bytes]  offset of pilots in file
+// * remapOffset    [8 bytes]  offset of remap in file
+// * entriesOffset  [8 bytes]  offset of entries in file
+// * variable-length key and value storage: keyString and valString, each 0-terminated
+// * pilots         [4 bytes * bucketCount]
+// * remap          [8 bytes * (slotCount - keyCount)]
+// * entries        [16 bytes * keyCount]  struct mmHashEntry
+// This is a minimal perfect hash: the 64 bit hash of a key picks a bucket, and the bucket's
+// pilot together with the key hash picks a slot that no other key hashes to.  Slots at or past
+// keyCount are mapped into the holes below keyCount by remap, so entries has no holes.  Each
+// entry has a fingerprint from the key hash, so most missing keys are rejected without looking
+// at strings, and a lookup touches one pilot, one entry and one key.
 
 #ifndef MMHASH_H
 #define MMHASH_H
@@ -44,26 +71,61 @@
 // be much less than this.
 #define MMHASH_MAX_EL_COUNT ((1 << 16) - 1)
 
+struct mmHashEntry
+// An entry in a version 2 mmHash
+{
+    uint64_t offset;            // offset of key in file, value follows it
+    uint32_t fingerprint;       // low bits of key hash
+    uint32_t reserved;          // always zero for now
+};
+
 struct mmHash
 {
+    uint32_t version;           // file format version, 1 or 2
     uint32_t powerOfTwoSize;    // power of two size between MMHASH_{MIN,MAX}_POWER_OF_2_SIZE
     uint32_t mask;              // for convenience, mask on hashed key ((1 << powerOfTwoSize) - 1)
     char *mmapFileName;         // path to memory-mapped file
     unsigned char *mmapBytes;   // pointer to start of memory-mapped file
     size_t mmapLength;          // number of memory-mapped bytes
     uint64_t *bucketOffsets;    // for convenience, pointer to start of bucket array in mmapBytes
+    // The rest are only used in version 2
+    uint64_t keyCount;          // number of keys
+    uint64_t bucketCount;       // number of buckets keys hash into
+    uint64_t slotCount;         // number of slots keys hash to
+    uint64_t seed;              // seed for key hash
+    uint32_t *pilots;           // pointer to pilots in mmapBytes
+    uint64_t *remap;            // pointer to remap in mmapBytes
+    struct mmHashEntry *entries; // pointer to entries in mmapBytes
 };
 
 void hashToMmHashFile(struct hash *hash, char *mmapFilePath);
 /* Convert hash, whose values are null-terminated strings, to memory-mapped hash format and
  * write to file at mmapFilePath. */
 
+struct mmHashBuilder;   // Opaque state of a version 2 file being built, see mmHashBuilderNew
+
 struct mmHash *mmHashFromFile(char *mmapFilePath);
 /* Return an mmHash read in from memory-mapped file at mmapFilePath. */
 
 const char *mmHashFindVal(struct mmHash *mmh, char *key);
 /* Look up key in mmh and return its string value or NULL if not found.  Do not modify return val. */
 
+void mmHashFindVals(struct mmHash *mmh, int count, char **keys, const char **retVals);
+/* Look up count keys in mmh, putting values or NULLs in retVals.  For version 2 files this
+ * visits entries and then keys in file order, which is kinder to cold pages than looking
+ * them up one at a time. */
+
+struct mmHashBuilder *mmHashBuilderNew(char *mmapFilePath, char *tmpDir, size_t maxMem);
+/* Start building a version 2 mmHash file at mmapFilePath.  Keys and values are written out
+ * as they are added, and key hashes are kept in sorted runs in tmpDir (default getTempDir())
+ * once they use more than maxMem bytes (default 1G if 0). */
+
+void mmHashBuilderAdd(struct mmHashBuilder *mhb, char *key, char *val);
+/* Add key and its value.  If a key is added more than once the last value is kept. */
+
+void mmHashBuilderFinish(struct mmHashBuilder **pMhb);
+/* Build the perfect hash, finish writing file and free up builder. */
+
 void mmHashFree(struct mmHash **pMmh);
 /* Free the allocated memory for *pMmh and unmap the mapped memory range if not NULL,
  * but leave the memory-mapped file in place for other processes. */
@@ -208,7 +208,15 @@ void netHttpGet(struct lineFile *lf, struct netParsedUrl *npu,
 
 int netOpenHttpExt(char *url, char *method, char *optionalHeader);
 /* Return a file handle that will read the url.  optionalHeader
- * may by NULL or may contain cookies and other info. */
+ * may by NULL or may contain cookies and other info.  GETs reuse
+ * pooled keep-alive connections. */
+
+void netKeepAliveEnable(boolean enable);
+/* Turn reuse of http and https connections on or off.  It is on by default.
+ * When on, GETs via netUrlOpen and netOpenHttpExt go out as HTTP/1.1 on
+ * connections kept open for up to 30 seconds, at most 4 per server, and the
+ * caller still just reads the response until end of file.  Turning it off
+ * closes idle connections. */
 
 void setAuthorization(struct netParsedUrl npu, char *authHeader, struct dyString *dy);
 /* Set the specified authorization header with BASIC auth base64-encoded user and password */
@@ -0,0 +1,56 @@
+/* numText - fast conversion of numbers to and from text.  The parsers here accept
+ * the same decimal syntax as strtod and give the same, correctly rounded, result,
+ * but handle the common short numbers without going through strtod.  The
+ * formatters write exactly what printf would for the corresponding format, using a
+ * digit pair table for integers and exact scaled arithmetic for %g, and fall back
+ * to printf only for the rare values that need it.
+ *
+ * The numTextXxx formatters write to a buffer, which must have room for at least
+ * NUM_TEXT_MAX_SIZE chars, add a terminating zero, and return the length written.
+ * The numTextWriteXxx versions write to a FILE without going through fprintf's
+ * format parsing, and are what the record writers use.
+ *
+ * This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+
+#ifndef NUMTEXT_H
+#define NUMTEXT_H
+
+#define NUM_TEXT_MAX_SIZE 32	/* Big enough for any number formatted here. */
+
+double numTextParseDouble(char *s, char **retEnd);
+/* Convert decimal number at start of s to a double, and put where number ends
+ * in *retEnd if it is non-NULL.  Same syntax and results as strtod, which this
+ * falls back on for hex, inf, nan, leading space and very long or extreme
+ * numbers.  If there is no number at s, *retEnd is set to s. */
+
+int numTextUnsigned(char *buf, unsigned long long x);
+/* Write x in decimal to buf as printf %llu would. Return length. */
+
+int numTextSigned(char *buf, long long x);
+/* Write x in decimal to buf as printf %lld would. Return length. */
+
+int numTextDoublePrec(char *buf, double x, int prec);
+/* Write x to buf as printf %.*g would with precision prec. Return length. */
+
+#define numTextDouble(buf, x) numTextDoublePrec(buf, x, 6)
+/* Write x to buf as printf %g would. Return length. */
+
+int numTextDoubleShortest(char *buf, double x);
+/* Write the shortest decimal that reads back as exactly x to buf, in %g style.
+ * Return length. */
+
+int numTextFloatShortest(char *buf, float x);
+/* Write the shortest decimal that reads back as exactly x when converted to float
+ * to buf, in %g style.  Return length. */
+
+void numTextWriteUnsigned(FILE *f, unsigned long long x);
+/* Write x to file as fprintf %u would. */
+
+void numTextWriteSigned(FILE *f, long long x);
+/* Write x to file as fprintf %d would. */
+
+void numTextWriteDouble(FILE *f, double x);
+/* Write x to file as fprintf %g would. */
+
+#endif /* NUMTEXT_H */
@@ -0,0 +1,90 @@
+/* oligoScan - find all occurrences of many DNA oligos, which may contain IUPAC
+ * ambiguity codes, on both strands in a single pass over the target sequence. */
+
+/* This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+
+// Typical use:
+//
+//    struct oligoScanner *os = oligoScannerNew(TRUE, FALSE);
+//    for (oligo = oligoList; oligo != NULL; oligo = oligo->next)
+//        oligoScannerAdd(os, oligo->dna, TRUE, oligo);
+//    while ((seq = dnaLoadNext(dl)) != NULL)
+//        {
+//        struct oligoHit *hitList = oligoScanHits(os, seq->dna, seq->size, lm);
+//        ...
+//        }
+//    oligoScannerFree(&os);
+//
+// Patterns whose ambiguity codes expand to only a few plain sequences are expanded
+// and put into an Aho-Corasick automaton over the four bases, so the cost per target
+// base doesn't depend on the number of patterns.  Highly degenerate patterns (runs of
+// N as in many restriction enzyme sites, or any N when N is allowed to match non-ACGT
+// bases) go into a multi-word bit-parallel Shift-And matcher instead.  Reverse
+// complement patterns are added for the minus strand unless they are the same as the
+// forward pattern, so hits on both strands come from the same pass.
+
+#ifndef OLIGOSCAN_H
+#define OLIGOSCAN_H
+
+#ifndef LOCALMEM_H
+#include "localmem.h"
+#endif
+
+struct oligoScanner
+/* Scanner for many IUPAC oligo patterns at once.  Add patterns, then scan. */
+    {
+    struct oligoScanner *next;	/* Next in list. */
+    boolean nMatchesAny;	/* If TRUE pattern N matches any target char, not just ACGT. */
+    boolean upperOnly;		/* If TRUE only upper case target bases can match. */
+    int patCount;		/* Number of patterns added by caller. */
+    int patAlloc;		/* Allocated size of patVals. */
+    void **patVals;		/* Value associated with each pattern by caller. */
+    struct oligoScanPat *strandPats;	/* Patterns by strand, built by oligoScannerAdd. */
+    int strandPatCount;		/* Number of strandPats. */
+    int strandPatAlloc;		/* Allocated size of strandPats. */
+    struct oligoScanAc *ac;	/* Aho-Corasick automaton for low-degeneracy patterns. */
+    struct oligoScanBits *bits;	/* Shift-And bank for highly degenerate patterns. */
+    boolean built;		/* TRUE once ac failure links have been computed. */
+    };
+
+struct oligoHit
+/* A single match of a pattern to target sequence. */
+    {
+    struct oligoHit *next;	/* Next in list. */
+    int patIx;			/* Index of pattern as returned by oligoScannerAdd. */
+    void *patVal;		/* Value that was passed to oligoScannerAdd. */
+    int start, end;		/* Position of match in forward strand target coordinates. */
+    char strand;		/* '+' or '-' */
+    };
+
+typedef void (*oligoScanHitFunc)(void *context, int patIx, void *patVal,
+	char strand, int start, int end);
+/* Function called on each match found by oligoScanDna. */
+
+struct oligoScanner *oligoScannerNew(boolean nMatchesAny, boolean upperOnly);
+/* Return a new empty scanner.  If nMatchesAny is TRUE, N in a pattern matches any
+ * character in the target (as in iupacMatch), otherwise only A, C, G or T.  If upperOnly
+ * is TRUE then lower case (soft-masked) target bases never match. */
+
+void oligoScannerFree(struct oligoScanner **pOs);
+/* Free up a scanner. */
+
+int oligoScannerAdd(struct oligoScanner *os, char *pattern, boolean bothStrands, void *val);
+/* Add a DNA pattern, which may contain IUPAC codes, to scanner, and return its index.
+ * If bothStrands is set, the reverse complement is searched for as well, unless it is
+ * the same as the pattern itself.  Must be called before any scan. */
+
+void oligoScanDna(struct oligoScanner *os, char *dna, int size,
+	oligoScanHitFunc hitFunc, void *context);
+/* Scan dna once, calling hitFunc on each match of any pattern on either strand.  Hits
+ * are reported in order of their end position. */
+
+struct oligoHit *oligoScanHits(struct oligoScanner *os, char *dna, int size, struct lm *lm);
+/* Return list of all hits of patterns in dna, allocated in lm, and sorted by start,
+ * then strand, then pattern index. */
+
+int oligoHitCmp(const void *va, const void *vb);
+/* Compare oligoHits to sort by start, strand ('+' first), then pattern index. */
+
+#endif /* OLIGOSCAN_H */
@@ -0,0 +1,38 @@
+/* tabixCache - process-wide cache of parsed tabix indexes.  Tracks that point at the
+ * same tabix-indexed file, and repeated opens of one file for different windows, share
+ * a single copy of the index instead of reading and inflating it again each time.
+ *
+ * Indexes are keyed by index file name or URL, plus modification time for local files.
+ * Remote indexes are keyed by URL alone; udc already decides whether its cached copy
+ * of the remote index is stale.  Indexes in use are reference counted.  A limited number
+ * of released indexes are kept (see tabixCacheSetMaxUnused), least recently used dropped
+ * first.
+ *
+ * This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+
+#ifndef TABIXCACHE_H
+#define TABIXCACHE_H
+
+#include "htslib/tbx.h"
+
+#define TABIX_CACHE_DEFAULT_MAX_UNUSED 32
+
+tbx_t *tabixCacheLoad(char *fileOrUrl, char *tbiFileOrUrl);
+/* Return parsed tabix index for fileOrUrl, loading it if it is not already in the cache.
+ * tbiFileOrUrl can be NULL, in which case it defaults to fileOrUrl.tbi.  Returns NULL
+ * if the index can't be loaded.  Call tabixCacheRelease when done with the index.
+ * Thread safe. */
+
+void tabixCacheRelease(tbx_t *tabix);
+/* Tell cache that caller is done with an index returned by tabixCacheLoad.
+ * Thread safe. */
+
+void tabixCacheSetMaxUnused(int maxUnused);
+/* Set the maximum number of indexes that are kept when not in use.  Zero turns caching
+ * off, so an index is freed as soon as its last user releases it. */
+
+void tabixCacheFlush();
+/* Free all indexes in the cache that are not currently in use. */
+
+#endif /* TABIXCACHE_H */
@@ -237,6 +237,10 @@ void vgClose(struct vGfx **pVg);
 #define vgSetFontMethod(v,method,fontName,fontFile) \
         v->setFontMethod(v->data,method,fontName,fontFile)
 
+void vgDrawSpans(struct vGfx *vg, int y, int height, struct mgSpan *spans, int spanCount);
+/* Draw spanCount boxes that all run from y to y+height, colors being color
+ * indexes.  Same as vgBox on each, but faster on pixel based graphics. */
+
 int vgFindRgb(struct vGfx *vg, struct rgbColor *rgb);
 /* Find color index corresponding to rgba color. */
 
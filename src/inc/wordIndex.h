@@ -0,0 +1,88 @@
+/* wordIndex - memory mapped index of the words in a text file of the sort used for
+ * grepIndex files, where each line is an id followed by free text.  The index holds
+ * the lines themselves, plus a sorted table of the upper-cased words in them, each
+ * with a sorted list of the lines it occurs in.  A search on word prefixes is then
+ * a couple of binary searches and a merge of posting lists rather than a scan of
+ * the whole file. */
+
+/* This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+
+// Typical use:
+//
+// * build the index from a text file, usually with the textToWordIndex utility
+//    wordIndexFromTextFile("description.tab", "description.tab.wix");
+//
+// * open it, search for lines that have words beginning with all of some prefixes
+//    struct wordIndex *wix = wordIndexOpen("description.tab.wix");
+//    int count;
+//    bits32 *lines = wordIndexSearch(wix, prefixCount, prefixes, &count);
+//    for (i=0; i<count; ++i)
+//        ... wordIndexLine(wix, lines[i]) ...
+//    freeMem(lines);
+//    wordIndexClose(&wix);
+
+// Memory mapped file layout, all numbers in native byte order:
+//
+// * magic bytes    [7 bytes]  0xF0 w i x v 1 0x0F
+// * reserved       [1 byte]
+// * lineCount      [8 bytes]
+// * wordCount      [8 bytes]
+// * lineOffsets    [8 bytes * (lineCount+1)]  offset of each line in file, then end of lines
+// * wordOffsets    [8 bytes * wordCount]  offset of each word in file, words in strcmp order
+// * postingStarts  [8 bytes * (wordCount+1)]  index of each word's first line in postings
+// * postings       [4 bytes * postingStarts[wordCount]]  line numbers, ascending within word
+// * lines          0-terminated lines of input, in input order
+// * words          0-terminated upper-cased words
+//
+// Words are maximal runs of isalnum characters, so any word start in the sense of
+// being at the start of a line or following a non-alphanumeric character is the
+// start of some indexed word.
+
+#ifndef WORDINDEX_H
+#define WORDINDEX_H
+
+struct wordIndex
+/* A memory mapped word index. */
+    {
+    char *fileName;		/* Name of index file. */
+    unsigned char *mmapBytes;	/* Start of memory mapped file. */
+    size_t mmapLength;		/* Number of memory mapped bytes. */
+    bits64 lineCount;		/* Number of lines indexed. */
+    bits64 wordCount;		/* Number of distinct words. */
+    bits64 *lineOffsets;	/* Offsets of lines, pointing into mmapBytes. */
+    bits64 *wordOffsets;	/* Offsets of words, pointing into mmapBytes. */
+    bits64 *postingStarts;	/* Start of each word's lines in postings. */
+    bits32 *postings;		/* Line numbers for each word in turn. */
+    };
+
+void wordIndexFromTextFile(char *inFile, char *outFile);
+/* Index the words in inFile and write index to outFile.  Blank lines and lines
+ * starting with # are skipped just as lineFileNextReal does, and are not counted in
+ * line numbers. */
+
+struct wordIndex *wordIndexOpen(char *fileName);
+/* Memory map word index in fileName and return it.  Aborts if it is not one. */
+
+void wordIndexClose(struct wordIndex **pWix);
+/* Unmap and free up word index. */
+
+char *wordIndexLine(struct wordIndex *wix, bits32 lineIx);
+/* Return line lineIx of indexed text.  This is in read-only memory; do not modify. */
+
+bits32 *wordIndexPrefixLines(struct wordIndex *wix, char *prefix, int *retCount);
+/* Return ascending array of numbers of lines that have a word starting with prefix,
+ * ignoring case, and put its size in *retCount.  Returns NULL if there are none.
+ * Free result with freeMem. */
+
+bits32 *wordIndexSearch(struct wordIndex *wix, int prefixCount, char **prefixes,
+	int *retCount);
+/* Return ascending array of numbers of lines that have words starting with each of
+ * prefixes, ignoring case, and put its size in *retCount.  Empty prefixes match
+ * every line.  Returns NULL if there are no matches.  Free result with freeMem. */
+
+int wordIndexIntersect(bits32 *a, int aCount, bits32 *b, int bCount, bits32 *out);
+/* Put numbers that are in both the ascending arrays a and b into out, which may be
+ * the same as a, and return how many there are. */
+
+#endif /* WORDINDEX_H */
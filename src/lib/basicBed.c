@@ -16,6 +16,7 @@
 #include "linefile.h"
 #include "dystring.h"
 #include "sqlNum.h"
+#include "numText.h"
 #include "sqlList.h"
 #include "rangeTree.h"
 #include "binRange.h"
@@ -525,9 +526,9 @@ if (sep == ',') fputc('"',f);
 fprintf(f, "%s", el->chrom);
 if (sep == ',') fputc('"',f);
 fputc(sep,f);
-fprintf(f, "%u", el->chromStart);
+numTextWriteUnsigned(f, el->chromStart);
 fputc(sep,f);
-fprintf(f, "%u", el->chromEnd);
+numTextWriteUnsigned(f, el->chromEnd);
 if (wordCount <= 3)
     {
     fputc(lastSep, f);
@@ -543,7 +544,7 @@ if (wordCount <= 4)
     return;
     }
 fputc(sep,f);
-fprintf(f, "%d", el->score);
+numTextWriteSigned(f, el->score);
 if (wordCount <= 5)
     {
     fputc(lastSep, f);
@@ -559,14 +560,14 @@ if (wordCount <= 6)
     return;
     }
 fputc(sep,f);
-fprintf(f, "%u", el->thickStart);
+numTextWriteUnsigned(f, el->thickStart);
 if (wordCount <= 7)
     {
     fputc(lastSep, f);
     return;
     }
 fputc(sep,f);
-fprintf(f, "%u", el->thickEnd);
+numTextWriteUnsigned(f, el->thickEnd);
 if (wordCount <= 8)
     {
     fputc(lastSep, f);
@@ -577,14 +578,14 @@ if (useItemRgb)
     fprintf(f, "%d,%d,%d", (el->itemRgb & 0xff0000) >> 16,
         (el->itemRgb & 0xff00) >> 8, (el->itemRgb & 0xff));
 else
-    fprintf(f, "%u", el->itemRgb);
+    numTextWriteUnsigned(f, el->itemRgb);
 if (wordCount <= 9)
     {
     fputc(lastSep, f);
     return;
     }
 fputc(sep,f);
-fprintf(f, "%d", el->blockCount);
+numTextWriteSigned(f, (int)el->blockCount);
 if (wordCount <= 10)
     {
     fputc(lastSep, f);
@@ -594,7 +595,7 @@ fputc(sep,f);
 if (sep == ',') fputc('{',f);
 for (i=0; i<el->blockCount; ++i)
     {
-    fprintf(f, "%d", el->blockSizes[i]);
+    numTextWriteSigned(f, el->blockSizes[i]);
     fputc(',', f);
     }
 if (sep == ',') fputc('}',f);
@@ -607,7 +608,7 @@ fputc(sep,f);
 if (sep == ',') fputc('{',f);
 for (i=0; i<el->blockCount; ++i)
     {
-    fprintf(f, "%d", el->chromStarts[i]);
+    numTextWriteSigned(f, el->chromStarts[i]);
     fputc(',', f);
     }
 if (sep == ',') fputc('}',f);
@@ -618,7 +619,7 @@ if (wordCount <= 12)
     return;
     }
 fputc(sep,f);
-fprintf(f, "%d", el->expCount);
+numTextWriteSigned(f, el->expCount);
 
 if (wordCount <= 13)
     {
@@ -629,7 +630,7 @@ fputc(sep,f);
 if (sep == ',') fputc('{',f);
 for (i=0; i<el->expCount; ++i)
     {
-    fprintf(f, "%d", el->expIds[i]);
+    numTextWriteSigned(f, el->expIds[i]);
     fputc(',', f);
     }
 if (sep == ',') fputc('}',f);
@@ -644,7 +645,7 @@ fputc(sep,f);
 if (sep == ',') fputc('{',f);
 for (i=0; i<el->expCount; ++i)
     {
-    fprintf(f, "%g", el->expScores[i]);
+    numTextWriteDouble(f, el->expScores[i]);
     fputc(',', f);
     }
 if (sep == ',') fputc('}',f);
@@ -13,6 +13,8 @@
 #include "hmmstats.h"
 #include "cirTree.h"
 #include "udc.h"
+#include "localmem.h"
+#include "pthreadDoList.h"
 #include "bbiFile.h"
 
 struct bbiZoomLevel *bbiBestZoom(struct bbiZoomLevel *levelList, int desiredReduction)
@@ -876,3 +878,179 @@ if (chromId != lastChromId)
 return chromBuf;
 }
 
+
+static void addStreamBlocks(struct bbiBlockStream *bs, char *chrom, bits32 chromId,
+	bits32 start, bits32 end, bits32 pad, struct bbiStreamBlock ***pTail)
+/* Add blocks overlapping chromId:start-end, widened by pad, to end of bs->todo. */
+{
+bits32 paddedStart = (start > pad) ? start - pad : 0;
+bits32 paddedEnd = end + pad;
+struct fileOffsetSize *fos, *fosList = cirTreeFindOverlappingBlocks(bs->bbi->unzoomedCir,
+	chromId, paddedStart, paddedEnd);
+for (fos = fosList; fos != NULL; fos = fos->next)
+    {
+    struct bbiStreamBlock *block;
+    lmAllocVar(bs->lm, block);
+    block->offset = fos->offset;
+    block->size = fos->size;
+    block->chrom = chrom;
+    block->chromId = chromId;
+    block->start = start;
+    block->end = end;
+    **pTail = block;
+    *pTail = &block->next;
+    }
+slFreeList(&fosList);
+}
+
+struct bbiBlockStream *bbiBlockStreamOpen(struct bbiFile *bbi, char *chrom,
+	bits32 start, bits32 end, bits32 pad, int threadCount)
+/* Set up to return unzoomed data blocks with items overlapping chrom:start-end,
+ * widened by pad bases on each side, or all blocks of all chromosomes if chrom is
+ * NULL.  Blocks come in the same order as separate queries of each chromosome in
+ * bbiChromList order would return them.  Up to threadCount threads inflate blocks. */
+{
+struct bbiBlockStream *bs;
+AllocVar(bs);
+bs->bbi = bbi;
+bs->threadCount = max(threadCount, 1);
+bs->batchSize = 8 * bs->threadCount;
+AllocArray(bs->bufs, bs->batchSize);
+bs->lm = lmInit(0);
+bbiAttachUnzoomedCir(bbi);
+struct bbiStreamBlock **tail = &bs->todo;
+if (chrom != NULL)
+    {
+    struct bbiChromIdSize *idSize = getChromIdSize(bbi, chrom);
+    if (idSize != NULL)
+	addStreamBlocks(bs, lmCloneString(bs->lm, chrom), idSize->chromId,
+		start, end, pad, &tail);
+    freeMem(idSize);
+    }
+else
+    {
+    struct bbiChromInfo *info, *chromList = bbiChromList(bbi);
+    for (info = chromList; info != NULL; info = info->next)
+	addStreamBlocks(bs, lmCloneString(bs->lm, info->name), info->id,
+		0, info->size, pad, &tail);
+    bbiChromInfoFreeList(&chromList);
+    }
+return bs;
+}
+
+static void inflateStreamBlock(void *item, void *context)
+/* Uncompress one block of a batch into its buffer. */
+{
+struct bbiStreamBlock *block = item;
+struct bbiFile *bbi = context;
+block->dataSize = zUncompress(block->raw, block->size, block->buf, bbi->uncompressBufSize);
+block->data = block->buf;
+}
+
+static boolean readStreamBatch(struct bbiBlockStream *bs)
+/* Move the next batch of blocks from todo to batch, read them in as few reads as
+ * possible, and inflate them.  Return FALSE if no blocks are left. */
+{
+struct bbiFile *bbi = bs->bbi;
+struct bbiStreamBlock *block, *last = NULL;
+bits64 totalSize = 0;
+int count = 0;
+if (bs->todo == NULL)
+    return FALSE;
+for (block = bs->todo; block != NULL && count < bs->batchSize; block = block->next)
+    {
+    totalSize += block->size;
+    last = block;
+    ++count;
+    }
+bs->batch = bs->todo;
+bs->todo = last->next;
+last->next = NULL;
+
+if (totalSize > bs->readBufSize)
+    {
+    freeMem(bs->readBuf);
+    bs->readBuf = needLargeMem(totalSize);
+    bs->readBufSize = totalSize;
+    }
+
+/* Read each run of blocks that are next to each other in the file at once. */
+char *raw = bs->readBuf;
+for (block = bs->batch; block != NULL; )
+    {
+    struct bbiStreamBlock *runEnd = block;
+    bits64 runSize = block->size;
+    while (runEnd->next != NULL && runEnd->next->offset == runEnd->offset + runEnd->size)
+	{
+	runEnd = runEnd->next;
+	runSize += runEnd->size;
+	}
+    udcSeek(bbi->udc, block->offset);
+    udcMustRead(bbi->udc, raw, runSize);
+    for (;;)
+	{
+	block->raw = raw;
+	raw += block->size;
+	if (block == runEnd)
+	    break;
+	block = block->next;
+	}
+    block = runEnd->next;
+    }
+
+/* Inflate batch, on several threads if we have them. */
+int i = 0;
+for (block = bs->batch; block != NULL; block = block->next, ++i)
+    {
+    if (bbi->uncompressBufSize > 0)
+	{
+	if (bs->bufs[i] == NULL)
+	    bs->bufs[i] = needLargeMem(bbi->uncompressBufSize);
+	block->buf = bs->bufs[i];
+	}
+    else
+	{
+	block->data = block->raw;
+	block->dataSize = block->size;
+	}
+    }
+if (bbi->uncompressBufSize > 0)
+    {
+    if (bs->threadCount > 1 && count > 1)
+	pthreadDoList(min(bs->threadCount, count), bs->batch, inflateStreamBlock, bbi);
+    else
+	{
+	for (block = bs->batch; block != NULL; block = block->next)
+	    inflateStreamBlock(block, bbi);
+	}
+    }
+return TRUE;
+}
+
+struct bbiStreamBlock *bbiBlockStreamNext(struct bbiBlockStream *bs)
+/* Return next block or NULL at end.  The block is valid until the next call. */
+{
+if (bs->current != NULL && bs->current->next != NULL)
+    bs->current = bs->current->next;
+else if (readStreamBatch(bs))
+    bs->current = bs->batch;
+else
+    bs->current = NULL;
+return bs->current;
+}
+
+void bbiBlockStreamClose(struct bbiBlockStream **pBs)
+/* Free up block stream.  Does not close the bbiFile. */
+{
+struct bbiBlockStream *bs = *pBs;
+if (bs != NULL)
+    {
+    int i;
+    for (i = 0; i < bs->batchSize; ++i)
+	freeMem(bs->bufs[i]);
+    freeMem(bs->bufs);
+    freeMem(bs->readBuf);
+    lmCleanup(&bs->lm);
+    freez(pBs);
+    }
+}
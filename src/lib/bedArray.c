@@ -0,0 +1,359 @@
+/* bedArray - hold many bed records compactly, a column at a time.
+ *
+ * This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+
+#include "common.h"
+#include "hash.h"
+#include "localmem.h"
+#include "linefile.h"
+#include "sqlNum.h"
+#include "sqlList.h"
+#include "basicBed.h"
+#include "bedArray.h"
+
+#define growArray(array, oldCount, newCount) \
+    (array = needLargeMemResize(array, (newCount)*sizeof((array)[0])))
+/* Like ExpandArray, but lets realloc move big arrays without copying, and doesn't
+ * zero the new part, so memory isn't touched until records are added. */
+
+struct bedArray *bedArrayNew(int fieldCount, int sizeGuess)
+/* Return a new empty bedArray that keeps fieldCount fields of each record.
+ * sizeGuess is how many records to allocate room for at first, and may be 0. */
+{
+if (fieldCount < 3 || fieldCount > BED_ARRAY_MAX_FIELDS)
+    errAbort("bedArrayNew: fieldCount %d is not between 3 and %d",
+	     fieldCount, BED_ARRAY_MAX_FIELDS);
+struct bedArray *ba;
+AllocVar(ba);
+ba->fieldCount = fieldCount;
+ba->alloc = max(sizeGuess, 64);
+int n = ba->alloc;
+AllocArray(ba->chrom, n);
+AllocArray(ba->chromStart, n);
+AllocArray(ba->chromEnd, n);
+if (fieldCount > 3)
+    AllocArray(ba->name, n);
+if (fieldCount > 4)
+    AllocArray(ba->score, n);
+if (fieldCount > 5)
+    AllocArray(ba->strand, n);
+if (fieldCount > 6)
+    AllocArray(ba->thickStart, n);
+if (fieldCount > 7)
+    AllocArray(ba->thickEnd, n);
+if (fieldCount > 8)
+    AllocArray(ba->itemRgb, n);
+if (fieldCount > 9)
+    {
+    AllocArray(ba->blockCount, n);
+    AllocArray(ba->blockOffset, n);
+    ba->blockAlloc = 4*n;
+    AllocArray(ba->blockSizes, ba->blockAlloc);
+    AllocArray(ba->chromStarts, ba->blockAlloc);
+    }
+ba->chromHash = hashNew(8);
+ba->lm = lmInit(0);
+return ba;
+}
+
+void bedArrayFree(struct bedArray **pBa)
+/* Free up bedArray and everything in it. */
+{
+struct bedArray *ba = *pBa;
+if (ba != NULL)
+    {
+    freeMem(ba->chrom);
+    freeMem(ba->chromStart);
+    freeMem(ba->chromEnd);
+    freeMem(ba->name);
+    freeMem(ba->score);
+    freeMem(ba->strand);
+    freeMem(ba->thickStart);
+    freeMem(ba->thickEnd);
+    freeMem(ba->itemRgb);
+    freeMem(ba->blockCount);
+    freeMem(ba->blockOffset);
+    freeMem(ba->blockSizes);
+    freeMem(ba->chromStarts);
+    hashFree(&ba->chromHash);
+    lmCleanup(&ba->lm);
+    freez(pBa);
+    }
+}
+
+static void expandRecords(struct bedArray *ba)
+/* Double the room for records. */
+{
+int oldAlloc = ba->alloc, newAlloc = 2*oldAlloc;
+growArray(ba->chrom, oldAlloc, newAlloc);
+growArray(ba->chromStart, oldAlloc, newAlloc);
+growArray(ba->chromEnd, oldAlloc, newAlloc);
+if (ba->name != NULL)
+    growArray(ba->name, oldAlloc, newAlloc);
+if (ba->score != NULL)
+    growArray(ba->score, oldAlloc, newAlloc);
+if (ba->strand != NULL)
+    growArray(ba->strand, oldAlloc, newAlloc);
+if (ba->thickStart != NULL)
+    growArray(ba->thickStart, oldAlloc, newAlloc);
+if (ba->thickEnd != NULL)
+    growArray(ba->thickEnd, oldAlloc, newAlloc);
+if (ba->itemRgb != NULL)
+    growArray(ba->itemRgb, oldAlloc, newAlloc);
+if (ba->blockCount != NULL)
+    {
+    growArray(ba->blockCount, oldAlloc, newAlloc);
+    growArray(ba->blockOffset, oldAlloc, newAlloc);
+    }
+ba->alloc = newAlloc;
+}
+
+static int allocBlocks(struct bedArray *ba, int blockCount)
+/* Make room for blockCount more entries in block pools and return offset of first. */
+{
+int offset = ba->blockUsed;
+int needed = offset + blockCount;
+if (needed > ba->blockAlloc)
+    {
+    int newAlloc = max(2*ba->blockAlloc, needed);
+    growArray(ba->blockSizes, ba->blockAlloc, newAlloc);
+    growArray(ba->chromStarts, ba->blockAlloc, newAlloc);
+    ba->blockAlloc = newAlloc;
+    }
+ba->blockUsed = needed;
+return offset;
+}
+
+static char *internChrom(struct bedArray *ba, char *chrom)
+/* Return the single copy of chrom kept in ba. */
+{
+return hashStoreName(ba->chromHash, chrom);
+}
+
+static int newRecord(struct bedArray *ba)
+/* Return index of a new record, making room for it if need be. */
+{
+if (ba->count >= ba->alloc)
+    expandRecords(ba);
+return ba->count++;
+}
+
+int bedArrayAddRow(struct bedArray *ba, char **row, int wordCount)
+/* Parse a bed in row, which has wordCount words, into a new record, and return its
+ * index.  Fields missing from row get the same defaults as in bedLoadN, except that a
+ * row with blockSizes but no chromStarts gets chromStarts of zero.  A blockCount with
+ * no block lists is kept, as bedLoadN does. */
+{
+int ix = newRecord(ba);
+int fieldCount = ba->fieldCount;
+ba->chrom[ix] = internChrom(ba, row[0]);
+ba->chromStart[ix] = sqlUnsigned(row[1]);
+ba->chromEnd[ix] = sqlUnsigned(row[2]);
+if (fieldCount > 3)
+    ba->name[ix] = (wordCount > 3 ? lmCloneString(ba->lm, row[3]) : NULL);
+if (fieldCount > 4)
+    ba->score[ix] = (wordCount > 4 ? sqlSigned(row[4]) : 0);
+if (fieldCount > 5)
+    ba->strand[ix] = (wordCount > 5 ? row[5][0] : 0);
+if (fieldCount > 6)
+    ba->thickStart[ix] = (wordCount > 6 ? sqlUnsigned(row[6]) : ba->chromStart[ix]);
+if (fieldCount > 7)
+    ba->thickEnd[ix] = (wordCount > 7 ? sqlUnsigned(row[7]) : ba->chromEnd[ix]);
+if (fieldCount > 8)
+    ba->itemRgb[ix] = (wordCount > 8 ? itemRgbColumn(row[8]) : 0);
+if (fieldCount > 9)
+    {
+    int blockCount = (wordCount > 9 ? sqlUnsigned(row[9]) : 0);
+    ba->blockCount[ix] = blockCount;
+    ba->blockOffset[ix] = -1;
+    if (wordCount > 10)
+	{
+	// Parse into one spare entry so that lists longer than blockCount are caught.
+	int offset = allocBlocks(ba, blockCount+1);
+	ba->blockUsed -= 1;
+	int sizeCount = sqlSignedArray(row[10], ba->blockSizes + offset, blockCount+1);
+	int startCount = blockCount;
+	if (wordCount > 11)
+	    startCount = sqlSignedArray(row[11], ba->chromStarts + offset, blockCount+1);
+	else
+	    zeroBytes(ba->chromStarts + offset, blockCount * sizeof(ba->chromStarts[0]));
+	if (sizeCount != blockCount || startCount != blockCount)
+	    errAbort("bed %s:%s has blockCount %d but %d blockSizes and %d chromStarts",
+		     row[0], row[1], blockCount, sizeCount, startCount);
+	if (blockCount > 0)
+	    ba->blockOffset[ix] = offset;
+	}
+    }
+return ix;
+}
+
+int bedArrayAddBed(struct bedArray *ba, struct bed *bed)
+/* Copy bed into a new record and return its index. */
+{
+int ix = newRecord(ba);
+int fieldCount = ba->fieldCount;
+ba->chrom[ix] = internChrom(ba, bed->chrom);
+ba->chromStart[ix] = bed->chromStart;
+ba->chromEnd[ix] = bed->chromEnd;
+if (fieldCount > 3)
+    ba->name[ix] = (bed->name != NULL ? lmCloneString(ba->lm, bed->name) : NULL);
+if (fieldCount > 4)
+    ba->score[ix] = bed->score;
+if (fieldCount > 5)
+    ba->strand[ix] = bed->strand[0];
+if (fieldCount > 6)
+    ba->thickStart[ix] = bed->thickStart;
+if (fieldCount > 7)
+    ba->thickEnd[ix] = bed->thickEnd;
+if (fieldCount > 8)
+    ba->itemRgb[ix] = bed->itemRgb;
+if (fieldCount > 9)
+    {
+    int blockCount = bed->blockCount;
+    ba->blockCount[ix] = blockCount;
+    ba->blockOffset[ix] = -1;
+    if (blockCount > 0 && bed->blockSizes != NULL)
+	{
+	int offset = allocBlocks(ba, blockCount);
+	int *blockSizes = ba->blockSizes + offset, *chromStarts = ba->chromStarts + offset;
+	ba->blockOffset[ix] = offset;
+	CopyArray(bed->blockSizes, blockSizes, blockCount);
+	if (bed->chromStarts != NULL)
+	    CopyArray(bed->chromStarts, chromStarts, blockCount);
+	else
+	    zeroBytes(chromStarts, blockCount * sizeof(chromStarts[0]));
+	}
+    }
+return ix;
+}
+
+struct bedArray *bedArrayLoadFile(char *fileName, int fieldCount)
+/* Load all beds in a tab-separated file.  If fieldCount is zero it is set from the
+ * first line of the file.  Dispose of this with bedArrayFree(). */
+{
+struct lineFile *lf = lineFileOpen(fileName, TRUE);
+struct bedArray *ba = NULL;
+char *line, *row[bedKnownFields];
+while (lineFileNextReal(lf, &line))
+    {
+    int wordCount = chopByWhite(line, row, ArraySize(row));
+    if (ba == NULL)
+	{
+	if (fieldCount == 0)
+	    fieldCount = min(wordCount, BED_ARRAY_MAX_FIELDS);
+	ba = bedArrayNew(fieldCount, 0);
+	}
+    if (wordCount < fieldCount)
+	errAbort("Expecting %d words, got %d line %d of %s",
+		 fieldCount, wordCount, lf->lineIx, lf->fileName);
+    bedArrayAddRow(ba, row, fieldCount);
+    }
+lineFileClose(&lf);
+if (ba == NULL)
+    ba = bedArrayNew(max(fieldCount, 3), 0);
+return ba;
+}
+
+void bedArrayGet(struct bedArray *ba, int ix, struct bed *bed)
+/* Fill in bed from record ix.  The strings and block arrays in bed point into ba,
+ * so bed must not be freed with bedFree, and must not be used after more records
+ * are added to ba. */
+{
+ZeroVar(bed);
+bed->chrom = ba->chrom[ix];
+bed->chromStart = ba->chromStart[ix];
+bed->chromEnd = ba->chromEnd[ix];
+if (ba->name != NULL)
+    bed->name = ba->name[ix];
+if (ba->score != NULL)
+    bed->score = ba->score[ix];
+if (ba->strand != NULL)
+    bed->strand[0] = ba->strand[ix];
+bed->thickStart = (ba->thickStart != NULL ? ba->thickStart[ix] : bed->chromStart);
+bed->thickEnd = (ba->thickEnd != NULL ? ba->thickEnd[ix] : bed->chromEnd);
+if (ba->itemRgb != NULL)
+    bed->itemRgb = ba->itemRgb[ix];
+if (ba->blockCount != NULL)
+    {
+    bed->blockCount = ba->blockCount[ix];
+    bed->blockSizes = bedArrayBlockSizes(ba, ix);
+    bed->chromStarts = bedArrayChromStarts(ba, ix);
+    }
+}
+
+struct bed *bedArrayToBed(struct bedArray *ba, int ix)
+/* Return a separately allocated copy of record ix. Free it with bedFree. */
+{
+struct bed view, *bed;
+bedArrayGet(ba, ix, &view);
+bed = cloneMem(&view, sizeof(view));
+bed->chrom = cloneString(view.chrom);
+bed->name = cloneString(view.name);
+if (view.blockSizes != NULL)
+    {
+    bed->blockSizes = CloneArray(view.blockSizes, view.blockCount);
+    bed->chromStarts = CloneArray(view.chromStarts, view.blockCount);
+    }
+return bed;
+}
+
+static struct bedArray *sortBa;	/* Array being sorted, for sortIxCmp. */
+
+static int sortIxCmp(const void *va, const void *vb)
+/* Compare record indexes to sort by chrom, chromStart, then original order. */
+{
+int a = *((const int *)va), b = *((const int *)vb);
+int dif = strcmp(sortBa->chrom[a], sortBa->chrom[b]);
+if (dif == 0)
+    {
+    if (sortBa->chromStart[a] != sortBa->chromStart[b])
+	dif = (sortBa->chromStart[a] < sortBa->chromStart[b] ? -1 : 1);
+    else
+	dif = a - b;
+    }
+return dif;
+}
+
+static void *permuted(void *column, int elSize, int *order, int count, int alloc)
+/* Return a copy of column where element i is old element order[i], and free the old
+ * column.  Returns NULL if column is NULL. */
+{
+if (column == NULL)
+    return NULL;
+char *old = column, *new = needLargeZeroedMem((size_t)elSize * alloc);
+int i;
+for (i = 0; i < count; ++i)
+    memcpy(new + (size_t)i*elSize, old + (size_t)order[i]*elSize, elSize);
+freeMem(old);
+return new;
+}
+
+#define permuteColumn(column, order, ba) \
+    (column = permuted(column, sizeof((column)[0]), order, (ba)->count, (ba)->alloc))
+/* Reorder a per-record array of ba by order. */
+
+void bedArraySort(struct bedArray *ba)
+/* Sort records by chrom, then chromStart. */
+{
+int count = ba->count;
+int *order, i;
+AllocArray(order, count);
+for (i = 0; i < count; ++i)
+    order[i] = i;
+sortBa = ba;
+qsort(order, count, sizeof(order[0]), sortIxCmp);
+sortBa = NULL;
+permuteColumn(ba->chrom, order, ba);
+permuteColumn(ba->chromStart, order, ba);
+permuteColumn(ba->chromEnd, order, ba);
+permuteColumn(ba->name, order, ba);
+permuteColumn(ba->score, order, ba);
+permuteColumn(ba->strand, order, ba);
+permuteColumn(ba->thickStart, order, ba);
+permuteColumn(ba->thickEnd, order, ba);
+permuteColumn(ba->itemRgb, order, ba);
+permuteColumn(ba->blockCount, order, ba);
+permuteColumn(ba->blockOffset, order, ba);
+freeMem(order);
+}
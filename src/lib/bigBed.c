@@ -137,6 +137,66 @@ slReverse(&list);
 return list;
 }
 
+struct bigBedStream *bigBedStreamOpen(struct bbiFile *bbi, char *chrom,
+	bits32 start, bits32 end, int threadCount)
+/* Set up to return the same items as bigBedIntervalQuery(bbi, chrom, start, end)
+ * would, in the same order, or if chrom is NULL all items in file in bbiChromList
+ * order.  Up to threadCount threads uncompress blocks ahead of the reader. */
+{
+struct bigBedStream *bbs;
+AllocVar(bbs);
+// Pad by a base as bigBedIntervalQuery does to get zero-length insertions at edges.
+bbs->blocks = bbiBlockStreamOpen(bbi, chrom, start, end, 1, threadCount);
+return bbs;
+}
+
+struct bigBedInterval *bigBedStreamNext(struct bigBedStream *bbs)
+/* Return next item or NULL at end.  The item, including rest, is only valid until
+ * the next call, and bbs->chrom is set to its chromosome. */
+{
+boolean isSwapped = bbs->blocks->bbi->isSwapped;
+for (;;)
+    {
+    while (bbs->pt < bbs->end)
+	{
+	struct bbiStreamBlock *block = bbs->block;
+	bits32 chr = memReadBits32(&bbs->pt, isSwapped);
+	bits32 s = memReadBits32(&bbs->pt, isSwapped);
+	bits32 e = memReadBits32(&bbs->pt, isSwapped);
+	char *rest = bbs->pt;
+	int restLen = strlen(rest);
+	bbs->pt += restLen + 1;
+	if (chr == block->chromId &&
+	    ((s < block->end && e > block->start)
+	     || (s == e && (s == block->end || e == block->start))))
+	    {
+	    struct bigBedInterval *el = &bbs->interval;
+	    el->start = s;
+	    el->end = e;
+	    el->rest = (restLen > 0 ? rest : NULL);
+	    el->chromId = chr;
+	    bbs->chrom = block->chrom;
+	    return el;
+	    }
+	}
+    if ((bbs->block = bbiBlockStreamNext(bbs->blocks)) == NULL)
+	return NULL;
+    bbs->pt = bbs->block->data;
+    bbs->end = bbs->pt + bbs->block->dataSize;
+    }
+}
+
+void bigBedStreamClose(struct bigBedStream **pBbs)
+/* Free up bigBed stream.  Does not close the bbiFile. */
+{
+struct bigBedStream *bbs = *pBbs;
+if (bbs != NULL)
+    {
+    bbiBlockStreamClose(&bbs->blocks);
+    freez(pBbs);
+    }
+}
+
 int bigBedIntervalToRow(struct bigBedInterval *interval, char *chrom, char *startBuf, char *endBuf,
 	char **row, int rowSize)
 /* Convert bigBedInterval into an array of chars equivalent to what you'd get by
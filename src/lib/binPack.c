@@ -0,0 +1,70 @@
+/* binPack - compact binary encoding of numbers and strings in memory.
+ *
+ * This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+
+#include "common.h"
+#include "dystring.h"
+#include "binPack.h"
+
+void binPackUnsigned(struct dyString *dy, bits64 x)
+/* Append x to dy in one to ten bytes. */
+{
+char buf[10];
+int size = 0;
+while (x >= 0x80)
+    {
+    buf[size++] = (x & 0x7f) | 0x80;
+    x >>= 7;
+    }
+buf[size++] = x;
+dyStringAppendN(dy, buf, size);
+}
+
+void binPackSigned(struct dyString *dy, long long x)
+/* Append x to dy in one to ten bytes. */
+{
+binPackUnsigned(dy, ((bits64)x << 1) ^ (bits64)(x >> 63));
+}
+
+void binPackString(struct dyString *dy, char *s)
+/* Append s including terminating zero to dy.  NULL is written as empty string. */
+{
+if (s == NULL)
+    s = "";
+dyStringAppendN(dy, s, strlen(s) + 1);
+}
+
+bits64 binUnpackUnsigned(char **pS)
+/* Read an unsigned number written by binPackUnsigned from *pS and advance *pS past it. */
+{
+unsigned char *s = (unsigned char *)*pS;
+bits64 x = 0;
+int shift = 0;
+for (;;)
+    {
+    unsigned char c = *s++;
+    x |= (bits64)(c & 0x7f) << shift;
+    if (c < 0x80)
+        break;
+    shift += 7;
+    }
+*pS = (char *)s;
+return x;
+}
+
+long long binUnpackSigned(char **pS)
+/* Read a signed number written by binPackSigned from *pS and advance *pS past it. */
+{
+bits64 x = binUnpackUnsigned(pS);
+return (long long)(x >> 1) ^ -(long long)(x & 1);
+}
+
+char *binUnpackString(char **pS)
+/* Return string written by binPackString at *pS and advance *pS past it.  The
+ * string is not copied, so it is only good as long as the buffer is. */
+{
+char *s = *pS;
+*pS = s + strlen(s) + 1;
+return s;
+}
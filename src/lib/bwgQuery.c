@@ -10,6 +10,7 @@
 #include "options.h"
 #include "sig.h"
 #include "sqlNum.h"
+#include "numText.h"
 #include "obscure.h"
 #include "dystring.h"
 #include "bPlusTree.h"
@@ -95,7 +96,14 @@ switch (head.type)
 	    val = memReadFloat(&blockPt, isSwapped);
 	    if (rangeIntersection(rangeStart, rangeEnd, start, end) > 0)
 		{
-		fprintf(out, "%s\t%u\t%u\t%g\n", chrom, start, end, val);
+		fputs(chrom, out);
+		fputc('\t', out);
+		numTextWriteUnsigned(out, start);
+		fputc('\t', out);
+		numTextWriteUnsigned(out, end);
+		fputc('\t', out);
+		numTextWriteDouble(out, val);
+		fputc('\n', out);
 		++outCount;
 		if (maxCount != 0 && outCount >= maxCount)
 		    break;
@@ -112,7 +120,10 @@ switch (head.type)
 	    val = memReadFloat(&blockPt, isSwapped);
 	    if (rangeIntersection(rangeStart, rangeEnd, start, start+head.itemSpan) > 0)
 		{
-		fprintf(out, "%u\t%g\n", start+1, val);
+		numTextWriteUnsigned(out, start+1);
+		fputc('\t', out);
+		numTextWriteDouble(out, val);
+		fputc('\n', out);
 		++outCount;
 		if (maxCount != 0 && outCount >= maxCount)
 		    break;
@@ -135,7 +146,8 @@ switch (head.type)
 			    chrom, start+1, head.itemStep, head.itemSpan);
 		    gotStart = TRUE;
 		    }
-		fprintf(out, "%g\n", val);
+		numTextWriteDouble(out, val);
+		fputc('\n', out);
 		++outCount;
 		if (maxCount != 0 && outCount >= maxCount)
 		    break;
@@ -286,6 +298,89 @@ slReverse(&list);
 return list;
 }
 
+struct bigWigStream *bigWigStreamOpen(struct bbiFile *bwf, char *chrom,
+	bits32 start, bits32 end, int threadCount)
+/* Set up to return the same intervals as bigWigIntervalQuery(bwf, chrom, start, end)
+ * would, in the same order, or if chrom is NULL all intervals in file in bbiChromList
+ * order.  Up to threadCount threads uncompress blocks ahead of the reader. */
+{
+if (bwf->typeSig != bigWigSig)
+   errAbort("Trying to do bigWigStreamOpen on a non big-wig file.");
+struct bigWigStream *bws;
+AllocVar(bws);
+bws->blocks = bbiBlockStreamOpen(bwf, chrom, start, end, 0, threadCount);
+return bws;
+}
+
+struct bbiInterval *bigWigStreamNext(struct bigWigStream *bws)
+/* Return next interval or NULL at end.  The interval is only valid until the next
+ * call, and bws->chrom is set to its chromosome. */
+{
+boolean isSwapped = bws->blocks->bbi->isSwapped;
+for (;;)
+    {
+    while (bws->itemsLeft > 0)
+	{
+	bits32 s, e;
+	float val;
+	--bws->itemsLeft;
+	switch (bws->type)
+	    {
+	    case bwgTypeBedGraph:
+		s = memReadBits32(&bws->pt, isSwapped);
+		e = memReadBits32(&bws->pt, isSwapped);
+		break;
+	    case bwgTypeVariableStep:
+		s = memReadBits32(&bws->pt, isSwapped);
+		e = s + bws->itemSpan;
+		break;
+	    default: /* bwgTypeFixedStep */
+		s = bws->fixedStart;
+		e = s + bws->itemSpan;
+		bws->fixedStart += bws->itemStep;
+		break;
+	    }
+	val = memReadFloat(&bws->pt, isSwapped);
+	struct bbiStreamBlock *block = bws->block;
+	if (s < block->start) s = block->start;
+	if (e > block->end) e = block->end;
+	if (s < e)
+	    {
+	    struct bbiInterval *el = &bws->interval;
+	    el->start = s;
+	    el->end = e;
+	    el->val = val;
+	    bws->chrom = block->chrom;
+	    return el;
+	    }
+	}
+    if ((bws->block = bbiBlockStreamNext(bws->blocks)) == NULL)
+	return NULL;
+    struct bwgSectionHead head;
+    bws->pt = bws->block->data;
+    bwgSectionHeadFromMem(&bws->pt, &head, isSwapped);
+    if (head.type != bwgTypeBedGraph && head.type != bwgTypeVariableStep
+        && head.type != bwgTypeFixedStep)
+	internalErr();
+    bws->type = head.type;
+    bws->itemsLeft = head.itemCount;
+    bws->itemStep = head.itemStep;
+    bws->itemSpan = head.itemSpan;
+    bws->fixedStart = head.start;
+    }
+}
+
+void bigWigStreamClose(struct bigWigStream **pBws)
+/* Free up bigWig stream.  Does not close the bbiFile. */
+{
+struct bigWigStream *bws = *pBws;
+if (bws != NULL)
+    {
+    bbiBlockStreamClose(&bws->blocks);
+    freez(pBws);
+    }
+}
+
 int bigWigIntervalDump(struct bbiFile *bwf, char *chrom, bits32 start, bits32 end, int maxCount,
 	FILE *out)
 /* Print out info on bigWig parts that intersect chrom:start-end.   Set maxCount to 0 if you 
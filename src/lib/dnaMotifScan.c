@@ -0,0 +1,288 @@
+/* dnaMotifScan - score position weight matrix motifs at every position of long
+ * sequences, using a lookup table for each four columns of the motif.
+ *
+ * This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+
+#include "common.h"
+#include "dnautil.h"
+#include "dnaMotif.h"
+#include "dnaMotifScan.h"
+
+#define OTHER_CODE 4	/* Code for bases that aren't A, C, G or T.  Others are ntVal. */
+#define SCORE_BLOCK 4096	/* Positions scored together in dnaMotifPwmScoreAll. */
+
+static double motifProb(struct dnaMotif *motif, int col, int base)
+/* Return probability of base (in ntVal coding) in column of motif. */
+{
+switch (base)
+    {
+    case T_BASE_VAL:
+	return motif->tProb[col];
+    case C_BASE_VAL:
+	return motif->cProb[col];
+    case A_BASE_VAL:
+	return motif->aProb[col];
+    case G_BASE_VAL:
+	return motif->gProb[col];
+    default:
+	return 0.25;
+    }
+}
+
+static double columnScore(struct dnaMotif *motif, double mark0[5], char strand,
+	int col, int base)
+/* Return log2-odds score of forward strand base at column col of the compiled
+ * motif.  Mirrors dnaMotifSequenceProb and dnaMotifSequenceProbWithMark0. */
+{
+double p, q;
+if (strand == '-' && base != OTHER_CODE)
+    p = motifProb(motif, motif->columnCount - 1 - col, base ^ 2);  // ^2 complements in ntVal
+else if (strand == '-')
+    p = motifProb(motif, motif->columnCount - 1 - col, base);
+else
+    p = motifProb(motif, col, base);
+if (mark0 == NULL)
+    q = 0.25;
+else if (base == OTHER_CODE)
+    q = 1.0;
+else
+    q = mark0[base+1]/mark0[0];
+return logBase2(p/q);
+}
+
+struct dnaMotifPwm *dnaMotifPwmNew(struct dnaMotif *motif, double mark0[5], char strand)
+/* Compile a probabalistic motif (see dnaMotifMakeProbabalistic) into score tables.
+ * If mark0 is non-NULL it is a 0-order background model as made by dnaMark0,
+ * otherwise the background is uniform.  If strand is '-' the tables score the
+ * reverse complement of the motif against the forward strand sequence.  The
+ * threshold starts out so low that every position is reported. */
+{
+if (strand != '+' && strand != '-')
+    errAbort("dnaMotifPwmNew: strand must be '+' or '-', not '%c'", strand);
+if (motif->columnCount <= 0)
+    errAbort("dnaMotifPwmNew: motif %s has no columns", motif->name);
+struct dnaMotifPwm *pwm;
+AllocVar(pwm);
+pwm->motif = motif;
+pwm->strand = strand;
+pwm->columnCount = motif->columnCount;
+pwm->groupCount = (motif->columnCount + DNA_MOTIF_SCAN_GROUP - 1) / DNA_MOTIF_SCAN_GROUP;
+pwm->threshold = -INFINITY;
+
+/* Score each column for each base code, padding columns scoring zero, and
+ * find the lowest finite score of an ACGT sequence along the way. */
+int paddedCount = pwm->groupCount * DNA_MOTIF_SCAN_GROUP;
+double colScores[paddedCount][OTHER_CODE+1];
+int col, base;
+for (col = 0; col < paddedCount; ++col)
+    {
+    double colMin = INFINITY;
+    for (base = 0; base <= OTHER_CODE; ++base)
+	{
+	double score = 0;
+	if (col < motif->columnCount)
+	    score = columnScore(motif, mark0, strand, col, base);
+	colScores[col][base] = score;
+	if (base != OTHER_CODE && !isinf(score) && score < colMin)
+	    colMin = score;
+	}
+    if (!isinf(colMin))
+	pwm->minScore += colMin;
+    }
+
+/* Sum columns into a table for each group, indexed by the four bases as a base 5
+ * number, and note the best each group can do. */
+AllocArray(pwm->groupScores, pwm->groupCount * DNA_MOTIF_SCAN_WORDS);
+AllocArray(pwm->bestRest, pwm->groupCount + 1);
+double groupBest[pwm->groupCount];
+int g, word;
+for (g = 0; g < pwm->groupCount; ++g)
+    {
+    float *table = pwm->groupScores + g*DNA_MOTIF_SCAN_WORDS;
+    double (*cs)[OTHER_CODE+1] = colScores + g*DNA_MOTIF_SCAN_GROUP;
+    double best = -INFINITY;
+    for (word = 0; word < DNA_MOTIF_SCAN_WORDS; ++word)
+	{
+	int b0 = word/125, b1 = (word/25)%5, b2 = (word/5)%5, b3 = word%5;
+	double score = cs[0][b0] + cs[1][b1] + cs[2][b2] + cs[3][b3];
+	table[word] = score;
+	if (score > best)
+	    best = score;
+	}
+    groupBest[g] = best;
+    }
+pwm->bestRest[pwm->groupCount] = 0;
+for (g = pwm->groupCount - 1; g >= 0; --g)
+    pwm->bestRest[g] = pwm->bestRest[g+1] + groupBest[g];
+pwm->maxScore = pwm->bestRest[0];
+return pwm;
+}
+
+void dnaMotifPwmFree(struct dnaMotifPwm **pPwm)
+/* Free up compiled motif. */
+{
+struct dnaMotifPwm *pwm = *pPwm;
+if (pwm != NULL)
+    {
+    freeMem(pwm->groupScores);
+    freeMem(pwm->bestRest);
+    freez(pPwm);
+    }
+}
+
+void dnaMotifPwmFreeList(struct dnaMotifPwm **pList)
+/* Free a list of compiled motifs. */
+{
+struct dnaMotifPwm *el, *next;
+for (el = *pList; el != NULL; el = next)
+    {
+    next = el->next;
+    dnaMotifPwmFree(&el);
+    }
+*pList = NULL;
+}
+
+double dnaMotifPwmRelativeScore(struct dnaMotifPwm *pwm, double fraction)
+/* Return the score that is fraction of the way from the lowest to the highest
+ * possible score of pwm.  Useful for setting pwm->threshold. */
+{
+return pwm->minScore + fraction * (pwm->maxScore - pwm->minScore);
+}
+
+struct dnaMotifScanSeq *dnaMotifScanSeqNew(DNA *dna, int size)
+/* Convert dna into four base word codes for scanning.  Any character other than
+ * upper or lower case A, C, G, T is treated as N. */
+{
+struct dnaMotifScanSeq *ss;
+AllocVar(ss);
+ss->size = size;
+AllocArray(ss->words, size + DNA_MOTIF_SCAN_GROUP);
+/* Codes past the end only ever line up with padding columns, so zero is fine. */
+int i, word = 0;
+for (i = size - 1; i >= 0; --i)
+    {
+    int base = ntVal[(unsigned char)dna[i]];
+    if (base < 0)
+	base = OTHER_CODE;
+    word = (word/5) + base*125;
+    ss->words[i] = word;
+    }
+return ss;
+}
+
+void dnaMotifScanSeqFree(struct dnaMotifScanSeq **pSs)
+/* Free up a converted sequence. */
+{
+struct dnaMotifScanSeq *ss = *pSs;
+if (ss != NULL)
+    {
+    freeMem(ss->words);
+    freez(pSs);
+    }
+}
+
+double dnaMotifPwmScoreAt(struct dnaMotifPwm *pwm, struct dnaMotifScanSeq *ss, int start)
+/* Return score of pwm at start, which must be at most ss->size - pwm->columnCount. */
+{
+unsigned short *words = ss->words + start;
+float *table = pwm->groupScores;
+float score = 0;
+int g;
+for (g = 0; g < pwm->groupCount; ++g, words += DNA_MOTIF_SCAN_GROUP,
+	table += DNA_MOTIF_SCAN_WORDS)
+    score += table[*words];
+return score;
+}
+
+void dnaMotifPwmScoreAll(struct dnaMotifPwm *pwm, struct dnaMotifScanSeq *ss,
+	float *scores)
+/* Put score of pwm at each position of ss into scores, which must have room for
+ * ss->size - pwm->columnCount + 1 values.  Ignores pwm->threshold. */
+{
+int posCount = ss->size - pwm->columnCount + 1;
+int blockStart;
+/* Go a group at a time over a block of positions, so that the inner loop is a
+ * simple gather and add the compiler can vectorize. */
+for (blockStart = 0; blockStart < posCount; blockStart += SCORE_BLOCK)
+    {
+    int blockSize = min(SCORE_BLOCK, posCount - blockStart);
+    float *blockScores = scores + blockStart;
+    float *table = pwm->groupScores;
+    unsigned short *words = ss->words + blockStart;
+    int i, g;
+    for (i = 0; i < blockSize; ++i)
+	blockScores[i] = table[words[i]];
+    for (g = 1; g < pwm->groupCount; ++g)
+	{
+	table += DNA_MOTIF_SCAN_WORDS;
+	words += DNA_MOTIF_SCAN_GROUP;
+	for (i = 0; i < blockSize; ++i)
+	    blockScores[i] += table[words[i]];
+	}
+    }
+}
+
+void dnaMotifPwmScan(struct dnaMotifPwm *pwm, struct dnaMotifScanSeq *ss,
+	dnaMotifScanHitFunc hitFunc, void *context)
+/* Call hitFunc on every position where pwm scores at least pwm->threshold, in order
+ * of position.  Scoring of a position stops as soon as the rest of the motif can't
+ * make up the difference. */
+{
+int posCount = ss->size - pwm->columnCount + 1;
+int groupCount = pwm->groupCount;
+float threshold = pwm->threshold;
+float *bestRest = pwm->bestRest;
+float blockScores[SCORE_BLOCK];
+int alive[SCORE_BLOCK];
+int blockStart;
+/* Score a block of positions a group at a time, keeping a list of the positions
+ * that can still reach the threshold.  The list is built without branching on the
+ * scores, which are too unpredictable for branching to pay. */
+for (blockStart = 0; blockStart < posCount; blockStart += SCORE_BLOCK)
+    {
+    int blockSize = min(SCORE_BLOCK, posCount - blockStart);
+    unsigned short *words = ss->words + blockStart;
+    float *table = pwm->groupScores;
+    float cutoff = threshold - bestRest[1];
+    int i, g, aliveCount = 0;
+    for (i = 0; i < blockSize; ++i)
+	{
+	float score = table[words[i]];
+	blockScores[i] = score;
+	alive[aliveCount] = i;
+	aliveCount += (score >= cutoff);
+	}
+    for (g = 1; g < groupCount && aliveCount > 0; ++g)
+	{
+	table += DNA_MOTIF_SCAN_WORDS;
+	words += DNA_MOTIF_SCAN_GROUP;
+	cutoff = threshold - bestRest[g+1];
+	int oldCount = aliveCount;
+	aliveCount = 0;
+	for (i = 0; i < oldCount; ++i)
+	    {
+	    int ix = alive[i];
+	    float score = blockScores[ix] + table[words[ix]];
+	    blockScores[ix] = score;
+	    alive[aliveCount] = ix;
+	    aliveCount += (score >= cutoff);
+	    }
+	}
+    for (i = 0; i < aliveCount; ++i)
+	{
+	int ix = alive[i];
+	hitFunc(context, pwm, blockStart + ix, blockScores[ix]);
+	}
+    }
+}
+
+void dnaMotifScan(struct dnaMotifPwm *pwmList, struct dnaMotifScanSeq *ss,
+	dnaMotifScanHitFunc hitFunc, void *context)
+/* Call hitFunc on every position where a motif in pwmList scores at least its
+ * threshold.  Hits are reported motif by motif, in order of position. */
+{
+struct dnaMotifPwm *pwm;
+for (pwm = pwmList; pwm != NULL; pwm = pwm->next)
+    dnaMotifPwmScan(pwm, ss, hitFunc, context);
+}
@@ -1,6 +1,7 @@
 
 #include "freeType.h"
 #include "iconv.h"
+#include "hash.h"
 
 #ifndef USE_FREETYPE
 int ftInitialize()
@@ -9,6 +10,11 @@ errAbort("FreeType not enabled. Install FreeType and recompile, or add freeType=
 return 0;
 }
 
+void ftGlyphCacheEnable(boolean enable)
+{
+errAbort("FreeType not enabled. Install FreeType and recompile, or add freeType=off to hg.conf");
+}
+
 int ftWidth(MgFont *font, unsigned char *chars, int charCount)
 {
 errAbort("FreeType not enabled. Install FreeType and recompile, or add freeType=off to hg.conf");
@@ -25,25 +31,6 @@ errAbort("FreeType not enabled. Install FreeType and recompile, or add freeType=
 FT_Library    library;
 FT_Face       face;
 
-int ftInitialize(char *fontFile)
-{
-FT_Error error;
-error = FT_Init_FreeType( &library );              /* initialize library */
-
-if (error !=0)
-    return error;
-
-error = FT_New_Face( library, fontFile, 0, &face );
-if ((error !=0) || (face == NULL))
-    errAbort("Cannot open font file '%s'.  Does it exist?", fontFile);
-
-error = FT_Select_Charmap(face, FT_ENCODING_UNICODE);
-if ((error !=0) || (face == NULL))
-    errAbort("Cannot select Unicode character map");
-
-return 0;
-}
-
 void
 draw_bitmap( struct memGfx *mg, FT_Bitmap*  bitmap, Color color,
              FT_Int      x,
@@ -120,6 +107,237 @@ switch(requestSize)
     }
 }
 
+struct ftGlyph
+/* A glyph loaded by FreeType at some size and transform. */
+    {
+    struct ftGlyph *next;
+    FT_Pos advance;		/* Advance in 1/64 pixels. */
+    boolean rendered;		/* If TRUE bitmap and position are filled in. */
+    boolean error;		/* If TRUE FreeType couldn't render it. */
+    FT_Int left, top;		/* Bitmap position relative to pen. */
+    FT_Bitmap bitmap;		/* Rendered glyph, buffer is our own copy. */
+    };
+
+struct ftGlyphSet
+/* All the glyphs we've loaded at one size and transform.  Labels on an image mostly
+ * use a few sizes, so this saves loading and rendering the same glyphs over and over. */
+    {
+    struct ftGlyphSet *next;
+    FT_UInt width, height;	/* Pixel size. */
+    FT_Fixed yy;		/* Vertical scale of transform, negative if upside down. */
+    FT_Pos penY;		/* Vertical translation of transform. */
+    struct ftGlyph *low[256];	/* Glyphs for characters below 256. */
+    struct hash *highHash;	/* Glyphs for other characters keyed by code. */
+    };
+
+static struct ftGlyphSet *glyphSetList;	/* All sets we've made for face. */
+static struct ftGlyphSet *curGlyphSet;	/* Set for current size and transform. */
+static FT_UInt curWidth, curHeight;	/* Current pixel size. */
+static FT_Fixed curYy = 0x10000L;	/* Current transform. */
+static FT_Pos curPenY;
+static char *curFontFile;		/* File face was loaded from. */
+static boolean glyphCacheOn = TRUE;	/* If FALSE every glyph is loaded afresh. */
+static struct ftGlyph scratchGlyph;	/* Glyph loaded when cache is off. */
+
+static void ftGlyphSetFree(struct ftGlyphSet **pSet)
+/* Free up a glyph set and the glyphs in it. */
+{
+struct ftGlyphSet *set = *pSet;
+if (set == NULL)
+    return;
+int i;
+for (i = 0; i < ArraySize(set->low); ++i)
+    {
+    if (set->low[i] != NULL)
+        {
+        freeMem(set->low[i]->bitmap.buffer);
+        freez(&set->low[i]);
+        }
+    }
+if (set->highHash != NULL)
+    {
+    struct hashEl *hel, *helList = hashElListHash(set->highHash);
+    for (hel = helList; hel != NULL; hel = hel->next)
+        {
+        struct ftGlyph *glyph = hel->val;
+        freeMem(glyph->bitmap.buffer);
+        freeMem(glyph);
+        }
+    hashElFreeList(&helList);
+    hashFree(&set->highHash);
+    }
+freez(pSet);
+}
+
+static void ftGlyphCacheReset()
+/* Forget all glyphs and the size and transform, as when the face changes. */
+{
+struct ftGlyphSet *set, *next;
+for (set = glyphSetList; set != NULL; set = next)
+    {
+    next = set->next;
+    ftGlyphSetFree(&set);
+    }
+glyphSetList = curGlyphSet = NULL;
+curWidth = curHeight = 0;
+curYy = 0x10000L;
+curPenY = 0;
+}
+
+int ftInitialize(char *fontFile)
+/* Make fontFile the face to draw with.  If it already is, keep the face and the glyphs
+ * loaded from it. */
+{
+FT_Error error;
+if (library == NULL)
+    {
+    error = FT_Init_FreeType( &library );              /* initialize library */
+    if (error !=0)
+        return error;
+    }
+
+if (face != NULL)
+    {
+    if (sameString(fontFile, curFontFile))
+        return 0;
+    // Glyphs from the old face mustn't be drawn for the new one.
+    FT_Done_Face(face);
+    face = NULL;
+    freez(&curFontFile);
+    ftGlyphCacheReset();
+    }
+
+error = FT_New_Face( library, fontFile, 0, &face );
+if ((error !=0) || (face == NULL))
+    errAbort("Cannot open font file '%s'.  Does it exist?", fontFile);
+
+error = FT_Select_Charmap(face, FT_ENCODING_UNICODE);
+if ((error !=0) || (face == NULL))
+    errAbort("Cannot select Unicode character map");
+
+curFontFile = cloneString(fontFile);
+return 0;
+}
+
+void ftGlyphCacheEnable(boolean enable)
+/* Turn the glyph cache on or off.  It is on unless this turns it off, which is
+ * for testing that cached glyphs draw the same as freshly loaded ones. */
+{
+glyphCacheOn = enable;
+}
+
+static void ftSetPixelSizes(FT_UInt width, FT_UInt height)
+/* Set pixel size of face, noting it for glyph cache. */
+{
+if (width != curWidth || height != curHeight)
+    {
+    FT_Set_Pixel_Sizes(face, width, height);
+    curWidth = width;
+    curHeight = height;
+    curGlyphSet = NULL;
+    }
+}
+
+static void ftSetTransform(FT_Matrix *matrix, FT_Vector *pen)
+/* Set transform of face, noting it for glyph cache.  We only ever flip vertically. */
+{
+FT_Set_Transform(face, matrix, pen);
+if (matrix->yy != curYy || pen->y != curPenY)
+    {
+    curYy = matrix->yy;
+    curPenY = pen->y;
+    curGlyphSet = NULL;
+    }
+}
+
+static struct ftGlyphSet *ftCurrentGlyphSet()
+/* Return glyph set for current size and transform, making it if need be. */
+{
+if (curGlyphSet == NULL)
+    {
+    struct ftGlyphSet *set;
+    for (set = glyphSetList; set != NULL; set = set->next)
+        if (set->width == curWidth && set->height == curHeight
+         && set->yy == curYy && set->penY == curPenY)
+            break;
+    if (set == NULL)
+        {
+        AllocVar(set);
+        set->width = curWidth;
+        set->height = curHeight;
+        set->yy = curYy;
+        set->penY = curPenY;
+        slAddHead(&glyphSetList, set);
+        }
+    curGlyphSet = set;
+    }
+return curGlyphSet;
+}
+
+static void ftLoadGlyph(struct ftGlyph *glyph, FT_ULong c, boolean render)
+/* Load character c at current size and transform through FreeType into glyph. */
+{
+FT_Error error = FT_Load_Char(face, c, render ? FT_LOAD_RENDER : 0);
+FT_GlyphSlot slot = face->glyph;
+glyph->advance = slot->advance.x;
+if (render)
+    {
+    glyph->rendered = TRUE;
+    glyph->error = (error != 0);
+    if (!error)
+        {
+        FT_Bitmap *bitmap = &slot->bitmap;
+        glyph->left = slot->bitmap_left;
+        glyph->top = slot->bitmap_top;
+        glyph->bitmap = *bitmap;
+        // draw_bitmap reads rows width apart, so store them that way.
+        glyph->bitmap.pitch = bitmap->width;
+        glyph->bitmap.buffer = needMem(bitmap->width * bitmap->rows + 1);
+        int row;
+        for (row = 0; row < bitmap->rows; ++row)
+            memcpy(glyph->bitmap.buffer + row * bitmap->width,
+                   bitmap->buffer + row * bitmap->pitch, bitmap->width);
+        }
+    }
+}
+
+static struct ftGlyph *ftGetGlyph(FT_ULong c, boolean render)
+/* Return glyph for character c at current size and transform, loading it through
+ * FreeType only the first time, or the first time it needs to be rendered. */
+{
+if (!glyphCacheOn)
+    {
+    freeMem(scratchGlyph.bitmap.buffer);
+    ZeroVar(&scratchGlyph);
+    ftLoadGlyph(&scratchGlyph, c, render);
+    return &scratchGlyph;
+    }
+struct ftGlyphSet *set = ftCurrentGlyphSet();
+struct ftGlyph *glyph;
+char key[16];
+if (c < ArraySize(set->low))
+    glyph = set->low[c];
+else
+    {
+    if (set->highHash == NULL)
+        set->highHash = hashNew(8);
+    safef(key, sizeof key, "%lx", (unsigned long)c);
+    glyph = hashFindVal(set->highHash, key);
+    }
+if (glyph != NULL && (glyph->rendered || !render))
+    return glyph;
+if (glyph == NULL)
+    {
+    AllocVar(glyph);
+    if (c < ArraySize(set->low))
+        set->low[c] = glyph;
+    else
+        hashAdd(set->highHash, key, glyph);
+    }
+ftLoadGlyph(glyph, c, render);
+return glyph;
+}
+
 static iconv_t ourIconv; // convert context UTF-8 > UNICOD
 
 static size_t utf8ToUnicode(char *text, unsigned short *buffer, size_t nLength)
@@ -158,7 +376,6 @@ void ftTextHelper(struct memGfx *mg, int x, int y, int baseline, Color color,
 {
 size_t length = strlen(text);
 int n;
-FT_Error error;
 unsigned long offset = 0;
 y +=  baseline;
 
@@ -177,14 +394,11 @@ for(n = 0; n < length; n++)
     {
     int dx;
     dx = x + offset / 64;
-    error = FT_Load_Char( face, sBuf[n], FT_LOAD_RENDER );
-    FT_GlyphSlot  slot;
-    slot = face->glyph;
-    if (!error)
-        draw_bitmap( mg,  &slot->bitmap, color,
-         dx + slot->bitmap_left, y - slot->bitmap_top, mg->pixels, mg->width ); 
-         //offset + slot->bitmap_left, y - slot->bitmap_top, mg->pixels, mg->width ); 
-    offset += slot->advance.x;
+    struct ftGlyph *glyph = ftGetGlyph(sBuf[n], TRUE);
+    if (!glyph->error)
+        draw_bitmap( mg,  &glyph->bitmap, color,
+         dx + glyph->left, y - glyph->top, mg->pixels, mg->width ); 
+    offset += glyph->advance;
     }
 }
 
@@ -203,8 +417,8 @@ if (height > 0)
     matrix.yy = (FT_Fixed)(1 * 0x10000L) ;
     pen.x = 0;
     pen.y = 0;
-    FT_Set_Transform( face, &matrix, &pen );
-    FT_Set_Pixel_Sizes( face, 1.3*width, 1.3 * height);
+    ftSetTransform(&matrix, &pen);
+    ftSetPixelSizes(1.3*width, 1.3 * height);
     ftTextHelper(mg, x, y, height, color, font, text);
     }
 else
@@ -215,16 +429,16 @@ else
     matrix.yy = (FT_Fixed)(-1 * 0x10000L) ;
     pen.x = 0;
     pen.y = -height * 64;
-    FT_Set_Transform( face, &matrix, &pen );
+    ftSetTransform(&matrix, &pen);
 
     height = -height;
-    FT_Set_Pixel_Sizes( face, 1.3*width, 1.3 * height);
+    ftSetPixelSizes(1.3*width, 1.3 * height);
     ftTextHelper(mg, x, y, height, color, font, text);
 
     matrix.yy = (FT_Fixed)(1 * 0x10000L) ;
     pen.x = 0;
     pen.y = 0;
-    FT_Set_Transform( face, &matrix, &pen );
+    ftSetTransform(&matrix, &pen);
     }
 }
 
@@ -235,7 +449,7 @@ void ftText(struct memGfx *mg, int x, int y, Color color,
 unsigned int fontHeight;
 unsigned int baseline;
 getFontCorrection(mgFontPixelHeight(font), &fontHeight, &baseline);
-FT_Set_Pixel_Sizes( face, fontHeight, fontHeight);
+ftSetPixelSizes(fontHeight, fontHeight);
 ftTextHelper(mg, x, y, baseline,color, font, text);
 }
 
@@ -244,16 +458,11 @@ int ftWidth(MgFont *font, unsigned char *chars, int charCount)
 unsigned int fontHeight;
 unsigned int baseline;
 getFontCorrection(mgFontPixelHeight(font), &fontHeight, &baseline);
-FT_Set_Pixel_Sizes( face, fontHeight, fontHeight);
+ftSetPixelSizes(fontHeight, fontHeight);
 int n;
 unsigned long offset = 0;
 for(n = 0; n < charCount; n++)
-    {
-    FT_Load_Char( face, chars[n], 0 );
-    FT_GlyphSlot  slot;
-    slot = face->glyph;
-    offset += slot->advance.x;
-    }
+    offset += ftGetGlyph(chars[n], FALSE)->advance;
 offset /= 64;
 return offset;
 }
@@ -12,6 +12,10 @@ extern FT_Face       face;
 
 int ftInitialize();
 
+void ftGlyphCacheEnable(boolean enable);
+/* Turn the glyph cache on or off.  It is on unless this turns it off, which is
+ * for testing that cached glyphs draw the same as freshly loaded ones. */
+
 void ftText(struct memGfx *mg, int x, int y, Color color, 
 	MgFont *font, char *text);
 
@@ -328,6 +328,16 @@ if (wordCount >= 9)
 slAddHead(&gff->lineList, gl);
 }
 
+static void gffFileReverseLists(struct gffFile *gff)
+/* put lists built by gffFileAddRow in file order */
+{
+slReverse(&gff->lineList);
+slReverse(&gff->seqList);
+slReverse(&gff->sourceList);
+slReverse(&gff->featureList);
+slReverse(&gff->groupList);
+slReverse(&gff->geneIdList);
+}
 
 void gffFileAdd(struct gffFile *gff, char *fileName, int baseOffset)
 /* Create a gffFile structure from a GFF file. */
@@ -346,30 +356,31 @@ while (lineFileNext(lf, &line, &lineSize))
             gffFileAddRow(gff, baseOffset, words, wordCount, lf->fileName, lf->lineIx);
 	}
     }
-slReverse(&gff->lineList);
-slReverse(&gff->seqList);
-slReverse(&gff->sourceList);
-slReverse(&gff->featureList);
-slReverse(&gff->groupList);
-slReverse(&gff->geneIdList);
+gffFileReverseLists(gff);
 lineFileClose(&lf);
 }
 
-struct gffFile *gffFileNew(char *fileName)
-/* Create a new gffFile structure. */
+static struct gffFile *gffFileNewSized(char *fileName, int seqBits, int groupBits, int strBits)
+/* Create a new gffFile structure with hashes of the given sizes. */
 {
 struct gffFile *gff;
 AllocVar(gff);
 gff->fileName = cloneString(fileName);
-gff->seqHash = newHash(18);
+gff->seqHash = newHash(seqBits);
 gff->sourceHash = newHash(6);
 gff->featureHash = newHash(6);
-gff->groupHash = newHash(16);
-gff->geneIdHash = newHash(16);
-gff->strPool = newHash(20);
+gff->groupHash = newHash(groupBits);
+gff->geneIdHash = newHash(groupBits);
+gff->strPool = newHash(strBits);
 return gff;
 }
 
+struct gffFile *gffFileNew(char *fileName)
+/* Create a new gffFile structure. */
+{
+return gffFileNewSized(fileName, 18, 16, 20);
+}
+
 struct gffFile *gffRead(char *fileName)
 /* Create a gffFile structure from a GFF file. */
 {
@@ -378,6 +389,93 @@ gffFileAdd(gff, fileName, 0);
 return gff;
 }
 
+boolean gffIsSortedByGene(char *fileName)
+/* Check if the lines of a GFF or GTF file are grouped by sequence, with no
+ * line starting before the last gene line of its sequence, so that
+ * gffReadNextChunk can end chunks at genes.  Standard input can't be read
+ * twice, so is treated as unsorted. */
+{
+if (sameString(fileName, "stdin"))
+    return FALSE;
+struct lineFile *lf = lineFileOpen(fileName, TRUE);
+struct hash *seqs = newHash(0);
+char *prevSeq = NULL;
+long geneStart = 0;
+boolean isSorted = TRUE;
+char *line, *words[9];
+while (isSorted && lineFileNext(lf, &line, NULL))
+    {
+    if ((line[0] == '#') || (chopTabs(line, words) < 5))
+        continue;
+    if ((prevSeq == NULL) || !sameString(words[0], prevSeq))
+        {
+        if (hashLookup(seqs, words[0]) != NULL)
+            isSorted = FALSE;
+        prevSeq = hashAdd(seqs, words[0], NULL)->name;
+        geneStart = 0;
+        }
+    long start = atol(words[3]);
+    if (start < geneStart)
+        isSorted = FALSE;
+    if (sameString(words[2], "gene"))
+        geneStart = start;
+    }
+freeHash(&seqs);
+lineFileClose(&lf);
+return isSorted;
+}
+
+static boolean chunkEndsAt(struct gffFile *gff, char *line, long maxEnd)
+/* Check if a line of a sorted file is not part of the chunk in gff, as it is
+ * on another sequence, or is a gene line starting after the end of all lines
+ * in the chunk.  This is done before the line is chopped. */
+{
+char *seq = gff->lineList->seq;
+char *tab = strchr(line, '\t');
+if (tab == NULL)
+    return FALSE;
+if ((strlen(seq) != tab - line) || !startsWith(seq, line))
+    return TRUE;
+char *feature = strchr(tab+1, '\t');
+if ((feature == NULL) || !startsWith("gene\t", ++feature))
+    return FALSE;
+return atol(feature + strlen("gene\t")) - 1 > maxEnd;
+}
+
+struct gffFile *gffReadNextChunk(struct lineFile *lf, boolean isSorted)
+/* Read the next chunk of lines from lf into a new gffFile, or return NULL at
+ * the end of the file.  If isSorted is set from gffIsSortedByGene, a chunk
+ * ends at a change of sequence or a gene line starting after the end of all
+ * lines in the chunk, so memory is bounded by the largest set of overlapping
+ * genes.  Otherwise the rest of the file is one chunk.  Lists are in file
+ * order as with gffRead, so gffGroupLines can be used on the chunk. */
+{
+struct gffFile *gff = NULL;
+long maxEnd = 0;
+char *line, *words[9];
+int wordCount;
+while (lineFileNext(lf, &line, NULL))
+    {
+    if (line[0] == '#')
+        continue;
+    if ((gff != NULL) && isSorted && chunkEndsAt(gff, line, maxEnd))
+        {
+        lineFileReuse(lf);
+        break;
+        }
+    wordCount = chopTabs(line, words);
+    if (wordCount == 0)
+        continue;
+    if (gff == NULL)
+        gff = gffFileNewSized(lf->fileName, 4, 8, 10);
+    gffFileAddRow(gff, 0, words, wordCount, lf->fileName, lf->lineIx);
+    maxEnd = max(maxEnd, gff->lineList->end);
+    }
+if (gff != NULL)
+    gffFileReverseLists(gff);
+return gff;
+}
+
 static void getGroupBoundaries(struct gffGroup *group)
 /* Fill in start, end, strand of group from lines. */
 {
@@ -63,9 +63,25 @@ char *gff3FeatDGeneSegment = "D_gene_segment";
 char *gff3FeatJGeneSegment = "J_gene_segment";
 char *gff3FeatVGeneSegment = "V_gene_segment";
 
+struct gff3Stream
+/* State of reading a GFF3 file a group of records at a time */
+{
+    int *groupStarts;         /* line numbers of first records of groups */
+    int groupCount;           /* number of groups, zero to read file as one group */
+    int nextGroup;            /* index of first group not yet started */
+};
+
+static struct gff3File *gff3FileErrFile(struct gff3File *g3f)
+/* get the object counting errors, groups read from a stream share the
+ * count of the stream */
+{
+return (g3f->streamFile != NULL) ? g3f->streamFile : g3f;
+}
+
 static bool gff3FileStopDueToErrors(struct gff3File *g3f)
 /* determine if we should stop due to the number of errors */
 {
+g3f = gff3FileErrFile(g3f);
 return g3f->errCnt > g3f->maxErr;
 }
 
@@ -84,6 +100,7 @@ __attribute__((format(printf, 3, 4)))
 static void vaGff3FileErr(struct gff3File *g3f, bool canWarn, char *format, va_list args)
 /* Print error message to error file, abort if max errors have been reached */
 {
+g3f = gff3FileErrFile(g3f);
 bool isWarning = canWarn && (g3f->flags & GFF3_WARN_WHEN_POSSIBLE);
 if (g3f->lf != NULL)
     fprintf(g3f->errFh, "%s:%d: ", g3f->lf->fileName, g3f->lf->lineIx);
@@ -287,11 +304,10 @@ static char *unescapeStrPooled(struct gff3Ann *g3a, char *src)
 return gff3FilePooledStr(g3a->file, unescapeStrTmp(g3a, src));
 }
 
-static char *escapeChar(char c)
-/* escape a character.  Warning: static return */
+static char *escapeChar(char c, char *ec, int ecSize)
+/* escape a character into ec, which must have room for 4 characters, and return it */
 {
-static char ec[4];
-safef(ec, sizeof(ec), "%%%02X", c);
+safef(ec, ecSize, "%%%02X", (unsigned char)c);
 return ec;
 }
 
@@ -304,11 +320,11 @@ return ((c == '\t') || (c == '\n') || (c == '\r') || !isprint(c) || (c == ';') |
 static void writeEscaped(char *str, FILE *fh)
 /* write a data string to a file, escaping as needed */
 {
-char *c;
+char *c, ec[4];
 for (c = str; *c != '\0'; c++)
     {
     if (isMetaChar(*c))
-        fputs(escapeChar(*c), fh);
+        fputs(escapeChar(*c, ec, sizeof(ec)), fh);
     else
         fputc(*c, fh);
     }
@@ -602,24 +618,25 @@ for (attr = g3a->attrs; attr != NULL; attr = attr->next)
     }
 }
 
-static void parseAnn(struct gff3File *g3f, char *line)
-/* parse an annotation line */
+static struct gff3Ann *parseAnn(struct gff3File *g3f, char *line)
+/* parse an annotation line, returning the new record or NULL on error */
 {
 // extra column to check for too many
 char *words[gffNumCols+1];
 int numWords = chopString(line, "\t", words, gffNumCols+1);
 if (numWords != gffNumCols)
-    gff3FileErr(g3f, FALSE, "expected %d tab-separated columns: %s", gffNumCols, line);
-else
     {
-    struct gff3Ann *g3a = gff3FileAlloc(g3f, sizeof(struct gff3Ann));
-    g3a->file = g3f;
-    g3a->lineNum = g3f->lf->lineIx;
-    parseFields(g3a, words);
-    parseAttrs(g3a, words[8]);
-    parseStdAttrs(g3a);
-    slAddHead(&g3f->anns, gff3AnnRefNew(g3a));
+    gff3FileErr(g3f, FALSE, "expected %d tab-separated columns: %s", gffNumCols, line);
+    return NULL;
     }
+struct gff3Ann *g3a = gff3FileAlloc(g3f, sizeof(struct gff3Ann));
+g3a->file = g3f;
+g3a->lineNum = g3f->lf->lineIx;
+parseFields(g3a, words);
+parseAttrs(g3a, words[8]);
+parseStdAttrs(g3a);
+slAddHead(&g3f->anns, gff3AnnRefNew(g3a));
+return g3a;
 }
 
 static void writeAttr(struct gff3Attr *attr, FILE *fh)
@@ -1060,12 +1077,20 @@ for (g3aRef = g3f->anns; (g3aRef != NULL) && !gff3FileStopDueToErrors(g3f); g3aR
     resolveAnn(g3aRef->ann);
 }
 
+static void finishMeta(struct gff3File *g3f);
+
 static void resolveFile(struct gff3File *g3f)
 /* do resolution phase of reading a GFF3 file */
 {
 // must sort first, as links point to the first feature
 discontigFeatureFinish(g3f);
 resolveAnns(g3f);
+finishMeta(g3f);
+}
+
+static void finishMeta(struct gff3File *g3f)
+/* put meta-data lists in file order */
+{
 // reorder just for test reproducibility
 slReverse(&g3f->seqRegions);
 slReverse(&g3f->featureOntologies);
@@ -1104,12 +1129,368 @@ if (g3f->errCnt > 0)
 return g3f;
 }
 
+struct gff3IdGroup
+/* group that a record ID is in, used to find IDs in more than one group */
+{
+    bits64 idHash;            /* hash of the unescaped ID */
+    int group;                /* index of group */
+};
+
+struct gff3GroupFinder
+/* state of finding where the groups of a file to be streamed start */
+{
+    int *groupStarts;         /* line numbers of first records of groups */
+    int groupCount;           /* number of groups found */
+    int groupStartsSize;      /* allocated size of groupStarts */
+    struct gff3IdGroup *ids;  /* group each ID is in, possibly more than once */
+    int idCount;              /* number of entries in ids */
+    int idsSize;              /* allocated size of ids */
+    struct hash *groupIds;    /* IDs in current group */
+    struct hash *pendingIds;  /* IDs referenced in current group but not yet in it */
+    char *seqid;              /* seqid of last record in group */
+    int maxEnd;               /* largest end of group records on seqid */
+    boolean atDirective;      /* a ### directive ends the group if possible */
+};
+
+static bits64 gff3IdHash(char *id)
+/* 64-bit FNV-1a hash of an ID, so IDs don't need to be kept to find ones
+ * that are in more than one group */
+{
+bits64 h = 0xcbf29ce484222325ULL;
+unsigned char *c;
+for (c = (unsigned char*)id; *c != '\0'; c++)
+    {
+    h ^= *c;
+    h *= 0x100000001b3ULL;
+    }
+return h;
+}
+
+static int gff3IdGroupCmp(const void *va, const void *vb)
+/* compare gff3IdGroups by hash, then group */
+{
+const struct gff3IdGroup *a = va, *b = vb;
+if (a->idHash != b->idHash)
+    return (a->idHash < b->idHash) ? -1 : 1;
+return a->group - b->group;
+}
+
+static void unescapeStrNoCheck(char *str)
+/* remove URL-style escapes from a string in place, leaving invalid escapes
+ * for the parser to report */
+{
+char *s = str, *d = str;
+while (*s != '\0')
+    {
+    if ((s[0] == '%') && isxdigit(s[1]) && isxdigit(s[2]))
+        {
+        char num[3] = {s[1], s[2], '\0'};
+        *d++ = (char)strtol(num, NULL, 16);
+        s += 3;
+        }
+    else
+        *d++ = *s++;
+    }
+*d = '\0';
+}
+
+static char *nextField(char **strPtr, char delim)
+/* return the next non-empty delim-separated field of *strPtr, terminating
+ * it, or NULL if there are no more.  Empty fields are skipped as by
+ * chopString. */
+{
+char *str = *strPtr;
+while ((str != NULL) && (*str == delim))
+    str++;
+if ((str == NULL) || (*str == '\0'))
+    return NULL;
+char *end = strchr(str, delim);
+if (end != NULL)
+    *end++ = '\0';
+*strPtr = end;
+return str;
+}
+
+static void groupFinderStartGroup(struct gff3GroupFinder *gf, int lineNum)
+/* start a new group at a line */
+{
+if (gf->groupCount == gf->groupStartsSize)
+    {
+    int newSize = (gf->groupStartsSize == 0) ? 1024 : 2*gf->groupStartsSize;
+    ExpandArray(gf->groupStarts, gf->groupStartsSize, newSize);
+    gf->groupStartsSize = newSize;
+    }
+gf->groupStarts[gf->groupCount++] = lineNum;
+hashFree(&gf->groupIds);
+hashFree(&gf->pendingIds);
+gf->groupIds = hashNew(8);
+gf->pendingIds = hashNew(6);
+freez(&gf->seqid);
+gf->atDirective = FALSE;
+}
+
+static void groupFinderAddId(struct gff3GroupFinder *gf, char *id)
+/* note an ID in the current group */
+{
+hashRemove(gf->pendingIds, id);
+if (hashLookup(gf->groupIds, id) != NULL)
+    return;  // another part of a discontinuous feature
+hashStore(gf->groupIds, id);
+if (gf->idCount == gf->idsSize)
+    {
+    int newSize = (gf->idsSize == 0) ? 1024 : 2*gf->idsSize;
+    ExpandArray(gf->ids, gf->idsSize, newSize);
+    gf->idsSize = newSize;
+    }
+gf->ids[gf->idCount].idHash = gff3IdHash(id);
+gf->ids[gf->idCount].group = gf->groupCount-1;
+gf->idCount++;
+}
+
+static void groupFinderAddRefs(struct gff3GroupFinder *gf, char *vals)
+/* note references to IDs in a comma-separated attribute value */
+{
+char *val;
+while ((val = nextField(&vals, ',')) != NULL)
+    {
+    unescapeStrNoCheck(val);
+    if (hashLookup(gf->groupIds, val) == NULL)
+        hashStore(gf->pendingIds, val);
+    }
+}
+
+static void groupFinderAddAttrs(struct gff3GroupFinder *gf, char *attrsCol)
+/* note the ID and references in the attribute column of a record */
+{
+char *attrStr;
+while ((attrStr = nextField(&attrsCol, ';')) != NULL)
+    {
+    attrStr = trimSpaces(attrStr);
+    char *vals = strchr(attrStr, '=');
+    if (vals == NULL)
+        continue;
+    *vals++ = '\0';
+    unescapeStrNoCheck(attrStr);
+    if (sameString(attrStr, gff3AttrID))
+        {
+        char *id = nextField(&vals, ',');
+        if (id != NULL)
+            {
+            unescapeStrNoCheck(id);
+            groupFinderAddId(gf, id);
+            }
+        }
+    else if (sameString(attrStr, gff3AttrParent) || sameString(attrStr, gff3AttrDerivesFrom))
+        groupFinderAddRefs(gf, vals);
+    }
+}
+
+static void groupFinderAddAnn(struct gff3GroupFinder *gf, char *line, int lineNum)
+/* add an annotation record, starting a new group if it can't reference
+ * anything in the current one */
+{
+char *words[gffNumCols+1];
+if (chopString(line, "\t", words, gffNumCols+1) != gffNumCols)
+    return;  // left for the parser to report
+char *seqid = words[0];
+int start = atoi(words[3])-1, end = atoi(words[4]);
+if ((gf->groupCount == 0)
+    || ((gf->pendingIds->elCount == 0)
+        && (gf->atDirective || !sameString(seqid, gf->seqid) || (start > gf->maxEnd))))
+    groupFinderStartGroup(gf, lineNum);
+if ((gf->seqid == NULL) || !sameString(seqid, gf->seqid))
+    {
+    freeMem(gf->seqid);
+    gf->seqid = cloneString(seqid);
+    gf->maxEnd = 0;
+    }
+gf->maxEnd = max(gf->maxEnd, end);
+groupFinderAddAttrs(gf, words[8]);
+}
+
+static boolean groupFinderCheckIds(struct gff3GroupFinder *gf)
+/* check that all references were resolved within their groups and that no
+ * ID is in more than one group */
+{
+if ((gf->pendingIds != NULL) && (gf->pendingIds->elCount > 0))
+    return FALSE;
+qsort(gf->ids, gf->idCount, sizeof(struct gff3IdGroup), gff3IdGroupCmp);
+int i;
+for (i = 1; i < gf->idCount; i++)
+    {
+    if (gf->ids[i].idHash == gf->ids[i-1].idHash)
+        return FALSE;
+    }
+return TRUE;
+}
+
+static void gff3FileFindGroups(struct gff3Stream *stream, char *fileName)
+/* Find where groups of related records start, reading the file once ahead of
+ * parsing it.  A record starts a new group after a ### directive, on a
+ * different seqid, or past the end of the records in the group, once the
+ * group has no references to records not yet read.  If any record references
+ * one in another group or an ID is used in more than one group, the file is
+ * read as one group, as is standard input, which can't be read twice. */
+{
+if (sameString(fileName, "stdin"))
+    return;
+struct gff3GroupFinder gf;
+ZeroVar(&gf);
+struct lineFile *lf = lineFileOpen(fileName, TRUE);
+char *line;
+while (lineFileNext(lf, &line, NULL))
+    {
+    if (startsWith("##FASTA", line))
+        break;
+    else if (startsWith("###", line))
+        gf.atDirective = TRUE;
+    else if (!startsWith("#", line) && (strlen(line) > 0))
+        groupFinderAddAnn(&gf, line, lf->lineIx);
+    }
+lineFileClose(&lf);
+if (groupFinderCheckIds(&gf))
+    {
+    stream->groupStarts = gf.groupStarts;
+    stream->groupCount = gf.groupCount;
+    }
+else
+    freeMem(gf.groupStarts);
+freeMem(gf.ids);
+hashFree(&gf.groupIds);
+hashFree(&gf.pendingIds);
+freeMem(gf.seqid);
+}
+
+struct gff3File *gff3FileOpenStream(char *fileName, int maxErr, unsigned flags, FILE *errFh)
+/* Open a GFF3 file to be read a group of related records at a time with
+ * gff3FileNextGroup, rather than all at once.  Arguments are as for
+ * gff3FileOpen.  The file is read once to find groups, which end at ###
+ * directives, changes of seqid, or records starting past the end of all
+ * records in the group, once none of them reference records not yet read.
+ * If that would separate a record from one it references, or put an ID in
+ * more than one group, the file is read as one group.  Meta-data is kept in
+ * the returned object and is complete once all groups have been read. */
+{
+struct gff3File *g3f = gff3FileNew();
+g3f->fileName = gff3FileCloneStr(g3f, fileName);
+g3f->flags = flags;
+g3f->errFh = (errFh != NULL) ? errFh : stderr;
+g3f->maxErr = (maxErr < 0) ? INT_MAX : maxErr;
+AllocVar(g3f->stream);
+gff3FileFindGroups(g3f->stream, g3f->fileName);
+g3f->lf = lineFileOpen(g3f->fileName, TRUE);
+parseHeader(g3f);
+return g3f;
+}
+
+static struct gff3File *streamGroupNew(struct gff3File *g3f, int lineNum)
+/* start a new group of records read from a stream at a line, most groups are
+ * a single gene, so the hashes start small */
+{
+struct gff3Stream *stream = g3f->stream;
+struct gff3File *group;
+AllocVar(group);
+group->byId = hashNew(8);
+group->pool = hashNew(10);
+group->fileName = gff3FileCloneStr(group, g3f->fileName);
+group->errFh = g3f->errFh;
+group->flags = g3f->flags;
+group->maxErr = g3f->maxErr;
+group->streamFile = g3f;
+while ((stream->nextGroup < stream->groupCount)
+       && (stream->groupStarts[stream->nextGroup] <= lineNum))
+    stream->nextGroup++;
+return group;
+}
+
+static boolean streamGroupStartsAt(struct gff3Stream *stream, int lineNum)
+/* check if the next group starts at a line */
+{
+return (stream->nextGroup < stream->groupCount)
+    && (stream->groupStarts[stream->nextGroup] == lineNum);
+}
+
+static struct gff3File *streamReadGroup(struct gff3File *g3f)
+/* read the records of the next group, or return NULL at the end of the file */
+{
+struct gff3File *group = NULL;
+char *line;
+while (g3f->lf != NULL)
+    {
+    if (!lineFileNext(g3f->lf, &line, NULL))
+        {
+        lineFileClose(&g3f->lf);
+        finishMeta(g3f);
+        }
+    else if (startsWith("##", line))
+        parseMeta(g3f, line);
+    else if (!startsWith("#", line) && (strlen(line) > 0))
+        {
+        if ((group != NULL) && streamGroupStartsAt(g3f->stream, g3f->lf->lineIx))
+            {
+            lineFileReuse(g3f->lf);
+            break;
+            }
+        if (group == NULL)
+            group = streamGroupNew(g3f, g3f->lf->lineIx);
+        group->lf = g3f->lf;
+        parseAnn(group, line);
+        group->lf = NULL;
+        }
+    }
+return group;
+}
+
+static void streamResolveGroup(struct gff3File *g3f, struct gff3File *group)
+/* resolve references within a group that has been read.  The current line
+ * is not included in errors, as it is not part of the group. */
+{
+struct lineFile *lf = g3f->lf;
+g3f->lf = NULL;
+slReverse(&group->anns);
+discontigFeatureFinish(group);
+resolveAnns(group);
+g3f->lf = lf;
+}
+
+struct gff3File *gff3FileNextGroup(struct gff3File *g3f)
+/* Read and resolve the next group of records from a file opened with
+ * gff3FileOpenStream.  The group is returned as a gff3File object with its
+ * own anns, roots and memory, which is freed with gff3FileFree
+ * independently of g3f and other groups.  Returns NULL at the end of file.
+ * Aborts once a group has parse errors, after reporting errors in the rest
+ * of the file up to maxErr. */
+{
+if (g3f->stream == NULL)
+    errAbort("gff3FileNextGroup: %s was not opened with gff3FileOpenStream", g3f->fileName);
+struct gff3File *group = streamReadGroup(g3f);
+if (group != NULL)
+    streamResolveGroup(g3f, group);
+if (g3f->errCnt > 0)
+    {
+    while (group != NULL)
+        {
+        gff3FileFree(&group);
+        if ((group = streamReadGroup(g3f)) != NULL)
+            streamResolveGroup(g3f, group);
+        }
+    errAbort("GFF3: %d parser errors", g3f->errCnt);
+    }
+return group;
+}
+
 void gff3FileFree(struct gff3File **g3fPtr)
 /* Free a gff3File object */
 {
 struct gff3File *g3f = *g3fPtr;
 if (g3f != NULL)
     {
+    lineFileClose(&g3f->lf);
+    if (g3f->stream != NULL)
+        {
+        freeMem(g3f->stream->groupStarts);
+        freeMem(g3f->stream);
+        }
     hashFree(&g3f->byId);
     hashFree(&g3f->pool);
     hashFree(&g3f->seqRegionMap);
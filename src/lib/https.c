@@ -72,8 +72,51 @@ struct netConnectHttpsParams
 pthread_t thread;
 int sv[2]; /* the pair of socket descriptors */
 BIO *sbio;  // ssl bio
+char *sessionKey;  // host:port for saving TLS session
 };
 
+/* TLS sessions by host:port, so that new connections to a server can resume
+ * the last session rather than doing a full handshake. */
+static struct hash *sessionHash = NULL;
+static pthread_mutex_t sessionMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void sessionSave(char *key, BIO *sbio)
+/* Save TLS session of sbio for reuse by later connections to key. */
+{
+SSL *ssl = NULL;
+BIO_get_ssl(sbio, &ssl);
+if (ssl == NULL)
+    return;
+SSL_SESSION *session = SSL_get1_session(ssl);
+if (session == NULL)
+    return;
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L   // # 1.1.1
+if (!SSL_SESSION_is_resumable(session))
+    {
+    SSL_SESSION_free(session);
+    return;
+    }
+#endif
+pthread_mutex_lock(&sessionMutex);
+if (sessionHash == NULL)
+    sessionHash = hashNew(0);
+SSL_SESSION *old = hashFindVal(sessionHash, key);
+if (old != NULL)
+    SSL_SESSION_free(old);
+hashReplace(sessionHash, key, session);
+pthread_mutex_unlock(&sessionMutex);
+}
+
+static void sessionResume(char *key, SSL *ssl)
+/* Set ssl to resume the saved session for key if there is one. */
+{
+pthread_mutex_lock(&sessionMutex);
+SSL_SESSION *session = (sessionHash ? hashFindVal(sessionHash, key) : NULL);
+if (session != NULL)
+    SSL_set_session(ssl, session);
+pthread_mutex_unlock(&sessionMutex);
+}
+
 static void xerrno(char *msg)
 {
 fprintf(stderr, "%s : %s\n", strerror(errno), msg); fflush(stderr);
@@ -151,6 +194,8 @@ int swt = 0;
 int brd = 0;
 int bwt = 0;
 int fd = 0;
+boolean awaitingReply = FALSE;  // sent data to server and have heard nothing back yet
+boolean sessionSaved = FALSE;
 
 while (1) 
     {
@@ -197,8 +242,10 @@ while (1)
 	}
     else if (err == 0) 
 	{
-	/* Timed out - just quit */
-	xerr("https timeout expired");
+	/* Timed out - just quit.  Only worth a message if user is waiting on server,
+	 * not if the connection is idle in the keep-alive pool. */
+	if (awaitingReply)
+	    xerr("https timeout expired");
 	goto cleanup;
 	}
 
@@ -235,6 +282,7 @@ while (1)
 		else
 		    {
 		    swt += swtx;
+		    awaitingReply = TRUE;
 		    if (swt >= srd)
 			{
 			swt = 0;
@@ -264,6 +312,14 @@ while (1)
 		    goto cleanup;
 		    }
 		}
+	    awaitingReply = FALSE;
+	    if (!sessionSaved)
+		{
+		// TLS 1.3 session tickets come after the handshake, ahead of the first reply.
+		// Save now, since a server closing without close_notify spoils the session.
+		sessionSave(params->sessionKey, params->sbio);
+		sessionSaved = TRUE;
+		}
 	    // write the https data received immediately back on socket to user, and it's ok if it blocks.
 	    while(bwt < brd)
 		{
@@ -285,7 +341,7 @@ while (1)
 
 cleanup:
 
-
+freeMem(params->sessionKey);
 BIO_free_all(params->sbio);  // will free entire chain of bios
 close(fd);     // Needed because we use BIO_NOCLOSE above. Someday might want to re-use a connection.
 close(params->sv[1]);  /* we are done with it */
@@ -700,7 +756,8 @@ return result;
 int netConnectHttps(char *hostName, int port, boolean noProxy, char *httpProtocol)
 /* Return socket for https connection with server or -1 if error.
  * httpProtocol is HTTP/1.0 or HTTP/1.1.  
- * 1.1 may only be used for non-persistent connections. Chunked encoding also not supported yet. */
+ * Resumes the last TLS session with the same host and port if there is one.
+ * The connection stays open until the caller closes the socket. */
 {
 
 int fd=0;
@@ -899,6 +956,10 @@ The hostname must not be an IP address.
 if (!isIpv4Address(hostName) && !isIpv6Address(hostName))
     SSL_set_tlsext_host_name(ssl,hostName);
 
+char sessionKey[1024];
+safef(sessionKey, sizeof sessionKey, "%s:%d", hostName, port);
+sessionResume(sessionKey, ssl);
+
 BIO_set_nbio(sbio, 1);     /* non-blocking mode */
 
 while (1) 
@@ -956,6 +1017,7 @@ while (1)
 struct netConnectHttpsParams *params;
 AllocVar(params);
 params->sbio = sbio;
+params->sessionKey = cloneString(sessionKey);
 
 socketpair(AF_UNIX, SOCK_STREAM, 0, params->sv);
 
@@ -0,0 +1,81 @@
+/* jsonLines - read files with one JSON object per line, parsing batches of lines in
+ * parallel. */
+
+/* This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+
+#include "common.h"
+#include "errCatch.h"
+#include "localmem.h"
+#include "pthreadDoList.h"
+#include "jsonLines.h"
+
+static void jsonLineParse(void *item, void *context)
+/* Parse the text of one jsonLine, catching errors.  Called by pthreadDoList. */
+{
+struct jsonLine *jl = item;
+struct errCatch *errCatch = errCatchNew();
+if (errCatchStart(errCatch))
+    jl->el = jsonParseLm(jl->text, jl->lm);
+errCatchEnd(errCatch);
+if (errCatch->gotError)
+    jl->error = lmCloneString(jl->lm, errCatch->message->string);
+errCatchFree(&errCatch);
+}
+
+struct jsonLine *jsonLinesRead(struct lineFile *lf, int maxCount, int threadCount)
+/* Read up to maxCount lines from lf and parse each as JSON, using up to threadCount threads.
+ * Return list in file order, or NULL at end of file.  Aborts with file name and line number
+ * if a line is not valid JSON.  Free with jsonLineFreeList. */
+{
+struct jsonLine *list = NULL;
+char *line;
+int size, count = 0;
+while (count < maxCount && lineFileNext(lf, &line, &size))
+    {
+    struct jsonLine *jl;
+    AllocVar(jl);
+    jl->lineIx = lf->lineIx;
+    // Parsing uses the lm in proportion to the size of the line
+    jl->lm = lmInit(max(1<<16, 2*size));
+    jl->text = lmCloneStringZ(jl->lm, line, size);
+    slAddHead(&list, jl);
+    count++;
+    }
+slReverse(&list);
+struct jsonLine *jl;
+if (threadCount > 1 && count > 1)
+    pthreadDoList(min(threadCount, count), list, jsonLineParse, NULL);
+else
+    {
+    for (jl = list;  jl != NULL;  jl = jl->next)
+        jsonLineParse(jl, NULL);
+    }
+for (jl = list;  jl != NULL;  jl = jl->next)
+    if (jl->error != NULL)
+        errAbort("%s line %d: %s", lf->fileName, jl->lineIx, jl->error);
+return list;
+}
+
+void jsonLineFree(struct jsonLine **pJl)
+/* Free up a jsonLine including its local memory. */
+{
+struct jsonLine *jl = *pJl;
+if (jl != NULL)
+    {
+    lmCleanup(&jl->lm);
+    freez(pJl);
+    }
+}
+
+void jsonLineFreeList(struct jsonLine **pList)
+/* Free up a list of jsonLines. */
+{
+struct jsonLine *el, *next;
+for (el = *pList;  el != NULL;  el = next)
+    {
+    next = el->next;
+    jsonLineFree(&el);
+    }
+*pList = NULL;
+}
@@ -7,6 +7,7 @@
 #include "common.h"
 #include "hash.h"
 #include "dystring.h"
+#include "obscure.h"
 #include "sqlNum.h"
 #include "jsonParse.h"
 
@@ -157,20 +158,16 @@ if(str[*posPtr] != c)
 (*posPtr)++;
 }
 
-static char *getStringLm(char *str, int *posPtr, struct lm *lm)
+static void jsonUnescapeBuf(char *in, int inSize, char *out)
+/* Copy the inSize chars at in to out, undoing backslash escapes, and terminate with '\0'.
+ * out must have room for inSize+1 chars. */
 {
-// read a double-quote delimited string; we handle backslash escaping.
-// returns allocated string.
 boolean escapeMode = FALSE;
 int i;
-struct dyString *ds = dyStringNew(1024);
-getSpecificChar('"', str, posPtr);
-for(i = 0;; i++)
+for (i = 0;  i < inSize;  i++)
     {
-    char c = str[*posPtr + i];
-    if(!c)
-        errAbort("Premature end of string (missing trailing double-quote); string position '%d'", *posPtr);
-    else if(escapeMode)
+    char c = in[i];
+    if(escapeMode)
         {
         // We support escape sequences listed in http://www.json.org,
         // except for Unicode which we cannot support in C-strings
@@ -193,53 +190,131 @@ for(i = 0;; i++)
                 break;
             case 'u':
 		// Pass through Unicode
-		dyStringAppendC(ds, '\\');
+		*out++ = '\\';
                 break;
             default:
                 // we don't need to convert \,/ or "
-		dyStringAppendC(ds, c);
+		*out++ = c;
                 break;
             }
-        dyStringAppendC(ds, c);
+        *out++ = c;
         escapeMode = FALSE;
         }
-    else if(c == '"')
-        break;
     else if(c == '\\')
         escapeMode = TRUE;
     else
-        {
-        dyStringAppendC(ds, c);
-        escapeMode = FALSE;
-        }
+        *out++ = c;
     }
-*posPtr += i;
+*out = '\0';
+}
+
+static char *getStringSpan(char *str, int *posPtr, int *retSize, boolean *retHasEscape)
+/* Find the double-quote delimited string at *posPtr and return a pointer to its contents
+ * in str, without unescaping or copying.  Set *retSize to the length of the contents and
+ * *retHasEscape to TRUE if it contains any backslash escapes. */
+{
 getSpecificChar('"', str, posPtr);
-if (lm)
+char *start = str + *posPtr;
+char *end;
+boolean hasEscape = FALSE;
+for (end = start;  *end != '"';  end++)
     {
-    char *str = lmCloneString(lm, ds->string);
-    dyStringFree(&ds);
-    return str;
+    if (*end == '\\')
+        {
+        hasEscape = TRUE;
+        end++;
+        }
+    if (*end == '\0')
+        errAbort("Premature end of string (missing trailing double-quote); string position '%d'", *posPtr);
     }
-else
-    return dyStringCannibalize(&ds);
+*posPtr += end - start;
+getSpecificChar('"', str, posPtr);
+*retSize = end - start;
+*retHasEscape = hasEscape;
+return start;
+}
+
+static char *getStringLm(char *str, int *posPtr, struct lm *lm)
+{
+// read a double-quote delimited string; we handle backslash escaping.
+// returns allocated string.
+int size;
+boolean hasEscape;
+char *start = getStringSpan(str, posPtr, &size, &hasEscape);
+if (!hasEscape)
+    return lm ? lmCloneStringZ(lm, start, size) : cloneStringZ(start, size);
+// Unescaped string is never longer than the escaped one.
+char *out = lm ? lmAlloc(lm, size+1) : needMem(size+1);
+jsonUnescapeBuf(start, size, out);
+return out;
 }
 
 static struct jsonElement *jsonParseExpressionLm(char *str, int *posPtr, struct lm *lm);
 
+struct jsonField
+/* A name : val pair of an object being parsed. */
+    {
+    char *name;                 // Name, not necessarily zero terminated
+    int nameSize;               // Length of name
+    boolean nameAlloced;        // If TRUE, name was allocated and must be freed when not lm
+    struct jsonElement *val;    // Value
+    };
+
+static void jsonFieldAdd(struct hash *h, struct jsonField *field, struct lm *lm)
+/* Add field to h, which copies the name, and free name if we allocated it. */
+{
+// hashAddN hashes up to the terminating '\0', so terminate a copy of name.
+char name[field->nameSize+1];
+memcpy(name, field->name, field->nameSize);
+name[field->nameSize] = '\0';
+hashAddN(h, name, field->nameSize, field->val);
+if (field->nameAlloced && lm == NULL)
+    freeMem(field->name);
+}
+
+// Objects with up to this many fields get a hash sized to fit; larger ones grow as usual.
+#define JSON_OBJECT_SMALL 32
+
 static struct jsonElement *jsonParseObjectLm(char *str, int *posPtr, struct lm *lm)
 {
-struct hash *h = hashNewLm(5, lm);
+// Most objects are small, so hold on to fields until we know how many there are and then
+// make a hash just big enough for them.
+struct jsonField fields[JSON_OBJECT_SMALL];
+int fieldCount = 0;
+struct hash *h = NULL;
 getSpecificChar('{', str, posPtr);
 while(str[*posPtr] != '}')
     {
     // parse out a name : val pair
+    struct jsonField field;
+    boolean hasEscape;
     skipLeadingSpacesWithPos(str, posPtr);
-    char *name = getStringLm(str, posPtr, lm);
+    field.name = getStringSpan(str, posPtr, &field.nameSize, &hasEscape);
+    field.nameAlloced = hasEscape;
+    if (hasEscape)
+        {
+        char *name = lm ? lmAlloc(lm, field.nameSize+1) : needMem(field.nameSize+1);
+        jsonUnescapeBuf(field.name, field.nameSize, name);
+        field.name = name;
+        field.nameSize = strlen(name);
+        }
     skipLeadingSpacesWithPos(str, posPtr);
     getSpecificChar(':', str, posPtr);
     skipLeadingSpacesWithPos(str, posPtr);
-    hashAdd(h, name, jsonParseExpressionLm(str, posPtr, lm));
+    field.val = jsonParseExpressionLm(str, posPtr, lm);
+    if (h == NULL && fieldCount < JSON_OBJECT_SMALL)
+        fields[fieldCount++] = field;
+    else
+        {
+        if (h == NULL)
+            {
+            h = hashNewLm(digitsBaseTwo(fieldCount), lm);
+            int i;
+            for (i = 0;  i < fieldCount;  i++)
+                jsonFieldAdd(h, &fields[i], lm);
+            }
+        jsonFieldAdd(h, &field, lm);
+        }
     skipLeadingSpacesWithPos(str, posPtr);
     if(str[*posPtr] == ',')
         (*posPtr)++;
@@ -248,6 +323,13 @@ while(str[*posPtr] != '}')
     }
 skipLeadingSpacesWithPos(str, posPtr);
 getSpecificChar('}', str, posPtr);
+if (h == NULL)
+    {
+    h = hashNewLm(max(1, digitsBaseTwo(fieldCount)), lm);
+    int i;
+    for (i = 0;  i < fieldCount;  i++)
+        jsonFieldAdd(h, &fields[i], lm);
+    }
 return newJsonObjectLm(h, lm);
 }
 
@@ -279,7 +361,9 @@ return newJsonListLm(list, lm);
 
 static struct jsonElement *jsonParseStringLm(char *str, int *posPtr, struct lm *lm)
 {
-return newJsonStringLm(getStringLm(str, posPtr, lm), lm);
+struct jsonElement *ele = newJsonElementLm(jsonString, lm);
+ele->val.jeString = getStringLm(str, posPtr, lm);
+return ele;
 }
 
 static struct jsonElement *jsonParseNumberLm(char *str, int *posPtr, struct lm *lm)
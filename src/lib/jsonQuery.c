@@ -101,210 +101,286 @@ errAbort("jsonPathPopHead: should have returned a result before this point");
 return NULL;
 }
 
-// Forward declaration for mutual recursion:
-static void rQueryElement(struct jsonElement *elIn, char *name, char *path,
-                          struct slRef **pResultList, struct lm *lm);
-/* Recursively search for descendants of jsonElements in inList matching path; add jsonElements
- * that match to resultList. */
+enum jsonPathListOp
+/* How a path step applies to a list. */
+    {
+    jplInvalid,         // Step id is not valid for a list
+    jplIndex,           // Single element by index
+    jplAll,             // All elements
+    jplCondition,       // Elements for which condPath matches condValue
+    };
 
-static void rQueryObject(struct jsonElement *el, char *name, char *id, char *path,
-                         struct slRef **pResultList, struct lm *lm)
-/* Given a JSON object and a child id, recursively search child for path. */
-{
-struct hash *hash = jsonObjectVal(el, name);
-if (hash)
+struct jsonPathStep
+/* One component of a compiled path.  The same step may be applied to an object (id is a
+ * field name) or a list (id is interpreted according to listOp). */
     {
-    struct jsonElement *child = hashFindVal(hash, id);
-    if (child)
-        rQueryElement(child, name, path, pResultList, lm);
-    }
+    struct jsonPathStep *next;
+    char *id;                   // Field name, or contents of []
+    enum jsonPathListOp listOp; // What to do if step is applied to a list
+    int index;                  // For jplIndex
+    struct jsonPath *condPath;  // For jplCondition: path to test in each list element...
+    char *condValue;            // ...and the value that it must have...
+    long condInt;               // ...as an int...
+    double condDouble;          // ...as a double...
+    boolean condBoolean;        // ...and as a boolean if condIsBoolean.
+    boolean condIsBoolean;
+    };
+
+static void *jsonPathAlloc(size_t size, struct lm *lm)
+/* Allocate zeroed memory from lm if given, otherwise from heap. */
+{
+return lm ? lmAlloc(lm, size) : needMem(size);
 }
 
-static void rQueryList(struct jsonElement *el, char *name, char *id, char *path,
-                       struct slRef **pResultList, struct lm *lm)
-/* Given a JSON list and a child index (* for all children), recursively search child(ren) if found
- * for path. */
+static void jsonPathStepInitList(struct jsonPathStep *step, struct lm *lm)
+/* Figure out how step->id applies to lists. */
 {
-struct slRef *list = jsonListVal(el, name);
+char *id = step->id;
 char *equals = strchr(id, '=');
 if (equals)
     {
     // Conditional query; filter list items by condPath=val.
     char *value = equals+1;
-    long intVal = atol(value);
-    double doubleVal = atof(value);
-    boolean booleanVal = FALSE, valIsBoolean = FALSE;
+    step->listOp = jplCondition;
+    step->condValue = value;
+    step->condInt = atol(value);
+    step->condDouble = atof(value);
     if (sameString(value, "true") || sameString(value, "TRUE") || sameString(value, "1"))
         {
-        booleanVal = TRUE;
-        valIsBoolean = TRUE;
+        step->condBoolean = TRUE;
+        step->condIsBoolean = TRUE;
         }
     else if (sameString(value, "false") || sameString(value, "FALSE") || sameString(value, "0"))
         {
-        booleanVal = FALSE;
-        valIsBoolean = TRUE;
+        step->condBoolean = FALSE;
+        step->condIsBoolean = TRUE;
         }
     char condPath[strlen(id)+1];
     safencpy(condPath, sizeof condPath, id, (equals - id));
-    struct slRef *ref;
-    for (ref = list;  ref != NULL;  ref = ref->next)
-        {
-        struct slRef *condPathResults = NULL;
-        rQueryElement(ref->val, name, condPath, &condPathResults, lm);
-        struct slRef *resRef;
-        for (resRef = condPathResults;  resRef != NULL;  resRef = resRef->next)
-            {
-            struct jsonElement *resEl = resRef->val;
-            boolean matches = FALSE;
-            switch (resEl->type)
-                {
-                case jsonString:
-                    matches = sameString(jsonStringVal(resEl, condPath), value);
-                    break;
-                case jsonNumber:
-                    matches = (jsonNumberVal(resEl, condPath) == intVal);
-                    break;
-                case jsonDouble:
-                    matches = (jsonDoubleVal(resEl, condPath) == doubleVal);
-                    break;
-                case jsonBoolean:
-                    if (!valIsBoolean)
-                        errAbort("jsonQueryElement: bad conditional value '%s' for boolean", value);
-                    matches = (jsonBooleanVal(resEl, condPath) == booleanVal);
-                    break;
-                case jsonNull:
-                    matches = (sameString(value, "NULL") || sameString(value, "null"));
-                    break;
-                default:
-                    errAbort("jsonQueryElement: bad jsonElementType %d for conditional query",
-                             resEl->type);
-                }
-            if (matches)
-                {
-                rQueryElement(ref->val, name, path, pResultList, lm);
-                break;
-                }
-            }
-        }
+    step->condPath = jsonPathCompileLm(condPath, lm);
     }
+else if (isdigit(id[0]))
+    {
+    step->listOp = jplIndex;
+    step->index = atoi(id);
+    }
+else if (sameString(id, "*"))
+    step->listOp = jplAll;
 else
+    step->listOp = jplInvalid;
+}
+
+struct jsonPath *jsonPathCompileLm(char *path, struct lm *lm)
+/* Parse path once into a form that can be used to query many jsonElements quickly.
+ * If lm is NULL, free with jsonPathFree when done. */
+{
+struct jsonPath *jp = jsonPathAlloc(sizeof(*jp), lm);
+jp->text = lm ? lmCloneString(lm, path ? path : "") : cloneString(path ? path : "");
+struct jsonPathStep *stepList = NULL;
+char *pathNext = NULL;
+char *id;
+for (id = jsonPathPopHead(path, &pathNext, lm);  isNotEmpty(id);
+     id = jsonPathPopHead(pathNext, &pathNext, lm))
     {
-    int idIx = -1;
-    if (isdigit(id[0]))
-        idIx = atoi(id);
-    else if (differentString(id, "*"))
-        errAbort("jsonQueryElement: invalid index '%s' for list", id);
-    struct slRef *ref;
-    int ix;
-    for (ref = list, ix = 0;  ref != NULL;  ref = ref->next, ix++)
+    struct jsonPathStep *step = jsonPathAlloc(sizeof(*step), lm);
+    step->id = id;
+    jsonPathStepInitList(step, lm);
+    slAddHead(&stepList, step);
+    }
+if (lm == NULL)
+    freeMem(id);
+slReverse(&stepList);
+jp->steps = stepList;
+return jp;
+}
+
+void jsonPathFree(struct jsonPath **pJp)
+/* Free up a jsonPath compiled without lm. */
+{
+struct jsonPath *jp = *pJp;
+if (jp != NULL)
+    {
+    struct jsonPathStep *step, *next;
+    for (step = jp->steps;  step != NULL;  step = next)
         {
-        if (idIx < 0 || ix == idIx)
-            {
-            rQueryElement(ref->val, name, path, pResultList, lm);
-            if (ix == idIx)
-                break;
-            }
+        next = step->next;
+        // condValue points into id
+        freeMem(step->id);
+        jsonPathFree(&step->condPath);
+        freeMem(step);
         }
+    freeMem(jp->text);
+    freez(pJp);
     }
 }
 
-static void rQueryElement(struct jsonElement *elIn, char *name, char *path,
-                          struct slRef **pResultList, struct lm *lm)
-/* Recursively search for descendants of jsonElements in inList matching path; add jsonElements
- * that match to resultList. */
+static void addResult(struct jsonElement *el, struct slRef **pResultList, struct lm *lm)
+/* Add el to the head of result list. */
 {
-char *pathNext = NULL;
-char *id = jsonPathPopHead(path, &pathNext, lm);
-struct dyString *dy = dyStringCreate("%s", name);
-if (isNotEmpty(id))
+struct slRef *ref;
+if (lm)
+    lmAllocVar(lm, ref)
+else
+    AllocVar(ref);
+ref->val = el;
+slAddHead(pResultList, ref);
+}
+
+// Forward declaration for mutual recursion:
+static void rQueryElement(struct jsonElement *elIn, struct jsonPathStep *step,
+                          struct slRef **pResultList, struct lm *lm);
+/* Recursively search for descendants of elIn matching the rest of the path from step;
+ * add jsonElements that match to resultList. */
+
+static boolean condMatches(struct jsonElement *el, struct jsonPathStep *step, struct lm *lm)
+/* Return TRUE if any element at step's condPath in el has step's condValue. */
+{
+char *value = step->condValue;
+char *condPath = step->condPath->text;
+struct slRef *condPathResults = NULL;
+rQueryElement(el, step->condPath->steps, &condPathResults, lm);
+boolean matches = FALSE;
+struct slRef *resRef;
+for (resRef = condPathResults;  resRef != NULL && !matches;  resRef = resRef->next)
     {
-    switch (elIn->type)
+    struct jsonElement *resEl = resRef->val;
+    switch (resEl->type)
         {
-        case jsonObject:
-            {
-            dyStringPrintf(dy, ".%s", id);
-            rQueryObject(elIn, dy->string, id, pathNext, pResultList, lm);
-            break;
-            }
-        case jsonList:
-            {
-            dyStringPrintf(dy, "[%s]", id);
-            rQueryList(elIn, dy->string, id, pathNext, pResultList, lm);
-            break;
-            }
         case jsonString:
-        case jsonBoolean:
+            matches = sameString(jsonStringVal(resEl, condPath), value);
+            break;
         case jsonNumber:
+            matches = (jsonNumberVal(resEl, condPath) == step->condInt);
+            break;
         case jsonDouble:
+            matches = (jsonDoubleVal(resEl, condPath) == step->condDouble);
+            break;
+        case jsonBoolean:
+            if (!step->condIsBoolean)
+                errAbort("jsonQueryElement: bad conditional value '%s' for boolean", value);
+            matches = (jsonBooleanVal(resEl, condPath) == step->condBoolean);
+            break;
         case jsonNull:
-            {
-            errAbort("jsonQueryElement: got element with scalar type (%d), but children specified "
-                     "(%s)", elIn->type, id);
+            matches = (sameString(value, "NULL") || sameString(value, "null"));
             break;
-            }
         default:
+            errAbort("jsonQueryElement: bad jsonElementType %d for conditional query",
+                     resEl->type);
+        }
+    }
+if (lm == NULL)
+    slFreeList(&condPathResults);
+return matches;
+}
+
+static void rQueryList(struct jsonElement *el, struct jsonPathStep *step,
+                       struct slRef **pResultList, struct lm *lm)
+/* Given a JSON list and a step that picks children, recursively search child(ren) if found
+ * for the rest of the path. */
+{
+struct slRef *list = el->val.jeList;
+struct slRef *ref;
+int ix;
+switch (step->listOp)
+    {
+    case jplCondition:
+        for (ref = list;  ref != NULL;  ref = ref->next)
+            if (condMatches(ref->val, step, lm))
+                rQueryElement(ref->val, step->next, pResultList, lm);
+        break;
+    case jplAll:
+        for (ref = list;  ref != NULL;  ref = ref->next)
+            rQueryElement(ref->val, step->next, pResultList, lm);
+        break;
+    case jplIndex:
+        for (ref = list, ix = 0;  ref != NULL;  ref = ref->next, ix++)
             {
-            errAbort("jsonQueryElement: invalid type: %d", elIn->type);
-            break;
+            if (ix == step->index)
+                {
+                rQueryElement(ref->val, step->next, pResultList, lm);
+                break;
+                }
             }
-        }
+        break;
+    default:
+        errAbort("jsonQueryElement: invalid index '%s' for list", step->id);
     }
-else
+}
+
+static void rQueryElement(struct jsonElement *elIn, struct jsonPathStep *step,
+                          struct slRef **pResultList, struct lm *lm)
+/* Recursively search for descendants of elIn matching the rest of the path from step;
+ * add jsonElements that match to resultList. */
+{
+if (step == NULL)
     {
-    struct slRef *ref;
-    if (lm)
-        lmAllocVar(lm, ref)
-    else
-        AllocVar(ref);
-    ref->val = elIn;
-    slAddHead(pResultList, ref);
+    addResult(elIn, pResultList, lm);
+    return;
+    }
+switch (elIn->type)
+    {
+    case jsonObject:
+        {
+        struct jsonElement *child = hashFindVal(elIn->val.jeHash, step->id);
+        if (child)
+            rQueryElement(child, step->next, pResultList, lm);
+        break;
+        }
+    case jsonList:
+        {
+        rQueryList(elIn, step, pResultList, lm);
+        break;
+        }
+    case jsonString:
+    case jsonBoolean:
+    case jsonNumber:
+    case jsonDouble:
+    case jsonNull:
+        {
+        errAbort("jsonQueryElement: got element with scalar type (%d), but children specified "
+                 "(%s)", elIn->type, step->id);
+        break;
+        }
+    default:
+        {
+        errAbort("jsonQueryElement: invalid type: %d", elIn->type);
+        break;
+        }
     }
-if (lm == NULL)
-    freez(&id);
-dyStringFree(&dy);
 }
 
-struct slRef *jsonQueryElementList(struct slRef *inList, char *name, char *path, struct lm *lm)
-/* Return a ref list of jsonElement descendants matching path of all jsonElements in inList.
- * name is for error reporting. */
+struct slRef *jsonPathQueryElementList(struct slRef *inList, char *name, struct jsonPath *jp,
+                                       struct lm *lm)
+/* Return a ref list of jsonElement descendants matching compiled path jp of all jsonElements
+ * in inList.  name is for error reporting. */
 {
 struct slRef *resultList = NULL;
-struct dyString *dy = dyStringNew(0);
-boolean isMult = (inList->next != NULL);
 struct slRef *ref;
-int ix;
-for (ref = inList, ix = 0;  ref != NULL;  ref = ref->next, ix++)
+for (ref = inList;  ref != NULL;  ref = ref->next)
     {
     struct jsonElement *elIn = ref->val;
     if (elIn)
-        {
-        dyStringClear(dy);
-        dyStringPrintf(dy, "%s", name);
-        if (isMult)
-            dyStringPrintf(dy, "[%d]", ix);
-        rQueryElement(elIn, dy->string, path, &resultList, lm);
-        }
+        rQueryElement(elIn, jp->steps, &resultList, lm);
     }
 slReverse(&resultList);
-dyStringFree(&dy);
 return resultList;
 }
 
-struct slRef *jsonQueryElement(struct jsonElement *el, char *name, char *path, struct lm *lm)
-/* Return a ref list of jsonElement descendants of el that match path.
+struct slRef *jsonPathQueryElement(struct jsonElement *el, char *name, struct jsonPath *jp,
+                                   struct lm *lm)
+/* Return a ref list of jsonElement descendants of el that match compiled path jp.
  * name is for error reporting. */
 {
-// Make an slRef wrapper for el and call jsonQueryElementList.
 struct slRef elRef = { NULL, el };
-return jsonQueryElementList(&elRef, name, path, lm);
+return jsonPathQueryElementList(&elRef, name, jp, lm);
 }
 
-static struct jsonElement *querySingle(struct jsonElement *el, char *name, char *path, struct lm *lm)
-/* Return one jsonElement resulting from searching el for path (or NULL); errAbort if multiple. */
+static struct jsonElement *pathQuerySingle(struct jsonElement *el, char *name,
+                                           struct jsonPath *jp, struct lm *lm)
+/* Return one jsonElement resulting from searching el for jp (or NULL); errAbort if multiple. */
 {
 struct jsonElement *resEl = NULL;
-struct slRef ref = { NULL, el };
-struct slRef *resultRef = jsonQueryElementList(&ref, name, path, lm);
+struct slRef *resultRef = jsonPathQueryElement(el, name, jp, lm);
 if (resultRef)
     {
     if (resultRef->next)
@@ -316,68 +392,67 @@ if (lm == NULL)
 return resEl;
 }
 
-char *jsonQueryString(struct jsonElement *el, char *name, char *path, struct lm *lm)
-/* Alloc & return the string value at the end of path in el. May be NULL. */
+char *jsonPathQueryString(struct jsonElement *el, char *name, struct jsonPath *jp, struct lm *lm)
+/* Alloc & return the string value at the end of compiled path jp in el. May be NULL. */
 {
-struct jsonElement *resEl = querySingle(el, name, path, lm);
+struct jsonElement *resEl = pathQuerySingle(el, name, jp, lm);
 if (resEl == NULL)
     return NULL;
 else if (lm)
-    return lmCloneString(lm, jsonStringVal(resEl, path));
+    return lmCloneString(lm, jsonStringVal(resEl, jp->text));
 else
-    return cloneString(jsonStringVal(resEl, path));
+    return cloneString(jsonStringVal(resEl, jp->text));
 }
 
-long jsonQueryInt(struct jsonElement *el, char *name, char *path, long defaultVal, struct lm *lm)
-/* Return the int value at path in el, or defaultVal if not found. */
+long jsonPathQueryInt(struct jsonElement *el, char *name, struct jsonPath *jp, long defaultVal,
+                      struct lm *lm)
+/* Return the int value at compiled path jp in el, or defaultVal if not found. */
 {
-struct jsonElement *resEl = querySingle(el, name, path, lm);
-long result = resEl ? jsonNumberVal(resEl, path) : defaultVal;
-if (lm == NULL)
-    freeMem(resEl);
-return result;
+struct jsonElement *resEl = pathQuerySingle(el, name, jp, lm);
+return resEl ? jsonNumberVal(resEl, jp->text) : defaultVal;
 }
 
-boolean jsonQueryBoolean(struct jsonElement *el, char *name, char *path, boolean defaultVal,
-                         struct lm *lm)
-/* Return the boolean value at path in el, or defaultVal if not found. */
+boolean jsonPathQueryBoolean(struct jsonElement *el, char *name, struct jsonPath *jp,
+                             boolean defaultVal, struct lm *lm)
+/* Return the boolean value at compiled path jp in el, or defaultVal if not found. */
 {
-struct jsonElement *resEl = querySingle(el, name, path, lm);
-boolean result = resEl ? jsonBooleanVal(resEl, path) : defaultVal;
-if (lm == NULL)
-    freeMem(resEl);
-return result;
+struct jsonElement *resEl = pathQuerySingle(el, name, jp, lm);
+return resEl ? jsonBooleanVal(resEl, jp->text) : defaultVal;
 }
 
-struct slName *jsonQueryStringList(struct slRef *inList, char *name, char *path, struct lm *lm)
-/* Alloc & return a list of string values matching path in all elements of inList. May be NULL. */
+struct slName *jsonPathQueryStringList(struct slRef *inList, char *name, struct jsonPath *jp,
+                                       struct lm *lm)
+/* Alloc & return a list of string values matching compiled path jp in all elements of inList.
+ * May be NULL. */
 {
 struct slName *results = NULL;
-struct slRef *resultRefs = jsonQueryElementList(inList, name, path, lm);
+struct slRef *resultRefs = jsonPathQueryElementList(inList, name, jp, lm);
 struct slRef *ref;
 for (ref = resultRefs;  ref != NULL;  ref = ref->next)
     {
     struct jsonElement *resEl = ref->val;
-    char *string = jsonStringVal(resEl, path);
+    char *string = jsonStringVal(resEl, jp->text);
     struct slName *sln = lm ? lmSlName(lm, string) : slNameNew(string);
     slAddHead(&results, sln);
     }
 slReverse(&results);
 if (lm == NULL && resultRefs)
-    slFreeList(resultRefs);
+    slFreeList(&resultRefs);
 return results;
 }
 
-struct slInt *jsonQueryIntList(struct slRef *inList, char *name, char *path, struct lm *lm)
-/* Alloc & return a list of int values matching path in all elements of inList. May be NULL. */
+struct slInt *jsonPathQueryIntList(struct slRef *inList, char *name, struct jsonPath *jp,
+                                   struct lm *lm)
+/* Alloc & return a list of int values matching compiled path jp in all elements of inList.
+ * May be NULL. */
 {
 struct slInt *results = NULL;
-struct slRef *resultRefs = jsonQueryElementList(inList, name, path, lm);
+struct slRef *resultRefs = jsonPathQueryElementList(inList, name, jp, lm);
 struct slRef *ref;
 for (ref = resultRefs;  ref != NULL;  ref = ref->next)
     {
     struct jsonElement *resEl = ref->val;
-    int val = jsonNumberVal(resEl, path);
+    int val = jsonNumberVal(resEl, jp->text);
     struct slInt *sli;
     if (lm)
         lmAllocVar(lm, sli)
@@ -388,7 +463,106 @@ for (ref = resultRefs;  ref != NULL;  ref = ref->next)
     }
 slReverse(&results);
 if (lm == NULL && resultRefs)
-    slFreeList(resultRefs);
+    slFreeList(&resultRefs);
+return results;
+}
+
+struct slName *jsonPathQueryStrings(struct jsonElement *el, char *name, struct jsonPath *jp,
+                                    struct lm *lm)
+/* Alloc & return a list of string values matching compiled path jp in el. May be NULL. */
+{
+struct slRef elRef = { NULL, el };
+return jsonPathQueryStringList(&elRef, name, jp, lm);
+}
+
+struct slInt *jsonPathQueryInts(struct jsonElement *el, char *name, struct jsonPath *jp,
+                                struct lm *lm)
+/* Alloc & return a list of int values matching compiled path jp in el. May be NULL. */
+{
+struct slRef elRef = { NULL, el };
+return jsonPathQueryIntList(&elRef, name, jp, lm);
+}
+
+/* The functions below take path strings and compile them for each call.  When running the
+ * same query on many elements, compile the path once with jsonPathCompile instead. */
+
+static struct jsonPath *compileForQuery(char *path, struct lm *lm, struct lm **retTempLm)
+/* Compile path into lm, or into a temporary lm returned in *retTempLm if lm is NULL. */
+{
+*retTempLm = NULL;
+if (lm == NULL)
+    lm = *retTempLm = lmInit(0);
+return jsonPathCompileLm(path, lm);
+}
+
+struct slRef *jsonQueryElementList(struct slRef *inList, char *name, char *path, struct lm *lm)
+/* Return a ref list of jsonElement descendants matching path of all jsonElements in inList.
+ * name is for error reporting. */
+{
+struct lm *tempLm;
+struct jsonPath *jp = compileForQuery(path, lm, &tempLm);
+struct slRef *resultList = jsonPathQueryElementList(inList, name, jp, lm);
+lmCleanup(&tempLm);
+return resultList;
+}
+
+struct slRef *jsonQueryElement(struct jsonElement *el, char *name, char *path, struct lm *lm)
+/* Return a ref list of jsonElement descendants of el that match path.
+ * name is for error reporting. */
+{
+// Make an slRef wrapper for el and call jsonQueryElementList.
+struct slRef elRef = { NULL, el };
+return jsonQueryElementList(&elRef, name, path, lm);
+}
+
+char *jsonQueryString(struct jsonElement *el, char *name, char *path, struct lm *lm)
+/* Alloc & return the string value at the end of path in el. May be NULL. */
+{
+struct lm *tempLm;
+struct jsonPath *jp = compileForQuery(path, lm, &tempLm);
+char *result = jsonPathQueryString(el, name, jp, lm);
+lmCleanup(&tempLm);
+return result;
+}
+
+long jsonQueryInt(struct jsonElement *el, char *name, char *path, long defaultVal, struct lm *lm)
+/* Return the int value at path in el, or defaultVal if not found. */
+{
+struct lm *tempLm;
+struct jsonPath *jp = compileForQuery(path, lm, &tempLm);
+long result = jsonPathQueryInt(el, name, jp, defaultVal, lm);
+lmCleanup(&tempLm);
+return result;
+}
+
+boolean jsonQueryBoolean(struct jsonElement *el, char *name, char *path, boolean defaultVal,
+                         struct lm *lm)
+/* Return the boolean value at path in el, or defaultVal if not found. */
+{
+struct lm *tempLm;
+struct jsonPath *jp = compileForQuery(path, lm, &tempLm);
+boolean result = jsonPathQueryBoolean(el, name, jp, defaultVal, lm);
+lmCleanup(&tempLm);
+return result;
+}
+
+struct slName *jsonQueryStringList(struct slRef *inList, char *name, char *path, struct lm *lm)
+/* Alloc & return a list of string values matching path in all elements of inList. May be NULL. */
+{
+struct lm *tempLm;
+struct jsonPath *jp = compileForQuery(path, lm, &tempLm);
+struct slName *results = jsonPathQueryStringList(inList, name, jp, lm);
+lmCleanup(&tempLm);
+return results;
+}
+
+struct slInt *jsonQueryIntList(struct slRef *inList, char *name, char *path, struct lm *lm)
+/* Alloc & return a list of int values matching path in all elements of inList. May be NULL. */
+{
+struct lm *tempLm;
+struct jsonPath *jp = compileForQuery(path, lm, &tempLm);
+struct slInt *results = jsonPathQueryIntList(inList, name, jp, lm);
+lmCleanup(&tempLm);
 return results;
 }
 
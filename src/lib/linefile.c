@@ -13,9 +13,11 @@
 #include "linefile.h"
 #include "pipeline.h"
 #include "localmem.h"
+#include "numText.h"
 #include "cheapcgi.h"
 #include "udc.h"
 #include "htslib/tbx.h"
+#include "tabixCache.h"
 
 char *getFileNameFromHdrSig(char *m)
 /* Check if header has signature of supported compression stream,
@@ -231,25 +233,19 @@ struct lineFile *lineFileTabixAndIndexMayOpen(char *fileOrUrl, char *tbiFileOrUr
 if (fileOrUrl == NULL)
     errAbort("lineFileTabixMayOpen: fileOrUrl is NULL");
 
-char tbiName[4096];
-if (tbiFileOrUrl==NULL)
-    safef(tbiName, sizeof(tbiName), "%s.tbi", fileOrUrl);
-else
-    safef(tbiName, sizeof(tbiName), "%s", tbiFileOrUrl);
-
 htsFile *htsFile = hts_open(fileOrUrl, "r");
 if (htsFile == NULL)
     {
     warn("Unable to open \"%s\"", fileOrUrl);
     return NULL;
     }
+// The index is shared with other lineFiles on the same file through tabixCache.
 tbx_t *tabix;
-if ((tabix = tbx_index_load2(fileOrUrl, tbiName)) == NULL)
+if ((tabix = tabixCacheLoad(fileOrUrl, tbiFileOrUrl)) == NULL)
     {
-    warn("Unable to load tabix index from \"%s\"", tbiName);
-    if (tabix)
-        ti_close(tabix);
-    tabix = NULL;
+    warn("Unable to load tabix index from \"%s\"",
+         tbiFileOrUrl ? tbiFileOrUrl : fileOrUrl);
+    hts_close(htsFile);
     return NULL;
     }
 struct lineFile *lf = needMem(sizeof(struct lineFile));
@@ -719,7 +715,7 @@ if ((lf = *pLf) != NULL)
 	{
 	if (lf->tabixIter != NULL)
 	    ti_iter_destroy(lf->tabixIter);
-	ti_close(lf->tabix);
+	tabixCacheRelease(lf->tabix);
         hts_close(lf->htsFile);
         kstring_t *kline = lf->kline;
         free(kline->s);
@@ -1233,7 +1229,7 @@ char *valEnd;
 char *val = words[wordIx];
 double doubleValue;
 
-doubleValue = strtod(val, &valEnd);
+doubleValue = numTextParseDouble(val, &valEnd);
 if ((*val == '\0') || (*valEnd != '\0'))
     errAbort("Expecting double field %d line %d of %s, got %s",
     	wordIx+1, lf->lineIx, lf->fileName, val);
@@ -45,6 +45,60 @@ Color *pt = _mgPixAdr(mg,x,y);
 *pt = multiply(*pt, color);
 }
 
+static Color dotColor(Color col, float frac)
+/* Return col with alpha set from frac the same way mixDot does it. */
+{
+int aA = frac * 255;
+return MAKECOLOR_32_A(COLOR_32_RED(col), COLOR_32_GREEN(col), COLOR_32_BLUE(col), aA);
+}
+
+static void mixSpan(Color *pt, int width, Color color)
+/* Blend color into width pixels starting at pt, same as mixColor on each.  An
+ * opaque color just replaces what is there, in a loop the compiler can vectorize.
+ * Otherwise runs of the same background are only blended once. */
+{
+Color *end = pt + width;
+if (COLOR_32_ALPHA(color) == 0xff)
+    {
+    for (; pt < end; ++pt)
+        *pt = color;
+    }
+else if (pt < end)
+    {
+    Color lastIn = *pt, lastOut = lastIn;
+    mixColor(&lastOut, color);
+    for (; pt < end; ++pt)
+        {
+        if (*pt != lastIn)
+            {
+            lastIn = lastOut = *pt;
+            mixColor(&lastOut, color);
+            }
+        *pt = lastOut;
+        }
+    }
+}
+
+static void multiplySpan(Color *pt, int width, Color color)
+/* Multiply width pixels starting at pt by color, same as multiply on each, only
+ * working out the product once for each run of the same pixel. */
+{
+Color *end = pt + width;
+if (pt < end)
+    {
+    Color lastIn = *pt, lastOut = multiply(lastIn, color);
+    for (; pt < end; ++pt)
+        {
+        if (*pt != lastIn)
+            {
+            lastIn = *pt;
+            lastOut = multiply(lastIn, color);
+            }
+        *pt = lastOut;
+        }
+    }
+}
+
 
 static void mgSetDefaultColorMap(struct memGfx *mg)
 /* Set up default color map for a memGfx. */
@@ -278,23 +332,19 @@ if (y2 > mg->clipMaxY)
 width = x2-x;
 height = y2-y;
 
-for (int i=x; i<x2; i++)
+if (width > 0)
     {
+    Color mixed = dotColor(color, COLOR_32_ALPHA(color)/255.0);
     for (int j=y; j<y2; j++)
-        {
-        mixDot(mg, i, j, COLOR_32_ALPHA(color)/255.0, color);
-        }
+        mixSpan(_mgPixAdr(mg,x,j), width, mixed);
     }
-
 }
 
 void mgDrawBoxMultiply(struct memGfx *mg, int x, int y, int width, int height, Color color)
 {
-int i;
 Color *pt;
 int x2 = x + width;
 int y2 = y + height;
-int wrapCount;
 
 if (x < mg->clipMinX)
     x = mg->clipMinX;
@@ -309,14 +359,10 @@ height = y2-y;
 if (width > 0 && height > 0)
     {
     pt = _mgPixAdr(mg,x,y);
-    wrapCount = _mgBpr(mg) - width;
     while (--height >= 0)
 	{
-        Color src = *pt;
-	i = width;
-	while (--i >= 0)
-	    *pt++ = multiply(src, color);
-	pt += wrapCount;
+	multiplySpan(pt, width, color);
+	pt += _mgBpr(mg);
 	}
     }
 }
@@ -338,6 +384,58 @@ switch(mg->writeMode)
     }
 }
 
+void mgDrawSpans(struct memGfx *mg, int y, int height, struct mgSpan *spans, int spanCount)
+/* Draw spanCount boxes that all run from y to y+height.  This gives the same
+ * result as calling mgDrawBox on each in turn, but clips once and goes a row at a
+ * time, which is much faster for the many small boxes of a dense wiggle or heatmap. */
+{
+int y2 = y + height;
+if (y < mg->clipMinY)
+    y = mg->clipMinY;
+if (y2 > mg->clipMaxY)
+    y2 = mg->clipMaxY;
+if (y >= y2 || spanCount <= 0)
+    return;
+
+/* Clip spans and work out what to blend once rather than on each row. */
+int *xs, *widths;
+Color *colors;
+AllocArray(xs, spanCount);
+AllocArray(widths, spanCount);
+AllocArray(colors, spanCount);
+int i;
+for (i = 0; i < spanCount; ++i)
+    {
+    struct mgSpan *span = &spans[i];
+    int x = max(span->x, mg->clipMinX);
+    int x2 = min(span->x + span->width, mg->clipMaxX);
+    xs[i] = x;
+    widths[i] = x2 - x;
+    if (mg->writeMode == MG_WRITE_MODE_MULTIPLY)
+        colors[i] = span->color;
+    else
+        colors[i] = dotColor(span->color, COLOR_32_ALPHA(span->color)/255.0);
+    }
+
+int row;
+for (row = y; row < y2; ++row)
+    {
+    Color *line = _mgPixAdr(mg, 0, row);
+    for (i = 0; i < spanCount; ++i)
+        {
+        if (widths[i] <= 0)
+            continue;
+        if (mg->writeMode == MG_WRITE_MODE_MULTIPLY)
+            multiplySpan(line + xs[i], widths[i], colors[i]);
+        else
+            mixSpan(line + xs[i], widths[i], colors[i]);
+        }
+    }
+freeMem(xs);
+freeMem(widths);
+freeMem(colors);
+}
+
 #define fraction(X) (((double)(X))-(double)(int)(X))
 #define invFraction(X) (1.0-fraction(X))
 
@@ -609,18 +707,9 @@ if (y >= mg->clipMinY && y < mg->clipMaxY)
         {
 	Color *pt = _mgPixAdr(mg,x1,y);
 	if (mg->writeMode == MG_WRITE_MODE_MULTIPLY)
-	    {
-	    while (--w >= 0)
-		{
-		*pt = multiply(*pt, color);
-		pt += 1;
-		}
-	    }
+	    multiplySpan(pt, w, color);
 	else
-	    {
-	    while (--w >= 0)
-                mixColor(pt++, color);
-	    }
+	    mixSpan(pt, w, color);
 	}
     }
 }
@@ -687,6 +776,9 @@ if (!mgClipForBlit(&width, &height, &bitX, &bitY, dest, &destX, &destY))
 inLine = bitData + (bitX>>3) + bitY * bitDataRowBytes;
 inLineBit = (0x80 >> (bitX&7));
 outLine = _mgPixAdr(dest,destX,destY);
+/* Most of the pixels under text are the same background, so remember the last blend. */
+Color lastIn = *outLine, lastOut = lastIn;
+mixColor(&lastOut, color);
 while (--height >= 0)
     {
     UBYTE *in = inLine;
@@ -696,8 +788,23 @@ while (--height >= 0)
     int i = width;
     while (--i >= 0)
 	{
+	if (inBit == 0x80 && inByte == 0 && i >= 8)
+	    {
+	    /* Skip over a whole byte of unset bits at once. */
+	    out += 8;
+	    i -= 7;
+	    inByte = *in++;
+	    continue;
+	    }
 	if (inBit & inByte)
-            mixColor(out, color);
+	    {
+	    if (*out != lastIn)
+		{
+		lastIn = lastOut = *out;
+		mixColor(&lastOut, color);
+		}
+	    *out = lastOut;
+	    }
 	++out;
 	if ((inBit >>= 1) == 0)
 	    {
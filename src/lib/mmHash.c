@@ -6,10 +6,22 @@
 #include "common.h"
 #include <sys/mman.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include "portable.h"
+#include "bits.h"
 #include "mmHash.h"
 
 unsigned char mmhMagicBytes[] = {0xF0, 'm', 'm', 'h', 'v', '1', 0x0F};
 size_t mmhMagicLen = sizeof mmhMagicBytes;
+// Version 2 magic differs only in the version character
+#define MMH_VERSION_IX 5
+#define MMH_V2_HEADER_SIZE 64
+// Version 2 has about 4 keys per bucket, and 50 slots for every 49 keys so slots are 98% full
+#define MMH_V2_BUCKET_KEYS 4
+#define MMH_V2_SLOT_RATIO 50
+#define MMH_V2_KEY_RATIO 49
+#define MMH_V2_DEFAULT_SEED 0x6d6d4861736832ULL
+#define MMH_V2_MAX_PILOT 0xFFFFFFFFU
 
 void hashToMmHashFile(struct hash *hash, char *mmapFilePath)
 /* Convert hash, whose values are null-terminated strings, to memory-mapped hash format and
@@ -85,6 +97,106 @@ verbose(2, "hashToMmHashFile: %d / %lu buckets occupied, max element count is %d
         occupiedBuckets, bucketCount, maxElCount);
 }
 
+static bits64 mix64(bits64 x)
+/* Scramble bits of x (splitmix64 finalizer). */
+{
+x ^= x >> 30;
+x *= 0xbf58476d1ce4e5b9ULL;
+x ^= x >> 27;
+x *= 0x94d049bb133111ebULL;
+x ^= x >> 31;
+return x;
+}
+
+static bits64 mmhKeyHash(char *key, bits64 seed)
+/* Return 64 bit hash of key for version 2 (seeded FNV-1a, then scrambled). */
+{
+bits64 h = 0xcbf29ce484222325ULL ^ seed;
+unsigned char *p;
+for (p = (unsigned char *)key;  *p != 0;  p++)
+    {
+    h ^= *p;
+    h *= 0x100000001b3ULL;
+    }
+return mix64(h);
+}
+
+static inline bits64 fastRange(bits64 x, bits64 n)
+/* Map x to [0,n) using the high bits of x * n, so smaller x never maps higher. */
+{
+return (bits64)(((unsigned __int128)x * n) >> 64);
+}
+
+static inline bits64 mmhBucket(bits64 keyHash, bits64 bucketCount)
+/* Return the bucket of keyHash.  Buckets increase with keyHash, so keys sorted by hash
+ * are also sorted by bucket. */
+{
+return fastRange(keyHash, bucketCount);
+}
+
+static inline bits64 mmhPilotHash(bits32 pilot, bits64 seed)
+/* Return the hash that pilot mixes into the key hashes of its bucket. */
+{
+return mix64(pilot ^ seed);
+}
+
+static inline bits64 mmhSlot(bits64 keyHash, bits64 pilotHash, bits64 slotCount)
+/* Return the slot keyHash goes to with its bucket's pilot. */
+{
+return fastRange(mix64(keyHash ^ pilotHash), slotCount);
+}
+
+static void mmHashV2FromBytes(struct mmHash *mmh)
+/* Fill in version 2 fields of mmh from its header in mmapBytes. */
+{
+bits64 *header = (bits64 *)(mmh->mmapBytes + 8);
+mmh->version = 2;
+mmh->keyCount = header[0];
+mmh->bucketCount = header[1];
+mmh->slotCount = header[2];
+mmh->seed = header[3];
+bits64 pilotsOffset = header[4], remapOffset = header[5], entriesOffset = header[6];
+if (mmh->bucketCount == 0 || mmh->slotCount < mmh->keyCount ||
+    pilotsOffset + mmh->bucketCount * sizeof(bits32) > remapOffset ||
+    remapOffset + (mmh->slotCount - mmh->keyCount) * sizeof(bits64) > entriesOffset ||
+    entriesOffset + mmh->keyCount * sizeof(struct mmHashEntry) > mmh->mmapLength)
+    errAbort("mmHashFromFile: corrupt version 2 header in %s", mmh->mmapFileName);
+mmh->pilots = (uint32_t *)(mmh->mmapBytes + pilotsOffset);
+mmh->remap = (uint64_t *)(mmh->mmapBytes + remapOffset);
+mmh->entries = (struct mmHashEntry *)(mmh->mmapBytes + entriesOffset);
+}
+
+static bits64 mmHashV2KeySlot(struct mmHash *mmh, bits64 keyHash)
+/* Return index in entries of the only place that key with keyHash could be. */
+{
+bits32 pilot = mmh->pilots[mmhBucket(keyHash, mmh->bucketCount)];
+bits64 slot = mmhSlot(keyHash, mmhPilotHash(pilot, mmh->seed), mmh->slotCount);
+if (slot >= mmh->keyCount)
+    slot = mmh->remap[slot - mmh->keyCount];
+return slot;
+}
+
+static const char *mmHashV2EntryVal(struct mmHash *mmh, struct mmHashEntry *entry, char *key)
+/* Return value of entry if its key is key, otherwise NULL. */
+{
+char *keyStr = (char *)(mmh->mmapBytes + entry->offset);
+if (!sameString(key, keyStr))
+    return NULL;
+return keyStr + strlen(keyStr) + 1;
+}
+
+static const char *mmHashV2FindVal(struct mmHash *mmh, char *key)
+/* Look up key in version 2 mmh. */
+{
+if (mmh->keyCount == 0)
+    return NULL;
+bits64 keyHash = mmhKeyHash(key, mmh->seed);
+struct mmHashEntry *entry = &mmh->entries[mmHashV2KeySlot(mmh, keyHash)];
+if (entry->fingerprint != (bits32)keyHash)
+    return NULL;
+return mmHashV2EntryVal(mmh, entry, key);
+}
+
 struct mmHash *mmHashFromFile(char *mmapFilePath)
 /* Return an mmHash read in from memory-mapped file at mmapFilePath. */
 {
@@ -98,9 +210,23 @@ if (mmh->mmapBytes == MAP_FAILED)
     errnoAbort("mmHashFromFile: mmap of file failed: %s", mmapFilePath);
 if (madvise(mmh->mmapBytes, mmh->mmapLength, MADV_RANDOM | MADV_WILLNEED) < 0)
     errnoAbort("mmHashFromFile: madvise of file failed: %s", mmapFilePath);
-// Check first 7 magic bytes
-if (strncmp((char *)mmh->mmapBytes, (char *)mmhMagicBytes, mmhMagicLen))
+// Check first 7 magic bytes, allowing either version in the middle
+if (mmh->mmapLength < mmhMagicLen + 1 ||
+    memcmp(mmh->mmapBytes, mmhMagicBytes, MMH_VERSION_IX) ||
+    mmh->mmapBytes[MMH_VERSION_IX+1] != mmhMagicBytes[MMH_VERSION_IX+1])
     errAbort("mmHashFromFile: magic bytes not found at start of file %s", mmapFilePath);
+char version = mmh->mmapBytes[MMH_VERSION_IX];
+if (version == '2')
+    {
+    if (mmh->mmapLength < MMH_V2_HEADER_SIZE)
+        errAbort("mmHashFromFile: truncated version 2 header in %s", mmapFilePath);
+    mmHashV2FromBytes(mmh);
+    carefulClose(&f);
+    return mmh;
+    }
+else if (version != '1')
+    errAbort("mmHashFromFile: unsupported version '%c' in %s", version, mmapFilePath);
+mmh->version = 1;
 unsigned char powerOfTwoSize = mmh->mmapBytes[mmhMagicLen];
 if (powerOfTwoSize < MMHASH_MIN_POWER_OF_2_SIZE || powerOfTwoSize > MMHASH_MAX_POWER_OF_2_SIZE)
     errAbort("mmHashFromFile: power of two size must be between %d and %d but is %d",
@@ -115,6 +241,8 @@ return mmh;
 const char *mmHashFindVal(struct mmHash *mmh, char *key)
 /* Look up key in mmh and return its string value or NULL if not found.  Do not modify return val. */
 {
+if (mmh->version == 2)
+    return mmHashV2FindVal(mmh, key);
 bits32 keyHash = hashString(key) & mmh->mask;
 size_t bucketOffset = mmh->bucketOffsets[keyHash];
 // Bucket offsets are always greater than 0 because of the header stuff at the beginning of the file.
@@ -138,6 +266,70 @@ for (i = 0;  i < elCount;  i++)
 return NULL;
 }
 
+struct mmhLookup
+/* A key being looked up in a batch, and where it goes. */
+{
+    bits64 pos;                 // slot, and later string offset of candidate
+    int ix;                     // index in keys
+};
+
+static int mmhLookupCmp(const void *va, const void *vb)
+/* Compare mmhLookups by pos. */
+{
+const struct mmhLookup *a = va, *b = vb;
+if (a->pos < b->pos)
+    return -1;
+return (a->pos > b->pos);
+}
+
+void mmHashFindVals(struct mmHash *mmh, int count, char **keys, const char **retVals)
+/* Look up count keys in mmh, putting values or NULLs in retVals.  For version 2 files this
+ * visits entries and then keys in file order, which is kinder to cold pages than looking
+ * them up one at a time. */
+{
+int i;
+if (mmh->version != 2 || mmh->keyCount == 0)
+    {
+    for (i = 0;  i < count;  i++)
+        retVals[i] = mmHashFindVal(mmh, keys[i]);
+    return;
+    }
+struct mmhLookup *lookups;
+AllocArray(lookups, count);
+bits32 *fingerprints;
+AllocArray(fingerprints, count);
+for (i = 0;  i < count;  i++)
+    {
+    bits64 keyHash = mmhKeyHash(keys[i], mmh->seed);
+    fingerprints[i] = keyHash;
+    lookups[i].pos = mmHashV2KeySlot(mmh, keyHash);
+    lookups[i].ix = i;
+    retVals[i] = NULL;
+    }
+// Visit entries in order, keeping only lookups whose fingerprints match
+qsort(lookups, count, sizeof lookups[0], mmhLookupCmp);
+int matchCount = 0;
+for (i = 0;  i < count;  i++)
+    {
+    struct mmHashEntry *entry = &mmh->entries[lookups[i].pos];
+    if (entry->fingerprint == fingerprints[lookups[i].ix])
+        {
+        lookups[matchCount].pos = entry->offset;
+        lookups[matchCount].ix = lookups[i].ix;
+        matchCount++;
+        }
+    }
+// Then compare keys in order of where they are in the file
+qsort(lookups, matchCount, sizeof lookups[0], mmhLookupCmp);
+for (i = 0;  i < matchCount;  i++)
+    {
+    struct mmHashEntry entry = {lookups[i].pos, 0, 0};
+    retVals[lookups[i].ix] = mmHashV2EntryVal(mmh, &entry, keys[lookups[i].ix]);
+    }
+freeMem(fingerprints);
+freeMem(lookups);
+}
+
 void mmHashFree(struct mmHash **pMmh)
 /* Free the allocated memory for *pMmh and unmap the mapped memory range if not NULL,
  * but leave the memory-mapped file in place for other processes. */
@@ -151,3 +343,394 @@ if (pMmh != NULL && *pMmh != NULL)
     freez(pMmh);
     }
 }
+
+struct mmhHashRec
+/* Hash of a key and offset of the key in the file being built. */
+{
+    bits64 hash;                // key hash
+    bits64 offset;              // offset of key in file
+};
+
+static int mmhHashRecCmp(const void *va, const void *vb)
+/* Compare mmhHashRecs by hash, then by offset. */
+{
+const struct mmhHashRec *a = va, *b = vb;
+if (a->hash != b->hash)
+    return (a->hash < b->hash ? -1 : 1);
+if (a->offset != b->offset)
+    return (a->offset < b->offset ? -1 : 1);
+return 0;
+}
+
+struct mmhRun
+/* A sorted run of key hashes, either in a temp file or in memory. */
+{
+    struct mmhRun *next;
+    FILE *f;                    // temp file, or NULL if run is in recs
+    struct mmhHashRec *recs;    // records if run is in memory
+    bits64 count;               // number of records in run
+    bits64 readCount;           // number of records read so far
+    struct mmhHashRec cur;      // last record read
+};
+
+struct mmHashBuilder
+/* State of a version 2 mmHash file being built. */
+{
+    char *fileName;             // file being built
+    FILE *f;                    // keys and values are written to this as they are added
+    bits64 offset;              // current offset in f
+    char *tmpDir;               // directory for sorted runs and buckets
+    bits64 seed;                // seed for key hash
+    struct mmhHashRec *recs;    // key hashes not yet written to a run
+    bits64 recCount;            // number of recs used
+    bits64 recAlloc;            // number of recs allocated
+    bits64 recMax;              // maximum number of recs to keep in memory
+    bits64 addCount;            // number of keys added, including repeats
+    struct mmhRun *runList;     // sorted runs in temp files
+};
+
+static FILE *mmhTempFile(char *tmpDir)
+/* Return a new temp file open for reading and writing.  It's removed already, so it goes away
+ * when closed. */
+{
+char *fileName = rTempName(tmpDir, "mmHash", ".tmp");
+FILE *f = mustOpen(fileName, "w+");
+mustRemove(fileName);
+return f;
+}
+
+struct mmHashBuilder *mmHashBuilderNew(char *mmapFilePath, char *tmpDir, size_t maxMem)
+/* Start building a version 2 mmHash file at mmapFilePath.  Keys and values are written out
+ * as they are added, and key hashes are kept in sorted runs in tmpDir (default getTempDir())
+ * once they use more than maxMem bytes (default 1G if 0). */
+{
+struct mmHashBuilder *mhb;
+AllocVar(mhb);
+mhb->fileName = cloneString(mmapFilePath);
+mhb->tmpDir = cloneString(tmpDir != NULL ? tmpDir : getTempDir());
+mhb->seed = MMH_V2_DEFAULT_SEED;
+if (maxMem == 0)
+    maxMem = 1024LL * 1024 * 1024;
+mhb->recMax = max(maxMem / sizeof(struct mmhHashRec), 16);
+mhb->recAlloc = min(mhb->recMax, 1024);
+mhb->recs = needHugeMem(mhb->recAlloc * sizeof(struct mmhHashRec));
+// Header is filled in by mmHashBuilderFinish; write magic now so a partial file is recognizable
+unsigned char header[MMH_V2_HEADER_SIZE];
+zeroBytes(header, sizeof header);
+memcpy(header, mmhMagicBytes, mmhMagicLen);
+header[MMH_VERSION_IX] = '2';
+mhb->f = mustOpen(mmapFilePath, "w");
+mustWrite(mhb->f, header, sizeof header);
+mhb->offset = sizeof header;
+return mhb;
+}
+
+static void mmhSpill(struct mmHashBuilder *mhb)
+/* Sort key hashes in memory and write them out as a run. */
+{
+qsort(mhb->recs, mhb->recCount, sizeof mhb->recs[0], mmhHashRecCmp);
+struct mmhRun *run;
+AllocVar(run);
+run->f = mmhTempFile(mhb->tmpDir);
+mustWrite(run->f, mhb->recs, mhb->recCount * sizeof mhb->recs[0]);
+rewind(run->f);
+run->count = mhb->recCount;
+slAddHead(&mhb->runList, run);
+verbose(2, "mmHashBuilder: wrote run of %llu keys\n", (unsigned long long)run->count);
+mhb->recCount = 0;
+}
+
+void mmHashBuilderAdd(struct mmHashBuilder *mhb, char *key, char *val)
+/* Add key and its value.  If a key is added more than once the last value is kept. */
+{
+if (mhb->recCount == mhb->recAlloc)
+    {
+    if (mhb->recAlloc < mhb->recMax)
+        {
+        bits64 newAlloc = min(2 * mhb->recAlloc, mhb->recMax);
+        mhb->recs = needHugeMemResize(mhb->recs, newAlloc * sizeof mhb->recs[0]);
+        mhb->recAlloc = newAlloc;
+        }
+    else
+        mmhSpill(mhb);
+    }
+struct mmhHashRec *rec = &mhb->recs[mhb->recCount++];
+rec->hash = mmhKeyHash(key, mhb->seed);
+rec->offset = mhb->offset;
+size_t keyLen = strlen(key) + 1, valLen = strlen(val) + 1;
+mustWrite(mhb->f, key, keyLen);
+mustWrite(mhb->f, val, valLen);
+mhb->offset += keyLen + valLen;
+mhb->addCount++;
+}
+
+static boolean mmhRunNext(struct mmhRun *run)
+/* Read next record of run into run->cur.  Return FALSE if there are no more. */
+{
+if (run->readCount >= run->count)
+    return FALSE;
+if (run->f != NULL)
+    mustRead(run->f, &run->cur, sizeof run->cur);
+else
+    run->cur = run->recs[run->readCount];
+run->readCount++;
+return TRUE;
+}
+
+struct mmhBucketFiles
+/* Buckets written to a temp file for each bucket size, so they can be placed biggest first. */
+{
+    FILE **files;               // temp file for each bucket size, NULL if none that size
+    bits64 *counts;             // number of buckets of each size
+    int sizeAlloc;              // number of sizes allocated
+    int maxSize;                // biggest bucket size
+    char *tmpDir;               // where to make the files
+};
+
+static void mmhBucketWrite(struct mmhBucketFiles *bf, bits64 bucket,
+                           struct mmhHashRec *recs, int count)
+/* Write bucket with count keys to the file for its size. */
+{
+if (count >= bf->sizeAlloc)
+    {
+    int newAlloc = max(2 * bf->sizeAlloc, count + 1);
+    ExpandArray(bf->files, bf->sizeAlloc, newAlloc);
+    ExpandArray(bf->counts, bf->sizeAlloc, newAlloc);
+    bf->sizeAlloc = newAlloc;
+    }
+if (bf->files[count] == NULL)
+    bf->files[count] = mmhTempFile(bf->tmpDir);
+writeOne(bf->files[count], bucket);
+mustWrite(bf->files[count], recs, count * sizeof recs[0]);
+bf->counts[count]++;
+if (count > bf->maxSize)
+    bf->maxSize = count;
+}
+
+static bits64 mmhMergeRuns(struct mmHashBuilder *mhb, unsigned char *strings,
+                           bits64 bucketCount, struct mmhBucketFiles *bf)
+/* Merge sorted runs of key hashes, keeping only the last of keys added more than once, and
+ * write them to bf a bucket at a time.  Return number of distinct keys. */
+{
+int runCount = slCount(mhb->runList), activeCount = 0, i;
+struct mmhRun **active, *run;
+AllocArray(active, runCount);
+for (run = mhb->runList;  run != NULL;  run = run->next)
+    if (mmhRunNext(run))
+        active[activeCount++] = run;
+int bucketAlloc = 16, bucketSize = 0;
+struct mmhHashRec *bucketRecs;
+AllocArray(bucketRecs, bucketAlloc);
+bits64 curBucket = 0, keyCount = 0;
+while (activeCount > 0)
+    {
+    // Take smallest record from the runs
+    int minIx = 0;
+    for (i = 1;  i < activeCount;  i++)
+        if (mmhHashRecCmp(&active[i]->cur, &active[minIx]->cur) < 0)
+            minIx = i;
+    struct mmhHashRec rec = active[minIx]->cur;
+    if (!mmhRunNext(active[minIx]))
+        active[minIx] = active[--activeCount];
+    bits64 bucket = mmhBucket(rec.hash, bucketCount);
+    if (bucketSize > 0 && bucket != curBucket)
+        {
+        mmhBucketWrite(bf, curBucket, bucketRecs, bucketSize);
+        bucketSize = 0;
+        }
+    curBucket = bucket;
+    if (bucketSize > 0 && bucketRecs[bucketSize-1].hash == rec.hash)
+        {
+        // Same hash as last key.  Records come in offset order so this one was added later.
+        char *oldKey = (char *)(strings + bucketRecs[bucketSize-1].offset);
+        char *newKey = (char *)(strings + rec.offset);
+        if (differentString(oldKey, newKey))
+            errAbort("mmHashBuilderFinish: keys '%s' and '%s' have the same 64 bit hash, sorry.",
+                     oldKey, newKey);
+        bucketRecs[bucketSize-1].offset = rec.offset;
+        continue;
+        }
+    if (bucketSize == bucketAlloc)
+        {
+        ExpandArray(bucketRecs, bucketAlloc, 2 * bucketAlloc);
+        bucketAlloc *= 2;
+        }
+    bucketRecs[bucketSize++] = rec;
+    keyCount++;
+    }
+if (bucketSize > 0)
+    mmhBucketWrite(bf, curBucket, bucketRecs, bucketSize);
+freeMem(bucketRecs);
+freeMem(active);
+return keyCount;
+}
+
+static bits32 mmhFindPilot(struct mmhHashRec *recs, int count, Bits *taken,
+                           bits64 seed, bits64 slotCount, bits64 *slots)
+/* Find a pilot that puts all keys of a bucket into different untaken slots, and put the
+ * slots in slots. */
+{
+bits64 pilot;
+for (pilot = 0;  pilot <= MMH_V2_MAX_PILOT;  pilot++)
+    {
+    bits64 pilotHash = mmhPilotHash(pilot, seed);
+    int i, j;
+    for (i = 0;  i < count;  i++)
+        {
+        slots[i] = mmhSlot(recs[i].hash, pilotHash, slotCount);
+        if (bitReadOne(taken, slots[i]))
+            break;
+        for (j = 0;  j < i;  j++)
+            if (slots[j] == slots[i])
+                break;
+        if (j < i)
+            break;
+        }
+    if (i == count)
+        return pilot;
+    }
+errAbort("mmHashBuilderFinish: could not find a pilot for a bucket of %d keys", count);
+return 0;
+}
+
+static void mmhPlaceBuckets(struct mmhBucketFiles *bf, struct mmHashEntry *entries,
+                            bits32 *pilots, bits64 *remap, bits64 keyCount, bits64 slotCount,
+                            bits64 seed, char *tmpDir)
+/* Find pilots for buckets, biggest buckets first, and fill in entries and remap. */
+{
+Bits *taken = bitAlloc(slotCount);
+FILE *overflow = mmhTempFile(tmpDir);
+bits64 overflowCount = 0;
+struct mmhHashRec *recs;
+bits64 *slots;
+AllocArray(recs, bf->maxSize + 1);
+AllocArray(slots, bf->maxSize + 1);
+int size;
+for (size = bf->maxSize;  size > 0;  size--)
+    {
+    FILE *f = bf->files[size];
+    if (f == NULL)
+        continue;
+    rewind(f);
+    bits64 b;
+    for (b = 0;  b < bf->counts[size];  b++)
+        {
+        bits64 bucket;
+        mustReadOne(f, bucket);
+        mustRead(f, recs, size * sizeof recs[0]);
+        pilots[bucket] = mmhFindPilot(recs, size, taken, seed, slotCount, slots);
+        int i;
+        for (i = 0;  i < size;  i++)
+            {
+            struct mmHashEntry entry = {recs[i].offset, (bits32)recs[i].hash, 0};
+            bitSetOne(taken, slots[i]);
+            if (slots[i] < keyCount)
+                entries[slots[i]] = entry;
+            else
+                {
+                // Slot is past the end of entries; store it until we know where it moves to.
+                writeOne(overflow, slots[i]);
+                writeOne(overflow, entry);
+                overflowCount++;
+                }
+            }
+        }
+    carefulClose(&bf->files[size]);
+    }
+// Map each taken slot past keyCount to a free slot below keyCount.
+bits64 slot, freeSlot = 0;
+for (slot = keyCount;  slot < slotCount;  slot++)
+    {
+    if (bitReadOne(taken, slot))
+        {
+        while (bitReadOne(taken, freeSlot))
+            freeSlot++;
+        remap[slot - keyCount] = freeSlot++;
+        }
+    }
+rewind(overflow);
+bits64 i;
+for (i = 0;  i < overflowCount;  i++)
+    {
+    struct mmHashEntry entry;
+    mustReadOne(overflow, slot);
+    mustReadOne(overflow, entry);
+    entries[remap[slot - keyCount]] = entry;
+    }
+carefulClose(&overflow);
+freeMem(slots);
+freeMem(recs);
+bitFree(&taken);
+}
+
+static bits64 mmhAlign8(bits64 offset)
+/* Round offset up to a multiple of 8. */
+{
+return (offset + 7) & ~7ULL;
+}
+
+void mmHashBuilderFinish(struct mmHashBuilder **pMhb)
+/* Build the perfect hash, finish writing file and free up builder. */
+{
+struct mmHashBuilder *mhb = *pMhb;
+if (mhb == NULL)
+    return;
+carefulClose(&mhb->f);
+bits64 stringEnd = mhb->offset;
+// Keep the last key hashes in memory as one more run.
+struct mmhRun *memRun;
+AllocVar(memRun);
+qsort(mhb->recs, mhb->recCount, sizeof mhb->recs[0], mmhHashRecCmp);
+memRun->recs = mhb->recs;
+memRun->count = mhb->recCount;
+slAddHead(&mhb->runList, memRun);
+
+// Merge runs into buckets, looking at keys in the file when hashes are the same.
+int fd = mustOpenFd(mhb->fileName, O_RDWR);
+unsigned char *strings = mmap(NULL, stringEnd, PROT_READ, MAP_SHARED, fd, 0);
+if (strings == MAP_FAILED)
+    errnoAbort("mmHashBuilderFinish: mmap of %s failed", mhb->fileName);
+bits64 bucketCount = max(1, mhb->addCount / MMH_V2_BUCKET_KEYS);
+struct mmhBucketFiles bf;
+ZeroVar(&bf);
+bf.tmpDir = mhb->tmpDir;
+bits64 keyCount = mmhMergeRuns(mhb, strings, bucketCount, &bf);
+if (munmap(strings, stringEnd))
+    errnoAbort("mmHashBuilderFinish: munmap failed");
+struct mmhRun *run;
+for (run = mhb->runList;  run != NULL;  run = run->next)
+    carefulClose(&run->f);
+slFreeList(&mhb->runList);
+
+// Lay out the rest of the file and map it to fill it in.  An empty table still gets one
+// slot so there is something to allocate; lookups check keyCount before using it.
+bits64 slotCount = (keyCount * MMH_V2_SLOT_RATIO + MMH_V2_KEY_RATIO - 1) / MMH_V2_KEY_RATIO;
+slotCount = max(1, slotCount);
+bits64 pilotsOffset = mmhAlign8(stringEnd);
+bits64 remapOffset = mmhAlign8(pilotsOffset + bucketCount * sizeof(bits32));
+bits64 entriesOffset = remapOffset + (slotCount - keyCount) * sizeof(bits64);
+bits64 fileLength = entriesOffset + keyCount * sizeof(struct mmHashEntry);
+if (ftruncate(fd, fileLength) < 0)
+    errnoAbort("mmHashBuilderFinish: could not extend %s", mhb->fileName);
+unsigned char *bytes = mmap(NULL, fileLength, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+if (bytes == MAP_FAILED)
+    errnoAbort("mmHashBuilderFinish: mmap of %s failed", mhb->fileName);
+mmhPlaceBuckets(&bf, (struct mmHashEntry *)(bytes + entriesOffset),
+                (bits32 *)(bytes + pilotsOffset), (bits64 *)(bytes + remapOffset),
+                keyCount, slotCount, mhb->seed, mhb->tmpDir);
+bits64 header[7] = {keyCount, bucketCount, slotCount, mhb->seed,
+                    pilotsOffset, remapOffset, entriesOffset};
+memcpy(bytes + 8, header, sizeof header);
+if (munmap(bytes, fileLength))
+    errnoAbort("mmHashBuilderFinish: munmap failed");
+mustCloseFd(&fd);
+verbose(2, "mmHashBuilderFinish: %llu keys (%llu added), %llu buckets, largest has %d keys\n",
+        (unsigned long long)keyCount, (unsigned long long)mhb->addCount,
+        (unsigned long long)bucketCount, bf.maxSize);
+freeMem(bf.files);
+freeMem(bf.counts);
+freeMem(mhb->recs);
+freeMem(mhb->tmpDir);
+freeMem(mhb->fileName);
+freez(pMhb);
+}
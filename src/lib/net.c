@@ -1321,6 +1321,60 @@ while((word=nextWord(&list)))
 return FALSE;
 }
 
+static void netHttpRequestHeader(struct dyString *dy, char *url, struct netParsedUrl *npu,
+	struct netParsedUrl *pxy, char *method, char *protocol, char *agent,
+	char *optionalHeader)
+/* Append request line and header lines other than Connection: for url to dy.
+ * pxy is the parsed proxy url or NULL if not going through a proxy. */
+{
+char *urlForProxy = NULL;
+if (pxy)
+    {
+    /* trim off the byterange part at the end of url because proxy does not understand it. */
+    urlForProxy = cloneString(url);
+    char *x = strrchr(urlForProxy, ';');
+    if (x && startsWith(";byterange=", x))
+	*x = 0;
+    }
+dyStringPrintf(dy, "%s %s %s\r\n", method, pxy ? urlForProxy : npu->file, protocol);
+freeMem(urlForProxy);
+dyStringPrintf(dy, "User-Agent: %s\r\n", agent);
+
+dyStringPrintf(dy, "Host: ");
+netHandleHostForIpv6(npu, dy);
+
+boolean portIsDefault = FALSE;
+/* do not need the 80 since it is the default */
+if (sameString(npu->protocol, "http" ) && sameString("80", npu->port))
+    portIsDefault = TRUE;
+if (sameString(npu->protocol, "https" ) && sameString("443", npu->port))
+    portIsDefault = TRUE;
+if (!portIsDefault)
+    {
+    dyStringAppendC(dy, ':');
+    dyStringAppend(dy, npu->port);
+    }
+dyStringPrintf(dy, "\r\n");
+
+setAuthorization(*npu, "Authorization", dy);
+if (pxy)
+    setAuthorization(*pxy, "Proxy-Authorization", dy);
+dyStringAppend(dy, "Accept: */*\r\n");
+if (npu->byteRangeStart != -1)
+    {
+    if (npu->byteRangeEnd != -1)
+	dyStringPrintf(dy, "Range: bytes=%lld-%lld\r\n"
+		       , (long long)npu->byteRangeStart
+		       , (long long)npu->byteRangeEnd);
+    else
+	dyStringPrintf(dy, "Range: bytes=%lld-\r\n"
+		       , (long long)npu->byteRangeStart);
+    }
+
+if (optionalHeader)
+    dyStringAppend(dy, optionalHeader);
+}
+
 int netHttpConnect(char *url, char *method, char *protocol, char *agent, char *optionalHeader)
 /* Parse URL, connect to associated server on port, and send most of
  * the request to the server.  If specified in the url send user name
@@ -1366,71 +1420,395 @@ if (sd < 0)
     return -1;
 
 /* Ask remote server for a file. */
-char *urlForProxy = NULL;
-if (proxyUrl)
+netHttpRequestHeader(dy, url, &npu, proxyUrl ? &pxy : NULL, method, protocol, agent,
+    optionalHeader);
+if (sameString(protocol, "HTTP/1.1"))
+    dyStringAppend(dy, "Connection: close\r\n");  // NON-persistent HTTP 1.1 connection
+
+/* finish off the header with final blank line */
+dyStringAppend(dy, "\r\n");
+
+mustWriteFd(sd, dy->string, dy->stringSize);
+
+
+/* Clean up and return handle. */
+dyStringFree(&dy);
+return sd;
+}
+
+
+/* Keep-alive connection pool.  GET requests to http and https servers that don't go
+ * through a proxy are sent as HTTP/1.1 on connections that are kept open and reused
+ * by later requests to the same server.  Callers still get a descriptor that reads
+ * the http header and body and then hits end of file as if the server had closed
+ * the connection.  A thread copies one response from the server to a socket pair,
+ * removing any chunked transfer encoding, and puts the server connection back in the
+ * pool once the whole response has been read. */
+
+#define NET_POOL_MAX_PER_HOST 4		/* Most idle connections kept per server. */
+#define NET_POOL_IDLE_SECONDS 30	/* Idle connections older than this are closed. */
+
+struct netPooledConn
+/* An idle keep-alive connection. */
     {
-    /* trim off the byterange part at the end of url because proxy does not understand it. */
-    urlForProxy = cloneString(url);
-    char *x = strrchr(urlForProxy, ';');
-    if (x && startsWith(";byterange=", x))
-	*x = 0;
-    }
-dyStringPrintf(dy, "%s %s %s\r\n", method, proxyUrl ? urlForProxy : npu.file, protocol);
-freeMem(urlForProxy);
-dyStringPrintf(dy, "User-Agent: %s\r\n", agent);
+    struct netPooledConn *next;	/* Next in list. */
+    char *key;			/* protocol://host:port */
+    int sd;			/* Connection to server. */
+    time_t idleSince;		/* When it was put in pool. */
+    pid_t pid;			/* Process that put it in pool. */
+    };
 
-dyStringPrintf(dy, "Host: ");
-netHandleHostForIpv6(&npu, dy);
+static struct netPooledConn *connPool = NULL;	/* Idle connections, most recent first. */
+static pthread_mutex_t connPoolMutex = PTHREAD_MUTEX_INITIALIZER;
+static boolean keepAliveOff = FALSE;	/* Set by netKeepAliveEnable(FALSE). */
 
-boolean portIsDefault = FALSE;
-/* do not need the 80 since it is the default */
-if (sameString(npu.protocol, "http" ) && sameString("80", npu.port))
-    portIsDefault = TRUE;
-if (sameString(npu.protocol, "https" ) && sameString("443", npu.port))
-    portIsDefault = TRUE;
-if (!portIsDefault)
+void netKeepAliveEnable(boolean enable)
+/* Turn reuse of http and https connections on or off.  It is on by default.
+ * Turning it off closes idle connections. */
+{
+pthread_mutex_lock(&connPoolMutex);
+keepAliveOff = !enable;
+if (keepAliveOff)
     {
-    dyStringAppendC(dy, ':');
-    dyStringAppend(dy, npu.port);
+    struct netPooledConn *pc;
+    while ((pc = slPopHead(&connPool)) != NULL)
+	{
+	close(pc->sd);
+	freeMem(pc->key);
+	freeMem(pc);
+	}
     }
-dyStringPrintf(dy, "\r\n");
+pthread_mutex_unlock(&connPoolMutex);
+}
 
-setAuthorization(npu, "Authorization", dy);
-if (proxyUrl)
-    setAuthorization(pxy, "Proxy-Authorization", dy);
-dyStringAppend(dy, "Accept: */*\r\n");
-if (npu.byteRangeStart != -1)
+static void connPoolExpire()
+/* Close connections that have been idle too long or belong to a parent process.
+ * Call with connPoolMutex held. */
+{
+time_t now = time(NULL);
+pid_t pid = getpid();
+struct netPooledConn *pc, *next, *keep = NULL;
+for (pc = connPool; pc != NULL; pc = next)
     {
-    if (npu.byteRangeEnd != -1)
-	dyStringPrintf(dy, "Range: bytes=%lld-%lld\r\n"
-		       , (long long)npu.byteRangeStart
-		       , (long long)npu.byteRangeEnd);
+    next = pc->next;
+    if (pc->pid != pid || now - pc->idleSince > NET_POOL_IDLE_SECONDS)
+	{
+	close(pc->sd);
+	freeMem(pc->key);
+	freeMem(pc);
+	}
     else
-	dyStringPrintf(dy, "Range: bytes=%lld-\r\n"
-		       , (long long)npu.byteRangeStart);
+	slAddHead(&keep, pc);
     }
+slReverse(&keep);
+connPool = keep;
+}
 
-if (optionalHeader)
-    dyStringAppend(dy, optionalHeader);
-if (sameString(protocol, "HTTP/1.1"))
-    dyStringAppend(dy, "Connection: close\r\n");  // NON-persistent HTTP 1.1 connection
+static int connPoolTake(char *key)
+/* Remove and return an idle connection to key from pool, or -1 if none. */
+{
+int sd = -1;
+pthread_mutex_lock(&connPoolMutex);
+connPoolExpire();
+struct netPooledConn *pc;
+for (pc = connPool; pc != NULL; pc = pc->next)
+    {
+    if (sameString(pc->key, key))
+	{
+	slRemoveEl(&connPool, pc);
+	sd = pc->sd;
+	freeMem(pc->key);
+	freeMem(pc);
+	break;
+	}
+    }
+pthread_mutex_unlock(&connPoolMutex);
+return sd;
+}
 
-/* finish off the header with final blank line */
-dyStringAppend(dy, "\r\n");
+static void connPoolGive(char *key, int sd)
+/* Put idle connection sd to key in pool, or close it if pool already has enough. */
+{
+pthread_mutex_lock(&connPoolMutex);
+connPoolExpire();
+int count = 0;
+struct netPooledConn *pc;
+for (pc = connPool; pc != NULL; pc = pc->next)
+    if (sameString(pc->key, key))
+	++count;
+if (keepAliveOff || count >= NET_POOL_MAX_PER_HOST)
+    close(sd);
+else
+    {
+    AllocVar(pc);
+    pc->key = cloneString(key);
+    pc->sd = sd;
+    pc->idleSince = time(NULL);
+    pc->pid = getpid();
+    slAddHead(&connPool, pc);
+    }
+pthread_mutex_unlock(&connPoolMutex);
+}
 
-mustWriteFd(sd, dy->string, dy->stringSize);
+static boolean writeAllFd(int fd, char *buf, size_t size)
+/* Write all of buf to fd.  Return FALSE on error. */
+{
+while (size > 0)
+    {
+    ssize_t wt = write(fd, buf, size);
+    if (wt < 0)
+	{
+	if (errno == EINTR)
+	    continue;
+	return FALSE;
+	}
+    buf += wt;
+    size -= wt;
+    }
+return TRUE;
+}
 
+struct netKeepAliveParams
+/* Params for thread that copies one response from a pooled connection to the caller. */
+    {
+    pthread_t thread;
+    char *key;		/* Pool key, protocol://host:port */
+    int sd;		/* Connection to server. */
+    int sv[2];		/* Socket pair. Caller reads sv[0], thread writes sv[1]. */
+    boolean userGone;	/* Set if caller closed sv[0] before end of response. */
+    int bufPos, bufEnd;	/* Unread part of buf. */
+    char buf[32768];	/* Buffered data from server. */
+    };
 
-/* Clean up and return handle. */
+static boolean kaFill(struct netKeepAliveParams *ka)
+/* Make sure there is unread data in buffer.  Return FALSE at end of file or error. */
+{
+if (ka->bufPos < ka->bufEnd)
+    return TRUE;
+ssize_t rd;
+while ((rd = read(ka->sd, ka->buf, sizeof(ka->buf))) < 0 && errno == EINTR)
+    ;
+if (rd <= 0)
+    return FALSE;
+ka->bufPos = 0;
+ka->bufEnd = rd;
+return TRUE;
+}
+
+static boolean kaLine(struct netKeepAliveParams *ka, struct dyString *dy)
+/* Read a line including the newline from server into dy.  Return FALSE if the
+ * connection ends first or the line is unreasonably long. */
+{
+dyStringClear(dy);
+while (kaFill(ka))
+    {
+    char *s = ka->buf + ka->bufPos;
+    int size = ka->bufEnd - ka->bufPos;
+    char *e = memchr(s, '\n', size);
+    if (e != NULL)
+	size = e - s + 1;
+    dyStringAppendN(dy, s, size);
+    ka->bufPos += size;
+    if (e != NULL)
+	return TRUE;
+    if (dy->stringSize > 65536)
+	return FALSE;
+    }
+return FALSE;
+}
+
+static boolean kaCopy(struct netKeepAliveParams *ka, long long size)
+/* Copy size bytes from server to caller, or until end of file if size is -1.
+ * Return FALSE if server connection ends early or caller closes. */
+{
+while (size != 0)
+    {
+    if (!kaFill(ka))
+	return size < 0;
+    long long chunk = ka->bufEnd - ka->bufPos;
+    if (size > 0 && chunk > size)
+	chunk = size;
+    if (!writeAllFd(ka->sv[1], ka->buf + ka->bufPos, chunk))
+	{
+	ka->userGone = TRUE;
+	return FALSE;
+	}
+    ka->bufPos += chunk;
+    if (size > 0)
+	size -= chunk;
+    }
+return TRUE;
+}
+
+static boolean kaCopyChunked(struct netKeepAliveParams *ka, struct dyString *dy)
+/* Copy a body in chunked transfer encoding from server to caller, minus the
+ * chunk sizes and trailers.  Return FALSE if anything goes wrong. */
+{
+for (;;)
+    {
+    if (!kaLine(ka, dy))
+	return FALSE;
+    char *end;
+    long long size = strtoll(dy->string, &end, 16);
+    if (end == dy->string || size < 0)
+	return FALSE;
+    if (size == 0)
+	break;
+    if (!kaCopy(ka, size) || !kaLine(ka, dy))
+	return FALSE;
+    }
+/* Skip trailer lines through the blank line. */
+for (;;)
+    {
+    if (!kaLine(ka, dy))
+	return FALSE;
+    if (dy->string[0] == '\r' || dy->string[0] == '\n')
+	return TRUE;
+    }
+}
+
+static void *netKeepAliveThread(void *threadParams)
+/* Copy one http response from pooled connection to the caller's socket, then put
+ * the connection back in pool if server will take another request on it. */
+{
+struct netKeepAliveParams *ka = threadParams;
+pthread_detach(ka->thread);  // this thread will never join back with it's progenitor
+struct dyString *dy = dyStringNew(256);
+boolean reusable = FALSE;
+if (kaLine(ka, dy) && startsWith("HTTP/", dy->string))
+    {
+    boolean keepAlive = !startsWith("HTTP/1.0", dy->string);
+    char *s = skipToSpaces(dy->string);
+    int status = (s == NULL ? 0 : atoi(s));
+    boolean chunked = FALSE;
+    long long contentLength = -1;
+    boolean ok = writeAllFd(ka->sv[1], dy->string, dy->stringSize);
+    while (ok && (ok = kaLine(ka, dy)))
+	{
+	s = dy->string;
+	if (startsWithNoCase("Transfer-Encoding:", s))
+	    {
+	    /* Caller gets the body without the chunk sizes, so don't pass this on. */
+	    chunked = (containsStringNoCase(s, "chunked") != NULL);
+	    continue;
+	    }
+	if (startsWithNoCase("Content-Length:", s))
+	    contentLength = atoll(s + strlen("Content-Length:"));
+	else if (startsWithNoCase("Connection:", s))
+	    {
+	    if (containsStringNoCase(s, "close"))
+		keepAlive = FALSE;
+	    else if (containsStringNoCase(s, "keep-alive"))
+		keepAlive = TRUE;
+	    }
+	ok = writeAllFd(ka->sv[1], s, dy->stringSize);
+	if (s[0] == '\r' || s[0] == '\n')
+	    break;
+	}
+    if (!ok)
+	ka->userGone = TRUE;
+    else if (status/100 == 1 || status == 204 || status == 304)
+	reusable = keepAlive;
+    else if (chunked)
+	reusable = kaCopyChunked(ka, dy) && keepAlive;
+    else if (contentLength >= 0)
+	reusable = kaCopy(ka, contentLength) && keepAlive;
+    else
+	kaCopy(ka, -1);  // body ends when server closes
+    }
+if (ka->userGone)
+    reusable = FALSE;
+/* Back in pool before caller sees end of file, so caller's next request can use it. */
+if (reusable && ka->bufPos == ka->bufEnd)
+    connPoolGive(ka->key, ka->sd);
+else
+    close(ka->sd);
+close(ka->sv[1]);
 dyStringFree(&dy);
-return sd;
+freeMem(ka->key);
+freeMem(ka);
+return NULL;
 }
 
+static boolean responseStarted(int sd)
+/* Wait for server to start responding on sd.  Return FALSE if it closes instead,
+ * which happens when a pooled connection timed out on the server side. */
+{
+char c;
+ssize_t rd;
+while ((rd = recv(sd, &c, 1, MSG_PEEK)) < 0 && errno == EINTR)
+    ;
+return rd > 0;
+}
+
+static int netKeepAliveGet(char *url, char *optionalHeader)
+/* Send a GET for url on a pooled connection if there is one, or on a new connection
+ * that will go in the pool afterwards.  Return descriptor that reads the response
+ * and then hits end of file, or -1 if error. */
+{
+struct netParsedUrl npu;
+netParseUrl(url, &npu);
+char key[1024];
+safef(key, sizeof key, "%s://%s:%s", npu.protocol, npu.host, npu.port);
+struct dyString *dy = dyStringNew(512);
+netHttpRequestHeader(dy, url, &npu, NULL, "GET", "HTTP/1.1", "genome.ucsc.edu/net.c",
+    optionalHeader);
+dyStringAppend(dy, "Connection: keep-alive\r\n\r\n");
+netBlockBrokenPipes();
+int sd;
+while ((sd = connPoolTake(key)) >= 0)
+    {
+    if (writeAllFd(sd, dy->string, dy->stringSize) && responseStarted(sd))
+	break;
+    close(sd);
+    }
+if (sd < 0)
+    {
+    sd = connectNpu(npu, url, checkNoProxy(npu.host), "HTTP/1.1");
+    if (sd < 0)
+	{
+	dyStringFree(&dy);
+	return -1;
+	}
+    mustWriteFd(sd, dy->string, dy->stringSize);
+    }
+dyStringFree(&dy);
+
+struct netKeepAliveParams *ka;
+AllocVar(ka);
+ka->key = cloneString(key);
+ka->sd = sd;
+if (socketpair(AF_UNIX, SOCK_STREAM, 0, ka->sv) < 0)
+    errnoAbort("netKeepAliveGet: socketpair failed");
+int rc = pthread_create(&ka->thread, NULL, netKeepAliveThread, ka);
+if (rc)
+    errAbort("Unexpected error %d from pthread_create(): %s", rc, strerror(rc));
+return ka->sv[0];
+}
+
+static boolean useKeepAlive(char *url)
+/* Return TRUE if GETs of url can go through the keep-alive pool. */
+{
+if (keepAliveOff)
+    return FALSE;
+if (startsWith("https://", url))
+    return TRUE;
+if (!startsWith("http://", url))
+    return FALSE;
+if (getenv("http_proxy") == NULL)
+    return TRUE;
+struct netParsedUrl npu;
+netParseUrl(url, &npu);
+return checkNoProxy(npu.host);
+}
 
 int netOpenHttpExt(char *url, char *method, char *optionalHeader)
 /* Return a file handle that will read the url.  optionalHeader
- * may by NULL or may contain cookies and other info.  */
+ * may by NULL or may contain cookies and other info.  GETs reuse
+ * pooled keep-alive connections. */
 {
+if (sameString(method, "GET") && useKeepAlive(url))
+    return netKeepAliveGet(url, optionalHeader);
 return netHttpConnect(url, method, "HTTP/1.0", "genome.ucsc.edu/net.c", optionalHeader);
 }
 
@@ -0,0 +1,378 @@
+/* numText - fast conversion of numbers to and from text.
+ *
+ * This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+
+#include "common.h"
+#include <float.h>
+#include "numText.h"
+
+static const double exactPowersOfTen[] =
+/* Powers of ten that are exactly representable as doubles. */
+    {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+#define MAX_EXACT_POWER 22
+
+static const unsigned long long intPowersOfTen[] =
+/* Powers of ten that fit in 64 bits. */
+    {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL,
+    1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+    1000000000000000ULL, 10000000000000000ULL,
+    };
+
+static const char digitPairs[] =
+/* Two digit decimal representation of 0 to 99. */
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+#define MAX_EXACT_MANTISSA (1ULL<<53)	/* Integers up to this are exact doubles. */
+#define MAX_PARSE_DIGITS 19		/* Significant digits that fit in 64 bits. */
+#define MAX_FAST_PREC 15		/* Precision we can round exactly in a double. */
+
+double numTextParseDouble(char *s, char **retEnd)
+/* Convert decimal number at start of s to a double, and put where number ends
+ * in *retEnd if it is non-NULL.  Same syntax and results as strtod, which this
+ * falls back on for hex, inf, nan, leading space and very long or extreme
+ * numbers.  If there is no number at s, *retEnd is set to s. */
+{
+char *p = s;
+boolean isNeg = FALSE;
+if (*p == '-')
+    {
+    isNeg = TRUE;
+    ++p;
+    }
+else if (*p == '+')
+    ++p;
+if (p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+    return strtod(s, retEnd);
+
+/* Gather up to MAX_PARSE_DIGITS significant digits as an integer mantissa and
+ * keep track of the power of ten it is to be multiplied by. */
+unsigned long long mantissa = 0;
+int sigDigits = 0, exp10 = 0;
+boolean gotDigits = FALSE, truncated = FALSE;
+for (; isdigit(*p); ++p)
+    {
+    gotDigits = TRUE;
+    if (sigDigits < MAX_PARSE_DIGITS)
+	{
+	mantissa = mantissa*10 + (*p - '0');
+	if (mantissa != 0)
+	    ++sigDigits;
+	}
+    else
+	{
+	++exp10;
+	if (*p != '0')
+	    truncated = TRUE;
+	}
+    }
+if (*p == '.')
+    {
+    for (++p; isdigit(*p); ++p)
+	{
+	gotDigits = TRUE;
+	if (sigDigits < MAX_PARSE_DIGITS)
+	    {
+	    mantissa = mantissa*10 + (*p - '0');
+	    --exp10;
+	    if (mantissa != 0)
+		++sigDigits;
+	    }
+	else if (*p != '0')
+	    truncated = TRUE;
+	}
+    }
+if (!gotDigits || truncated)
+    return strtod(s, retEnd);
+
+/* Optional exponent, which like strtod we ignore if it has no digits. */
+if (*p == 'e' || *p == 'E')
+    {
+    char *e = p + 1;
+    boolean expNeg = FALSE;
+    if (*e == '-')
+	{
+	expNeg = TRUE;
+	++e;
+	}
+    else if (*e == '+')
+	++e;
+    if (isdigit(*e))
+	{
+	int x = 0;
+	for (; isdigit(*e); ++e)
+	    if (x < 100000)
+		x = x*10 + (*e - '0');
+	exp10 += (expNeg ? -x : x);
+	p = e;
+	}
+    }
+
+/* When both the mantissa and the power of ten are exact doubles a single
+ * multiply or divide gives the correctly rounded result. */
+double val;
+if (mantissa == 0)
+    val = 0.0;
+else if (mantissa > MAX_EXACT_MANTISSA)
+    return strtod(s, retEnd);
+else if (exp10 < 0 && exp10 >= -MAX_EXACT_POWER)
+    val = (double)mantissa / exactPowersOfTen[-exp10];
+else if (exp10 >= 0 && exp10 <= MAX_EXACT_POWER)
+    val = (double)mantissa * exactPowersOfTen[exp10];
+else if (exp10 > MAX_EXACT_POWER && exp10 - MAX_EXACT_POWER < ArraySize(intPowersOfTen)
+	&& mantissa <= MAX_EXACT_MANTISSA / intPowersOfTen[exp10 - MAX_EXACT_POWER])
+    {
+    /* Something like 12e25 - move the excess power into the mantissa. */
+    mantissa *= intPowersOfTen[exp10 - MAX_EXACT_POWER];
+    val = (double)mantissa * exactPowersOfTen[MAX_EXACT_POWER];
+    }
+else
+    return strtod(s, retEnd);
+if (retEnd != NULL)
+    *retEnd = p;
+return (isNeg ? -val : val);
+}
+
+static char *digitsBefore(unsigned long long x, char *end)
+/* Write x in decimal so that it ends just before end, and return where it starts. */
+{
+char *p = end;
+while (x >= 100)
+    {
+    int i = (x % 100) * 2;
+    x /= 100;
+    p -= 2;
+    p[0] = digitPairs[i];
+    p[1] = digitPairs[i+1];
+    }
+if (x >= 10)
+    {
+    p -= 2;
+    p[0] = digitPairs[x*2];
+    p[1] = digitPairs[x*2+1];
+    }
+else
+    *(--p) = '0' + x;
+return p;
+}
+
+int numTextUnsigned(char *buf, unsigned long long x)
+/* Write x in decimal to buf as printf %llu would. Return length. */
+{
+char tmp[NUM_TEXT_MAX_SIZE], *end = tmp + sizeof(tmp);
+char *s = digitsBefore(x, end);
+int len = end - s;
+memcpy(buf, s, len);
+buf[len] = 0;
+return len;
+}
+
+int numTextSigned(char *buf, long long x)
+/* Write x in decimal to buf as printf %lld would. Return length. */
+{
+if (x >= 0)
+    return numTextUnsigned(buf, x);
+buf[0] = '-';
+return 1 + numTextUnsigned(buf+1, -(unsigned long long)x);
+}
+
+static boolean roundToDigits(double ax, int prec, unsigned long long *retDigits, int *retExp)
+/* Round positive ax to prec significant digits.  Put the digits as an integer in
+ * *retDigits and the decimal exponent of the first digit in *retExp.  Returns FALSE
+ * if ax is out of range of the exact powers of ten or is too close to halfway
+ * between two roundings to decide with one rounding error in hand. */
+{
+int binExp;
+frexp(ax, &binExp);
+int exp10 = (int)floor((binExp - 1) * 0.30102999566398120);	/* May be one low. */
+int shift = prec - 1 - exp10;
+double scaled = 0, lowLim = exactPowersOfTen[prec-1], highLim = exactPowersOfTen[prec];
+int i;
+for (i=0; i<2; ++i)
+    {
+    if (shift > MAX_EXACT_POWER || shift < -MAX_EXACT_POWER)
+	return FALSE;
+    if (shift >= 0)
+	scaled = ax * exactPowersOfTen[shift];
+    else
+	scaled = ax / exactPowersOfTen[-shift];
+    if (scaled < highLim)
+	break;
+    ++exp10;
+    --shift;
+    }
+if (scaled >= highLim || scaled < lowLim * 0.5)
+    return FALSE;
+
+/* scaled is within half a unit in the last place of the true product, so unless
+ * the fraction is within that of one half we know which way the true value rounds. */
+double whole = floor(scaled);
+double frac = scaled - whole;
+double slop = scaled * 4.5e-16;
+if (fabs(frac - 0.5) <= slop)
+    return FALSE;
+unsigned long long digits = (unsigned long long)whole + (frac > 0.5);
+if (digits >= intPowersOfTen[prec])
+    {
+    digits /= 10;
+    ++exp10;
+    }
+if (digits < intPowersOfTen[prec-1])
+    return FALSE;
+*retDigits = digits;
+*retExp = exp10;
+return TRUE;
+}
+
+static int formatG(char *buf, unsigned long long digits, int exp10, int prec)
+/* Write prec digits with first digit at exp10 in printf %g style, without trailing
+ * zeros. Return length. */
+{
+char digitBuf[NUM_TEXT_MAX_SIZE];
+digitsBefore(digits, digitBuf + prec);
+int last = prec - 1;	/* Index of last digit we need to write. */
+while (last > 0 && digitBuf[last] == '0')
+    --last;
+char *p = buf;
+if (exp10 < -4 || exp10 >= prec)
+    {
+    *p++ = digitBuf[0];
+    if (last > 0)
+	{
+	*p++ = '.';
+	memcpy(p, digitBuf+1, last);
+	p += last;
+	}
+    *p++ = 'e';
+    int absExp = exp10;
+    if (exp10 < 0)
+	{
+	*p++ = '-';
+	absExp = -exp10;
+	}
+    else
+	*p++ = '+';
+    if (absExp < 10)
+	*p++ = '0';
+    p += numTextUnsigned(p, absExp);
+    }
+else if (exp10 >= 0)
+    {
+    memcpy(p, digitBuf, exp10+1);
+    p += exp10+1;
+    if (last > exp10)
+	{
+	*p++ = '.';
+	memcpy(p, digitBuf+exp10+1, last-exp10);
+	p += last-exp10;
+	}
+    }
+else
+    {
+    *p++ = '0';
+    *p++ = '.';
+    int i;
+    for (i = -1; i > exp10; --i)
+	*p++ = '0';
+    memcpy(p, digitBuf, last+1);
+    p += last+1;
+    }
+*p = 0;
+return p - buf;
+}
+
+int numTextDoublePrec(char *buf, double x, int prec)
+/* Write x to buf as printf %.*g would with precision prec. Return length. */
+{
+if (prec < 1)
+    prec = 1;
+if (prec > 17)
+    errAbort("numTextDoublePrec: precision %d too large", prec);
+if (x == 0)
+    {
+    if (signbit(x))
+	return safef(buf, NUM_TEXT_MAX_SIZE, "-0");
+    return safef(buf, NUM_TEXT_MAX_SIZE, "0");
+    }
+unsigned long long digits;
+int exp10;
+double ax = fabs(x);
+if (prec <= MAX_FAST_PREC && isfinite(ax) && roundToDigits(ax, prec, &digits, &exp10))
+    {
+    if (x < 0)
+	{
+	buf[0] = '-';
+	return 1 + formatG(buf+1, digits, exp10, prec);
+	}
+    return formatG(buf, digits, exp10, prec);
+    }
+return safef(buf, NUM_TEXT_MAX_SIZE, "%.*g", prec, x);
+}
+
+int numTextDoubleShortest(char *buf, double x)
+/* Write the shortest decimal that reads back as exactly x to buf, in %g style.
+ * Return length. */
+{
+/* Any normal double that has a representation of 15 or fewer digits is within
+ * rounding distance of it at 15 digits, and trailing zeros are dropped, so only the
+ * doubles that need more have to be tried again.  Subnormals have less precision
+ * so need to start from the beginning. */
+int prec = (fabs(x) < DBL_MIN ? 1 : MAX_FAST_PREC);
+for (; prec < 17; ++prec)
+    {
+    int len = numTextDoublePrec(buf, x, prec);
+    if (numTextParseDouble(buf, NULL) == x)
+	return len;
+    }
+return numTextDoublePrec(buf, x, 17);
+}
+
+int numTextFloatShortest(char *buf, float x)
+/* Write the shortest decimal that reads back as exactly x when converted to float
+ * to buf, in %g style.  Return length. */
+{
+int prec;
+for (prec = 1; prec < 9; ++prec)
+    {
+    int len = numTextDoublePrec(buf, x, prec);
+    if ((float)numTextParseDouble(buf, NULL) == x)
+	return len;
+    }
+return numTextDoublePrec(buf, x, 9);
+}
+
+void numTextWriteUnsigned(FILE *f, unsigned long long x)
+/* Write x to file as fprintf %u would. */
+{
+char tmp[NUM_TEXT_MAX_SIZE], *end = tmp + sizeof(tmp);
+char *s = digitsBefore(x, end);
+fwrite(s, 1, end - s, f);
+}
+
+void numTextWriteSigned(FILE *f, long long x)
+/* Write x to file as fprintf %d would. */
+{
+if (x < 0)
+    {
+    fputc('-', f);
+    numTextWriteUnsigned(f, -(unsigned long long)x);
+    }
+else
+    numTextWriteUnsigned(f, x);
+}
+
+void numTextWriteDouble(FILE *f, double x)
+/* Write x to file as fprintf %g would. */
+{
+char buf[NUM_TEXT_MAX_SIZE];
+fwrite(buf, 1, numTextDouble(buf, x), f);
+}
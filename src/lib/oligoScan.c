@@ -0,0 +1,535 @@
+/* oligoScan - find all occurrences of many DNA oligos, which may contain IUPAC
+ * ambiguity codes, on both strands in a single pass over the target sequence.
+ *
+ * Each pattern (and its reverse complement) is turned into an array of base masks,
+ * one bit for each of A, C, G, T and "other" target characters.  Patterns that
+ * expand to at most maxAcExpansion plain sequences are put into a dense Aho-Corasick
+ * automaton with four transitions per node; anything outside ACGT in the target just
+ * returns the automaton to its root.  The remaining patterns are laid end to end in
+ * a bit vector and matched with the Shift-And algorithm, which handles any amount of
+ * degeneracy at a cost proportional to the total pattern length. */
+
+/* This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+
+#include "common.h"
+#include "localmem.h"
+#include "iupac.h"
+#include "oligoScan.h"
+
+/* Patterns that expand to more than this many plain sequences go into the
+ * Shift-And bank rather than the Aho-Corasick automaton. */
+static int maxAcExpansion = 16;
+
+#define otherCode 4	/* Code for target characters that are not A, C, G or T. */
+
+struct oligoScanPat
+/* A pattern on one strand. */
+    {
+    int patIx;		/* Index of caller's pattern. */
+    char strand;	/* '+' or '-' */
+    int size;		/* Size of pattern. */
+    };
+
+struct oligoScanAc
+/* Aho-Corasick automaton over the four bases. */
+    {
+    int nodeCount;	/* Number of nodes, including root at 0. */
+    int nodeAlloc;	/* Allocated size of node arrays. */
+    int *trans;		/* Four transitions per node, -1 for none until built. */
+    int *fail;		/* Failure link for each node. */
+    int *nodeOut;	/* First output of node in out arrays or -1. */
+    int *dictLink;	/* Nearest node along failure chain that has outputs, 0 for none. */
+    int outCount;	/* Number of outputs. */
+    int outAlloc;	/* Allocated size of out arrays. */
+    int *outNext;	/* Next output of same node or -1. */
+    int *outPat;	/* Index into strandPats of output. */
+    };
+
+struct oligoScanBits
+/* Shift-And matcher for highly degenerate patterns. */
+    {
+    int pendCount;	/* Number of patterns added. */
+    int pendAlloc;	/* Allocated size of pend arrays. */
+    int *pendPat;	/* Index into strandPats of each pattern. */
+    unsigned char **pendMasks;	/* Base masks of each pattern. */
+    int bitCount;	/* Total bits of all patterns. */
+    int wordCount;	/* Number of 64 bit words to hold bitCount. */
+    bits64 *masks[otherCode+1];	/* Bits set where pattern accepts a base code. */
+    bits64 *initBits;	/* Bits set at first base of each pattern. */
+    bits64 *finalBits;	/* Bits set at last base of each pattern. */
+    int *finalPat;	/* Index into strandPats of pattern ending at each bit. */
+    };
+
+static unsigned char codeAny[256], codeUpper[256];
+static boolean codesInitialized = FALSE;
+
+static void initCodes()
+/* Initialize tables mapping target characters to base codes. */
+{
+if (codesInitialized)
+    return;
+int i;
+for (i=0; i<256; ++i)
+    codeAny[i] = codeUpper[i] = otherCode;
+codeAny['a'] = codeAny['A'] = codeUpper['A'] = 0;
+codeAny['c'] = codeAny['C'] = codeUpper['C'] = 1;
+codeAny['g'] = codeAny['G'] = codeUpper['G'] = 2;
+codeAny['t'] = codeAny['T'] = codeUpper['T'] = 3;
+codeAny['u'] = codeAny['U'] = codeUpper['U'] = 3;
+codesInitialized = TRUE;
+}
+
+static unsigned char iupacMask(char iupac, boolean nMatchesAny)
+/* Return bit mask of base codes matched by lower case iupac character. */
+{
+switch (iupac)
+    {
+    case 'a': return 0x1;
+    case 'c': return 0x2;
+    case 'g': return 0x4;
+    case 't':
+    case 'u': return 0x8;
+    case 'r': return 0x1|0x4;
+    case 'y': return 0x2|0x8;
+    case 's': return 0x2|0x4;
+    case 'w': return 0x1|0x8;
+    case 'k': return 0x4|0x8;
+    case 'm': return 0x1|0x2;
+    case 'b': return 0x2|0x4|0x8;
+    case 'd': return 0x1|0x4|0x8;
+    case 'h': return 0x1|0x2|0x8;
+    case 'v': return 0x1|0x2|0x4;
+    case 'n': return (nMatchesAny ? 0x1F : 0xF);
+    default:
+	errAbort("Unrecognized IUPAC code '%c' in oligoScan pattern", iupac);
+	return 0;
+    }
+}
+
+static int acNewNode(struct oligoScanAc *ac)
+/* Add a node to automaton and return its index. */
+{
+if (ac->nodeCount >= ac->nodeAlloc)
+    {
+    int newAlloc = 2*ac->nodeAlloc;
+    ac->trans = needLargeMemResize(ac->trans, 4*newAlloc*sizeof(int));
+    ExpandArray(ac->fail, ac->nodeAlloc, newAlloc);
+    ExpandArray(ac->nodeOut, ac->nodeAlloc, newAlloc);
+    ExpandArray(ac->dictLink, ac->nodeAlloc, newAlloc);
+    ac->nodeAlloc = newAlloc;
+    }
+int node = ac->nodeCount++;
+int *trans = ac->trans + 4*node;
+trans[0] = trans[1] = trans[2] = trans[3] = -1;
+ac->nodeOut[node] = -1;
+return node;
+}
+
+static struct oligoScanAc *acNew()
+/* Return automaton with just a root node. */
+{
+struct oligoScanAc *ac;
+AllocVar(ac);
+ac->nodeAlloc = 256;
+AllocArray(ac->trans, 4*ac->nodeAlloc);
+AllocArray(ac->fail, ac->nodeAlloc);
+AllocArray(ac->nodeOut, ac->nodeAlloc);
+AllocArray(ac->dictLink, ac->nodeAlloc);
+ac->outAlloc = 64;
+AllocArray(ac->outNext, ac->outAlloc);
+AllocArray(ac->outPat, ac->outAlloc);
+acNewNode(ac);
+return ac;
+}
+
+static void acFree(struct oligoScanAc **pAc)
+/* Free up automaton. */
+{
+struct oligoScanAc *ac = *pAc;
+if (ac != NULL)
+    {
+    freeMem(ac->trans);
+    freeMem(ac->fail);
+    freeMem(ac->nodeOut);
+    freeMem(ac->dictLink);
+    freeMem(ac->outNext);
+    freeMem(ac->outPat);
+    freez(pAc);
+    }
+}
+
+static void acAddOutput(struct oligoScanAc *ac, int node, int strandPatIx)
+/* Record that pattern ends at node. */
+{
+if (ac->outCount >= ac->outAlloc)
+    {
+    int newAlloc = 2*ac->outAlloc;
+    ExpandArray(ac->outNext, ac->outAlloc, newAlloc);
+    ExpandArray(ac->outPat, ac->outAlloc, newAlloc);
+    ac->outAlloc = newAlloc;
+    }
+int out = ac->outCount++;
+ac->outPat[out] = strandPatIx;
+ac->outNext[out] = ac->nodeOut[node];
+ac->nodeOut[node] = out;
+}
+
+static void acAddExpanded(struct oligoScanAc *ac, unsigned char *masks, int size, int pos,
+	int node, int strandPatIx)
+/* Add all plain sequences matched by masks[pos..size) to automaton below node. */
+{
+if (pos == size)
+    {
+    acAddOutput(ac, node, strandPatIx);
+    return;
+    }
+int code;
+for (code = 0; code < 4; ++code)
+    {
+    if (masks[pos] & (1<<code))
+	{
+	int child = ac->trans[4*node + code];
+	if (child < 0)
+	    {
+	    child = acNewNode(ac);
+	    ac->trans[4*node + code] = child;
+	    }
+	acAddExpanded(ac, masks, size, pos+1, child, strandPatIx);
+	}
+    }
+}
+
+static void acBuild(struct oligoScanAc *ac)
+/* Compute failure and dictionary links breadth first, and fill in missing transitions
+ * so that scanning needs just one table lookup per base. */
+{
+int *queue = needLargeMem(ac->nodeCount * sizeof(int));
+int head = 0, tail = 0;
+queue[tail++] = 0;
+ac->fail[0] = ac->dictLink[0] = 0;
+while (head < tail)
+    {
+    int node = queue[head++];
+    int fail = ac->fail[node];
+    int code;
+    for (code = 0; code < 4; ++code)
+	{
+	int *pChild = &ac->trans[4*node + code];
+	if (*pChild < 0)
+	    *pChild = (node == 0 ? 0 : ac->trans[4*fail + code]);
+	else
+	    {
+	    int child = *pChild;
+	    int childFail = (node == 0 ? 0 : ac->trans[4*fail + code]);
+	    ac->fail[child] = childFail;
+	    ac->dictLink[child] = (ac->nodeOut[childFail] >= 0 ? childFail
+	    						      : ac->dictLink[childFail]);
+	    queue[tail++] = child;
+	    }
+	}
+    }
+freeMem(queue);
+}
+
+static void bitsAdd(struct oligoScanBits *bits, unsigned char *masks, int size, int strandPatIx)
+/* Save pattern to be put in Shift-And bank when scanner is built. */
+{
+if (bits->pendCount >= bits->pendAlloc)
+    {
+    int newAlloc = (bits->pendAlloc == 0 ? 16 : 2*bits->pendAlloc);
+    ExpandArray(bits->pendPat, bits->pendAlloc, newAlloc);
+    ExpandArray(bits->pendMasks, bits->pendAlloc, newAlloc);
+    bits->pendAlloc = newAlloc;
+    }
+bits->pendPat[bits->pendCount] = strandPatIx;
+bits->pendMasks[bits->pendCount] = cloneMem(masks, size);
+bits->pendCount += 1;
+bits->bitCount += size;
+}
+
+static void bitsBuild(struct oligoScanBits *bits, struct oligoScanPat *strandPats)
+/* Lay out pending patterns end to end in bit vectors. */
+{
+int wordCount = bits->wordCount = (bits->bitCount + 63)/64;
+int code, i;
+for (code = 0; code <= otherCode; ++code)
+    AllocArray(bits->masks[code], wordCount);
+AllocArray(bits->initBits, wordCount);
+AllocArray(bits->finalBits, wordCount);
+AllocArray(bits->finalPat, wordCount*64);
+int bit = 0;
+for (i=0; i<bits->pendCount; ++i)
+    {
+    int strandPatIx = bits->pendPat[i];
+    unsigned char *masks = bits->pendMasks[i];
+    int size = strandPats[strandPatIx].size;
+    int j;
+    bits->initBits[bit>>6] |= (1ULL << (bit&63));
+    for (j=0; j<size; ++j, ++bit)
+	{
+	for (code = 0; code <= otherCode; ++code)
+	    if (masks[j] & (1<<code))
+		bits->masks[code][bit>>6] |= (1ULL << (bit&63));
+	}
+    int last = bit - 1;
+    bits->finalBits[last>>6] |= (1ULL << (last&63));
+    bits->finalPat[last] = strandPatIx;
+    freez(&bits->pendMasks[i]);
+    }
+}
+
+static void bitsFree(struct oligoScanBits **pBits)
+/* Free up Shift-And bank. */
+{
+struct oligoScanBits *bits = *pBits;
+if (bits != NULL)
+    {
+    int i;
+    for (i=0; i<bits->pendCount; ++i)
+	freeMem(bits->pendMasks[i]);
+    freeMem(bits->pendMasks);
+    freeMem(bits->pendPat);
+    for (i=0; i<=otherCode; ++i)
+	freeMem(bits->masks[i]);
+    freeMem(bits->initBits);
+    freeMem(bits->finalBits);
+    freeMem(bits->finalPat);
+    freez(pBits);
+    }
+}
+
+struct oligoScanner *oligoScannerNew(boolean nMatchesAny, boolean upperOnly)
+/* Return a new empty scanner.  If nMatchesAny is TRUE, N in a pattern matches any
+ * character in the target (as in iupacMatch), otherwise only A, C, G or T.  If upperOnly
+ * is TRUE then lower case (soft-masked) target bases never match. */
+{
+struct oligoScanner *os;
+initCodes();
+AllocVar(os);
+os->nMatchesAny = nMatchesAny;
+os->upperOnly = upperOnly;
+return os;
+}
+
+void oligoScannerFree(struct oligoScanner **pOs)
+/* Free up a scanner. */
+{
+struct oligoScanner *os = *pOs;
+if (os != NULL)
+    {
+    freeMem(os->patVals);
+    freeMem(os->strandPats);
+    acFree(&os->ac);
+    bitsFree(&os->bits);
+    freez(pOs);
+    }
+}
+
+static void addStrandPat(struct oligoScanner *os, int patIx, char strand, char *iupac, int size)
+/* Add lower case iupac pattern for one strand to automaton or Shift-And bank. */
+{
+if (os->strandPatCount >= os->strandPatAlloc)
+    {
+    int newAlloc = (os->strandPatAlloc == 0 ? 16 : 2*os->strandPatAlloc);
+    ExpandArray(os->strandPats, os->strandPatAlloc, newAlloc);
+    os->strandPatAlloc = newAlloc;
+    }
+int strandPatIx = os->strandPatCount++;
+struct oligoScanPat *sp = &os->strandPats[strandPatIx];
+sp->patIx = patIx;
+sp->strand = strand;
+sp->size = size;
+
+unsigned char masks[size];
+boolean needBits = FALSE;
+double expansion = 1;
+int i;
+for (i=0; i<size; ++i)
+    {
+    masks[i] = iupacMask(iupac[i], os->nMatchesAny);
+    if (masks[i] & (1<<otherCode))
+	needBits = TRUE;
+    int code, baseCount = 0;
+    for (code = 0; code < 4; ++code)
+	if (masks[i] & (1<<code))
+	    ++baseCount;
+    expansion *= baseCount;
+    }
+if (needBits || expansion > maxAcExpansion)
+    {
+    if (os->bits == NULL)
+	AllocVar(os->bits);
+    bitsAdd(os->bits, masks, size, strandPatIx);
+    }
+else
+    {
+    if (os->ac == NULL)
+	os->ac = acNew();
+    acAddExpanded(os->ac, masks, size, 0, 0, strandPatIx);
+    }
+}
+
+int oligoScannerAdd(struct oligoScanner *os, char *pattern, boolean bothStrands, void *val)
+/* Add a DNA pattern, which may contain IUPAC codes, to scanner, and return its index.
+ * If bothStrands is set, the reverse complement is searched for as well, unless it is
+ * the same as the pattern itself.  Must be called before any scan. */
+{
+if (os->built)
+    errAbort("oligoScannerAdd: can't add patterns after scanning has started");
+int size = strlen(pattern);
+if (size == 0)
+    errAbort("oligoScannerAdd: empty pattern");
+if (os->patCount >= os->patAlloc)
+    {
+    int newAlloc = (os->patAlloc == 0 ? 16 : 2*os->patAlloc);
+    ExpandArray(os->patVals, os->patAlloc, newAlloc);
+    os->patAlloc = newAlloc;
+    }
+int patIx = os->patCount++;
+os->patVals[patIx] = val;
+char *fwd = cloneString(pattern);
+tolowers(fwd);
+addStrandPat(os, patIx, '+', fwd, size);
+if (bothStrands)
+    {
+    char *rev = cloneString(fwd);
+    iupacReverseComplement(rev, size);
+    if (!sameString(rev, fwd))
+	addStrandPat(os, patIx, '-', rev, size);
+    freeMem(rev);
+    }
+freeMem(fwd);
+return patIx;
+}
+
+static void oligoScannerBuild(struct oligoScanner *os)
+/* Finish building automaton and Shift-And bank if not done already. */
+{
+if (!os->built)
+    {
+    if (os->ac != NULL)
+	acBuild(os->ac);
+    if (os->bits != NULL)
+	bitsBuild(os->bits, os->strandPats);
+    os->built = TRUE;
+    }
+}
+
+INLINE void reportHit(struct oligoScanner *os, int strandPatIx, int end,
+	oligoScanHitFunc hitFunc, void *context)
+/* Pass hit of strandPat ending at end to hitFunc. */
+{
+struct oligoScanPat *sp = &os->strandPats[strandPatIx];
+hitFunc(context, sp->patIx, os->patVals[sp->patIx], sp->strand, end - sp->size, end);
+}
+
+void oligoScanDna(struct oligoScanner *os, char *dna, int size,
+	oligoScanHitFunc hitFunc, void *context)
+/* Scan dna once, calling hitFunc on each match of any pattern on either strand.  Hits
+ * are reported in order of their end position. */
+{
+oligoScannerBuild(os);
+unsigned char *codes = (os->upperOnly ? codeUpper : codeAny);
+struct oligoScanAc *ac = os->ac;
+struct oligoScanBits *bits = os->bits;
+int *trans = NULL, *nodeOut = NULL, *dictLink = NULL, *outNext = NULL, *outPat = NULL;
+if (ac != NULL)
+    {
+    trans = ac->trans;
+    nodeOut = ac->nodeOut;
+    dictLink = ac->dictLink;
+    outNext = ac->outNext;
+    outPat = ac->outPat;
+    }
+int wordCount = 0;
+bits64 *state = NULL;
+if (bits != NULL)
+    {
+    wordCount = bits->wordCount;
+    AllocArray(state, wordCount);
+    }
+int node = 0;
+int i;
+for (i=0; i<size; ++i)
+    {
+    int code = codes[(unsigned char)dna[i]];
+    if (ac != NULL)
+	{
+	node = (code < otherCode ? trans[4*node + code] : 0);
+	int outNode = (nodeOut[node] >= 0 ? node : dictLink[node]);
+	for (; outNode > 0; outNode = dictLink[outNode])
+	    {
+	    int out;
+	    for (out = nodeOut[outNode]; out >= 0; out = outNext[out])
+		reportHit(os, outPat[out], i+1, hitFunc, context);
+	    }
+	}
+    if (bits != NULL)
+	{
+	bits64 *masks = bits->masks[code], *initBits = bits->initBits;
+	bits64 *finalBits = bits->finalBits;
+	bits64 carry = 0;
+	int w;
+	for (w=0; w<wordCount; ++w)
+	    {
+	    bits64 old = state[w];
+	    bits64 cur = ((old << 1) | carry | initBits[w]) & masks[w];
+	    state[w] = cur;
+	    carry = old >> 63;
+	    bits64 hits = cur & finalBits[w];
+	    while (hits)
+		{
+		int bit = __builtin_ctzll(hits);
+		reportHit(os, bits->finalPat[w*64 + bit], i+1, hitFunc, context);
+		hits &= hits - 1;
+		}
+	    }
+	}
+    }
+freeMem(state);
+}
+
+struct hitCollector
+/* Context for collecting hits into a list. */
+    {
+    struct lm *lm;		/* Where to allocate hits. */
+    struct oligoHit *list;	/* Hits collected so far. */
+    };
+
+static void collectHit(void *context, int patIx, void *patVal, char strand, int start, int end)
+/* Add hit to list in collector. */
+{
+struct hitCollector *hc = context;
+struct oligoHit *hit;
+lmAllocVar(hc->lm, hit);
+hit->patIx = patIx;
+hit->patVal = patVal;
+hit->strand = strand;
+hit->start = start;
+hit->end = end;
+slAddHead(&hc->list, hit);
+}
+
+int oligoHitCmp(const void *va, const void *vb)
+/* Compare oligoHits to sort by start, strand ('+' first), then pattern index. */
+{
+const struct oligoHit *a = *((struct oligoHit **)va);
+const struct oligoHit *b = *((struct oligoHit **)vb);
+int dif = a->start - b->start;
+if (dif == 0)
+    dif = a->strand - b->strand;
+if (dif == 0)
+    dif = a->patIx - b->patIx;
+return dif;
+}
+
+struct oligoHit *oligoScanHits(struct oligoScanner *os, char *dna, int size, struct lm *lm)
+/* Return list of all hits of patterns in dna, allocated in lm, and sorted by start,
+ * then strand, then pattern index. */
+{
+struct hitCollector hc = {lm, NULL};
+oligoScanDna(os, dna, size, collectHit, &hc);
+slSort(&hc.list, oligoHitCmp);
+return hc.list;
+}
@@ -7,6 +7,7 @@
 
 #include "common.h"
 #include "sqlNum.h"
+#include "numText.h"
 #include "sqlList.h"
 #include "localmem.h"
 #include "psl.h"
@@ -258,21 +259,21 @@ void pslOutput(struct psl *el, FILE *f, char sep, char lastSep)
 /* Print out psl.  Separate fields with sep. Follow last field with lastSep. */
 {
 int i;
-fprintf(f, "%u", el->match);
+numTextWriteUnsigned(f, el->match);
 fputc(sep,f);
-fprintf(f, "%u", el->misMatch);
+numTextWriteUnsigned(f, el->misMatch);
 fputc(sep,f);
-fprintf(f, "%u", el->repMatch);
+numTextWriteUnsigned(f, el->repMatch);
 fputc(sep,f);
-fprintf(f, "%u", el->nCount);
+numTextWriteUnsigned(f, el->nCount);
 fputc(sep,f);
-fprintf(f, "%u", el->qNumInsert);
+numTextWriteUnsigned(f, el->qNumInsert);
 fputc(sep,f);
-fprintf(f, "%d", el->qBaseInsert);
+numTextWriteSigned(f, el->qBaseInsert);
 fputc(sep,f);
-fprintf(f, "%u", el->tNumInsert);
+numTextWriteUnsigned(f, el->tNumInsert);
 fputc(sep,f);
-fprintf(f, "%d", el->tBaseInsert);
+numTextWriteSigned(f, el->tBaseInsert);
 fputc(sep,f);
 if (sep == ',') fputc('"',f);
 fprintf(f, "%s", el->strand);
@@ -282,28 +283,28 @@ if (sep == ',') fputc('"',f);
 fprintf(f, "%s", el->qName);
 if (sep == ',') fputc('"',f);
 fputc(sep,f);
-fprintf(f, "%u", el->qSize);
+numTextWriteUnsigned(f, el->qSize);
 fputc(sep,f);
-fprintf(f, "%u", el->qStart);
+numTextWriteUnsigned(f, (unsigned)el->qStart);
 fputc(sep,f);
-fprintf(f, "%u", el->qEnd);
+numTextWriteUnsigned(f, (unsigned)el->qEnd);
 fputc(sep,f);
 if (sep == ',') fputc('"',f);
 fprintf(f, "%s", el->tName);
 if (sep == ',') fputc('"',f);
 fputc(sep,f);
-fprintf(f, "%u", el->tSize);
+numTextWriteUnsigned(f, el->tSize);
 fputc(sep,f);
-fprintf(f, "%u", el->tStart);
+numTextWriteUnsigned(f, (unsigned)el->tStart);
 fputc(sep,f);
-fprintf(f, "%u", el->tEnd);
+numTextWriteUnsigned(f, (unsigned)el->tEnd);
 fputc(sep,f);
-fprintf(f, "%u", el->blockCount);
+numTextWriteUnsigned(f, el->blockCount);
 fputc(sep,f);
 if (sep == ',') fputc('{',f);
 for (i=0; i<el->blockCount; ++i)
     {
-    fprintf(f, "%u", el->blockSizes[i]);
+    numTextWriteUnsigned(f, el->blockSizes[i]);
     fputc(',', f);
     }
 if (sep == ',') fputc('}',f);
@@ -311,7 +312,7 @@ fputc(sep,f);
 if (sep == ',') fputc('{',f);
 for (i=0; i<el->blockCount; ++i)
     {
-    fprintf(f, "%u", el->qStarts[i]);
+    numTextWriteUnsigned(f, el->qStarts[i]);
     fputc(',', f);
     }
 if (sep == ',') fputc('}',f);
@@ -319,7 +320,7 @@ fputc(sep,f);
 if (sep == ',') fputc('{',f);
 for (i=0; i<el->blockCount; ++i)
     {
-    fprintf(f, "%u", el->tStarts[i]);
+    numTextWriteUnsigned(f, el->tStarts[i]);
     fputc(',', f);
     }
 if (sep == ',') fputc('}',f);
@@ -9,6 +9,7 @@
 
 #include "common.h"
 #include "sqlNum.h"
+#include "numText.h"
 #include "sqlList.h"
 #include "dystring.h"
 #include "hash.h"
@@ -436,7 +437,7 @@ for (;;)
     e = strchr(s, ',');
     if (e != NULL)
 	*e++ = 0;
-    array[count++] = atof(s);
+    array[count++] = numTextParseDouble(s, NULL);
     s = e;
     }
 return count;
@@ -476,7 +477,7 @@ for (;;)
     e = strchr(s, ',');
     if (e != NULL)
 	*e++ = 0;
-    array[count++] = atof(s);
+    array[count++] = numTextParseDouble(s, NULL);
     s = e;
     }
 return count;
@@ -506,7 +507,7 @@ for (;;)
 	    alloc <<= 1;
 	ExpandArray(array, count, alloc);
 	}
-    array[count++] = atof(s);
+    array[count++] = numTextParseDouble(s, NULL);
     s = e;
     }
 *retSize = count;
@@ -537,7 +538,7 @@ for (;;)
 	    alloc <<= 1;
 	ExpandArray(array, count, alloc);
 	}
-    array[count++] = atof(s);
+    array[count++] = numTextParseDouble(s, NULL);
     s = e;
     }
 *retSize = count;
@@ -1133,7 +1134,7 @@ float ret;
 
 *e++ = 0;
 *pS = e;
-ret = atof(s);
+ret = numTextParseDouble(s, NULL);
 return ret;
 }
 
@@ -1146,7 +1147,7 @@ double ret;
 
 *e++ = 0;
 *pS = e;
-ret = atof(s);
+ret = numTextParseDouble(s, NULL);
 return ret;
 }
 
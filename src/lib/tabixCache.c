@@ -0,0 +1,177 @@
+/* tabixCache - process-wide cache of parsed tabix indexes.  Tracks that point at the
+ * same tabix-indexed file, and repeated opens of one file for different windows, share
+ * a single copy of the index instead of reading and inflating it again each time.
+ *
+ * This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+
+#include "common.h"
+#include "hash.h"
+#include "portable.h"
+#include "net.h"
+#include "pthreadWrap.h"
+#include "tabixCache.h"
+
+struct tabixCacheEntry
+/* A loaded index and how it is being used. */
+    {
+    struct tabixCacheEntry *next;	/* Next in list. */
+    char *key;				/* Index name plus modification time. */
+    tbx_t *tabix;			/* Parsed index. */
+    int refCount;			/* Number of users that haven't released it yet. */
+    long long lastUse;			/* Value of useCounter when last loaded or released. */
+    };
+
+static pthread_mutex_t cacheMutex = PTHREAD_MUTEX_INITIALIZER;
+static struct tabixCacheEntry *cacheList = NULL;	/* All entries. */
+static struct hash *cacheHash = NULL;	/* Entries keyed by key. */
+static long long useCounter = 0;	/* Increments on each load and release. */
+static int maxUnused = TABIX_CACHE_DEFAULT_MAX_UNUSED;
+
+static void makeKey(char *fileOrUrl, char *tbiFileOrUrl, char *key, int keySize)
+/* Put cache key for index in key. */
+{
+char tbiName[4096];
+if (tbiFileOrUrl == NULL)
+    safef(tbiName, sizeof(tbiName), "%s.tbi", fileOrUrl);
+else
+    safef(tbiName, sizeof(tbiName), "%s", tbiFileOrUrl);
+long long modTime = 0;
+if (!hasProtocol(tbiName) && fileExists(tbiName))
+    modTime = fileModTime(tbiName);
+safef(key, keySize, "%s\t%lld", tbiName, modTime);
+}
+
+static void entryFree(struct tabixCacheEntry **pEntry)
+/* Free up entry and the index in it. */
+{
+struct tabixCacheEntry *entry = *pEntry;
+if (entry != NULL)
+    {
+    tbx_destroy(entry->tabix);
+    freeMem(entry->key);
+    freez(pEntry);
+    }
+}
+
+static void removeEntry(struct tabixCacheEntry *entry)
+/* Remove entry from cache and free it.  Call with cacheMutex locked. */
+{
+hashRemove(cacheHash, entry->key);
+slRemoveEl(&cacheList, entry);
+entryFree(&entry);
+}
+
+static void trimUnused(int maxKeep)
+/* Free least recently used entries not in use until at most maxKeep unused ones are left.
+ * Call with cacheMutex locked. */
+{
+for (;;)
+    {
+    struct tabixCacheEntry *entry, *oldest = NULL;
+    int unusedCount = 0;
+    for (entry = cacheList; entry != NULL; entry = entry->next)
+	{
+	if (entry->refCount == 0)
+	    {
+	    ++unusedCount;
+	    if (oldest == NULL || entry->lastUse < oldest->lastUse)
+		oldest = entry;
+	    }
+	}
+    if (unusedCount <= maxKeep)
+	break;
+    removeEntry(oldest);
+    }
+}
+
+tbx_t *tabixCacheLoad(char *fileOrUrl, char *tbiFileOrUrl)
+/* Return parsed tabix index for fileOrUrl, loading it if it is not already in the cache.
+ * tbiFileOrUrl can be NULL, in which case it defaults to fileOrUrl.tbi.  Returns NULL
+ * if the index can't be loaded.  Call tabixCacheRelease when done with the index.
+ * Thread safe. */
+{
+char key[4096+32];
+makeKey(fileOrUrl, tbiFileOrUrl, key, sizeof(key));
+pthreadMutexLock(&cacheMutex);
+if (cacheHash == NULL)
+    cacheHash = hashNew(0);
+struct tabixCacheEntry *entry = hashFindVal(cacheHash, key);
+if (entry != NULL)
+    {
+    entry->refCount += 1;
+    entry->lastUse = ++useCounter;
+    }
+pthreadMutexUnlock(&cacheMutex);
+if (entry != NULL)
+    return entry->tabix;
+
+// Load outside of the lock; remote indexes can take a while and udc may errAbort.
+char *tbiName = strchr(key, '\t');
+*tbiName = 0;
+tbx_t *tabix = tbx_index_load2(fileOrUrl, key);
+*tbiName = '\t';
+if (tabix == NULL)
+    return NULL;
+
+pthreadMutexLock(&cacheMutex);
+entry = hashFindVal(cacheHash, key);
+if (entry != NULL)
+    {
+    // Another thread loaded the same index while we were busy; use theirs.
+    tbx_destroy(tabix);
+    tabix = entry->tabix;
+    }
+else
+    {
+    AllocVar(entry);
+    entry->key = cloneString(key);
+    entry->tabix = tabix;
+    hashAdd(cacheHash, key, entry);
+    slAddHead(&cacheList, entry);
+    }
+entry->refCount += 1;
+entry->lastUse = ++useCounter;
+pthreadMutexUnlock(&cacheMutex);
+return tabix;
+}
+
+void tabixCacheRelease(tbx_t *tabix)
+/* Tell cache that caller is done with an index returned by tabixCacheLoad.
+ * Thread safe. */
+{
+if (tabix == NULL)
+    return;
+pthreadMutexLock(&cacheMutex);
+struct tabixCacheEntry *entry;
+for (entry = cacheList; entry != NULL; entry = entry->next)
+    if (entry->tabix == tabix)
+	break;
+if (entry == NULL)
+    {
+    pthreadMutexUnlock(&cacheMutex);
+    errAbort("tabixCacheRelease: index was not loaded through tabixCacheLoad");
+    }
+entry->refCount -= 1;
+entry->lastUse = ++useCounter;
+trimUnused(maxUnused);
+pthreadMutexUnlock(&cacheMutex);
+}
+
+void tabixCacheSetMaxUnused(int newMaxUnused)
+/* Set the maximum number of indexes that are kept when not in use.  Zero turns caching
+ * off, so an index is freed as soon as its last user releases it. */
+{
+pthreadMutexLock(&cacheMutex);
+maxUnused = max(newMaxUnused, 0);
+trimUnused(maxUnused);
+pthreadMutexUnlock(&cacheMutex);
+}
+
+void tabixCacheFlush()
+/* Free all indexes in the cache that are not currently in use. */
+{
+pthreadMutexLock(&cacheMutex);
+trimUnused(0);
+pthreadMutexUnlock(&cacheMutex);
+}
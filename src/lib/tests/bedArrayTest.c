@@ -0,0 +1,110 @@
+/* bedArrayTest - Test that beds come back out of a bedArray the way bedLoadN reads them. */
+
+/* This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+#include "common.h"
+#include "linefile.h"
+#include "options.h"
+#include "basicBed.h"
+#include "bedArray.h"
+
+void usage()
+/* Explain usage and exit. */
+{
+errAbort(
+  "bedArrayTest - Test that beds come back out of a bedArray the way bedLoadN reads them\n"
+  "usage:\n"
+  "   bedArrayTest in.bed out.bed\n"
+  "For each field count from 3 to 12, add the first that many fields of each tab-separated\n"
+  "line of in.bed to a bedArray, copy each record into a second bedArray with\n"
+  "bedArrayAddBed, and check that bedArrayToBed on the copy gives the same bed as bedLoadN\n"
+  "on the line.  The beds are written to out.bed, each field count in turn.\n"
+  );
+}
+
+static struct optionSpec options[] = {
+   {NULL, 0},
+};
+
+static char *bedText(struct bed *bed, int fieldCount)
+/* Return bed as a line of text.  Free this when done. */
+{
+char *text = NULL;
+size_t size = 0;
+FILE *f = open_memstream(&text, &size);
+bedOutputN(bed, fieldCount, f, '\t', '\n');
+carefulClose(&f);
+return text;
+}
+
+void bedArrayTestFields(char *inFile, int fieldCount, FILE *f)
+/* Round trip the first fieldCount fields of inFile through bedArrays. */
+{
+struct bedArray *ba = bedArrayNew(fieldCount, 0);
+struct bed *expected, *expectedList = NULL;
+struct lineFile *lf = lineFileOpen(inFile, TRUE);
+char *line;
+while (lineFileNextReal(lf, &line))
+    {
+    // Parsing changes the row, so bedLoadN and bedArrayAddRow each get their own copy.
+    char *rowA[BED_ARRAY_MAX_FIELDS], *rowB[BED_ARRAY_MAX_FIELDS];
+    char *dupe = cloneString(line);
+    int wordCount = chopTabs(line, rowA);
+    if (wordCount < fieldCount)
+        errAbort("Expecting %d words, got %d line %d of %s",
+                 fieldCount, wordCount, lf->lineIx, lf->fileName);
+    chopTabs(dupe, rowB);
+    slAddHead(&expectedList, bedLoadN(rowA, fieldCount));
+    bedArrayAddRow(ba, rowB, fieldCount);
+    freeMem(dupe);
+    }
+lineFileClose(&lf);
+slReverse(&expectedList);
+
+struct bedArray *copy = bedArrayNew(fieldCount, 0);
+int ix;
+for (ix = 0; ix < ba->count; ix++)
+    {
+    struct bed view;
+    bedArrayGet(ba, ix, &view);
+    bedArrayAddBed(copy, &view);
+    }
+for (expected = expectedList, ix = 0; expected != NULL; expected = expected->next, ix++)
+    {
+    struct bed *got = bedArrayToBed(copy, ix);
+    char *expectedText = bedText(expected, fieldCount), *gotText = bedText(got, fieldCount);
+    if (!sameString(expectedText, gotText) || expected->blockCount != got->blockCount)
+        errAbort("bed%d record %d: bedLoadN gives\n%sbut bedArray gives\n%s",
+                 fieldCount, ix, expectedText, gotText);
+    fputs(gotText, f);
+    free(expectedText);
+    free(gotText);
+    bedFree(&got);
+    }
+bedFreeList(&expectedList);
+bedArrayFree(&copy);
+bedArrayFree(&ba);
+}
+
+void bedArrayTest(char *inFile, char *outFile)
+/* bedArrayTest - Test that beds come back out of a bedArray the way bedLoadN reads them. */
+{
+FILE *f = mustOpen(outFile, "w");
+int fieldCount;
+for (fieldCount = 3; fieldCount <= BED_ARRAY_MAX_FIELDS; fieldCount++)
+    {
+    fprintf(f, "# bed%d\n", fieldCount);
+    bedArrayTestFields(inFile, fieldCount, f);
+    }
+carefulClose(&f);
+}
+
+int main(int argc, char *argv[])
+/* Process command line. */
+{
+optionInit(&argc, argv, options);
+if (argc != 3)
+    usage();
+bedArrayTest(argv[1], argv[2]);
+return 0;
+}
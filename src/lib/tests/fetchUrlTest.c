@@ -15,10 +15,15 @@ void usage()
 errAbort(
 "fetchUrlTest - try to fetch url\n"
 "usage:\n"
-"   fetchUrlTest URL\n");
+"   fetchUrlTest URL\n"
+"options:\n"
+"   -repeat=N - fetch URL N times, reusing the connection if server allows\n"
+"   -noKeepAlive - open a new connection for each fetch\n");
 }
 
 static struct optionSpec options[] = {
+   {"repeat", OPTION_INT},
+   {"noKeepAlive", OPTION_BOOLEAN},
    {NULL, 0},
 };
 
@@ -27,6 +32,7 @@ void fetchUrlTest(char *url)
 {
 struct dyString *dy = netSlurpUrl(url);
 mustWrite(stdout, dy->string, dy->stringSize);
+dyStringFree(&dy);
 }
 
 void fetchUrlBody(char *url)
@@ -78,7 +84,12 @@ int main(int argc, char *argv[])
 optionInit(&argc, argv, options);
 if (argc != 2)
     usage();
-fetchUrlTest(argv[1]);
+int repeat = optionInt("repeat", 1);
+if (optionExists("noKeepAlive"))
+    netKeepAliveEnable(FALSE);
+int i;
+for (i = 0; i < repeat; ++i)
+    fetchUrlTest(argv[1]);
 //fetchUrlBody(argv[1]);
 return 0;
 }
@@ -0,0 +1,111 @@
+/* freeTypeTest - Check that FreeType text drawn from the glyph cache matches text drawn
+ * without it, including after the font changes. */
+
+/* This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+#include "common.h"
+#include "options.h"
+#include "dystring.h"
+#include "memgfx.h"
+#include "vGfx.h"
+#include "../freeType.h"
+
+void usage()
+/* Explain usage and exit. */
+{
+errAbort(
+  "freeTypeTest - Check that FreeType text drawn from the glyph cache matches text drawn\n"
+  "without it, including after the font changes\n"
+  "usage:\n"
+  "   freeTypeTest font1 font2 out.png\n"
+  "Draws labels at each text size in font1, then font2, then font1 again, once with the\n"
+  "glyph cache off and once with it on, and errors out if the images or string widths\n"
+  "differ.  The image drawn with the cache on is saved to out.png.\n"
+  );
+}
+
+static struct optionSpec options[] = {
+   {NULL, 0},
+};
+
+static char *textSizes[] = {"6", "8", "10", "12", "14", "18", "24", "34"};
+static char *labels[] = {"chr1:11,874-14,409", "DDX11L1", "WASH7P Ag",
+                         "ENST00000456328.2", "gjqpy |@#% \xc3\xa9t\xc3\xa9"};
+
+static int drawLabels(struct memGfx *mg, char *fontFile, int y, struct dyString *widths)
+/* Draw all labels at every size in fontFile starting at y, and add their widths to
+ * widths.  Return y below them. */
+{
+mg->fontMethod = FONT_METHOD_FREETYPE;
+ftInitialize(fontFile);
+int i, j;
+for (i = 0; i < ArraySize(textSizes); i++)
+    {
+    MgFont *font = mgFontForSizeAndStyle(textSizes[i], "medium");
+    int x = 0;
+    for (j = 0; j < ArraySize(labels); j++)
+        {
+        int width = mgFontStringWidth(font, labels[j]);
+        if (x + width > mg->width)
+            {
+            x = 0;
+            y += mgFontLineHeight(font);
+            }
+        mgText(mg, x, y, MG_BLACK, font, labels[j]);
+        dyStringPrintf(widths, " %d", width);
+        x += width + 10;
+        }
+    y += mgFontLineHeight(font);
+    }
+mgTextInBox(mg, 0, y, 10, 20, MG_BLACK, mgSmallFont(), "upright");
+mgTextInBox(mg, mg->width / 2, y, 10, -20, MG_BLACK, mgSmallFont(), "flipped");
+return y + 30;
+}
+
+static struct memGfx *drawImage(char *font1, char *font2, boolean cacheOn,
+                                 struct dyString *widths)
+/* Draw labels in font1, font2, then font1 again with cache on or off. */
+{
+struct memGfx *mg = mgNew(1200, 1200);
+mgClearPixels(mg);
+ftGlyphCacheEnable(cacheOn);
+int y = 0;
+y = drawLabels(mg, font1, y, widths);
+y = drawLabels(mg, font2, y, widths);
+y = drawLabels(mg, font1, y, widths);
+return mg;
+}
+
+void freeTypeTest(char *font1, char *font2, char *outPng)
+/* freeTypeTest - Check that FreeType text drawn from the glyph cache matches text drawn
+ * without it, including after the font changes. */
+{
+struct dyString *plainWidths = dyStringNew(0), *cachedWidths = dyStringNew(0);
+struct memGfx *plain = drawImage(font1, font2, FALSE, plainWidths);
+struct memGfx *cached = drawImage(font1, font2, TRUE, cachedWidths);
+int pixelCount = plain->width * plain->height, i, diffCount = 0;
+for (i = 0; i < pixelCount; i++)
+    if (plain->pixels[i] != cached->pixels[i])
+        diffCount++;
+mgSavePng(cached, outPng, FALSE);
+if (diffCount > 0)
+    errAbort("%d of %d pixels differ between text drawn with and without glyph cache",
+             diffCount, pixelCount);
+if (!sameString(plainWidths->string, cachedWidths->string))
+    errAbort("String widths differ between glyph cache off:\n%s\nand on:\n%s",
+             plainWidths->string, cachedWidths->string);
+dyStringFree(&cachedWidths);
+dyStringFree(&plainWidths);
+mgFree(&cached);
+mgFree(&plain);
+}
+
+int main(int argc, char *argv[])
+/* Process command line. */
+{
+optionInit(&argc, argv, options);
+if (argc != 4)
+    usage();
+freeTypeTest(argv[1], argv[2], argv[3]);
+return 0;
+}
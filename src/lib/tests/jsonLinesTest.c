@@ -0,0 +1,80 @@
+/* jsonLinesTest - Read a line-delimited JSON file in batches and query each batch. */
+
+/* This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+#include "common.h"
+#include "linefile.h"
+#include "options.h"
+#include "jsonLines.h"
+#include "jsonQuery.h"
+
+void usage()
+/* Explain usage and exit. */
+{
+errAbort(
+  "jsonLinesTest - Read a line-delimited JSON file in batches and query each batch\n"
+  "usage:\n"
+  "   jsonLinesTest in.jsonl out.txt\n"
+  "options:\n"
+  "   -batch=N    Number of lines to read per batch (default 2)\n"
+  "   -threads=N  Number of threads to parse each batch with (default 2)\n"
+  "For each line, out.txt gets the line number and the values of its top-level name and\n"
+  "count fields.  Then for each batch, out.txt gets the names and counts of all lines in\n"
+  "the batch as found by jsonQueryStringList and jsonQueryIntList.\n"
+  );
+}
+
+static struct optionSpec options[] = {
+   {"batch", OPTION_INT},
+   {"threads", OPTION_INT},
+   {NULL, 0},
+};
+
+void jsonLinesTest(char *inFile, char *outFile, int batchSize, int threadCount)
+/* jsonLinesTest - Read a line-delimited JSON file in batches and query each batch. */
+{
+struct lineFile *lf = lineFileOpen(inFile, TRUE);
+FILE *f = mustOpen(outFile, "w");
+struct jsonLine *jlList;
+int batchIx = 0;
+while ((jlList = jsonLinesRead(lf, batchSize, threadCount)) != NULL)
+    {
+    struct slRef *elList = NULL;
+    struct jsonLine *jl;
+    for (jl = jlList;  jl != NULL;  jl = jl->next)
+        {
+        char *name = jsonQueryString(jl->el, "line", "name", jl->lm);
+        long count = jsonQueryInt(jl->el, "line", "count", -1, jl->lm);
+        fprintf(f, "line %d: name=%s count=%ld\n", jl->lineIx, naForNull(name), count);
+        refAdd(&elList, jl->el);
+        }
+    slReverse(&elList);
+    // With NULL lm the query results are allocated, so the refs are freed internally too.
+    struct slName *names = jsonQueryStringList(elList, "batch", "name", NULL), *name;
+    struct slInt *counts = jsonQueryIntList(elList, "batch", "count", NULL), *count;
+    fprintf(f, "batch %d names:", batchIx);
+    for (name = names;  name != NULL;  name = name->next)
+        fprintf(f, " %s", name->name);
+    fprintf(f, "\nbatch %d counts:", batchIx);
+    for (count = counts;  count != NULL;  count = count->next)
+        fprintf(f, " %d", count->val);
+    fputc('\n', f);
+    slFreeList(&counts);
+    slFreeList(&names);
+    slFreeList(&elList);
+    jsonLineFreeList(&jlList);
+    batchIx++;
+    }
+carefulClose(&f);
+lineFileClose(&lf);
+}
+
+int main(int argc, char *argv[])
+/* Process command line. */
+{
+optionInit(&argc, argv, options);
+if (argc != 3)
+    usage();
+jsonLinesTest(argv[1], argv[2], optionInt("batch", 2), optionInt("threads", 2));
+return 0;
+}
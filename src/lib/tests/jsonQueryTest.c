@@ -53,6 +53,8 @@ switch (el->type)
         {
         struct hash *hash = jsonObjectVal(el, "el");
         struct hashEl *helList = hashElListHash(hash);
+        // Hash order depends on table size, so show the alphabetically first field.
+        slSort(&helList, hashElCmp);
 	fprintf(f, "{");
         if (helList)
             {
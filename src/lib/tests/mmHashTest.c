@@ -20,13 +20,21 @@ errAbort(
   "out.mmh is read back in as a memory-mapped file, items are looked up and written to out.txt.\n"
   "out.txt should contain the same contents as in.txt unless there are multiple lines with\n"
   "the same key; in that case, only the last line with the key will be included in out.txt.\n"
+  "options:\n"
+  "  -v2           Stream items into a version 2 file with mmHashBuilder instead of using a hash\n"
+  "  -maxMem=N     With -v2, keep at most N bytes of key hashes in memory (default 1G)\n"
   );
 }
 
 static struct optionSpec options[] = {
+    {"v2", OPTION_BOOLEAN},
+    {"maxMem", OPTION_LONG_LONG},
     {NULL, 0},
 };
 
+static boolean v2 = FALSE;
+static long long maxMem = 0;
+
 static void makeRandomString(char *buf, int bufSize)
 /* Fill buf with bufSize-1 random printable characters and 0-terminate. */
 {
@@ -44,6 +52,9 @@ FILE *f = mustOpen(outFileName, "w");
 // Read inFile into hash
 struct lineFile *lf = lineFileOpen(inFileName, TRUE);
 struct hash *hash = hashNew(0);
+struct mmHashBuilder *mhb = NULL;
+if (v2)
+    mhb = mmHashBuilderNew(mmHashFileName, NULL, maxMem);
 struct slName *keyList = NULL;
 char *line;
 int size;
@@ -57,15 +68,23 @@ while (lineFileNext(lf, &line, &size))
         *tab = '\0';
         val = tab + 1;
         }
-    hashAdd(hash, key, cloneString(val));
+    if (mhb != NULL)
+        mmHashBuilderAdd(mhb, key, val);
+    else
+        hashAdd(hash, key, cloneString(val));
     slNameAddHead(&keyList, key);
     }
 lineFileClose(&lf);
 slReverse(&keyList);
 
-// Convert hash to mmHash file.
-hashToMmHashFile(hash, mmHashFileName);
-freeHashAndVals(&hash);
+// Convert hash to mmHash file, or finish building it.
+if (mhb != NULL)
+    mmHashBuilderFinish(&mhb);
+else
+    {
+    hashToMmHashFile(hash, mmHashFileName);
+    freeHashAndVals(&hash);
+    }
 
 // Get that file memory-mapped.
 struct mmHash *mmh = mmHashFromFile(mmHashFileName);
@@ -81,15 +100,35 @@ if (shouldBeNull != NULL)
              "-- but there it was, with a value of '%s'",
              inFileName, longRandomString, shouldBeNull);
 
-// Look up and write out all the items.
+// Look up all the items at once too, along with the random name, and make sure the batch
+// lookup agrees with looking them up one at a time.
+int keyCount = slCount(keyList) + 1, i;
+char **keys;
+const char **vals;
+AllocArray(keys, keyCount);
+AllocArray(vals, keyCount);
 struct slName *key;
-for (key = keyList;  key != NULL;  key = key->next)
+for (key = keyList, i = 0;  key != NULL;  key = key->next, i++)
+    keys[i] = key->name;
+keys[i] = longRandomString;
+mmHashFindVals(mmh, keyCount, keys, vals);
+
+// Look up and write out all the items.
+for (key = keyList, i = 0;  key != NULL;  key = key->next, i++)
     {
     const char *val = mmHashFindVal(mmh, key->name);
     if (val == NULL)
         errAbort("Lookup of key '%s' failed.", key->name);
+    if (vals[i] != val)
+        errAbort("Batch lookup of key '%s' got '%s' instead of '%s'.", key->name,
+                 vals[i] ? vals[i] : "NULL", val);
     fprintf(f, "%s\t%s\n", key->name, val);
     }
+if (vals[keyCount-1] != NULL)
+    errAbort("Batch lookup of random key found '%s'", vals[keyCount-1]);
+freeMem(keys);
+freeMem(vals);
+mmHashFree(&mmh);
 carefulClose(&f);
 }
 
@@ -100,6 +139,8 @@ int main(int argc, char *argv[])
 optionInit(&argc, argv, options);
 if (argc != 4)
     usage();
+v2 = optionExists("v2");
+maxMem = optionLongLong("maxMem", maxMem);
 mmHashTest(argv[1], argv[2], argv[3]);
 return 0;
 }
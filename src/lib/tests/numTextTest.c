@@ -0,0 +1,184 @@
+/* numTextTest - check numText conversions against printf and strtod.
+ *
+ * This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+
+#include "common.h"
+#include "linefile.h"
+#include "options.h"
+#include "numText.h"
+
+static struct optionSpec options[] = {
+   {"count", OPTION_INT},
+   {NULL, 0},
+};
+
+int errCount = 0;
+
+void usage()
+/* Explain usage and exit. */
+{
+errAbort(
+  "numTextTest - check numText conversions against printf and strtod\n"
+  "usage:\n"
+  "   numTextTest numbers.txt output.txt\n"
+  "Each line of numbers.txt is parsed and formatted, with the results written to\n"
+  "output.txt, and then a number of random values are checked.\n"
+  "options:\n"
+  "   -count=N - number of random values to check, default 1000000\n"
+  );
+}
+
+static void checkParse(char *s)
+/* Check that numTextParseDouble agrees with strtod on s. */
+{
+char *end, *expEnd;
+double val = numTextParseDouble(s, &end);
+double expVal = strtod(s, &expEnd);
+if (end != expEnd || memcmp(&val, &expVal, sizeof(val)) != 0)
+    {
+    if (errCount++ < 10)
+	printf("parse mismatch on '%s': %.17g vs strtod %.17g\n", s, val, expVal);
+    }
+}
+
+static void checkFormat(double x, int prec)
+/* Check that numTextDoublePrec agrees with printf %.*g on x. */
+{
+char buf[NUM_TEXT_MAX_SIZE], expBuf[64];
+int len = numTextDoublePrec(buf, x, prec);
+safef(expBuf, sizeof(expBuf), "%.*g", prec, x);
+if (len != strlen(buf) || !sameString(buf, expBuf))
+    {
+    if (errCount++ < 10)
+	printf("format mismatch on %a precision %d: %s vs printf %s\n", x, prec, buf, expBuf);
+    }
+}
+
+static void checkShortest(double x)
+/* Check that shortest forms read back exactly. */
+{
+char buf[NUM_TEXT_MAX_SIZE];
+numTextDoubleShortest(buf, x);
+if (numTextParseDouble(buf, NULL) != x)
+    {
+    if (errCount++ < 10)
+	printf("shortest %s does not read back as %a\n", buf, x);
+    }
+float f = x;
+numTextFloatShortest(buf, f);
+if ((float)numTextParseDouble(buf, NULL) != f)
+    {
+    if (errCount++ < 10)
+	printf("float shortest %s does not read back as %a\n", buf, f);
+    }
+}
+
+static void checkInt(long long x)
+/* Check integer formatting on x. */
+{
+char buf[NUM_TEXT_MAX_SIZE], expBuf[NUM_TEXT_MAX_SIZE];
+numTextSigned(buf, x);
+safef(expBuf, sizeof(expBuf), "%lld", x);
+if (!sameString(buf, expBuf))
+    {
+    if (errCount++ < 10)
+	printf("signed mismatch %s vs %s\n", buf, expBuf);
+    }
+numTextUnsigned(buf, (unsigned long long)x);
+safef(expBuf, sizeof(expBuf), "%llu", (unsigned long long)x);
+if (!sameString(buf, expBuf))
+    {
+    if (errCount++ < 10)
+	printf("unsigned mismatch %s vs %s\n", buf, expBuf);
+    }
+}
+
+static unsigned long long randomBits()
+/* Return 64 random bits. */
+{
+return ((unsigned long long)random() << 42) ^ ((unsigned long long)random() << 21) ^ random();
+}
+
+static void checkRandom(int count)
+/* Check count random values of various kinds. */
+{
+srandom(1234);
+int i;
+char buf[64];
+for (i=0; i<count; ++i)
+    {
+    /* Doubles with random bits, scaled to the range numbers usually are in. */
+    unsigned long long bits = randomBits();
+    double x;
+    memcpy(&x, &bits, sizeof(x));
+    if (isnan(x))
+	continue;
+    checkFormat(x, 6);
+    checkFormat(x, 1 + i%17);
+    checkShortest(x);
+    double y = ldexp((double)(bits>>11), -53) * exp10((int)(bits%40) - 20);
+    checkFormat(y, 6);
+    checkFormat(-y, 1 + i%17);
+    checkShortest(y);
+    checkFormat((float)y, 6);
+
+    /* Decimals of the sort found in files, and numbers near rounding ties. */
+    int decimals = i%8;
+    safef(buf, sizeof(buf), "%.*f", decimals, (double)(bits%20000000) / 1000 - 10000);
+    checkParse(buf);
+    double z = numTextParseDouble(buf, NULL);
+    checkFormat(z, 6);
+    checkFormat(z, 1 + i%15);
+    safef(buf, sizeof(buf), "%llue%d", bits % 100000000, (int)(bits % 61) - 30);
+    checkParse(buf);
+    safef(buf, sizeof(buf), "%.*g", 1 + i%17, x);
+    checkParse(buf);
+    checkFormat((double)(bits%1000000) + 0.5, 6);
+    checkFormat((double)(bits%1000000) / 16, 1 + i%8);
+
+    checkInt(bits);
+    checkInt((int)bits);
+    checkInt((int)bits % 1000);
+    }
+}
+
+void numTextTest(char *inFile, char *outFile, int count)
+/* Check numText conversions of numbers in inFile and random ones. */
+{
+struct lineFile *lf = lineFileOpen(inFile, TRUE);
+FILE *f = mustOpen(outFile, "w");
+char *line;
+while (lineFileNext(lf, &line, NULL))
+    {
+    char *end;
+    double val = numTextParseDouble(line, &end);
+    checkParse(line);
+    char buf[NUM_TEXT_MAX_SIZE];
+    fprintf(f, "%s\t", line);
+    numTextWriteSigned(f, end - line);
+    numTextDouble(buf, val);
+    fprintf(f, "\t%s", buf);
+    numTextDoubleShortest(buf, val);
+    fprintf(f, "\t%s", buf);
+    numTextFloatShortest(buf, val);
+    fprintf(f, "\t%s\t", buf);
+    numTextWriteDouble(f, val * 1000);
+    fputc('\n', f);
+    checkFormat(val, 6);
+    }
+lineFileClose(&lf);
+checkRandom(count);
+fprintf(f, "%d errors\n", errCount);
+carefulClose(&f);
+}
+
+int main(int argc, char *argv[])
+/* Process command line. */
+{
+optionInit(&argc, argv, options);
+if (argc != 3)
+    usage();
+numTextTest(argv[1], argv[2], optionInt("count", 1000000));
+return errCount != 0;
+}
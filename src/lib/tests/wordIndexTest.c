@@ -0,0 +1,61 @@
+/* wordIndexTest - Index words of a text file, memory-map the index and search it. */
+
+/* This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+
+#include "common.h"
+#include "linefile.h"
+#include "options.h"
+#include "wordIndex.h"
+
+void usage()
+/* Explain usage and exit. */
+{
+errAbort(
+  "wordIndexTest - Index words of a text file, memory-map the index and search it.\n"
+  "usage:\n"
+  "  wordIndexTest in.txt queries.txt out.wix out.txt\n"
+  "The words in in.txt are indexed and written to out.wix, which is read back in as a\n"
+  "memory-mapped file.  Each line of queries.txt is a list of word prefixes to search\n"
+  "for, and the lines of in.txt that have words starting with all of them are written\n"
+  "to out.txt.\n"
+  );
+}
+
+static struct optionSpec options[] = {
+    {NULL, 0},
+};
+
+void wordIndexTest(char *inFile, char *queryFile, char *wixFile, char *outFile)
+/* Index inFile, run searches in queryFile on it and write results to outFile. */
+{
+wordIndexFromTextFile(inFile, wixFile);
+struct wordIndex *wix = wordIndexOpen(wixFile);
+FILE *f = mustOpen(outFile, "w");
+struct lineFile *lf = lineFileOpen(queryFile, TRUE);
+char *line;
+while (lineFileNext(lf, &line, NULL))
+    {
+    fprintf(f, "search: %s\n", line);
+    char *prefixes[16];
+    int prefixCount = chopLine(line, prefixes);
+    int i, count;
+    bits32 *lines = wordIndexSearch(wix, prefixCount, prefixes, &count);
+    for (i=0; i<count; ++i)
+        fprintf(f, "%u\t%s\n", lines[i], wordIndexLine(wix, lines[i]));
+    freeMem(lines);
+    }
+lineFileClose(&lf);
+carefulClose(&f);
+wordIndexClose(&wix);
+}
+
+int main(int argc, char *argv[])
+/* Process command line. */
+{
+optionInit(&argc, argv, options);
+if (argc != 5)
+    usage();
+wordIndexTest(argv[1], argv[2], argv[3], argv[4]);
+return 0;
+}
@@ -31,6 +31,20 @@ vg->height = height;
 return vg;
 }
 
+void vgDrawSpans(struct vGfx *vg, int y, int height, struct mgSpan *spans, int spanCount)
+/* Draw spanCount boxes that all run from y to y+height, colors being color
+ * indexes.  Same as vgBox on each, but faster on pixel based graphics. */
+{
+if (vg->pixelBased)
+    mgDrawSpans(vg->data, y, height, spans, spanCount);
+else
+    {
+    int i;
+    for (i = 0; i < spanCount; ++i)
+        vgBox(vg, spans[i].x, y, spans[i].width, height, spans[i].color);
+    }
+}
+
 int vgFindRgb(struct vGfx *vg, struct rgbColor *rgb)
 /* Find color index corresponding to rgba color. */
 {
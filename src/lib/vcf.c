@@ -14,6 +14,7 @@
 #include "net.h"
 #include "regexHelper.h"
 #include "htslib/tbx.h"
+#include "tabixCache.h"
 #include "vcf.h"
 
 /* Reserved but optional INFO keys: */
@@ -1126,31 +1127,24 @@ long long vcfTabixItemCount(char *fileOrUrl, char *tbiFileOrUrl)
  * large files. */
 {
 long long itemCount = 0;
-hts_idx_t *idx = NULL;
-if (isNotEmpty(tbiFileOrUrl))
-    idx = hts_idx_load2(fileOrUrl, tbiFileOrUrl);
-else
-    {
-    idx = hts_idx_load(fileOrUrl, HTS_FMT_TBI);
-    }
-if (idx == NULL)
-    warn("vcfTabixItemCount: hts_idx_load(%s) failed.", tbiFileOrUrl ? tbiFileOrUrl : fileOrUrl);
+tbx_t *tabix = tabixCacheLoad(fileOrUrl, isNotEmpty(tbiFileOrUrl) ? tbiFileOrUrl : NULL);
+if (tabix == NULL)
+    warn("vcfTabixItemCount: tabixCacheLoad(%s) failed.", tbiFileOrUrl ? tbiFileOrUrl : fileOrUrl);
 else
     {
     int tCount;
-    const char **seqNames = tbx_seqnames((tbx_t *)idx, &tCount);
+    const char **seqNames = tbx_seqnames(tabix, &tCount);
     int tid;
     for (tid = 0;  tid < tCount;  tid++)
         {
         uint64_t mapped, unmapped;
-        int ret = hts_idx_get_stat(idx, tid, &mapped, &unmapped);
+        int ret = hts_idx_get_stat(tabix->idx, tid, &mapped, &unmapped);
         if (ret == 0)
             itemCount += mapped;
         // ret is -1 if counts are unavailable.
         }
     freeMem(seqNames);
-    hts_idx_destroy(idx);
-    idx = NULL;
+    tabixCacheRelease(tabix);
     }
 return itemCount;
 }
@@ -0,0 +1,381 @@
+/* wordIndex - memory mapped index of the words in an id-and-text file. */
+
+/* This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+
+#include "common.h"
+#include <sys/mman.h>
+#include "hash.h"
+#include "linefile.h"
+#include "localmem.h"
+#include "wordIndex.h"
+
+static unsigned char wixMagicBytes[] = {0xF0, 'w', 'i', 'x', 'v', '1', 0x0F};
+#define wixHeaderSize 24	/* Magic, reserved byte, lineCount and wordCount. */
+
+struct wordPostings
+/* Lines a word occurs in while building index. */
+    {
+    bits32 *lines;	/* Line numbers, ascending. */
+    int count;		/* Number of lines used. */
+    int alloc;		/* Number of lines allocated. */
+    };
+
+static void addWordsOnLine(struct hash *wordHash, struct lm *lm, char *line, bits32 lineIx)
+/* Add the upper-cased alphanumeric runs in line to wordHash. */
+{
+char word[1024];
+char *s = line;
+for (;;)
+    {
+    while (*s != 0 && !isalnum(*s))
+        ++s;
+    if (*s == 0)
+        break;
+    int size = 0;
+    while (isalnum(*s))
+        {
+	if (size < sizeof(word) - 1)
+	    word[size++] = toupper(*s);
+	++s;
+	}
+    word[size] = 0;
+    struct hashEl *hel = hashLookup(wordHash, word);
+    if (hel == NULL)
+        {
+	struct wordPostings *wp;
+	lmAllocVar(lm, wp);
+	hel = hashAdd(wordHash, word, wp);
+	}
+    struct wordPostings *wp = hel->val;
+    if (wp->count == 0 || wp->lines[wp->count-1] != lineIx)
+        {
+	if (wp->count >= wp->alloc)
+	    {
+	    int newAlloc = (wp->alloc == 0 ? 4 : wp->alloc * 2);
+	    ExpandArray(wp->lines, wp->alloc, newAlloc);
+	    wp->alloc = newAlloc;
+	    }
+	wp->lines[wp->count++] = lineIx;
+	}
+    }
+}
+
+static int hashElCmpName(const void *va, const void *vb)
+/* Compare two hashEl pointers by name with strcmp. */
+{
+const struct hashEl *a = *((struct hashEl **)va);
+const struct hashEl *b = *((struct hashEl **)vb);
+return strcmp(a->name, b->name);
+}
+
+void wordIndexFromTextFile(char *inFile, char *outFile)
+/* Index the words in inFile and write index to outFile.  Blank lines and lines
+ * starting with # are skipped just as lineFileNextReal does, and are not counted in
+ * line numbers. */
+{
+/* Read in lines and collect postings for each word. */
+struct lineFile *lf = lineFileOpen(inFile, TRUE);
+struct lm *lm = lmInit(0);
+struct hash *wordHash = hashNew(20);
+struct slName *lineList = NULL;
+bits64 lineCount = 0;
+char *line;
+while (lineFileNextReal(lf, &line))
+    {
+    if (lineCount >= BIGNUM)
+        errAbort("Too many lines in %s for word index", inFile);
+    struct slName *el = lmSlName(lm, line);
+    slAddHead(&lineList, el);
+    addWordsOnLine(wordHash, lm, line, lineCount);
+    ++lineCount;
+    }
+lineFileClose(&lf);
+slReverse(&lineList);
+
+/* Sort words. */
+bits64 wordCount = wordHash->elCount;
+struct hashEl **words;
+AllocArray(words, wordCount + 1);
+struct hashEl *hel, *helList = hashElListHash(wordHash);
+bits64 i = 0;
+for (hel = helList; hel != NULL; hel = hel->next)
+    words[i++] = hel;
+qsort(words, wordCount, sizeof(words[0]), hashElCmpName);
+
+/* Figure out where everything goes. */
+bits64 postingCount = 0;
+for (i=0; i<wordCount; ++i)
+    postingCount += ((struct wordPostings *)words[i]->val)->count;
+bits64 offset = wixHeaderSize + sizeof(bits64) * (lineCount + 1 + wordCount + wordCount + 1)
+	+ sizeof(bits32) * postingCount;
+
+/* Write header. */
+FILE *f = mustOpen(outFile, "w");
+mustWrite(f, wixMagicBytes, sizeof(wixMagicBytes));
+unsigned char reserved = 0;
+mustWrite(f, &reserved, 1);
+mustWrite(f, &lineCount, sizeof(lineCount));
+mustWrite(f, &wordCount, sizeof(wordCount));
+
+/* Write lineOffsets, wordOffsets and postingStarts. */
+struct slName *el;
+for (el = lineList; el != NULL; el = el->next)
+    {
+    mustWrite(f, &offset, sizeof(offset));
+    offset += strlen(el->name) + 1;
+    }
+mustWrite(f, &offset, sizeof(offset));
+for (i=0; i<wordCount; ++i)
+    {
+    mustWrite(f, &offset, sizeof(offset));
+    offset += strlen(words[i]->name) + 1;
+    }
+bits64 postingStart = 0;
+for (i=0; i<wordCount; ++i)
+    {
+    mustWrite(f, &postingStart, sizeof(postingStart));
+    postingStart += ((struct wordPostings *)words[i]->val)->count;
+    }
+mustWrite(f, &postingStart, sizeof(postingStart));
+
+/* Write postings, lines and words. */
+for (i=0; i<wordCount; ++i)
+    {
+    struct wordPostings *wp = words[i]->val;
+    mustWrite(f, wp->lines, wp->count * sizeof(wp->lines[0]));
+    freez(&wp->lines);
+    }
+for (el = lineList; el != NULL; el = el->next)
+    mustWrite(f, el->name, strlen(el->name) + 1);
+for (i=0; i<wordCount; ++i)
+    mustWrite(f, words[i]->name, strlen(words[i]->name) + 1);
+carefulClose(&f);
+verbose(2, "Indexed %llu lines with %llu distinct words and %llu postings in %s\n",
+	lineCount, wordCount, postingCount, outFile);
+
+hashElFreeList(&helList);
+freeMem(words);
+hashFree(&wordHash);
+lmCleanup(&lm);
+}
+
+struct wordIndex *wordIndexOpen(char *fileName)
+/* Memory map word index in fileName and return it.  Aborts if it is not one. */
+{
+struct wordIndex *wix;
+AllocVar(wix);
+wix->fileName = cloneString(fileName);
+wix->mmapLength = fileSize(fileName);
+if (wix->mmapLength < wixHeaderSize)
+    errAbort("%s is too small to be a word index", fileName);
+FILE *f = mustOpen(fileName, "r");
+wix->mmapBytes = mmap(NULL, wix->mmapLength, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+if (wix->mmapBytes == MAP_FAILED)
+    errnoAbort("wordIndexOpen: mmap of file failed: %s", fileName);
+carefulClose(&f);
+if (memcmp(wix->mmapBytes, wixMagicBytes, sizeof(wixMagicBytes)))
+    errAbort("wordIndexOpen: magic bytes not found at start of file %s", fileName);
+wix->lineCount = *((bits64 *)(wix->mmapBytes + 8));
+wix->wordCount = *((bits64 *)(wix->mmapBytes + 16));
+wix->lineOffsets = (bits64 *)(wix->mmapBytes + wixHeaderSize);
+wix->wordOffsets = wix->lineOffsets + wix->lineCount + 1;
+wix->postingStarts = wix->wordOffsets + wix->wordCount;
+wix->postings = (bits32 *)(wix->postingStarts + wix->wordCount + 1);
+unsigned char *postingEnd = (unsigned char *)(wix->postings + wix->postingStarts[wix->wordCount]);
+if (postingEnd > wix->mmapBytes + wix->mmapLength
+ || wix->lineOffsets[wix->lineCount] > wix->mmapLength)
+    errAbort("wordIndexOpen: %s is truncated", fileName);
+return wix;
+}
+
+void wordIndexClose(struct wordIndex **pWix)
+/* Unmap and free up word index. */
+{
+struct wordIndex *wix = *pWix;
+if (wix != NULL)
+    {
+    if (munmap(wix->mmapBytes, wix->mmapLength))
+        errnoAbort("wordIndexClose: munmap failed");
+    freeMem(wix->fileName);
+    freez(pWix);
+    }
+}
+
+char *wordIndexLine(struct wordIndex *wix, bits32 lineIx)
+/* Return line lineIx of indexed text.  This is in read-only memory; do not modify. */
+{
+if (lineIx >= wix->lineCount)
+    errAbort("Line %u out of range in %s, which has %llu lines",
+	lineIx, wix->fileName, wix->lineCount);
+return (char *)(wix->mmapBytes + wix->lineOffsets[lineIx]);
+}
+
+static char *wordAt(struct wordIndex *wix, bits64 wordIx)
+/* Return word wordIx. */
+{
+return (char *)(wix->mmapBytes + wix->wordOffsets[wordIx]);
+}
+
+static void prefixRange(struct wordIndex *wix, char *prefix,
+	bits64 *retStart, bits64 *retEnd)
+/* Find the range of words that start with upper-cased prefix. */
+{
+int prefixSize = strlen(prefix);
+bits64 start = 0, end = wix->wordCount;
+/* Find first word that is not less than prefix. */
+while (start < end)
+    {
+    bits64 mid = (start + end) / 2;
+    if (strcmp(wordAt(wix, mid), prefix) < 0)
+        start = mid + 1;
+    else
+        end = mid;
+    }
+*retStart = start;
+/* Find first word after that does not start with prefix. */
+end = wix->wordCount;
+while (start < end)
+    {
+    bits64 mid = (start + end) / 2;
+    if (strncmp(wordAt(wix, mid), prefix, prefixSize) == 0)
+        start = mid + 1;
+    else
+        end = mid;
+    }
+*retEnd = start;
+}
+
+static int bits32Cmp(const void *va, const void *vb)
+/* Compare two bits32s. */
+{
+bits32 a = *((bits32 *)va), b = *((bits32 *)vb);
+return (a < b ? -1 : (a > b ? 1 : 0));
+}
+
+static bits32 *rangeLines(struct wordIndex *wix, bits64 start, bits64 end, int *retCount)
+/* Return ascending unique lines in postings of words from start to end. */
+{
+bits64 first = wix->postingStarts[start], last = wix->postingStarts[end];
+bits64 count = last - first;
+if (count == 0)
+    {
+    *retCount = 0;
+    return NULL;
+    }
+bits32 *lines = needLargeMem(count * sizeof(lines[0]));
+memcpy(lines, wix->postings + first, count * sizeof(lines[0]));
+if (end - start > 1)
+    {
+    qsort(lines, count, sizeof(lines[0]), bits32Cmp);
+    bits64 readIx, writeIx = 1;
+    for (readIx = 1; readIx < count; ++readIx)
+        if (lines[readIx] != lines[writeIx-1])
+	    lines[writeIx++] = lines[readIx];
+    count = writeIx;
+    }
+*retCount = count;
+return lines;
+}
+
+bits32 *wordIndexPrefixLines(struct wordIndex *wix, char *prefix, int *retCount)
+/* Return ascending array of numbers of lines that have a word starting with prefix,
+ * ignoring case, and put its size in *retCount.  Returns NULL if there are none.
+ * Free result with freeMem. */
+{
+char *upper = cloneString(prefix);
+touppers(upper);
+bits64 start, end;
+prefixRange(wix, upper, &start, &end);
+freeMem(upper);
+return rangeLines(wix, start, end, retCount);
+}
+
+int wordIndexIntersect(bits32 *a, int aCount, bits32 *b, int bCount, bits32 *out)
+/* Put numbers that are in both the ascending arrays a and b into out, which may be
+ * the same as a, and return how many there are. */
+{
+int aIx = 0, bIx = 0, outCount = 0;
+while (aIx < aCount && bIx < bCount)
+    {
+    if (a[aIx] < b[bIx])
+        ++aIx;
+    else if (a[aIx] > b[bIx])
+        ++bIx;
+    else
+        {
+	out[outCount++] = a[aIx];
+	++aIx;
+	++bIx;
+	}
+    }
+return outCount;
+}
+
+struct prefixCost
+/* A prefix's range of words and how many postings they have. */
+    {
+    bits64 start, end;	/* Range of words. */
+    bits64 cost;	/* Number of postings in range. */
+    };
+
+static int prefixCostCmp(const void *va, const void *vb)
+/* Compare prefixCosts by cost. */
+{
+const struct prefixCost *a = va, *b = vb;
+return (a->cost < b->cost ? -1 : (a->cost > b->cost ? 1 : 0));
+}
+
+bits32 *wordIndexSearch(struct wordIndex *wix, int prefixCount, char **prefixes,
+	int *retCount)
+/* Return ascending array of numbers of lines that have words starting with each of
+ * prefixes, ignoring case, and put its size in *retCount.  Empty prefixes match
+ * every line.  Returns NULL if there are no matches.  Free result with freeMem. */
+{
+/* Look up range of words for each prefix, and do the cheapest first so that the
+ * candidate list is small from the start. */
+struct prefixCost *costs;
+AllocArray(costs, prefixCount + 1);
+int i, rangeCount = 0;
+for (i=0; i<prefixCount; ++i)
+    {
+    if (isEmpty(prefixes[i]))
+        continue;
+    char *upper = cloneString(prefixes[i]);
+    touppers(upper);
+    struct prefixCost *pc = &costs[rangeCount++];
+    prefixRange(wix, upper, &pc->start, &pc->end);
+    pc->cost = wix->postingStarts[pc->end] - wix->postingStarts[pc->start];
+    freeMem(upper);
+    }
+qsort(costs, rangeCount, sizeof(costs[0]), prefixCostCmp);
+
+bits32 *lines = NULL;
+int lineCount = 0;
+if (rangeCount == 0)
+    {
+    if (wix->lineCount > 0)
+	{
+	lineCount = wix->lineCount;
+	lines = needLargeMem(lineCount * sizeof(lines[0]));
+	for (i=0; i<lineCount; ++i)
+	    lines[i] = i;
+	}
+    }
+else
+    {
+    lines = rangeLines(wix, costs[0].start, costs[0].end, &lineCount);
+    for (i=1; i<rangeCount && lineCount > 0; ++i)
+	{
+	int count;
+	bits32 *more = rangeLines(wix, costs[i].start, costs[i].end, &count);
+	lineCount = wordIndexIntersect(lines, lineCount, more, count, lines);
+	freeMem(more);
+	}
+    if (lineCount == 0)
+	freez(&lines);
+    }
+freeMem(costs);
+*retCount = lineCount;
+return lines;
+}
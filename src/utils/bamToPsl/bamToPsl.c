@@ -7,6 +7,8 @@
 #include "psl.h"
 #include "fa.h"
 #include "net.h"
+#include "pthreadWrap.h"
+#include "pthreadDoList.h"
 
 void usage()
 /* Explain usage and exit. */
@@ -22,6 +24,8 @@ errAbort(
   "          names not found are passed through intact\n"
   "   -nohead          - do not output the PSL header, default has header output\n"
   "   -dots=N          - output progress dot(.) every N alignments processed\n"
+  "   -threads=N       - convert alignments with N threads while another thread\n"
+  "          reads the input, default 1.  Output is the same as with one thread.\n"
   "\n"
   "Note: a chromAlias file can be obtained from a UCSC database, e.g.:\n"
   " hgsql -N -e 'select alias,chrom from chromAlias;' hg38 > hg38.chromAlias.tab\n"
@@ -39,12 +43,48 @@ static struct optionSpec options[] = {
    {"allowDups", OPTION_BOOLEAN},
    {"noSequenceVerify", OPTION_BOOLEAN},
    {"dots", OPTION_INT},
+   {"threads", OPTION_INT},
    {"querySizes", OPTION_STRING},
    {NULL, 0},
 };
 
 static int dots = 0;
 static boolean nohead = FALSE;
+static int threads = 1;
+
+/* Alignments are read in batches of chunks.  The chunks of one batch are converted in
+ * parallel and written out in order while the next batch is read. */
+#define CHUNK_SIZE 256
+#define CHUNKS_PER_THREAD 4
+
+struct bamChunk
+/* A run of alignments and the text they convert to. */
+    {
+    struct bamChunk *next;
+    bam1_t **alns;		/* Alignments, allocated once and reused. */
+    int alnCount;		/* Number of alignments read into alns. */
+    char **dnas;		/* Query sequence of each alignment for fasta, or NULL. */
+    char *pslText;		/* PSL lines for all alignments in chunk. */
+    size_t pslSize;		/* Size of pslText. */
+    };
+
+struct bamBatch
+/* A batch of chunks that are read together and then converted together. */
+    {
+    struct bamChunk *chunkList;	/* Chunks in input order. */
+    int alnCount;		/* Total alignments in all chunks. */
+    };
+
+struct convertContext
+/* Things that all chunks are converted and written with. */
+    {
+    bam_header_t *head;		/* Header of BAM. */
+    struct hash *chromAlias;	/* Alias for target names, may be NULL. */
+    FILE *f;			/* PSL output. */
+    FILE *faF;			/* Fasta output, may be NULL. */
+    struct hash *fastaDoneSeqs;	/* Names of sequences already in fasta output. */
+    struct bamBatch *batch;	/* Batch being converted. */
+    };
 
 static struct hash *hashChromAlias(char *fileName)
 /* Read two column file into hash keyed by first column */
@@ -67,28 +107,133 @@ static void convertToPsl(bam1_t *aln, bam_header_t *head, struct hash *chromAlia
 struct psl *psl = bamToPslUnscored2(aln, head, TRUE);
 if (psl != NULL)
     {
+    char *tName = psl->tName;
     if (chromAlias)
         {
         struct hashEl *hel = NULL;
         if ((hel = hashLookup(chromAlias, psl->tName)) != NULL)
-            psl->tName = cloneString((char *)hel->val); /* memory leak */
+            psl->tName = (char *)hel->val;
         }
-    pslTabOut(psl, f);  /* no free of this psl data, memory leak */
+    pslTabOut(psl, f);
+    psl->tName = tName;
     pslFree(&psl);
     }
 }
 
-static void convertToFasta(bam1_t *aln, struct hash *fastaDoneSeqs, FILE *faF)
-/* output a FASTA record of the query sequence */
+static void convertChunk(void *item, void *context)
+/* Convert alignments in chunk to PSL text and get their query sequences if needed.
+ * Called by pthreadDoList. */
+{
+struct bamChunk *chunk = item;
+struct convertContext *cc = context;
+FILE *f = open_memstream(&chunk->pslText, &chunk->pslSize);
+if (f == NULL)
+    errnoAbort("Can't open memory stream for PSL text");
+int i;
+for (i = 0; i < chunk->alnCount; ++i)
+    {
+    bam1_t *aln = chunk->alns[i];
+    if (aln->core.n_cigar != 0)
+        convertToPsl(aln, cc->head, cc->chromAlias, f);
+    // supplementary are not include as they don't have full sequence
+    if (cc->faF != NULL && (aln->core.flag & BAM_FSUPPLEMENTARY) == 0)
+        chunk->dnas[i] = bamGetQuerySequence(aln, TRUE);
+    }
+carefulClose(&f);
+}
+
+static void writeChunk(struct bamChunk *chunk, struct convertContext *cc)
+/* Write out converted chunk, and first occurrence of each query to fasta. */
+{
+mustWrite(cc->f, chunk->pslText, chunk->pslSize);
+freez(&chunk->pslText);
+chunk->pslSize = 0;
+int i;
+for (i = 0; i < chunk->alnCount; ++i)
+    {
+    char *dna = chunk->dnas[i];
+    if (dna != NULL)
+        {
+        char *qName = bam1_qname(chunk->alns[i]);
+        if (hashLookup(cc->fastaDoneSeqs, qName) == NULL) // first seen
+            {
+            hashAddInt(cc->fastaDoneSeqs, qName, TRUE);
+            faWriteNext(cc->faF, qName, dna, strlen(dna));
+            }
+        freez(&chunk->dnas[i]);
+        }
+    }
+}
+
+static void *convertBatch(void *context)
+/* Convert chunks of batch in parallel and then write them in order. */
 {
-char *dna = bamGetQuerySequence(aln, TRUE);
-char *qName = bam1_qname(aln);
-if (hashLookup(fastaDoneSeqs, qName) == NULL) // first seen
+struct convertContext *cc = context;
+struct bamChunk *chunk;
+pthreadDoList(threads, cc->batch->chunkList, convertChunk, cc);
+for (chunk = cc->batch->chunkList; chunk != NULL; chunk = chunk->next)
+    writeChunk(chunk, cc);
+return NULL;
+}
+
+static struct bamBatch *bamBatchNew(int chunkCount)
+/* Allocate a batch of chunkCount chunks. */
+{
+struct bamBatch *batch;
+AllocVar(batch);
+int i, j;
+for (i = 0; i < chunkCount; ++i)
+    {
+    struct bamChunk *chunk;
+    AllocVar(chunk);
+    AllocArray(chunk->alns, CHUNK_SIZE);
+    AllocArray(chunk->dnas, CHUNK_SIZE);
+    for (j = 0; j < CHUNK_SIZE; ++j)
+        chunk->alns[j] = bam_init1();
+    slAddHead(&batch->chunkList, chunk);
+    }
+return batch;
+}
+
+static void bamBatchFree(struct bamBatch **pBatch)
+/* Free batch and its alignments. */
+{
+struct bamBatch *batch = *pBatch;
+if (batch == NULL)
+    return;
+struct bamChunk *chunk;
+for (chunk = batch->chunkList; chunk != NULL; chunk = chunk->next)
+    {
+    int i;
+    for (i = 0; i < CHUNK_SIZE; ++i)
+        bam_destroy1(chunk->alns[i]);
+    freeMem(chunk->alns);
+    freeMem(chunk->dnas);
+    }
+slFreeList(&batch->chunkList);
+freez(pBatch);
+}
+
+static int readBatch(samfile_t *in, bam_header_t *head, struct bamBatch *batch)
+/* Read alignments into chunks of batch until it is full or input ends.  Return count read. */
+{
+struct bamChunk *chunk;
+batch->alnCount = 0;
+for (chunk = batch->chunkList; chunk != NULL; chunk = chunk->next)
     {
-    hashAddInt(fastaDoneSeqs, qName, TRUE);
-    faWriteNext(faF, qName, dna, strlen(dna));
+    chunk->alnCount = 0;
+    while (chunk->alnCount < CHUNK_SIZE && sam_read1(in, head, chunk->alns[chunk->alnCount]) >= 0)
+        ++chunk->alnCount;
+    batch->alnCount += chunk->alnCount;
+    if (chunk->alnCount < CHUNK_SIZE)
+        {
+        // End of input, so rest of chunks are empty.
+        for (chunk = chunk->next; chunk != NULL; chunk = chunk->next)
+            chunk->alnCount = 0;
+        break;
+        }
     }
-freez(&dna);
+return batch->alnCount;
 }
 
 static void bamToPsl(char *inBam, char *outPsl, char *outFasta, char *aliasFile)
@@ -120,31 +265,37 @@ if (outFasta != NULL)
     fastaDoneSeqs = hashNew(20);
     }
 
-bam1_t one;
-ZeroVar(&one);	// This seems to be necessary!
-/* Write next sequence to fa file. */
-for (;;)
+/* Read a batch while the one before is converted and written by another thread. */
+struct convertContext cc = {head, chromAlias, f, faF, fastaDoneSeqs, NULL};
+int chunkCount = threads * CHUNKS_PER_THREAD;
+struct bamBatch *readingBatch = bamBatchNew(chunkCount), *convertingBatch = NULL;
+pthread_t converter;
+unsigned long long lastDot = 0;
+while (readBatch(in, head, readingBatch) > 0)
     {
-    if (sam_read1(in, head, &one) < 0)
-	{
-	break;
-	}
-    if (one.core.n_cigar != 0)
-        {
-        convertToPsl(&one, head, chromAlias, f);
-        }
-    if ((faF != NULL) && ((one.core.flag & BAM_FSUPPLEMENTARY) == 0))
-        {
-        // supplementary are not include as they don't have full sequence
-        convertToFasta(&one, fastaDoneSeqs, faF);
-        }
-    ++processCount;
+    if (convertingBatch == NULL)
+        convertingBatch = bamBatchNew(chunkCount);
+    else if (threads > 1)
+        pthreadJoin(&converter, NULL);
+    struct bamBatch *temp = convertingBatch;
+    convertingBatch = readingBatch;
+    readingBatch = temp;
+    cc.batch = convertingBatch;
+    if (threads > 1)
+        pthreadCreate(&converter, NULL, convertBatch, &cc);
+    else
+        convertBatch(&cc);
+    processCount += convertingBatch->alnCount;
     if (dots)
-       if (0 == processCount % dots)
-          verbose(1,".");
+        for (; lastDot + dots <= processCount; lastDot += dots)
+            verbose(1,".");
     }
-    if (dots)
-       verbose(1,"\n");
+if (convertingBatch != NULL && threads > 1)
+    pthreadJoin(&converter, NULL);
+if (dots)
+    verbose(1,"\n");
+bamBatchFree(&readingBatch);
+bamBatchFree(&convertingBatch);
 
 samclose(in);
 carefulClose(&f);
@@ -162,6 +313,9 @@ char *aliasFile = optionVal("chromAlias", NULL);
 
 dots = optionInt("dots", dots);
 nohead = optionExists("nohead");
+threads = optionInt("threads", threads);
+if (threads < 1)
+    errAbort("-threads must be at least 1");
 if (optionExists("allowDups"))
     fprintf(stderr, "Note: -allowDups is obsolete and ignored");
 if (optionExists("noSequenceVerify"))
@@ -21,6 +21,7 @@ int clEnd = -1;
 char *clBed = NULL;
 boolean header = FALSE;
 boolean tsv = FALSE;
+int threads = 4;
 
 void usage()
 /* Explain usage and exit. */
@@ -37,6 +38,8 @@ errAbort(
   "   -udcDir=/dir/to/cache - place to put cache for remote bigBed/bigWigs\n"
   "   -header - output a autoSql-style header (starts with '#').\n"
   "   -tsv - output a TSV header (without '#').\n"
+  "   -threads=N - number of threads used to uncompress blocks. Default %d\n"
+  , threads
   );
 }
 
@@ -48,34 +51,54 @@ static struct optionSpec options[] = {
    {"udcDir", OPTION_STRING},
    {"header", OPTION_BOOLEAN},
    {"tsv", OPTION_BOOLEAN},
+   {"threads", OPTION_INT},
    {NULL, 0},
 };
 
-static void writeFeatures(struct bbiFile *bbi, char *chromName, int start, int end, int itemsLeft, struct lm *lm, FILE *f)
+static char *unsignedToAscii(unsigned x, char *end)
+/* Write x in decimal so that it ends just before end, and return where it starts. */
 {
-    struct bigBedInterval *interval, *intervalList = bigBedIntervalQuery(bbi, chromName, 
-    	start, end, itemsLeft, lm);
-    for (interval = intervalList; interval != NULL; interval = interval->next)
+do
+    {
+    *(--end) = '0' + x%10;
+    x /= 10;
+    }
+while (x != 0);
+return end;
+}
+
+static void writeFeatures(struct bbiFile *bbi, char *chromName, int start, int end, FILE *f)
+/* Write items overlapping chromName:start-end, or all items if chromName is NULL. */
+{
+struct bigBedStream *bbs = bigBedStreamOpen(bbi, chromName, start, end, threads);
+struct bigBedInterval *interval;
+char buf[32], *bufEnd = buf + sizeof(buf);
+while ((interval = bigBedStreamNext(bbs)) != NULL)
+    {
+    fputs(bbs->chrom, f);
+    char *s = unsignedToAscii(interval->end, bufEnd);
+    *(--s) = '\t';
+    s = unsignedToAscii(interval->start, s);
+    *(--s) = '\t';
+    fwrite(s, 1, bufEnd - s, f);
+    char *rest = interval->rest;
+    if (rest != NULL)
 	{
-	fprintf(f, "%s\t%u\t%u", chromName, interval->start, interval->end);
-	char *rest = interval->rest;
-	if (rest != NULL)
-	    fprintf(f, "\t%s\n", rest);
-	else
-	    fprintf(f, "\n");
+	fputc('\t', f);
+	fputs(rest, f);
 	}
+    fputc('\n', f);
+    }
+bigBedStreamClose(&bbs);
 }
 
 static void bigBedToBedFromBed(struct bbiFile *bbi, char *bedFileName, FILE *outFile)
+/* Write items overlapping each region in bed file. */
 {
 struct bed *bed, *bedList = bedLoadNAll(bedFileName, 3);
-int itemsLeft = 0;
-struct lm *lm = lmInit(0);
 for (bed = bedList; bed != NULL; bed = bed->next)
-    {
-    writeFeatures(bbi, bed->chrom, bed->chromStart, bed->chromEnd, itemsLeft, lm, outFile);
-    }
-lmCleanup(&lm);
+    writeFeatures(bbi, bed->chrom, bed->chromStart, bed->chromEnd, outFile);
+bedFreeList(&bedList);
 }
 
 void bigBedToBed(char *inFile, char *outFile)
@@ -89,28 +112,25 @@ else if (tsv)
     bigBedCmdOutputTsvHeader(bbi, f);
 
 if (clBed != NULL)
-    {
     bigBedToBedFromBed(bbi, clBed, f);
-    return;
-    }
-
-struct bbiChromInfo *chrom, *chromList = bbiChromList(bbi);
-for (chrom = chromList; chrom != NULL; chrom = chrom->next)
+else if (clChrom == NULL && clStart <= 0 && clEnd <= 0)
+    writeFeatures(bbi, NULL, 0, 0, f);
+else
     {
-    if (clChrom != NULL && !sameString(clChrom, chrom->name))
-        continue;
-    char *chromName = chrom->name;
-    int start = 0, end = chrom->size;
-    if (clStart > 0)
-        start = clStart;
-    if (clEnd > 0)
-        end = clEnd;
-    int itemsLeft = 0;	// Zero actually means no limit.... 
-    struct lm *lm = lmInit(0);
-    writeFeatures(bbi, chromName, start, end, itemsLeft, lm, f);
-    lmCleanup(&lm);
+    struct bbiChromInfo *chrom, *chromList = bbiChromList(bbi);
+    for (chrom = chromList; chrom != NULL; chrom = chrom->next)
+	{
+	if (clChrom != NULL && !sameString(clChrom, chrom->name))
+	    continue;
+	int start = 0, end = chrom->size;
+	if (clStart > 0)
+	    start = clStart;
+	if (clEnd > 0)
+	    end = clEnd;
+	writeFeatures(bbi, chrom->name, start, end, f);
+	}
+    bbiChromInfoFreeList(&chromList);
     }
-bbiChromInfoFreeList(&chromList);
 carefulClose(&f);
 bbiFileClose(&bbi);
 }
@@ -126,6 +146,7 @@ clBed = optionVal("bed", clBed);
 udcSetDefaultDir(optionVal("udcDir", udcDefaultDir()));
 header = optionExists("header");
 tsv = optionExists("tsv");
+threads = optionInt("threads", threads);
 if (header & tsv)
     errAbort("can't specify both -header and -tsv");
 if (argc != 3)
@@ -13,11 +13,16 @@
 #include "bigBed.h"
 #include "bigWig.h"
 #include "genomeRangeTree.h"
+#include "pthreadDoList.h"
 
 char *restrictFile = NULL;
 double threshold = FLT_MAX;
 boolean rootNames = FALSE;
 boolean ignoreMissing = FALSE;
+int binSize = 1;
+int threads = 1;
+char *matrixFile = NULL;
+long long maxWindowBytes = 512*1024*1024LL;	/* Memory for data of all inputs in a window. */
 
 void usage()
 /* Explain usage and exit. */
@@ -35,6 +40,15 @@ errAbort(
   "                names when using listOfFiles\n"
   "   -ignoreMissing - if set do not correlate where either side is missing data\n"
   "                Normally missing data is treated as zeros\n"
+  "The listOfFiles form reads each file once, a window of each chromosome at a time,\n"
+  "and correlates all pairs in the window together.  It prints lines of\n"
+  "   <fileA> <fileB> <correlation>\n"
+  "which can be used as the -precalc file of bigWigCluster.  Options for it are:\n"
+  "   -binSize=N - correlate averages over bins of N bases rather than single bases.\n"
+  "                Default %d\n"
+  "   -threads=N - number of threads to read files and correlate pairs with. Default %d\n"
+  "   -matrix=out.tab - also write a square matrix of correlations to out.tab\n"
+  , binSize, threads
   );
 }
 
@@ -44,6 +58,9 @@ static struct optionSpec options[] = {
    {"threshold", OPTION_DOUBLE},
    {"rootNames", OPTION_BOOLEAN},
    {"ignoreMissing", OPTION_BOOLEAN},
+   {"binSize", OPTION_INT},
+   {"threads", OPTION_INT},
+   {"matrix", OPTION_STRING},
    {NULL, 0},
 };
 
@@ -153,36 +170,360 @@ struct correlate *c = bigWigCorrelate(aFileName, bFileName);
 printf("%g\n", correlateResult(c));
 }
 
+struct bwInput
+/* A bigWig being correlated with others, and its data in the current window. */
+    {
+    struct bwInput *next;
+    char *fileName;		/* Name of file. */
+    char *name;			/* Name to report file as. */
+    struct bbiFile *bbi;	/* Open file. */
+    struct hash *chromSizes;	/* Sizes of chromosomes in file. */
+    boolean present;		/* TRUE if window's chromosome is in file. */
+    double *vals;		/* Values in window, clipped to threshold, 0 if missing. */
+    UBYTE *cov;			/* Nonzero where there is data in window. */
+    double *samples;		/* Values of bases or bins correlated, may be same as vals. */
+    UBYTE *sampleCov;		/* Nonzero where sample has data, may be same as cov. */
+    int sampleCount;		/* Number of samples in window. */
+    double sumX, sumXX;		/* Sum of samples and their squares. */
+    };
+
+struct bwWindow
+/* A part of a chromosome that all inputs are loaded for at once. */
+    {
+    char *chrom;		/* Chromosome name. */
+    int start, end;		/* Bounds of window, start is a multiple of binSize. */
+    struct range *rangeList;	/* Restricting ranges overlapping window, or NULL for all. */
+    int sampleCount;		/* Number of samples in window. */
+    };
+
+struct bwCorrelation
+/* Correlations of all pairs of inputs. */
+    {
+    struct bwInput **inputs;	/* Array of inputs. */
+    int inputCount;		/* Size of inputs array. */
+    struct correlate *pairs;	/* Correlation of inputs i and j at pairs[i*inputCount+j], i<j. */
+    struct bwWindow *window;	/* Current window. */
+    };
+
+struct bwRow
+/* Row of correlation matrix, for the threads to work on. */
+    {
+    struct bwRow *next;
+    int ix;			/* Input compared to all later ones. */
+    };
+
+static void addSample(struct bwInput *in, int sampleIx, double sum, int baseCount, int covCount)
+/* Set up sample from sum of values over baseCount bases, covCount of them with data. */
+{
+if (ignoreMissing)
+    {
+    in->sampleCov[sampleIx] = (covCount > 0);
+    in->samples[sampleIx] = (covCount > 0 ? sum/covCount : 0);
+    }
+else
+    {
+    in->sampleCov[sampleIx] = TRUE;
+    in->samples[sampleIx] = sum/baseCount;
+    }
+}
+
+static int makeSamples(struct bwInput *in, struct bwWindow *win)
+/* Fill in samples from window values, one per binSize bases that have some bases
+ * in the restricting ranges.  Returns number of samples. */
+{
+struct range wholeWindow = {NULL, win->start, win->end, NULL};
+struct range *r, *rangeList = (win->rangeList != NULL ? win->rangeList : &wholeWindow);
+int sampleCount = 0, curBin = -1, baseCount = 0, covCount = 0;
+double sum = 0;
+for (r = rangeList; r != NULL; r = r->next)
+    {
+    int s = max(r->start, win->start), e = min(r->end, win->end);
+    int pos;
+    for (pos = s; pos < e; ++pos)
+        {
+	int bin = pos/binSize;
+	if (bin != curBin)
+	    {
+	    if (baseCount > 0)
+	        addSample(in, sampleCount++, sum, baseCount, covCount);
+	    curBin = bin;
+	    sum = 0;
+	    baseCount = covCount = 0;
+	    }
+	int i = pos - win->start;
+	++baseCount;
+	if (in->cov[i])
+	    {
+	    sum += in->vals[i];
+	    ++covCount;
+	    }
+	}
+    }
+if (baseCount > 0)
+    addSample(in, sampleCount++, sum, baseCount, covCount);
+return sampleCount;
+}
+
+static void loadWindow(void *item, void *context)
+/* Load data in window for one input and figure out its samples.  Called by pthreadDoList. */
+{
+struct bwInput *in = item;
+struct bwWindow *win = context;
+int size = win->end - win->start;
+zeroBytes(in->vals, size * sizeof(in->vals[0]));
+zeroBytes(in->cov, size * sizeof(in->cov[0]));
+in->present = (hashLookup(in->chromSizes, win->chrom) != NULL);
+if (in->present)
+    {
+    struct lm *lm = lmInit(0);
+    struct bbiInterval *iv, *ivList = bigWigIntervalQuery(in->bbi, win->chrom,
+	win->start, win->end, lm);
+    for (iv = ivList; iv != NULL; iv = iv->next)
+        {
+	double val = iv->val;
+	if (val > threshold)
+	    val = threshold;
+	int s = max(iv->start, win->start) - win->start;
+	int e = min(iv->end, win->end) - win->start;
+	int i;
+	for (i=s; i<e; ++i)
+	    {
+	    in->vals[i] = val;
+	    in->cov[i] = TRUE;
+	    }
+	}
+    lmCleanup(&lm);
+    }
+
+/* Make samples, which are just the values when correlating all bases one at a time. */
+if (binSize == 1 && win->rangeList == NULL)
+    {
+    in->samples = in->vals;
+    in->sampleCov = in->cov;
+    in->sampleCount = size;
+    }
+else
+    in->sampleCount = makeSamples(in, win);
+
+in->sumX = in->sumXX = 0;
+int i;
+for (i=0; i<in->sampleCount; ++i)
+    {
+    double x = in->samples[i];
+    in->sumX += x;
+    in->sumXX += x*x;
+    }
+}
+
+static void correlateRow(void *item, void *context)
+/* Add samples in window to correlations of an input with all later inputs.
+ * Called by pthreadDoList. */
+{
+struct bwRow *row = item;
+struct bwCorrelation *bwc = context;
+struct bwInput *a = bwc->inputs[row->ix];
+int sampleCount = bwc->window->sampleCount;
+if (!a->present)
+    return;
+double *x = a->samples;
+UBYTE *xCov = a->sampleCov;
+int j;
+for (j = row->ix+1; j < bwc->inputCount; ++j)
+    {
+    struct bwInput *b = bwc->inputs[j];
+    if (!b->present)
+        continue;
+    double *y = b->samples;
+    struct correlate *c = &bwc->pairs[row->ix*bwc->inputCount + j];
+    int i;
+    if (ignoreMissing)
+        {
+	UBYTE *yCov = b->sampleCov;
+	for (i=0; i<sampleCount; ++i)
+	    {
+	    if (xCov[i] && yCov[i])
+		correlateNext(c, x[i], y[i]);
+	    }
+	}
+    else
+        {
+	double sumXY = 0;
+	for (i=0; i<sampleCount; ++i)
+	    sumXY += x[i] * y[i];
+	c->sumXY += sumXY;
+	c->sumX += a->sumX;
+	c->sumY += b->sumX;
+	c->sumXX += a->sumXX;
+	c->sumYY += b->sumXX;
+	c->n += sampleCount;
+	}
+    }
+}
+
+static struct slName *allChromNames(struct bwInput *inList, struct hash *sizeHash)
+/* Return sorted list of chromosomes in any input, and put largest size of each
+ * in sizeHash. */
+{
+struct slName *nameList = NULL;
+struct bwInput *in;
+for (in = inList; in != NULL; in = in->next)
+    {
+    struct bbiChromInfo *chrom, *chromList = bbiChromList(in->bbi);
+    for (chrom = chromList; chrom != NULL; chrom = chrom->next)
+        {
+	hashAddInt(in->chromSizes, chrom->name, chrom->size);
+	struct hashEl *hel = hashLookup(sizeHash, chrom->name);
+	if (hel == NULL)
+	    {
+	    hashAddInt(sizeHash, chrom->name, chrom->size);
+	    slNameAddHead(&nameList, chrom->name);
+	    }
+	else if (ptToInt(hel->val) < chrom->size)
+	    hel->val = intToPt(chrom->size);
+	}
+    bbiChromInfoFreeList(&chromList);
+    }
+slNameSort(&nameList);
+return nameList;
+}
+
+static struct bwInput *bwInputListOpen(char **fileNames, int fileCount, int windowSize)
+/* Open all files, allocating space for windowSize values of each. */
+{
+struct bwInput *inList = NULL;
+int i;
+for (i=0; i<fileCount; ++i)
+    {
+    struct bwInput *in;
+    AllocVar(in);
+    in->fileName = fileNames[i];
+    char name[FILENAME_LEN];
+    if (rootNames)
+	splitPath(in->fileName, NULL, name, NULL);
+    else
+	safef(name, sizeof(name), "%s", in->fileName);
+    in->name = cloneString(name);
+    in->bbi = bigWigFileOpen(in->fileName);
+    in->chromSizes = hashNew(0);
+    AllocArray(in->vals, windowSize);
+    AllocArray(in->cov, windowSize);
+    if (binSize > 1 || restrictFile != NULL)
+        {
+	AllocArray(in->samples, windowSize);
+	AllocArray(in->sampleCov, windowSize);
+	}
+    slAddHead(&inList, in);
+    }
+slReverse(&inList);
+return inList;
+}
+
+static void writeMatrix(char *fileName, struct bwCorrelation *bwc)
+/* Write out square matrix of correlations with a header row of names. */
+{
+FILE *f = mustOpen(fileName, "w");
+int count = bwc->inputCount;
+int i, j;
+fprintf(f, "name");
+for (i=0; i<count; ++i)
+    fprintf(f, "\t%s", bwc->inputs[i]->name);
+fprintf(f, "\n");
+for (i=0; i<count; ++i)
+    {
+    fprintf(f, "%s", bwc->inputs[i]->name);
+    for (j=0; j<count; ++j)
+        {
+	if (i == j)
+	    fprintf(f, "\t1");
+	else
+	    {
+	    struct correlate *c = &bwc->pairs[min(i,j)*count + max(i,j)];
+	    fprintf(f, "\t%g", correlateResult(c));
+	    }
+	}
+    fprintf(f, "\n");
+    }
+carefulClose(&f);
+}
+
 void bigWigCorrelateList(char *listFile)
-/* Correlate all files in list to each other */
+/* Correlate all files in list to each other, reading each file once and going
+ * through the genome a window at a time. */
 {
 char **fileNames = NULL;
 int fileCount = 0;
 char *buf = NULL;
 readAllWords(listFile, &fileNames, &fileCount, &buf);
+if (fileCount < 2)
+    errAbort("Need at least two files in %s", listFile);
+
+/* Figure out window size, a multiple of binSize that keeps values within bounds. */
+long long bytesPerBase = 2 * (sizeof(double) + 1);
+int windowSize = maxWindowBytes / (bytesPerBase * fileCount);
+windowSize -= windowSize % binSize;
+if (windowSize < binSize)
+    windowSize = binSize;
+
+/* Open inputs and set up structures to hold results. */
+struct genomeRangeTree *targetGrt = NULL;
+if (restrictFile)
+    targetGrt = grtFromBigBed(restrictFile);
+struct bwInput *in, *inList = bwInputListOpen(fileNames, fileCount, windowSize);
+struct bwCorrelation bwc;
+ZeroVar(&bwc);
+bwc.inputCount = fileCount;
+AllocArray(bwc.inputs, fileCount);
 int i;
-for (i=0; i<fileCount; ++i)
+for (i = 0, in = inList; in != NULL; in = in->next, ++i)
+    bwc.inputs[i] = in;
+AllocArray(bwc.pairs, fileCount*fileCount);
+struct bwRow *rowList = NULL;
+for (i = fileCount-2; i >= 0; --i)
     {
-    char *aPath = fileNames[i];
-    char aName[FILENAME_LEN];
-    if (rootNames)
-	splitPath(aPath, NULL, aName, NULL);
-    else
-        safef(aName, sizeof(aName), "%s", aPath);
-    int j;
-    for (j=i+1; j<fileCount; ++j)
+    struct bwRow *row;
+    AllocVar(row);
+    row->ix = i;
+    slAddHead(&rowList, row);
+    }
+
+/* Load each window of each chromosome for all inputs, and then correlate them. */
+struct hash *sizeHash = hashNew(0);
+struct slName *chrom, *chromList = allChromNames(inList, sizeHash);
+for (chrom = chromList; chrom != NULL; chrom = chrom->next)
+    {
+    int chromSize = hashIntVal(sizeHash, chrom->name);
+    struct rbTree *targetRanges = NULL;
+    if (targetGrt != NULL)
+	targetRanges = genomeRangeTreeFindRangeTree(targetGrt, chrom->name);
+    verbose(2, "Correlating %s\n", chrom->name);
+    struct bwWindow window;
+    ZeroVar(&window);
+    window.chrom = chrom->name;
+    for (window.start = 0; window.start < chromSize; window.start += windowSize)
         {
-	char *bPath = fileNames[j];
-	char bName[FILENAME_LEN];
-	if (rootNames)
-	    splitPath(bPath, NULL, bName, NULL);
-	else
-	    safef(bName, sizeof(bName), "%s", bPath);
-	struct correlate *c = bigWigCorrelate(aPath, bPath);
-	printf("%s\t%s\t%g\n", aName, bName, correlateResult(c));
-	correlateFree(&c);
+	window.end = min(chromSize, window.start + windowSize);
+	if (targetRanges != NULL)
+	    {
+	    window.rangeList = rangeTreeAllOverlapping(targetRanges, window.start, window.end);
+	    if (window.rangeList == NULL)
+	        continue;
+	    }
+	pthreadDoList(threads, inList, loadWindow, &window);
+	window.sampleCount = inList->sampleCount;	/* Same for all inputs. */
+	bwc.window = &window;
+	pthreadDoList(threads, rowList, correlateRow, &bwc);
 	}
     }
+
+/* Write results. */
+int j;
+for (i=0; i<fileCount; ++i)
+    for (j=i+1; j<fileCount; ++j)
+	printf("%s\t%s\t%g\n", bwc.inputs[i]->name, bwc.inputs[j]->name,
+	    correlateResult(&bwc.pairs[i*fileCount + j]));
+if (matrixFile != NULL)
+    writeMatrix(matrixFile, &bwc);
+genomeRangeTreeFree(&targetGrt);
 }
 
 int main(int argc, char *argv[])
@@ -192,6 +533,11 @@ optionInit(&argc, argv, options);
 if (argc != 2 && argc != 3)
     usage();
 restrictFile = optionVal("restrict", restrictFile);
+binSize = optionInt("binSize", binSize);
+if (binSize < 1)
+    errAbort("binSize must be at least 1");
+threads = optionInt("threads", threads);
+matrixFile = optionVal("matrix", matrixFile);
 threshold = optionDouble("threshold", threshold);
 rootNames = optionExists("rootNames");
 ignoreMissing = optionExists("ignoreMissing");
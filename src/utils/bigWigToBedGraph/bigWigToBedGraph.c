@@ -10,11 +10,13 @@
 #include "udc.h"
 #include "bigWig.h"
 #include "obscure.h"
+#include "numText.h"
 
 
 char *clChrom = NULL;
 int clStart = -1;
 int clEnd = -1;
+int threads = 4;
 
 void usage()
 /* Explain usage and exit. */
@@ -28,6 +30,8 @@ errAbort(
   "   -start=N - if set, restrict output to only that over start\n"
   "   -end=N - if set, restict output to only that under end\n"
   "   -udcDir=/dir/to/cache - place to put cache for remote bigBed/bigWigs\n"
+  "   -threads=N - number of threads used to uncompress blocks. Default %d\n"
+  , threads
   );
 }
 
@@ -36,58 +40,74 @@ static struct optionSpec options[] = {
    {"start", OPTION_INT},
    {"end", OPTION_INT},
    {"udcDir", OPTION_STRING},
+   {"threads", OPTION_INT},
    {NULL, 0},
 };
 
+static void writeBedGraph(char *chrom, bits32 start, bits32 end, double val, FILE *f)
+/* Write out one bedGraph line. */
+{
+char buf[3*NUM_TEXT_MAX_SIZE], *s = buf;
+*s++ = '\t';
+s += numTextUnsigned(s, start);
+*s++ = '\t';
+s += numTextUnsigned(s, end);
+*s++ = '\t';
+s += numTextDouble(s, val);
+*s++ = '\n';
+fputs(chrom, f);
+fwrite(buf, 1, s - buf, f);
+}
+
+static void writeIntervals(struct bbiFile *bwf, char *chromName, int start, int end, FILE *f)
+/* Write intervals overlapping chromName:start-end, or all intervals if chromName is
+ * NULL, merging adjacent intervals with the same value. */
+{
+struct bigWigStream *bws = bigWigStreamOpen(bwf, chromName, start, end, threads);
+struct bbiInterval *interval;
+char *saveChrom = NULL;
+bits32 saveStart = 0, prevEnd = 0;
+double saveVal = -1.0;
+while ((interval = bigWigStreamNext(bws)) != NULL)
+    {
+    if (saveChrom != bws->chrom || prevEnd != interval->start || saveVal != interval->val)
+	{
+	if (saveChrom != NULL)
+	    writeBedGraph(saveChrom, saveStart, prevEnd, saveVal, f);
+	saveChrom = bws->chrom;
+	saveStart = interval->start;
+	saveVal = interval->val;
+	}
+    prevEnd = interval->end;
+    }
+if (saveChrom != NULL)
+    writeBedGraph(saveChrom, saveStart, prevEnd, saveVal, f);
+bigWigStreamClose(&bws);
+}
+
 void bigWigToBedGraph(char *inFile, char *outFile)
 /* bigWigToBedGraph - Convert from bigWig to bedGraph format.. */
 {
 struct bbiFile *bwf = bigWigFileOpen(inFile);
 FILE *f = mustOpen(outFile, "w");
-struct bbiChromInfo *chrom, *chromList = bbiChromList(bwf);
-for (chrom = chromList; chrom != NULL; chrom = chrom->next)
+if (clChrom == NULL && clStart <= 0 && clEnd <= 0)
+    writeIntervals(bwf, NULL, 0, 0, f);
+else
     {
-    boolean firstTime = TRUE;
-    int saveStart = -1, prevEnd = -1;
-    double saveVal = -1.0;
-
-    if (clChrom != NULL && !sameString(clChrom, chrom->name))
-        continue;
-    char *chromName = chrom->name;
-    struct lm *lm = lmInit(0);
-    int start = 0, end = chrom->size;
-    if (clStart > 0)
-        start = clStart;
-    if (clEnd > 0)
-        end = clEnd;
-    struct bbiInterval *interval, *intervalList = bigWigIntervalQuery(bwf, chromName, 
-    	start, end, lm);
-    for (interval = intervalList; interval != NULL; interval = interval->next)
+    struct bbiChromInfo *chrom, *chromList = bbiChromList(bwf);
+    for (chrom = chromList; chrom != NULL; chrom = chrom->next)
 	{
-	if (firstTime)
-	    {
-	    saveStart = interval->start;
-	    saveVal = interval->val;
-	    firstTime = FALSE;
-	    }
-	else
-	    {
-	    if (!((prevEnd == interval->start) && (saveVal == interval->val)))
-		{
-		fprintf(f, "%s\t%u\t%u\t%g\n", chromName, saveStart, prevEnd, saveVal);
-		saveStart = interval->start;
-		saveVal = interval->val;
-		}
-
-	    }
-	prevEnd = interval->end;
+	if (clChrom != NULL && !sameString(clChrom, chrom->name))
+	    continue;
+	int start = 0, end = chrom->size;
+	if (clStart > 0)
+	    start = clStart;
+	if (clEnd > 0)
+	    end = clEnd;
+	writeIntervals(bwf, chrom->name, start, end, f);
 	}
-    if (!firstTime)
-	fprintf(f, "%s\t%u\t%u\t%g\n", chromName, saveStart, prevEnd, saveVal);
-
-    lmCleanup(&lm);
+    bbiChromInfoFreeList(&chromList);
     }
-bbiChromInfoFreeList(&chromList);
 carefulClose(&f);
 bbiFileClose(&bwf);
 }
@@ -100,6 +120,7 @@ clChrom = optionVal("chrom", clChrom);
 clStart = optionInt("start", clStart);
 clEnd = optionInt("end", clEnd);
 udcSetDefaultDir(optionVal("udcDir", udcDefaultDir()));
+threads = optionInt("threads", threads);
 if (argc != 3)
     usage();
 bigWigToBedGraph(argv[1], argv[2]);
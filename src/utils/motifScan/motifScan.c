@@ -0,0 +1,396 @@
+/* motifScan - scan sequence for matches to many position weight matrix motifs. */
+
+/* This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+
+#include "common.h"
+#include "linefile.h"
+#include "options.h"
+#include "localmem.h"
+#include "sqlNum.h"
+#include "sqlList.h"
+#include "dnautil.h"
+#include "dnaseq.h"
+#include "dnaLoad.h"
+#include "dnaMarkov.h"
+#include "dnaMotif.h"
+#include "dnaMotifScan.h"
+#include "portable.h"
+#include "pthreadDoList.h"
+
+double threshold = 0.85;	/* Relative threshold, fraction of way from min to max score. */
+double minScore = -INFINITY;	/* Absolute threshold in bits, overrides threshold if set. */
+boolean doPlus = TRUE, doMinus = TRUE;	/* Strands to scan. */
+boolean seqBackground = FALSE;	/* Use base composition of each sequence as background. */
+int threads = 1;		/* Number of threads to scan with. */
+boolean bench = FALSE;		/* Compare against dnaMotifBitScore and time both. */
+
+void usage()
+/* Explain usage and exit. */
+{
+errAbort(
+  "motifScan - scan sequence for matches to many position weight matrix motifs\n"
+  "usage:\n"
+  "   motifScan motifs.tab sequence output.bed\n"
+  "where:\n"
+  "   motifs.tab is a tab separated file of dnaMotifs as in the transfac and\n"
+  "       factorSource motif tables: name, columnCount, then comma separated\n"
+  "       lists of A, C, G and T probabilities for each column.\n"
+  "   sequence is a .fa, .nib or .2bit file, or a file which is a list of\n"
+  "       sequence files.\n"
+  "   output.bed gets a line for each match: chrom, start, end, motif name,\n"
+  "       log2-odds score in bits, and strand.\n"
+  "options:\n"
+  "   -threshold=0.N - report matches scoring at least this fraction of the way\n"
+  "       from the lowest to the highest score possible for the motif. Default %g\n"
+  "   -minScore=N - report matches scoring at least N bits, instead of -threshold.\n"
+  "   -strand=<+|-> - scan only one strand.  Default is both.\n"
+  "   -seqBackground - score against base composition of each sequence rather than\n"
+  "       a uniform background.\n"
+  "   -threads=N - scan with N threads, splitting up the motifs. Default %d\n"
+  "   -bench - also score every position with dnaMotifBitScore, check the scores\n"
+  "       agree, and report how long each way took to stderr.\n"
+  , threshold, threads
+  );
+}
+
+static struct optionSpec options[] = {
+   {"threshold", OPTION_DOUBLE},
+   {"minScore", OPTION_DOUBLE},
+   {"strand", OPTION_STRING},
+   {"seqBackground", OPTION_BOOLEAN},
+   {"threads", OPTION_INT},
+   {"bench", OPTION_BOOLEAN},
+   {NULL, 0},
+};
+
+struct motifHit
+/* A place where a motif scores above threshold. */
+    {
+    struct motifHit *next;	/* Next in list. */
+    struct dnaMotifPwm *pwm;	/* Compiled motif that hit. */
+    int start;			/* Start in sequence. */
+    float score;		/* Score in bits. */
+    };
+
+int motifHitCmp(const void *va, const void *vb)
+/* Compare to sort by start, motif name, then strand. */
+{
+const struct motifHit *a = *((struct motifHit **)va);
+const struct motifHit *b = *((struct motifHit **)vb);
+int diff = a->start - b->start;
+if (diff == 0)
+    diff = strcmp(a->pwm->motif->name, b->pwm->motif->name);
+if (diff == 0)
+    diff = a->pwm->strand - b->pwm->strand;
+return diff;
+}
+
+struct dnaMotif *loadMotifs(char *fileName)
+/* Load all motifs in tab separated file. */
+{
+struct dnaMotif *list = NULL, *motif;
+struct lineFile *lf = lineFileOpen(fileName, TRUE);
+char *row[6];
+while (lineFileRow(lf, row))
+    {
+    int count;
+    AllocVar(motif);
+    motif->name = cloneString(row[0]);
+    motif->columnCount = lineFileNeedNum(lf, row, 1);
+    sqlFloatDynamicArray(row[2], &motif->aProb, &count);
+    if (count != motif->columnCount)
+        errAbort("%s has %d A probabilities but %d columns line %d of %s",
+		 motif->name, count, motif->columnCount, lf->lineIx, lf->fileName);
+    sqlFloatDynamicArray(row[3], &motif->cProb, &count);
+    if (count != motif->columnCount)
+        errAbort("%s has %d C probabilities but %d columns line %d of %s",
+		 motif->name, count, motif->columnCount, lf->lineIx, lf->fileName);
+    sqlFloatDynamicArray(row[4], &motif->gProb, &count);
+    if (count != motif->columnCount)
+        errAbort("%s has %d G probabilities but %d columns line %d of %s",
+		 motif->name, count, motif->columnCount, lf->lineIx, lf->fileName);
+    sqlFloatDynamicArray(row[5], &motif->tProb, &count);
+    if (count != motif->columnCount)
+        errAbort("%s has %d T probabilities but %d columns line %d of %s",
+		 motif->name, count, motif->columnCount, lf->lineIx, lf->fileName);
+    dnaMotifMakeProbabalistic(motif);
+    slAddHead(&list, motif);
+    }
+lineFileClose(&lf);
+slReverse(&list);
+return list;
+}
+
+struct dnaMotifPwm *compileMotifs(struct dnaMotif *motifList, double mark0[5])
+/* Compile motifs on the strands we are scanning, and set thresholds. */
+{
+struct dnaMotifPwm *pwmList = NULL;
+struct dnaMotif *motif;
+for (motif = motifList; motif != NULL; motif = motif->next)
+    {
+    int i;
+    for (i = 0; i < 2; ++i)
+        {
+	char strand = (i == 0 ? '+' : '-');
+	if ((strand == '+' && !doPlus) || (strand == '-' && !doMinus))
+	    continue;
+	struct dnaMotifPwm *pwm = dnaMotifPwmNew(motif, mark0, strand);
+	if (isinf(minScore))
+	    pwm->threshold = dnaMotifPwmRelativeScore(pwm, threshold);
+	else
+	    pwm->threshold = minScore;
+	slAddHead(&pwmList, pwm);
+	}
+    }
+slReverse(&pwmList);
+return pwmList;
+}
+
+struct scanJob
+/* A share of the motifs to scan a sequence with, and the hits they make. */
+    {
+    struct scanJob *next;	/* Next in list. */
+    int jobIx;			/* This job does every jobCount'th pwm starting at jobIx. */
+    struct lm *lm;		/* Hits allocated here. */
+    struct motifHit *hitList;	/* Hits found. */
+    };
+
+struct scanContext
+/* What all the jobs scanning a sequence share. */
+    {
+    struct dnaMotifPwm **pwms;	/* All compiled motifs. */
+    int pwmCount;		/* Number of pwms. */
+    int jobCount;		/* Number of jobs splitting up the pwms. */
+    struct dnaMotifScanSeq *ss;	/* Sequence to scan. */
+    };
+
+static void addHit(void *context, struct dnaMotifPwm *pwm, int start, double score)
+/* Save hit on job's list. */
+{
+struct scanJob *job = context;
+struct motifHit *hit;
+lmAllocVar(job->lm, hit);
+hit->pwm = pwm;
+hit->start = start;
+hit->score = score;
+slAddHead(&job->hitList, hit);
+}
+
+static void scanJobDo(void *item, void *context)
+/* Scan sequence with this job's share of the motifs.  Called by pthreadDoList. */
+{
+struct scanJob *job = item;
+struct scanContext *sc = context;
+int i;
+for (i = job->jobIx; i < sc->pwmCount; i += sc->jobCount)
+    dnaMotifPwmScan(sc->pwms[i], sc->ss, addHit, job);
+}
+
+struct motifHit *scanSeq(struct dnaMotifPwm **pwms, int pwmCount, struct dnaMotifScanSeq *ss,
+	struct lm *lm)
+/* Return sorted list of hits of all pwms in ss. */
+{
+struct scanContext sc = {pwms, pwmCount, min(threads, pwmCount), ss};
+struct scanJob *jobs, *jobList = NULL;
+AllocArray(jobs, sc.jobCount);
+int i;
+for (i = sc.jobCount - 1; i >= 0; --i)
+    {
+    struct scanJob *job = &jobs[i];
+    job->jobIx = i;
+    job->lm = lmInit(0);
+    slAddHead(&jobList, job);
+    }
+pthreadDoList(sc.jobCount, jobList, scanJobDo, &sc);
+/* Copy into caller's lm so the per-job ones can go. */
+struct motifHit *hitList = NULL;
+for (i = 0; i < sc.jobCount; ++i)
+    {
+    struct motifHit *hit;
+    for (hit = jobs[i].hitList; hit != NULL; hit = hit->next)
+	{
+	struct motifHit *copy = lmCloneMem(lm, hit, sizeof(*hit));
+	slAddHead(&hitList, copy);
+	}
+    lmCleanup(&jobs[i].lm);
+    }
+freeMem(jobs);
+slSort(&hitList, motifHitCmp);
+return hitList;
+}
+
+void benchSeq(struct dnaMotifPwm **pwms, int pwmCount, struct dnaSeq *seq,
+	struct dnaMotifScanSeq *ss, double mark0[5], long scanTime)
+/* Score every position of seq with dnaMotifBitScore, compare with compiled motifs,
+ * and report times. */
+{
+long startTime = clock1000();
+DNA *rcDna = cloneStringZ(seq->dna, seq->size);
+reverseComplement(rcDna, seq->size);
+double mark0Rc[5];
+if (mark0 != NULL)
+    {
+    /* Reverse complement sequence needs the background complemented too. */
+    mark0Rc[0] = mark0[0];
+    mark0Rc[T_BASE_VAL+1] = mark0[A_BASE_VAL+1];
+    mark0Rc[A_BASE_VAL+1] = mark0[T_BASE_VAL+1];
+    mark0Rc[C_BASE_VAL+1] = mark0[G_BASE_VAL+1];
+    mark0Rc[G_BASE_VAL+1] = mark0[C_BASE_VAL+1];
+    }
+long long slowHits = 0;
+float *slowScores = NULL;
+int maxPosCount = 0;
+struct dnaMotifPwm *pwm;
+int i;
+for (i = 0; i < pwmCount; ++i)
+    {
+    pwm = pwms[i];
+    int posCount = seq->size - pwm->columnCount + 1;
+    if (posCount > maxPosCount)
+        {
+	freeMem(slowScores);
+	maxPosCount = posCount;
+	AllocArray(slowScores, maxPosCount);
+	}
+    }
+double maxDiff = 0;
+long long fastHits = 0;
+long slowTime = 0, allTime = 0;
+float *fastScores = NULL;
+if (maxPosCount > 0)
+    AllocArray(fastScores, maxPosCount);
+for (i = 0; i < pwmCount; ++i)
+    {
+    pwm = pwms[i];
+    struct dnaMotif *motif = pwm->motif;
+    int posCount = seq->size - pwm->columnCount + 1;
+    int pos;
+    long time = clock1000();
+    for (pos = 0; pos < posCount; ++pos)
+        {
+	double score;
+	if (pwm->strand == '+')
+	    score = (mark0 == NULL ? dnaMotifBitScore(motif, seq->dna + pos)
+			: dnaMotifBitScoreWithMark0Bg(motif, seq->dna + pos, mark0));
+	else
+	    {
+	    DNA *dna = rcDna + seq->size - pos - pwm->columnCount;
+	    score = (mark0 == NULL ? dnaMotifBitScore(motif, dna)
+			: dnaMotifBitScoreWithMark0Bg(motif, dna, mark0Rc));
+	    }
+	slowScores[pos] = score;
+	if (score >= pwm->threshold)
+	    ++slowHits;
+	}
+    slowTime += clock1000() - time;
+    time = clock1000();
+    dnaMotifPwmScoreAll(pwm, ss, fastScores);
+    allTime += clock1000() - time;
+    for (pos = 0; pos < posCount; ++pos)
+        {
+	if (fastScores[pos] >= pwm->threshold)
+	    ++fastHits;
+	/* The product in dnaMotifSequenceProb can underflow to zero on long motifs,
+	 * so only compare where both are finite. */
+	if (!isinf(slowScores[pos]) && !isinf(fastScores[pos]))
+	    {
+	    double diff = fabs(slowScores[pos] - fastScores[pos]);
+	    if (diff > maxDiff)
+		maxDiff = diff;
+	    }
+	}
+    }
+fprintf(stderr, "%s: %d bases, %d compiled motifs\n", seq->name, seq->size, pwmCount);
+fprintf(stderr, "  dnaMotifBitScore: %ld millis, %lld hits\n", slowTime, slowHits);
+fprintf(stderr, "  dnaMotifPwmScoreAll: %ld millis, %lld hits\n", allTime, fastHits);
+fprintf(stderr, "  dnaMotifScan with threshold: %ld millis\n", scanTime);
+fprintf(stderr, "  largest score difference: %g bits\n", maxDiff);
+fprintf(stderr, "  total benchmark time: %ld millis\n", clock1000() - startTime);
+freeMem(fastScores);
+freeMem(slowScores);
+freeMem(rcDna);
+}
+
+void motifScan(char *motifFile, char *seqFile, char *outFile)
+/* motifScan - scan sequence for matches to many position weight matrix motifs. */
+{
+struct dnaMotif *motifList = loadMotifs(motifFile);
+verbose(2, "Loaded %d motifs from %s\n", slCount(motifList), motifFile);
+struct dnaMotifPwm *pwmList = NULL;
+if (!seqBackground)
+    pwmList = compileMotifs(motifList, NULL);
+FILE *f = mustOpen(outFile, "w");
+struct dnaLoad *dl = dnaLoadOpen(seqFile);
+struct dnaSeq *seq;
+while ((seq = dnaLoadNext(dl)) != NULL)
+    {
+    double mark0Buf[5], *mark0 = NULL;
+    if (seqBackground)
+        {
+	/* Background differs per sequence, so tables do too. */
+	mark0 = mark0Buf;
+	seq->next = NULL;
+	dnaMark0(seq, mark0, NULL);
+	dnaMotifPwmFreeList(&pwmList);
+	pwmList = compileMotifs(motifList, mark0);
+	}
+    int pwmCount = slCount(pwmList);
+    if (pwmCount > 0)
+	{
+	struct dnaMotifPwm **pwms, *pwm;
+	AllocArray(pwms, pwmCount);
+	int i = 0;
+	for (pwm = pwmList; pwm != NULL; pwm = pwm->next)
+	    pwms[i++] = pwm;
+	long time = clock1000();
+	struct dnaMotifScanSeq *ss = dnaMotifScanSeqNew(seq->dna, seq->size);
+	struct lm *lm = lmInit(0);
+	struct motifHit *hit, *hitList = scanSeq(pwms, pwmCount, ss, lm);
+	time = clock1000() - time;
+	verbose(2, "%s: %d hits in %ld millis\n", seq->name, slCount(hitList), time);
+	for (hit = hitList; hit != NULL; hit = hit->next)
+	    fprintf(f, "%s\t%d\t%d\t%s\t%.3f\t%c\n", seq->name, hit->start,
+		    hit->start + hit->pwm->columnCount, hit->pwm->motif->name, hit->score,
+		    hit->pwm->strand);
+	if (bench)
+	    benchSeq(pwms, pwmCount, seq, ss, mark0, time);
+	freeMem(pwms);
+	lmCleanup(&lm);
+	dnaMotifScanSeqFree(&ss);
+	}
+    dnaSeqFree(&seq);
+    }
+dnaLoadClose(&dl);
+carefulClose(&f);
+dnaMotifPwmFreeList(&pwmList);
+dnaMotifFreeList(&motifList);
+}
+
+int main(int argc, char *argv[])
+/* Process command line. */
+{
+optionInit(&argc, argv, options);
+if (argc != 4)
+    usage();
+threshold = optionDouble("threshold", threshold);
+minScore = optionDouble("minScore", minScore);
+threads = optionInt("threads", threads);
+if (threads < 1 || threads > 256)
+    errAbort("-threads must be between 1 and 256");
+seqBackground = optionExists("seqBackground");
+bench = optionExists("bench");
+char *strand = optionVal("strand", NULL);
+if (strand != NULL)
+    {
+    if (sameString(strand, "+"))
+        doMinus = FALSE;
+    else if (sameString(strand, "-"))
+        doPlus = FALSE;
+    else
+        errAbort("-strand must be + or -, not %s", strand);
+    }
+dnaUtilOpen();
+motifScan(argv[1], argv[2], argv[3]);
+return 0;
+}
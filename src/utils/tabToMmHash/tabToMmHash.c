@@ -15,24 +15,40 @@ errAbort(
   "tabToMmHash - Read in a tab-sep file, hash first column to string of remaining columns, write mmHash file\n"
   "usage:\n"
   "   tabToMmHash in.tab out.mmh\n"
-//  "options:\n"
-//  "   -xxx=XXX\n"
+  "options:\n"
+  "   -v2           Write version 2 mmHash, streaming lines instead of reading them into\n"
+  "                 memory.  Use this for big files; lookups are also faster.  Files are not\n"
+  "                 readable by programs built before version 2 was added.\n"
+  "   -tmpDir=dir   With -v2, put temporary files in dir instead of the default temp dir\n"
+  "   -maxMem=N     With -v2, use at most about N bytes of memory for key hashes before\n"
+  "                 sorting them to temporary files (default 1G)\n"
   );
 }
 
 /* Command line validation table. */
 static struct optionSpec options[] = {
+   {"v2", OPTION_BOOLEAN},
+   {"tmpDir", OPTION_STRING},
+   {"maxMem", OPTION_LONG_LONG},
    {NULL, 0},
 };
 
+static boolean v2 = FALSE;
+static char *tmpDir = NULL;
+static long long maxMem = 0;
+
 void tabToMmHash(char *tabIn, char *mmhOut)
 /* tabToMmHash - Read in a tab-sep file, hash first column to string of remaining columns,
  * write mmHash file. */
 {
-// Read inFile into hash
+// Read inFile into hash, or stream it into builder for version 2
 struct lineFile *lf = lineFileOpen(tabIn, TRUE);
-struct hash *hash = hashNew(0);
-struct slName *keyList = NULL;
+struct hash *hash = NULL;
+struct mmHashBuilder *mhb = NULL;
+if (v2)
+    mhb = mmHashBuilderNew(mmhOut, tmpDir, maxMem);
+else
+    hash = hashNew(0);
 char *line;
 int size;
 while (lineFileNext(lf, &line, &size))
@@ -45,15 +61,21 @@ while (lineFileNext(lf, &line, &size))
         *tab = '\0';
         val = tab + 1;
         }
-    hashAdd(hash, key, cloneString(val));
-    slNameAddHead(&keyList, key);
+    if (mhb != NULL)
+        mmHashBuilderAdd(mhb, key, val);
+    else
+        hashAdd(hash, key, cloneString(val));
     }
 lineFileClose(&lf);
-slReverse(&keyList);
 
-// Convert hash to mmHash file.
-hashToMmHashFile(hash, mmhOut);
-freeHashAndVals(&hash);
+// Convert hash to mmHash file, or finish building it.
+if (mhb != NULL)
+    mmHashBuilderFinish(&mhb);
+else
+    {
+    hashToMmHashFile(hash, mmhOut);
+    freeHashAndVals(&hash);
+    }
 }
 
 int main(int argc, char *argv[])
@@ -62,6 +84,9 @@ int main(int argc, char *argv[])
 optionInit(&argc, argv, options);
 if (argc != 3)
     usage();
+v2 = optionExists("v2");
+tmpDir = optionVal("tmpDir", tmpDir);
+maxMem = optionLongLong("maxMem", maxMem);
 tabToMmHash(argv[1], argv[2]);
 return 0;
 }
@@ -0,0 +1,38 @@
+/* textToWordIndex - Make a memory mapped word index of a file of ids and text, such as
+ * a grepIndex file, for fast in-process word prefix searches. */
+#include "common.h"
+#include "options.h"
+#include "wordIndex.h"
+
+/* This file is copyright 2026 UCSC Genome Browser Authors, but license is hereby
+ * granted for all use - public, private or commercial. */
+
+void usage()
+/* Explain usage and exit. */
+{
+errAbort(
+  "textToWordIndex - Make a memory mapped word index of a file of ids and text, such as\n"
+  "a grepIndex file, for fast in-process word prefix searches\n"
+  "usage:\n"
+  "   textToWordIndex in.txt out.wix\n"
+  "Words are runs of letters and digits, indexed without regard to case.  Blank lines\n"
+  "and lines starting with # are skipped.  hgFind uses file.wix in place of running\n"
+  "fgrep over grepIndex file when it exists, so for those the usual invocation is\n"
+  "   textToWordIndex file file.wix\n"
+  );
+}
+
+/* Command line validation table. */
+static struct optionSpec options[] = {
+   {NULL, 0},
+};
+
+int main(int argc, char *argv[])
+/* Process command line. */
+{
+optionInit(&argc, argv, options);
+if (argc != 3)
+    usage();
+wordIndexFromTextFile(argv[1], argv[2]);
+return 0;
+}